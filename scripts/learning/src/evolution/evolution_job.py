@@ -60,6 +60,25 @@ class EvolutionJob(NTRTJob):
                 subprocess.check_call([self.args['executable'], "-l", self.args['filename'], "-P", self.args['path'], "-s", str(trialLength), "-b", str(run[0]), "-H", str(run[1]), "-a", str(run[2]), "-B", str(run[3])], stdout=logFile)
             sys.exit()
 
+    def workerTasks(self):
+        """
+        The trials startJob would run, as (workerArgs, fileName, steps)
+        tuples for a WorkerScheduler.
+        """
+        terrainMatrix = self.args['terrain']
+        if len(terrainMatrix[0]) < 4:
+            raise NTRTMasterError("Not enough terrain args!")
+
+        tasks = []
+        for run in terrainMatrix:
+            if (len(run)) >= 5:
+                trialLength = run[4]
+            else:
+                trialLength = self.args['length']
+            workerArgs = [self.args['executable'], "-P", self.args['path'], "-b", str(run[0]), "-H", str(run[1]), "-a", str(run[2]), "-B", str(run[3])]
+            tasks.append((workerArgs, self.args['filename'], trialLength))
+        return tasks
+
     def processJobOutput(self):
         scoresPath = self.args['resourcePrefix'] + self.args['path'] + self.args['filename']
 
@@ -4,6 +4,7 @@ import random
 import collections
 from interfaces import NTRTJobMaster, NTRTMasterError
 from concurrent_scheduler import ConcurrentScheduler
+from worker_scheduler import WorkerScheduler
 import collections
 #TODO: This is hackety, fix it.
 from evolution_job import EvolutionJob
@@ -523,6 +524,13 @@ class EvolutionJobMaster(NTRTJobMaster):
 
         scoreDump = open('scoreDump.txt', 'w')
         scoreDump.close()
+
+        # Persistent workers keep each app's world alive between trials.
+        # The executable must support -W
+        workerScheduler = None
+        if self.jConf.get('persistentWorkers', False):
+            workerScheduler = WorkerScheduler(self.numProcesses, self.jConf['resourcePath'] + self.jConf['lowerPath'])
+
         for n in range(numGenerations):
             # Create the generation'
             for p in self.prefixes:
@@ -554,8 +562,11 @@ class EvolutionJobMaster(NTRTJobMaster):
                         jobList.append(EvolutionJob(args))
 
             # Run the jobs
-            conSched = ConcurrentScheduler(jobList, self.numProcesses)
-            completedJobs = conSched.processJobs()
+            if workerScheduler is not None:
+                completedJobs = workerScheduler.processJobs(jobList)
+            else:
+                conSched = ConcurrentScheduler(jobList, self.numProcesses)
+                completedJobs = conSched.processJobs()
 
             # Read scores from files, write to logs
             totalScore = 0
@@ -586,3 +597,5 @@ class EvolutionJobMaster(NTRTJobMaster):
             logFile.write(str((n+1) * numTrials) + ',' + str(maxScore) + ',' + str(avgScore) +'\n')
             logFile.close()
 
+        if workerScheduler is not None:
+            workerScheduler.close()
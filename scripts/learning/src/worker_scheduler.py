@@ -0,0 +1,234 @@
+import logging
+import os
+import select
+import shutil
+import socket
+import subprocess
+import tempfile
+from interfaces import NTRTMasterError
+
+class WorkerScheduler:
+    """
+    Runs jobs on a fixed pool of long lived NTRT workers instead of
+    starting an executable per trial. A worker is a learning app started
+    with -W <socket>: it connects back, builds its world once and then
+    loops asking for parameter files to evaluate. The protocol is
+    described in src/learning/Adapters/LearningWorker.h.
+
+    Jobs provide workerTasks(), a list of (workerArgs, fileName, steps).
+    Workers started with the same workerArgs (executable and terrain
+    options) can run each other's tasks. Keep one scheduler for the whole
+    learning run so the workers outlive each generation, and call close()
+    at the end.
+    """
+
+    # Seconds to wait for messages before checking on the processes
+    __POLL_TIMEOUT = 1.0
+
+    def __init__(self, numProcesses, logPath = ''):
+        self.numProcesses = numProcesses
+        self.logPath = logPath
+        self.__dir = tempfile.mkdtemp(prefix = 'ntrt_workers')
+        self.__socketPath = os.path.join(self.__dir, 'scheduler.sock')
+        self.__listener = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.__listener.bind(self.__socketPath)
+        self.__listener.listen(numProcesses)
+        self.__workers = []
+        # Accepted connections that have not said which worker they are
+        self.__anonymous = []
+        self.__pending = []
+        self.__nextTaskID = 0
+        self.__spawned = 0
+        logging.info("Worker scheduler listening on %s. Number of workers: %d." % (self.__socketPath, numProcesses))
+
+    def processJobs(self, toProcess):
+        """
+        Run every task of the jobs in toProcess, which is emptied as by
+        ConcurrentScheduler, and return the jobs once all tasks are done.
+        The controllers write scores to the jobs' files as before; the
+        scores the workers report are also kept in job.workerScores.
+        """
+        jobs = []
+        while len(toProcess) > 0:
+            job = toProcess.pop()
+            job.workerScores = []
+            jobs.append(job)
+            for workerArgs, fileName, steps in job.workerTasks():
+                self.__pending.append({'job' : job,
+                                       'key' : tuple(workerArgs),
+                                       'file' : fileName,
+                                       'steps' : steps})
+
+        logging.info("Worker scheduler beginning %d tasks." % len(self.__pending))
+        while len(self.__pending) > 0 or self.__outstanding() > 0:
+            self.__balance()
+            self.__dispatch()
+            self.__poll()
+
+        return jobs
+
+    def close(self):
+        """ Tell every worker to quit and wait for them to exit """
+        for worker in self.__workers:
+            if worker['conn'] is None:
+                worker['proc'].kill()
+            else:
+                self.__send(worker, "quit")
+        for worker in self.__workers:
+            worker['proc'].wait()
+            self.__forget(worker)
+        self.__workers = []
+        self.__listener.close()
+        shutil.rmtree(self.__dir, True)
+
+    def __outstanding(self):
+        return sum(len(w['tasks']) for w in self.__workers)
+
+    def __balance(self):
+        """
+        Start workers for the kinds of task waiting to run, retiring idle
+        workers of other kinds if the pool is full.
+        """
+        needed = {}
+        for task in self.__pending:
+            needed[task['key']] = needed.get(task['key'], 0) + 1
+
+        for key, count in needed.items():
+            have = len([w for w in self.__workers if w['key'] == key and not w['quitting']])
+            if have >= count:
+                continue
+            if len(self.__workers) >= self.numProcesses:
+                idle = [w for w in self.__workers
+                        if w['waiting'] == 'ready' and w['key'] not in needed and not w['quitting']]
+                if len(idle) == 0:
+                    return
+                self.__retire(idle[0])
+            if len(self.__workers) < self.numProcesses:
+                self.__spawn(key)
+
+    def __spawn(self, key):
+        args = list(key) + ["-W", self.__socketPath]
+        logFile = open(os.path.join(self.logPath, 'worker_%d_log.txt' % self.__spawned), 'wb')
+        proc = subprocess.Popen(args, stdout = logFile)
+        logFile.close()
+        self.__spawned += 1
+        logging.info("Started worker %d: %r" % (proc.pid, args))
+        self.__workers.append({'proc' : proc,
+                               'key' : key,
+                               'conn' : None,
+                               'buffer' : '',
+                               # The request the worker is waiting on
+                               'waiting' : None,
+                               # Dispatched tasks not yet reported, by id
+                               'tasks' : {},
+                               'quitting' : False})
+
+    def __retire(self, worker):
+        logging.info("Retiring idle worker %d." % worker['proc'].pid)
+        self.__send(worker, "quit")
+        worker['quitting'] = True
+        worker['waiting'] = None
+
+    def __dispatch(self):
+        """ Answer every worker waiting for a job """
+        # Trials of the same job share a file that each one rewrites
+        busyFiles = set()
+        for worker in self.__workers:
+            for task in worker['tasks'].values():
+                busyFiles.add(task['file'])
+
+        for worker in self.__workers:
+            if worker['waiting'] is None:
+                continue
+            task = None
+            for candidate in self.__pending:
+                if candidate['key'] == worker['key'] and candidate['file'] not in busyFiles:
+                    task = candidate
+                    break
+            if task is not None:
+                self.__pending.remove(task)
+                taskID = str(self.__nextTaskID)
+                self.__nextTaskID += 1
+                worker['tasks'][taskID] = task
+                busyFiles.add(task['file'])
+                self.__send(worker, "job %s %d %s" % (taskID, task['steps'], task['file']))
+                worker['waiting'] = None
+            elif worker['waiting'] == 'next':
+                # It must report its job before asking again
+                self.__send(worker, "none")
+                worker['waiting'] = None
+
+    def __poll(self):
+        """ Handle connections, messages and exited workers """
+        conns = [w['conn'] for w in self.__workers if w['conn'] is not None]
+        conns += [a['conn'] for a in self.__anonymous]
+        readable = select.select([self.__listener] + conns, [], [], self.__POLL_TIMEOUT)[0]
+
+        for conn in readable:
+            if conn is self.__listener:
+                newConn = self.__listener.accept()[0]
+                self.__anonymous.append({'conn' : newConn, 'buffer' : ''})
+                continue
+            owner = [w for w in self.__workers if w['conn'] is conn]
+            owner += [a for a in self.__anonymous if a['conn'] is conn]
+            self.__receive(owner[0])
+
+        for worker in list(self.__workers):
+            if worker['proc'].poll() is not None:
+                self.__lost(worker)
+
+    def __receive(self, owner):
+        data = owner['conn'].recv(4096)
+        if not data:
+            if owner in self.__anonymous:
+                self.__anonymous.remove(owner)
+                owner['conn'].close()
+            return
+        owner['buffer'] += data.decode()
+        while '\n' in owner['buffer']:
+            line, owner['buffer'] = owner['buffer'].split('\n', 1)
+            owner = self.__handle(owner, line.split(' ', 2))
+
+    def __handle(self, owner, words):
+        """
+        Handle one message, returning the worker that sent it once known
+        """
+        if words[0] in ('ready', 'next'):
+            if owner in self.__anonymous:
+                pid = int(words[1])
+                worker = [w for w in self.__workers if w['proc'].pid == pid][0]
+                worker['conn'] = owner['conn']
+                worker['buffer'] = owner['buffer']
+                self.__anonymous.remove(owner)
+                owner = worker
+            if not owner['quitting']:
+                owner['waiting'] = words[0]
+        elif words[0] == 'done':
+            task = owner['tasks'].pop(words[1])
+            scores = [float(s) for s in words[2].split()] if len(words) > 2 else []
+            task['job'].workerScores.append(scores)
+        elif words[0] == 'error':
+            task = owner['tasks'].pop(words[1])
+            logging.error("Worker %d failed on %s: %s" % (owner['proc'].pid, task['file'], words[2]))
+        else:
+            raise NTRTMasterError("Unknown message from worker: %r" % ' '.join(words))
+        return owner
+
+    def __lost(self, worker):
+        """ Remove a worker whose process has exited """
+        status = worker['proc'].returncode
+        if worker['conn'] is None and not worker['quitting']:
+            raise NTRTMasterError("Worker exited with status %d before connecting. Does %s support -W?" % (status, worker['key'][0]))
+        for task in worker['tasks'].values():
+            # Its job finishes like one whose process crashed
+            logging.error("Worker %d exited with status %d during %s" % (worker['proc'].pid, status, task['file']))
+        self.__forget(worker)
+        self.__workers.remove(worker)
+
+    def __forget(self, worker):
+        if worker['conn'] is not None:
+            worker['conn'].close()
+            worker['conn'] = None
+
+    def __send(self, worker, line):
+        worker['conn'].sendall((line + '\n').encode())
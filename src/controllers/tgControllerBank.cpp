@@ -0,0 +1,190 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgControllerBank.cpp
+ * @brief Implementation of the tgControllerBank class
+ * $Id$
+ */
+
+// This module
+#include "tgControllerBank.h"
+// This library
+#include "tgImpedanceController.h"
+#include "core/tgBasicActuator.h"
+#include "core/tgCast.h"
+#include "core/tgSpringCableActuator.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+tgControllerBank::tgControllerBank()
+{
+}
+
+std::size_t tgControllerBank::add(tgSpringCableActuator& actuator,
+                                  const tgImpedanceController& impedance,
+                                  const tgPIDController::Config& pidConfig)
+{
+    if (tgCast::cast<tgSpringCableActuator, tgBasicActuator>(&actuator) != NULL)
+    {
+        throw std::invalid_argument("tgBasicActuators are not controlled through setControlInput");
+    }
+    
+    m_actuators.push_back(&actuator);
+    
+    m_offsetTension.push_back(impedance.getOffsetTension());
+    m_lengthStiffness.push_back(impedance.getLengthStiffness());
+    m_velStiffness.push_back(impedance.getVelStiffness());
+    m_position.push_back(0.0);
+    m_offsetVel.push_back(0.0);
+    
+    m_kP.push_back(pidConfig.kP);
+    m_kI.push_back(pidConfig.kI);
+    m_kD.push_back(pidConfig.kD);
+    m_startingSetPoint.push_back(pidConfig.startingSetPoint);
+    
+    m_setTension.push_back(pidConfig.startingSetPoint);
+    m_prevError.push_back(0.0);
+    m_intError.push_back(0.0);
+    
+    m_length.push_back(0.0);
+    m_velocity.push_back(0.0);
+    m_tension.push_back(0.0);
+    m_output.push_back(0.0);
+    
+    return m_actuators.size() - 1;
+}
+
+void tgControllerBank::setTarget(std::size_t i, double position, double offsetVel)
+{
+    assert(i < size());
+    m_position[i] = position;
+    m_offsetVel[i] = offsetVel;
+}
+
+void tgControllerBank::setOffsetTension(std::size_t i, double offsetTension)
+{
+    assert(i < size());
+    assert(offsetTension >= 0.0);
+    m_offsetTension[i] = offsetTension;
+}
+
+void tgControllerBank::controlImpedance(double dt)
+{
+    if (dt <= 0.0)
+    {
+        throw std::runtime_error ("Timestep must be positive.");
+    }
+    
+    readSensors();
+    
+    const std::size_t n = size();
+    const double* const offset = n ? &m_offsetTension[0] : NULL;
+    const double* const kLength = n ? &m_lengthStiffness[0] : NULL;
+    const double* const kVel = n ? &m_velStiffness[0] : NULL;
+    const double* const position = n ? &m_position[0] : NULL;
+    const double* const offsetVel = n ? &m_offsetVel[0] : NULL;
+    const double* const length = n ? &m_length[0] : NULL;
+    const double* const velocity = n ? &m_velocity[0] : NULL;
+    double* const setTension = n ? &m_setTension[0] : NULL;
+    
+    // The impedance law of tgImpedanceController::controlTension,
+    // in the same order of operations
+    for (std::size_t i = 0; i < n; i++)
+    {
+        setTension[i] =
+            std::max(static_cast<double>(0.0),
+                     offset[i] +
+                     kLength[i] * (length[i] - position[i]) +
+                     kVel[i] * (velocity[i] - offsetVel[i]));
+    }
+    
+    runPID(dt);
+    applyOutputs();
+}
+
+void tgControllerBank::controlTension(double dt)
+{
+    if (dt <= 0.0)
+    {
+        throw std::runtime_error ("Timestep must be positive.");
+    }
+    
+    readSensors();
+    runPID(dt);
+    applyOutputs();
+}
+
+void tgControllerBank::reset()
+{
+    m_setTension = m_startingSetPoint;
+    std::fill(m_prevError.begin(), m_prevError.end(), 0.0);
+    std::fill(m_intError.begin(), m_intError.end(), 0.0);
+    std::fill(m_output.begin(), m_output.end(), 0.0);
+}
+
+void tgControllerBank::readSensors()
+{
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const tgSpringCableActuator& actuator = *m_actuators[i];
+        m_length[i] = actuator.getCurrentLength();
+        m_velocity[i] = actuator.getVelocity();
+        m_tension[i] = actuator.getTension();
+    }
+}
+
+void tgControllerBank::runPID(double dt)
+{
+    const std::size_t n = size();
+    if (n == 0)
+    {
+        return;
+    }
+    
+    const double* const kP = &m_kP[0];
+    const double* const kI = &m_kI[0];
+    const double* const kD = &m_kD[0];
+    const double* const setTension = &m_setTension[0];
+    const double* const tension = &m_tension[0];
+    double* const prevError = &m_prevError[0];
+    double* const intError = &m_intError[0];
+    double* const output = &m_output[0];
+    
+    // tgPIDController::control(dt), in the same order of operations
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const double error = setTension[i] - tension[i];
+        intError[i] += (error + prevError[i]) / 2.0 * dt;
+        const double dError = (error - prevError[i]) / dt;
+        output[i] = kP[i] * error + kI[i] * intError[i] + kD[i] * dError;
+        prevError[i] = error;
+    }
+}
+
+void tgControllerBank::applyOutputs()
+{
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        m_actuators[i]->setControlInput(m_output[i]);
+    }
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_CONTROLLER_BANK_H
+#define TG_CONTROLLER_BANK_H
+
+/**
+ * @file tgControllerBank.h
+ * @brief Definition of the tgControllerBank class
+ * $Id$
+ */
+
+// This library
+#include "tgPIDController.h"
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+// Forward declarations
+class tgImpedanceController;
+class tgSpringCableActuator;
+
+/**
+ * Impedance and PID control of many spring-cable actuators at once.
+ * Replaces one tgImpedanceController and one tgPIDController per
+ * actuator: the gains, setpoints and PID state of all actuators are
+ * kept in arrays, the sensors are read once per step and the control
+ * inputs of all actuators are computed in one loop the compiler can
+ * vectorize.
+ *
+ * For the same inputs the results are identical to
+ * tgImpedanceController::control followed by tgPIDController::control,
+ * as in tgCPGCableControl::onStep. Actuators are controlled through
+ * setControlInput, so tgBasicActuators, which tgImpedanceController
+ * drives through tgTensionController, are not supported.
+ */
+class tgControllerBank
+{
+public:
+    
+    tgControllerBank();
+    
+    /**
+     * Add an actuator. The bank does not own it, it must outlive the
+     * bank.
+     * @param[in] actuator the actuator, controlled with setControlInput
+     * @param[in] impedance supplies the offset tension and stiffnesses
+     * @param[in] pidConfig the gains and starting setpoint of the
+     * tension PID loop
+     * @return the index of the actuator in the bank
+     * @throw std::invalid_argument if actuator is a tgBasicActuator
+     */
+    std::size_t add(tgSpringCableActuator& actuator,
+                    const tgImpedanceController& impedance,
+                    const tgPIDController::Config& pidConfig);
+    
+    std::size_t size() const
+    {
+        return m_actuators.size();
+    }
+    
+    /**
+     * Set the length and offset velocity the next controlImpedance uses,
+     * the newPosition and offsetVel of tgImpedanceController::control
+     */
+    void setTarget(std::size_t i, double position, double offsetVel = 0.0);
+    
+    /** Change the offset tension of actuator i, must be non-negative */
+    void setOffsetTension(std::size_t i, double offsetTension);
+    
+    /**
+     * Compute the set tensions from the targets with the impedance law,
+     * then run the PID loops on them.
+     * @param[in] dt the timestep, must be positive
+     * @throw std::runtime_error if dt is not positive
+     */
+    void controlImpedance(double dt);
+    
+    /**
+     * Run the PID loops on the set tensions of the last controlImpedance,
+     * for the steps in between control steps
+     * @param[in] dt the timestep, must be positive
+     * @throw std::runtime_error if dt is not positive
+     */
+    void controlTension(double dt);
+    
+    /** The set tension of actuator i from the last controlImpedance */
+    double getSetTension(std::size_t i) const
+    {
+        return m_setTension[i];
+    }
+    
+    /** The control input last given to actuator i */
+    double getControlInput(std::size_t i) const
+    {
+        return m_output[i];
+    }
+    
+    /** Clear the PID state and set tensions, as new controllers would be */
+    void reset();
+    
+private:
+    
+    /** Read length, velocity and tension of every actuator */
+    void readSensors();
+    
+    /**
+     * The tension PID loops of tgPIDController::control, on all
+     * actuators
+     */
+    void runPID(double dt);
+    
+    /** Give every actuator its control input */
+    void applyOutputs();
+    
+    /** Not owned */
+    std::vector<tgSpringCableActuator*> m_actuators;
+    
+    // Impedance law
+    std::vector<double> m_offsetTension;
+    std::vector<double> m_lengthStiffness;
+    std::vector<double> m_velStiffness;
+    std::vector<double> m_position;
+    std::vector<double> m_offsetVel;
+    
+    // PID gains, already inverted for tension control as in Config
+    std::vector<double> m_kP;
+    std::vector<double> m_kI;
+    std::vector<double> m_kD;
+    std::vector<double> m_startingSetPoint;
+    
+    // PID state
+    std::vector<double> m_setTension;
+    std::vector<double> m_prevError;
+    std::vector<double> m_intError;
+    
+    // Sensors and outputs of the current step
+    std::vector<double> m_length;
+    std::vector<double> m_velocity;
+    std::vector<double> m_tension;
+    std::vector<double> m_output;
+};
+
+#endif  // TG_CONTROLLER_BANK_H
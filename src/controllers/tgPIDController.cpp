@@ -114,3 +114,11 @@ void tgPIDController::setSensorData(double sensorData)
 	/// @todo - are there any sanity checks we can enforce here?
 	m_sensorData = sensorData;
 }
+
+void tgPIDController::reset()
+{
+	m_sensorData = 0.0;
+	m_prevError = 0.0;
+	m_intError = 0.0;
+	m_setPoint = m_config.startingSetPoint;
+}
@@ -132,6 +132,13 @@ public:
 	 */
 	virtual void setSensorData(double sensorData);
 	
+	/**
+	 * Clear the error history and return to the starting setpoint,
+	 * as a new controller would be. Called when a simulation is
+	 * restored rather than rebuilt
+	 */
+	virtual void reset();
+	
 	/// @todo should we have a getSensorData function? Might make code changes simpler later
 	
 private:
@@ -65,7 +65,8 @@ tgBasicActuator::tgBasicActuator(tgBulletSpringCable* muscle,
                    const tgTags& tags,
                    tgSpringCableActuator::Config& config) :
     tgSpringCableActuator(muscle, tags, config),
-    m_preferredLength(m_restLength)
+    m_preferredLength(m_restLength),
+    m_snapshotPreferredLength(m_restLength)
 {
     constructorAux();
 
@@ -112,6 +113,19 @@ void tgBasicActuator::step(double dt)
     }
 }
 
+void tgBasicActuator::snapshot()
+{
+    m_snapshotPreferredLength = m_preferredLength;
+    tgSpringCableActuator::snapshot();
+}
+
+void tgBasicActuator::restore()
+{
+    m_preferredLength = m_snapshotPreferredLength;
+    tgSpringCableActuator::restore();
+    logHistory();
+}
+
 void tgBasicActuator::onVisit(const tgModelVisitor& r) const
 {
 #ifndef BT_NO_PROFILE 
@@ -124,7 +138,7 @@ void tgBasicActuator::logHistory()
 {
     m_prevVelocity = m_springCable->getVelocity();
 
-    if (m_config.hist)
+    if (m_config.hist && m_pHistory->sample())
     {
         m_pHistory->lastLengths.push_back(m_springCable->getActualLength());
         m_pHistory->lastVelocities.push_back(m_springCable->getVelocity());
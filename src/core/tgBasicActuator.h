@@ -77,6 +77,15 @@ public:
      */    
     virtual void step(double dt);
     
+    /** Records the preferred length along with the base class state */
+    virtual void snapshot();
+    
+    /**
+     * Restores the preferred length and base class state, logs the
+     * first history entry and notifies observers of the restore
+     */
+    virtual void restore();
+    
     /**
      * Double dispatch function for a tgModelVisitor. This object
      * will pass itself back to the visitor. Used for rendering and 
@@ -135,6 +144,9 @@ private:
      */
     double m_preferredLength;
     
+    /** m_preferredLength when snapshot() was called */
+    double m_snapshotPreferredLength;
+    
 };
 
 
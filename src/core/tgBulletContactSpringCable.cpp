@@ -30,6 +30,7 @@
 // NTRT
 #include "tgcreator/tgUtil.h"
 #include "core/tgBulletSpringCableAnchor.h"
+#include "core/tgBulletSpringCableAnchorPool.h"
 #include "core/tgCast.h"
 #include "core/tgBulletUtil.h"
 #include "core/tgWorld.h"
@@ -48,6 +49,7 @@
 #include "LinearMath/btQuickprof.h"
 
 // The C++ Standard Library
+#include <algorithm>	// sort
 #include <iostream>
 #include <cmath>		// abs
 #include <stdexcept>
@@ -125,6 +127,20 @@ void tgBulletContactSpringCable::step(double dt)
     assert(invariant());
 }
 
+void tgBulletContactSpringCable::restore()
+{
+    tgBulletSpringCable::restore();
+    
+    for (int i = m_anchors.size() - 1; i >= 0; i--)
+    {
+        deleteAnchor(i);
+    }
+    
+    updateCollisionObject();
+    
+    assert(invariant());
+}
+
 void tgBulletContactSpringCable::calculateAndApplyForce(double dt)
 {
 #ifndef BT_NO_PROFILE 
@@ -233,6 +249,9 @@ void tgBulletContactSpringCable::updateManifolds()
 	
 	btBroadphaseInterface* const m_overlappingPairCache = tgBulletUtil::worldToDynamicsWorld(m_world).getBroadphase();
 	
+	// New anchors come from the world's pool, delete returns them
+	tgBulletSpringCableAnchorPool& anchorPool = tgBulletUtil::worldToAnchorPool(m_world);
+	
 	// Only caches the pairs, they don't have a lot of useful information
 	btBroadphasePairArray& pairArray = m_ghostObject->getOverlappingPairCache()->getOverlappingPairArray();
 	int numPairs = pairArray.size();
@@ -309,7 +328,7 @@ void tgBulletContactSpringCable::updateManifolds()
 						if (anchorPos >= 0)
 						{
 							// Not permanent, sliding contact
-							tgBulletSpringCableAnchor* const newAnchor = new tgBulletSpringCableAnchor(rb, pos, m_touchingNormal, false, true, manifold);
+							tgBulletSpringCableAnchor* const newAnchor = new (anchorPool) tgBulletSpringCableAnchor(rb, pos, m_touchingNormal, false, true, manifold);
 						
 							
 							tgBulletSpringCableAnchor* backAnchor = m_anchors[anchorPos];
@@ -686,12 +705,7 @@ void tgBulletContactSpringCable::updateCollisionObject()
     BT_PROFILE("updateCollisionObject");
 #endif //BT_NO_PROFILE    
 	
-	btDispatcher* m_dispatcher = tgBulletUtil::worldToDynamicsWorld(m_world).getDispatcher();
-	btBroadphaseInterface* const m_overlappingPairCache = tgBulletUtil::worldToDynamicsWorld(m_world).getBroadphase();
-	
-    // Clear the existing child shapes
     btCompoundShape* m_compoundShape = tgCast::cast<btCollisionShape, btCompoundShape> (m_ghostObject->getCollisionShape());
-    clearCompoundShape(m_compoundShape);
     
     btVector3 maxes(anchor2->getWorldPosition());
     btVector3 mins(anchor1->getWorldPosition());
@@ -715,10 +729,23 @@ void tgBulletContactSpringCable::updateCollisionObject()
     }
     btVector3 center = (maxes + mins)/2.0;
     
-    btVector3 from = anchor1->getWorldPosition();
-	btVector3 to = anchor2->getWorldPosition();
+    const int nSegments = n - 1;
+    
+    // Remove surplus children, and any not made by createSegmentShape
+    // (the builder starts the ghost object with a box)
+    for (int i = m_compoundShape->getNumChildShapes() - 1; i >= 0; i--)
+    {
+        btCollisionShape* pCShape = m_compoundShape->getChildShape(i);
+        if (i >= nSegments || pCShape->getShapeType() != CYLINDER_SHAPE_PROXYTYPE)
+        {
+            deleteCollisionShape(pCShape);
+            m_compoundShape->removeChildShapeByIndex(i);
+        }
+    }
+    
+    const int nChildren = m_compoundShape->getNumChildShapes();
 	
-    for (std::size_t i = 0; i < n-1; i++)
+    for (int i = 0; i < nSegments; i++)
     {
         btVector3 pos1 = m_anchors[i]->getWorldPosition();
         btVector3 pos2 = m_anchors[i+1]->getWorldPosition();
@@ -730,10 +757,21 @@ void tgBulletContactSpringCable::updateCollisionObject()
         btScalar length = (pos2 - pos1).length() / 2.0;
 		
         /// @todo - seriously examine box vs cylinder shapes
-        btCylinderShape* box = new btCylinderShape(btVector3(m_thickness, length, m_thickness));
-        
-        m_compoundShape->addChildShape(t, box);
+        if (i < nChildren)
+        {
+            btCylinderShape* box = static_cast<btCylinderShape*>(m_compoundShape->getChildShape(i));
+            resizeSegmentShape(box, length);
+            // The local AABB is recalculated once all children are updated
+            m_compoundShape->updateChildTransform(i, t, false);
+        }
+        else
+        {
+            btCylinderShape* box = createSegmentShape();
+            resizeSegmentShape(box, length);
+            m_compoundShape->addChildShape(t, box);
+        }
     }
+    m_compoundShape->recalculateLocalAabb();
     // Default margin is 0.04, so larger than default thickness. Behavior is better with larger margin
     //m_compoundShape->setMargin(m_thickness);
     
@@ -741,11 +779,63 @@ void tgBulletContactSpringCable::updateCollisionObject()
     transform.setOrigin(center);
     transform.setRotation(btQuaternion::getIdentity());
     
-    m_ghostObject->setCollisionShape (m_compoundShape);
     m_ghostObject->setWorldTransform(transform);
 	
 	// Delete the existing contacts in bullet to prevent sticking - may exacerbate problems with rotations
-	m_overlappingPairCache->getOverlappingPairCache()->cleanProxyFromPairs(m_ghostObject->getBroadphaseHandle(),m_dispatcher);
+	cleanGhostPairs();
+}
+
+btCylinderShape* tgBulletContactSpringCable::createSegmentShape() const
+{
+    return new btCylinderShape(btVector3(m_thickness, 1.0, m_thickness));
+}
+
+void tgBulletContactSpringCable::resizeSegmentShape(btCylinderShape* pShape, btScalar halfLength) const
+{
+    const btVector3 halfExtents(m_thickness, halfLength, m_thickness);
+    
+    // Scaling a cylinder keeps its margin, while a new one would get
+    // btCylinderShape's safe margin for its size. Set both explicitly
+    // so the shape does not drift from step to step.
+    pShape->setLocalScaling(btVector3(1.0, halfLength, 1.0));
+    pShape->setMargin(CONVEX_DISTANCE_MARGIN);
+    pShape->setSafeMargin(halfExtents);
+    const btScalar margin = pShape->getMargin();
+    pShape->setImplicitShapeDimensions(halfExtents - btVector3(margin, margin, margin));
+}
+
+void tgBulletContactSpringCable::cleanGhostPairs()
+{
+#ifndef BT_NO_PROFILE 
+    BT_PROFILE("cleanGhostPairs");
+#endif //BT_NO_PROFILE
+	
+	btDispatcher* m_dispatcher = tgBulletUtil::worldToDynamicsWorld(m_world).getDispatcher();
+	btOverlappingPairCache* const m_overlappingPairCache = tgBulletUtil::worldToDynamicsWorld(m_world).getBroadphase()->getOverlappingPairCache();
+	
+	// The ghost object's cache holds just its pairs, so this avoids
+	// cleanProxyFromPairs' search of every pair in the world
+	btBroadphasePairArray& pairArray = m_ghostObject->getOverlappingPairCache()->getOverlappingPairArray();
+	const int numPairs = pairArray.size();
+	
+	std::vector<btBroadphasePair*> collisionPairs;
+	collisionPairs.reserve(numPairs);
+	for (int i = 0; i < numPairs; i++)
+	{
+		btBroadphasePair* collisionPair = m_overlappingPairCache->findPair(pairArray[i].m_pProxy0, pairArray[i].m_pProxy1);
+		if (collisionPair)
+		{
+			collisionPairs.push_back(collisionPair);
+		}
+	}
+	
+	// Clean in the broadphase's order, as cleanProxyFromPairs would, so
+	// the dispatcher reuses the freed manifolds in the same order
+	std::sort(collisionPairs.begin(), collisionPairs.end());
+	for (std::size_t i = 0; i < collisionPairs.size(); i++)
+	{
+		m_overlappingPairCache->cleanOverlappingPair(*collisionPairs[i], m_dispatcher);
+	}
 }
 
 void tgBulletContactSpringCable::deleteCollisionShape(btCollisionShape* pShape)
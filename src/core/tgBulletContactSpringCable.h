@@ -42,6 +42,7 @@ class tgBulletSpringCableAnchor;
 class btRigidBody;
 class btCollisionShape;
 class btCompoundShape;
+class btCylinderShape;
 class btPairCachingGhostObject;
 class btDynamicsWorld;
 
@@ -113,6 +114,14 @@ public:
      */
     virtual const btScalar getActualLength() const;
     
+    /**
+     * Return the spring state recorded by snapshot(). Restoring the
+     * world drops the contact manifolds that sliding anchors track,
+     * so the anchor list returns to the permanent anchors. Contacts
+     * are found again from the restored bodies on the next step.
+     */
+    virtual void restore();
+    
 private:
     
     /**
@@ -182,9 +191,34 @@ private:
      * Uses m_anchors to update the collision shape of the m_ghostObject
      * Also resets the broadphase's pairCache after collision object
      * is changed.
+     * The child shapes of the compound are resized and moved in place,
+     * children are only added or removed when the number of anchors
+     * changes.
      */
     void updateCollisionObject();
     
+    /**
+     * Create the collision shape of one segment: a cylinder along y
+     * whose half height is set by resizeSegmentShape
+     * @return a new btCylinderShape, owned by the caller
+     */
+    btCylinderShape* createSegmentShape() const;
+    
+    /**
+     * Scale a shape from createSegmentShape so it has the same
+     * dimensions and margin as a new btCylinderShape of half extents
+     * (m_thickness, halfLength, m_thickness)
+     * @param[in] pShape the shape to be resized
+     * @param[in] halfLength half the length of the segment
+     */
+    void resizeSegmentShape(btCylinderShape* pShape, btScalar halfLength) const;
+    
+    /**
+     * Delete the contact manifolds of the ghost object's pairs in the
+     * broadphase's pairCache, leaving the pairs themselves
+     */
+    void cleanGhostPairs();
+    
     /**
      * Deletes a collision shape and it's child shapes
      * @param[in] pShape the btCollisionShape to be deleted
@@ -25,6 +25,7 @@
 // This module
 #include "tgBulletSpringCable.h"
 #include "tgBulletSpringCableAnchor.h"
+#include "tgBulletSpringCableSystem.h"
 #include "tgCast.h"
 // The BulletPhysics library
 #include "BulletDynamics/Dynamics/btRigidBody.h"
@@ -40,7 +41,9 @@ tgSpringCable(tgCast::filter<tgBulletSpringCableAnchor, tgSpringCableAnchor>(anc
                 coefK, dampingCoefficient, pretension),
 m_anchors(anchors),
 anchor1(anchors.front()),
-anchor2(anchors.back())
+anchor2(anchors.back()),
+m_pSystem(NULL),
+m_systemIndex(0)
 {
     assert(m_anchors.size() >= 2);
     assert(invariant());
@@ -54,6 +57,11 @@ tgBulletSpringCable::~tgBulletSpringCable()
     std::cout << "Destroying tgBulletSpringCable" << std::endl;
     #endif
     
+    if (m_pSystem != NULL)
+    {
+        m_pSystem->removeCable(this);
+    }
+    
     std::size_t n = m_anchors.size();
     
     // Make absolutely sure these are deleted, in case we have a poorly timed reset
@@ -82,11 +90,43 @@ void tgBulletSpringCable::step(double dt)
     {
         throw std::invalid_argument("dt is not positive!");
     }
-
-    calculateAndApplyForce(dt);
+    
+    // Otherwise the cable system applies our forces with the world step
+    if (m_pSystem == NULL)
+    {
+        calculateAndApplyForce(dt);
+    }
     assert(invariant());
 }
 
+const double tgBulletSpringCable::getRestLength() const
+{
+    return m_pSystem ? m_pSystem->getRestLength(m_systemIndex) : m_restLength;
+}
+
+void tgBulletSpringCable::setRestLength(const double newRestLength)
+{
+    if (m_pSystem != NULL)
+    {
+        assert(newRestLength > 0.0);
+        m_pSystem->setRestLength(m_systemIndex, newRestLength);
+    }
+    else
+    {
+        tgSpringCable::setRestLength(newRestLength);
+    }
+}
+
+const double tgBulletSpringCable::getVelocity() const
+{
+    return m_pSystem ? m_pSystem->getVelocity(m_systemIndex) : m_velocity;
+}
+
+const double tgBulletSpringCable::getDamping() const
+{
+    return m_pSystem ? m_pSystem->getDamping(m_systemIndex) : m_damping;
+}
+
 void tgBulletSpringCable::calculateAndApplyForce(double dt)
 {
     btVector3 force(0.0, 0.0, 0.0);
@@ -149,7 +189,7 @@ const double tgBulletSpringCable::getActualLength() const
 
 const double tgBulletSpringCable::getTension() const
 {
-    double tension = (getActualLength() - m_restLength) * m_coefK;
+    double tension = (getActualLength() - getRestLength()) * m_coefK;
     tension = (tension < 0.0) ? 0.0 : tension;
     return tension;
 }
@@ -164,7 +204,7 @@ bool tgBulletSpringCable::invariant(void) const
     return (m_coefK > 0.0 &&
     m_dampingCoefficient >= 0.0 &&
     m_prevLength >= 0.0 &&
-    m_restLength >= 0.0 &&
+    getRestLength() >= 0.0 &&
     anchor1 != NULL &&
     anchor2 != NULL &&
     m_anchors.size() >= 2);
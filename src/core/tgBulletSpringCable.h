@@ -38,6 +38,7 @@
 class btRigidBody;
 class tgSpringCableAnchor;
 class tgBulletSpringCableAnchor;
+class tgBulletSpringCableSystem;
 
 /**
  * This class defines the passive dynamics of a spring-cable system
@@ -47,6 +48,9 @@ class tgBulletSpringCableAnchor;
 class tgBulletSpringCable : public tgSpringCable
 {
 public: 
+    // Owns this cable's spring state while it is attached
+    friend class tgBulletSpringCableSystem;
+    
     /**
      * The only constructor. Takes a list of anchors, a coefficient
      * of stiffness, a coefficent of damping, and optionally the amount
@@ -63,15 +67,39 @@ public:
     
     /**
      * The virtual destructor. Deletes all of the anchors including anchor1 and anchor2
+     * Removes this from its tgBulletSpringCableSystem, if any.
      */
     virtual ~tgBulletSpringCable();
 
     /**
-     * Updates this object. Calls calculateAndApplyForce(dt)
+     * Updates this object. Calls calculateAndApplyForce(dt), unless
+     * this cable belongs to a tgBulletSpringCableSystem, in which case
+     * the system applies the forces when the world steps.
      * @param[in] dt, must be positive
      */
     virtual void step(double dt);
     
+    /**
+     * Returns the rest length, from the cable system if attached
+     */
+    virtual const double getRestLength() const;
+    
+    /**
+     * Sets the rest length, in the cable system if attached
+     * @param[in] newRestLength, must be non-negative
+     */
+    virtual void setRestLength(const double newRestLength);
+    
+    /**
+     * Get the last change in length / time
+     */
+    virtual const double getVelocity() const;
+    
+    /**
+     * Get the last value of the damping force
+     */
+    virtual const double getDamping() const;
+    
     /**
      * Finds the distance between anchor1 and anchor2, and returns
      * the length between them
@@ -115,6 +143,18 @@ protected:
      */
     tgBulletSpringCableAnchor * const anchor2;
     
+    /**
+     * The batched cable system holding this cable's state, or NULL
+     * if this cable computes its own forces.
+     */
+    tgBulletSpringCableSystem* m_pSystem;
+    
+    /**
+     * This cable's slot in m_pSystem. Only meaningful when m_pSystem
+     * is not NULL
+     */
+    std::size_t m_systemIndex;
+    
 private:
     
     /**
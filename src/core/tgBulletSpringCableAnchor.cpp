@@ -23,6 +23,7 @@
  */
  
 #include "tgBulletSpringCableAnchor.h"
+#include "tgBulletSpringCableAnchorPool.h"
 
 // The BulletPhysics library
 #include "BulletDynamics/Dynamics/btRigidBody.h"
@@ -72,6 +73,28 @@ tgBulletSpringCableAnchor::~tgBulletSpringCableAnchor()
     
 }
 
+void* tgBulletSpringCableAnchor::operator new(std::size_t size)
+{
+    return tgBulletSpringCableAnchorPool::allocate(size, NULL);
+}
+
+void* tgBulletSpringCableAnchor::operator new(std::size_t size,
+                                              tgBulletSpringCableAnchorPool& pool)
+{
+    return tgBulletSpringCableAnchorPool::allocate(size, &pool);
+}
+
+void tgBulletSpringCableAnchor::operator delete(void* p)
+{
+    tgBulletSpringCableAnchorPool::deallocate(p);
+}
+
+void tgBulletSpringCableAnchor::operator delete(void* p,
+                                               tgBulletSpringCableAnchorPool&)
+{
+    tgBulletSpringCableAnchorPool::deallocate(p);
+}
+
 // This returns current position relative to the rigidbody.
 btVector3 tgBulletSpringCableAnchor::getRelativePosition() const
 {
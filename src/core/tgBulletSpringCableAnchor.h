@@ -34,6 +34,7 @@
 #include "LinearMath/btScalar.h"
 #include "LinearMath/btVector3.h"
 // The C++ Standard Library
+#include <cstddef>
 #include <string>
 #include <utility> //std::pair
 
@@ -41,6 +42,8 @@
 class btRigidBody;
 class btPersistentManifold;
 class tgBulletContactSpringCable;
+class tgBulletSpringCableSystem;
+class tgBulletSpringCableAnchorPool;
 
 /**
  * A class that allows tgBulletSpringCable and tgBulletContactSpringCable to attach to btRigidBodies
@@ -55,6 +58,8 @@ class tgBulletSpringCableAnchor : public tgSpringCableAnchor
 public:
 	// tgBulletContactSpringCable needs to scale the forces
    friend class tgBulletContactSpringCable;
+   // tgBulletSpringCableSystem caches the relative position
+   friend class tgBulletSpringCableSystem;
 	
 	/**
 	 * The only constructor. At a minimum requires a body and a position
@@ -80,6 +85,23 @@ public:
      */
     virtual ~tgBulletSpringCableAnchor();
     
+    /**
+     * Allocate from the heap. Anchors of any origin are freed with
+     * delete, see tgBulletSpringCableAnchorPool.
+     */
+    static void* operator new(std::size_t size);
+    
+    /**
+     * Allocate from a world's pool:
+     * new (pool) tgBulletSpringCableAnchor(...)
+     */
+    static void* operator new(std::size_t size, tgBulletSpringCableAnchorPool& pool);
+    
+    static void operator delete(void* p);
+    
+    /** Frees the memory if the constructor throws after new (pool) */
+    static void operator delete(void* p, tgBulletSpringCableAnchorPool& pool);
+    
     /**
      * Return the current position of the anchor in world coordinates
      * Uses attachedRelativeOriginalPosition and the attachedBody's
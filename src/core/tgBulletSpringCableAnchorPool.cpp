@@ -0,0 +1,120 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgBulletSpringCableAnchorPool.cpp
+ * @brief Definitions of members of class tgBulletSpringCableAnchorPool
+ * $Id$
+ */
+
+// This module
+#include "tgBulletSpringCableAnchorPool.h"
+#include "tgBulletSpringCableAnchor.h"
+
+// The C++ Standard Library
+#include <cassert>
+#include <new>
+#include <stdexcept>
+
+tgBulletSpringCableAnchorPool::tgBulletSpringCableAnchorPool(std::size_t chunkSize) :
+    m_chunkSize(chunkSize),
+    m_slotHeaders(1 + (sizeof(tgBulletSpringCableAnchor) + sizeof(Header) - 1) /
+                      sizeof(Header)),
+    m_pFree(NULL),
+    m_size(0)
+{
+    if (chunkSize == 0)
+    {
+        throw std::invalid_argument("chunkSize is zero");
+    }
+}
+
+tgBulletSpringCableAnchorPool::~tgBulletSpringCableAnchorPool()
+{
+    assert(m_size == 0);
+    for (std::size_t i = 0; i < m_chunks.size(); i++)
+    {
+        ::operator delete(m_chunks[i]);
+    }
+}
+
+void* tgBulletSpringCableAnchorPool::allocate(std::size_t size,
+                                              tgBulletSpringCableAnchorPool* pPool)
+{
+    Header* pHeader = NULL;
+    if (pPool != NULL &&
+        size <= (pPool->m_slotHeaders - 1) * sizeof(Header))
+    {
+        pHeader = pPool->take();
+    }
+    else
+    {
+        // Anchors made by the builders, or a larger derived class
+        pHeader = static_cast<Header*>(::operator new(sizeof(Header) + size));
+        pPool = NULL;
+    }
+    pHeader->pool = pPool;
+    return pHeader + 1;
+}
+
+void tgBulletSpringCableAnchorPool::deallocate(void* p)
+{
+    if (p == NULL)
+    {
+        return;
+    }
+    Header* const pHeader = static_cast<Header*>(p) - 1;
+    if (pHeader->pool != NULL)
+    {
+        pHeader->pool->give(pHeader);
+    }
+    else
+    {
+        ::operator delete(pHeader);
+    }
+}
+
+tgBulletSpringCableAnchorPool::Header* tgBulletSpringCableAnchorPool::take()
+{
+    if (m_pFree == NULL)
+    {
+        Header* const pChunk = static_cast<Header*>(
+            ::operator new(m_chunkSize * m_slotHeaders * sizeof(Header)));
+        m_chunks.push_back(pChunk);
+        
+        // Link the slots so the first of the chunk is taken first
+        for (std::size_t i = m_chunkSize; i > 0; i--)
+        {
+            Header* const pSlot = pChunk + (i - 1) * m_slotHeaders;
+            pSlot->next = m_pFree;
+            m_pFree = pSlot;
+        }
+    }
+    Header* const pSlot = m_pFree;
+    m_pFree = pSlot->next;
+    m_size++;
+    return pSlot;
+}
+
+void tgBulletSpringCableAnchorPool::give(Header* pSlot)
+{
+    assert(m_size > 0);
+    pSlot->next = m_pFree;
+    m_pFree = pSlot;
+    m_size--;
+}
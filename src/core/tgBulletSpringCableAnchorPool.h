@@ -0,0 +1,129 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef SRC_CORE_TG_BULLET_SPRING_CABLE_ANCHOR_POOL_H_
+#define SRC_CORE_TG_BULLET_SPRING_CABLE_ANCHOR_POOL_H_
+
+/**
+ * @file tgBulletSpringCableAnchorPool.h
+ * @brief Definition of class tgBulletSpringCableAnchorPool
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+/**
+ * Fixed size slots for the tgBulletSpringCableAnchors of one world.
+ * Contact cables gain and lose sliding anchors nearly every step; taking
+ * them from here instead of the heap makes that churn allocation free
+ * once the pool has grown, and keeps a cable's anchors close together
+ * in memory for its sort and prune passes.
+ *
+ * Slots are carved out of chunks that are only released when the pool
+ * is destroyed, and freed slots are reused most recent first. Every
+ * allocation, pooled or not, is preceded by a header naming its pool, so
+ * a plain delete of any anchor returns its memory to the right place.
+ *
+ * Owned by tgWorldBulletPhysicsImpl, see tgBulletUtil::worldToAnchorPool.
+ * Anchors from a pool must be deleted before it; contact cables already
+ * have to be deleted before their world.
+ */
+class tgBulletSpringCableAnchorPool
+{
+public:
+
+    /**
+     * Construct an empty pool
+     * @param[in] chunkSize the number of anchors the pool grows by
+     * @throw std::invalid_argument if chunkSize is zero
+     */
+    explicit tgBulletSpringCableAnchorPool(std::size_t chunkSize = 128);
+
+    /** Releases the chunks; the anchors must have been deleted */
+    ~tgBulletSpringCableAnchorPool();
+
+    /**
+     * Memory for an anchor. Used by tgBulletSpringCableAnchor's
+     * operator new.
+     * @param[in] size the size of the object, in bytes
+     * @param[in,out] pPool the pool to allocate from; if NULL, or if size
+     * does not fit a slot, the memory comes from the heap
+     * @throw std::bad_alloc if memory cannot be allocated
+     */
+    static void* allocate(std::size_t size, tgBulletSpringCableAnchorPool* pPool);
+
+    /**
+     * Return memory from allocate to its pool or to the heap
+     * @param[in] p a pointer returned by allocate, or NULL
+     */
+    static void deallocate(void* p);
+
+    /** The number of anchors allocated from this pool and not deleted */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /** The number of anchors this pool can hold without growing */
+    std::size_t capacity() const
+    {
+        return m_chunks.size() * m_chunkSize;
+    }
+
+private:
+
+    /**
+     * Precedes every allocation. Two doubles wide, so the anchor that
+     * follows keeps the alignment of btVector3.
+     */
+    union Header
+    {
+        /** Of an allocation: its pool, NULL if from the heap */
+        tgBulletSpringCableAnchorPool* pool;
+        /** Of a free slot: the next free slot */
+        Header* next;
+        double align[2];
+    };
+
+    /** Take a free slot, growing by a chunk if there is none */
+    Header* take();
+
+    /** Put a slot back on the free list */
+    void give(Header* pSlot);
+
+    /** The number of anchors per chunk */
+    const std::size_t m_chunkSize;
+
+    /** The size of a slot, header included, in Headers */
+    const std::size_t m_slotHeaders;
+
+    std::vector<Header*> m_chunks;
+
+    /** The most recently freed slot, NULL if all are taken */
+    Header* m_pFree;
+
+    std::size_t m_size;
+
+    /** Not copyable, the anchors point back at the pool */
+    tgBulletSpringCableAnchorPool(const tgBulletSpringCableAnchorPool&);
+    tgBulletSpringCableAnchorPool& operator=(const tgBulletSpringCableAnchorPool&);
+};
+
+#endif  // SRC_CORE_TG_BULLET_SPRING_CABLE_ANCHOR_POOL_H_
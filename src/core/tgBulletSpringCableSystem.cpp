@@ -0,0 +1,363 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgBulletSpringCableSystem.cpp
+ * @brief Definitions of members of class tgBulletSpringCableSystem
+ * $Id$
+ */
+
+// This module
+#include "tgBulletSpringCableSystem.h"
+#include "tgBulletSpringCable.h"
+#include "tgBulletSpringCableAnchor.h"
+// The BulletPhysics library
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+#include "LinearMath/btTransform.h"
+#include "LinearMath/btQuickprof.h"
+
+// The C++ Standard Library
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+tgBulletSpringCableSystem::tgBulletSpringCableSystem()
+{
+    assert(invariant());
+}
+
+tgBulletSpringCableSystem::~tgBulletSpringCableSystem()
+{
+    // Hand the state back in case a cable outlives its world
+    for (std::size_t i = 0; i < m_owners.size(); i++)
+    {
+        restoreCable(i);
+        m_owners[i]->m_pSystem = NULL;
+    }
+}
+
+void tgBulletSpringCableSystem::addCable(tgBulletSpringCable* cable)
+{
+    if (cable == NULL)
+    {
+        throw std::invalid_argument("Pointer to tgBulletSpringCable is NULL.");
+    }
+    else if (cable->m_pSystem != NULL)
+    {
+        throw std::invalid_argument("Cable already belongs to a cable system.");
+    }
+    else if (cable->m_anchors.size() != 2)
+    {
+        throw std::invalid_argument("Only two anchor cables can be batched.");
+    }
+    
+    const tgBulletSpringCableAnchor* const a = cable->anchor1;
+    const tgBulletSpringCableAnchor* const b = cable->anchor2;
+    
+    m_owners.push_back(cable);
+    
+    m_localAX.push_back(a->attachedRelativeOriginalPosition.x());
+    m_localAY.push_back(a->attachedRelativeOriginalPosition.y());
+    m_localAZ.push_back(a->attachedRelativeOriginalPosition.z());
+    m_localBX.push_back(b->attachedRelativeOriginalPosition.x());
+    m_localBY.push_back(b->attachedRelativeOriginalPosition.y());
+    m_localBZ.push_back(b->attachedRelativeOriginalPosition.z());
+    
+    m_bodyA.push_back(acquireBody(a->attachedBody));
+    m_bodyB.push_back(acquireBody(b->attachedBody));
+    
+    m_restLength.push_back(cable->m_restLength);
+    m_coefK.push_back(cable->m_coefK);
+    m_coefD.push_back(cable->m_dampingCoefficient);
+    m_prevLength.push_back(cable->m_prevLength);
+    m_velocity.push_back(cable->m_velocity);
+    m_damping.push_back(cable->m_damping);
+    
+    cable->m_pSystem = this;
+    cable->m_systemIndex = m_owners.size() - 1;
+    
+    // Postcondition
+    assert(invariant());
+}
+
+void tgBulletSpringCableSystem::removeCable(tgBulletSpringCable* cable)
+{
+    if (cable == NULL || cable->m_pSystem != this)
+    {
+        throw std::invalid_argument("Cable does not belong to this cable system.");
+    }
+    
+    const std::size_t i = cable->m_systemIndex;
+    assert(m_owners[i] == cable);
+    
+    restoreCable(i);
+    releaseBody(m_bodyA[i]);
+    releaseBody(m_bodyB[i]);
+    
+    // Swap the last cable into the vacated slot
+    const std::size_t last = m_owners.size() - 1;
+    if (i != last)
+    {
+        m_owners[i] = m_owners[last];
+        m_owners[i]->m_systemIndex = i;
+        
+        m_localAX[i] = m_localAX[last];
+        m_localAY[i] = m_localAY[last];
+        m_localAZ[i] = m_localAZ[last];
+        m_localBX[i] = m_localBX[last];
+        m_localBY[i] = m_localBY[last];
+        m_localBZ[i] = m_localBZ[last];
+        m_bodyA[i] = m_bodyA[last];
+        m_bodyB[i] = m_bodyB[last];
+        m_restLength[i] = m_restLength[last];
+        m_coefK[i] = m_coefK[last];
+        m_coefD[i] = m_coefD[last];
+        m_prevLength[i] = m_prevLength[last];
+        m_velocity[i] = m_velocity[last];
+        m_damping[i] = m_damping[last];
+    }
+    
+    m_owners.pop_back();
+    m_localAX.pop_back();
+    m_localAY.pop_back();
+    m_localAZ.pop_back();
+    m_localBX.pop_back();
+    m_localBY.pop_back();
+    m_localBZ.pop_back();
+    m_bodyA.pop_back();
+    m_bodyB.pop_back();
+    m_restLength.pop_back();
+    m_coefK.pop_back();
+    m_coefD.pop_back();
+    m_prevLength.pop_back();
+    m_velocity.pop_back();
+    m_damping.pop_back();
+    
+    cable->m_pSystem = NULL;
+    
+    // Postcondition
+    assert(invariant());
+}
+
+void tgBulletSpringCableSystem::step(double dt)
+{
+#ifndef BT_NO_PROFILE 
+    BT_PROFILE("tgBulletSpringCableSystem::step");
+#endif //BT_NO_PROFILE
+    if (dt <= 0.0)
+    {
+        throw std::invalid_argument("dt is not positive!");
+    }
+    
+    const std::size_t n = m_owners.size();
+    if (n == 0)
+    {
+        return;
+    }
+    
+    m_relAX.resize(n);
+    m_relAY.resize(n);
+    m_relAZ.resize(n);
+    m_relBX.resize(n);
+    m_relBY.resize(n);
+    m_relBZ.resize(n);
+    m_distX.resize(n);
+    m_distY.resize(n);
+    m_distZ.resize(n);
+    m_length.resize(n);
+    m_magnitude.resize(n);
+    
+    // Gather: transform each anchor into world coordinates
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const btTransform& trA = m_bodies[m_bodyA[i]]->getWorldTransform();
+        const btTransform& trB = m_bodies[m_bodyB[i]]->getWorldTransform();
+        
+        const btVector3 worldA =
+            trA * btVector3(m_localAX[i], m_localAY[i], m_localAZ[i]);
+        const btVector3 worldB =
+            trB * btVector3(m_localBX[i], m_localBY[i], m_localBZ[i]);
+        
+        const btVector3 relA = worldA - trA.getOrigin();
+        const btVector3 relB = worldB - trB.getOrigin();
+        const btVector3 dist = worldB - worldA;
+        
+        m_relAX[i] = relA.x();
+        m_relAY[i] = relA.y();
+        m_relAZ[i] = relA.z();
+        m_relBX[i] = relB.x();
+        m_relBY[i] = relB.y();
+        m_relBZ[i] = relB.z();
+        m_distX[i] = dist.x();
+        m_distY[i] = dist.y();
+        m_distZ[i] = dist.z();
+    }
+    
+    /*
+     * Spring-damper forces. Same arithmetic as
+     * tgBulletSpringCable::calculateAndApplyForce, written without
+     * branches over flat arrays so the compiler can vectorize it.
+     */
+    const btScalar* const dx = &m_distX[0];
+    const btScalar* const dy = &m_distY[0];
+    const btScalar* const dz = &m_distZ[0];
+    const btScalar* const restLength = &m_restLength[0];
+    const btScalar* const coefK = &m_coefK[0];
+    const btScalar* const coefD = &m_coefD[0];
+    btScalar* const prevLength = &m_prevLength[0];
+    btScalar* const velocity = &m_velocity[0];
+    btScalar* const damping = &m_damping[0];
+    btScalar* const length = &m_length[0];
+    btScalar* const magnitude = &m_magnitude[0];
+    
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const btScalar currLength =
+            btSqrt(dx[i] * dx[i] + dy[i] * dy[i] + dz[i] * dz[i]);
+        const btScalar stretch = currLength - restLength[i];
+        const btScalar spring = coefK[i] * stretch;
+        
+        const btScalar vel = (currLength - prevLength[i]) / dt;
+        const btScalar damp = coefD[i] * vel;
+        const btScalar clamped = (damp > 0.0 ? spring : -spring);
+        const btScalar d = (btFabs(spring) < btFabs(damp)) ? clamped : damp;
+        
+        velocity[i] = vel;
+        damping[i] = d;
+        length[i] = currLength;
+        magnitude[i] = (currLength > restLength[i]) ? spring + d : 0.0;
+        prevLength[i] = currLength;
+    }
+    
+    // Scatter: apply equal and opposite impulses to the bodies
+    for (std::size_t i = 0; i < n; i++)
+    {
+        if (magnitude[i] == 0.0)
+        {
+            // Slack, no impulse to apply but still keep the bodies awake
+            m_bodies[m_bodyA[i]]->activate();
+            m_bodies[m_bodyB[i]]->activate();
+            continue;
+        }
+        
+        const btVector3 unitVector =
+            btVector3(dx[i], dy[i], dz[i]) / length[i];
+        const btVector3 force = unitVector * magnitude[i];
+        
+        btRigidBody* const bodyA = m_bodies[m_bodyA[i]];
+        bodyA->activate();
+        bodyA->applyImpulse(force * dt,
+                            btVector3(m_relAX[i], m_relAY[i], m_relAZ[i]));
+        
+        btRigidBody* const bodyB = m_bodies[m_bodyB[i]];
+        bodyB->activate();
+        bodyB->applyImpulse(-force * dt,
+                            btVector3(m_relBX[i], m_relBY[i], m_relBZ[i]));
+    }
+}
+
+void tgBulletSpringCableSystem::snapshot()
+{
+    m_snapshotOwners = m_owners;
+    m_snapshotRestLength = m_restLength;
+    m_snapshotPrevLength = m_prevLength;
+    m_snapshotVelocity = m_velocity;
+    m_snapshotDamping = m_damping;
+}
+
+void tgBulletSpringCableSystem::restore()
+{
+    if (m_snapshotOwners != m_owners)
+    {
+        throw std::runtime_error("Cables changed since the cable system snapshot.");
+    }
+    
+    m_restLength = m_snapshotRestLength;
+    m_prevLength = m_snapshotPrevLength;
+    m_velocity = m_snapshotVelocity;
+    m_damping = m_snapshotDamping;
+    
+    // Postcondition
+    assert(invariant());
+}
+
+std::size_t tgBulletSpringCableSystem::acquireBody(btRigidBody* body)
+{
+    assert(body != NULL);
+    
+    std::map<btRigidBody*, std::size_t>::iterator it = m_bodyIndex.find(body);
+    if (it != m_bodyIndex.end())
+    {
+        m_bodyRefs[it->second]++;
+        return it->second;
+    }
+    
+    std::size_t index;
+    if (m_freeBodies.empty())
+    {
+        index = m_bodies.size();
+        m_bodies.push_back(body);
+        m_bodyRefs.push_back(1);
+    }
+    else
+    {
+        index = m_freeBodies.back();
+        m_freeBodies.pop_back();
+        m_bodies[index] = body;
+        m_bodyRefs[index] = 1;
+    }
+    m_bodyIndex[body] = index;
+    
+    return index;
+}
+
+void tgBulletSpringCableSystem::releaseBody(std::size_t bodyIndex)
+{
+    assert(bodyIndex < m_bodies.size());
+    assert(m_bodyRefs[bodyIndex] > 0);
+    
+    m_bodyRefs[bodyIndex]--;
+    if (m_bodyRefs[bodyIndex] == 0)
+    {
+        m_bodyIndex.erase(m_bodies[bodyIndex]);
+        m_bodies[bodyIndex] = NULL;
+        m_freeBodies.push_back(bodyIndex);
+    }
+}
+
+void tgBulletSpringCableSystem::restoreCable(std::size_t i)
+{
+    tgBulletSpringCable* const cable = m_owners[i];
+    cable->m_restLength = m_restLength[i];
+    cable->m_prevLength = m_prevLength[i];
+    cable->m_velocity = m_velocity[i];
+    cable->m_damping = m_damping[i];
+}
+
+bool tgBulletSpringCableSystem::invariant() const
+{
+    const std::size_t n = m_owners.size();
+    return (m_localAX.size() == n &&
+            m_bodyA.size() == n &&
+            m_bodyB.size() == n &&
+            m_restLength.size() == n &&
+            m_prevLength.size() == n &&
+            m_velocity.size() == n &&
+            m_damping.size() == n &&
+            m_bodies.size() == m_bodyRefs.size());
+}
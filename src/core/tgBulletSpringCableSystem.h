@@ -0,0 +1,213 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef SRC_CORE_TG_BULLET_SPRING_CABLE_SYSTEM_H_
+#define SRC_CORE_TG_BULLET_SPRING_CABLE_SYSTEM_H_
+
+/**
+ * @file tgBulletSpringCableSystem.h
+ * @brief Definition of class tgBulletSpringCableSystem
+ * $Id$
+ */
+
+// The Bullet Physics library
+#include "LinearMath/btScalar.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cstddef>
+#include <map>
+#include <vector>
+
+// Forward references
+class btRigidBody;
+class tgBulletSpringCable;
+
+/**
+ * A world level container that computes the passive spring-damper
+ * forces of every two anchor tgBulletSpringCable in one batched pass.
+ * Cable state (anchor offsets, body indices, rest lengths, stiffness,
+ * damping and previous lengths) is stored in contiguous arrays rather
+ * than inside each cable, so the force computation is a set of flat
+ * loops with no virtual calls or pointer chasing.
+ * Owned by tgWorldBulletPhysicsImpl, which calls step() once per
+ * world step before Bullet integrates.
+ */
+class tgBulletSpringCableSystem
+{
+public:
+
+    /** Construct an empty system. */
+    tgBulletSpringCableSystem();
+
+    /**
+     * Detaches any remaining cables, copying their state back into
+     * the cables so they remain usable.
+     */
+    ~tgBulletSpringCableSystem();
+
+    /**
+     * Move a cable's state into this system. After this call the
+     * cable's forces are computed by step() rather than by
+     * tgBulletSpringCable::step.
+     * @param[in,out] cable - a two anchor cable not owned by any system
+     * @throw std::invalid_argument if cable is NULL, already attached
+     * or does not have exactly two anchors
+     */
+    void addCable(tgBulletSpringCable* cable);
+
+    /**
+     * Remove a cable, copying its state back into the cable. Called
+     * automatically from the cable's destructor.
+     * @param[in,out] cable - a cable attached to this system
+     */
+    void removeCable(tgBulletSpringCable* cable);
+
+    /**
+     * Compute the tension, velocity and damping of every cable and
+     * apply the resulting impulses to the attached bodies.
+     * @param[in] dt - the world timestep, must be positive
+     */
+    void step(double dt);
+
+    /**
+     * Record the rest length, previous length, velocity and damping
+     * of every cable. Replaces any previous snapshot.
+     */
+    void snapshot();
+    
+    /**
+     * Return every cable to the state recorded by snapshot()
+     * @throw std::runtime_error if cables were added or removed since
+     */
+    void restore();
+
+    /** The number of cables in this system */
+    std::size_t size() const
+    {
+        return m_owners.size();
+    }
+
+    /**
+     * Accessors for the per cable storage, indexed by the cable's
+     * slot in this system.
+     */
+    double getRestLength(std::size_t i) const
+    {
+        return m_restLength[i];
+    }
+    
+    void setRestLength(std::size_t i, double restLength)
+    {
+        m_restLength[i] = restLength;
+    }
+    
+    double getPrevLength(std::size_t i) const
+    {
+        return m_prevLength[i];
+    }
+    
+    double getVelocity(std::size_t i) const
+    {
+        return m_velocity[i];
+    }
+    
+    double getDamping(std::size_t i) const
+    {
+        return m_damping[i];
+    }
+
+private:
+
+    /** Find or add the slot for body, and add a reference to it */
+    std::size_t acquireBody(btRigidBody* body);
+    
+    /** Remove a reference, freeing the slot if nothing uses it */
+    void releaseBody(std::size_t bodyIndex);
+
+    /** Copy the state of cable i back into its owner */
+    void restoreCable(std::size_t i);
+
+    /** Integrity predicate. */
+    bool invariant() const;
+
+private:
+
+    /**
+     * The cables whose state lives here, used to fix up slot indices
+     * when a cable is removed.
+     */
+    std::vector<tgBulletSpringCable*> m_owners;
+    
+    /** Anchor positions in the local frame of each body */
+    std::vector<btScalar> m_localAX;
+    std::vector<btScalar> m_localAY;
+    std::vector<btScalar> m_localAZ;
+    std::vector<btScalar> m_localBX;
+    std::vector<btScalar> m_localBY;
+    std::vector<btScalar> m_localBZ;
+    
+    /** Indicies into m_bodies */
+    std::vector<std::size_t> m_bodyA;
+    std::vector<std::size_t> m_bodyB;
+    
+    /** Spring parameters and state, see tgSpringCable */
+    std::vector<btScalar> m_restLength;
+    std::vector<btScalar> m_coefK;
+    std::vector<btScalar> m_coefD;
+    std::vector<btScalar> m_prevLength;
+    std::vector<btScalar> m_velocity;
+    std::vector<btScalar> m_damping;
+    
+    /**
+     * Scratch space filled each step: the anchor positions relative
+     * to each body's center of mass, the vector from anchor A to
+     * anchor B, its length and the resulting force magnitude.
+     */
+    std::vector<btScalar> m_relAX;
+    std::vector<btScalar> m_relAY;
+    std::vector<btScalar> m_relAZ;
+    std::vector<btScalar> m_relBX;
+    std::vector<btScalar> m_relBY;
+    std::vector<btScalar> m_relBZ;
+    std::vector<btScalar> m_distX;
+    std::vector<btScalar> m_distY;
+    std::vector<btScalar> m_distZ;
+    std::vector<btScalar> m_length;
+    std::vector<btScalar> m_magnitude;
+    
+    /** State recorded by snapshot(), in slot order */
+    std::vector<tgBulletSpringCable*> m_snapshotOwners;
+    std::vector<btScalar> m_snapshotRestLength;
+    std::vector<btScalar> m_snapshotPrevLength;
+    std::vector<btScalar> m_snapshotVelocity;
+    std::vector<btScalar> m_snapshotDamping;
+    
+    /** Each body referenced by a cable, NULL for a free slot */
+    std::vector<btRigidBody*> m_bodies;
+    
+    /** Number of cable ends attached to each body */
+    std::vector<std::size_t> m_bodyRefs;
+    
+    /** Reverse lookup for m_bodies */
+    std::map<btRigidBody*, std::size_t> m_bodyIndex;
+    
+    /** Free slots in m_bodies available for reuse */
+    std::vector<std::size_t> m_freeBodies;
+};
+
+#endif // SRC_CORE_TG_BULLET_SPRING_CABLE_SYSTEM_H_
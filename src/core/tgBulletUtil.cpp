@@ -88,3 +88,19 @@ btDynamicsWorld& tgBulletUtil::worldToDynamicsWorld(const tgWorld& world)
   btDynamicsWorld& result = bulletPhysicsImpl.dynamicsWorld();
   return result;
 }
+
+tgBulletSpringCableSystem& tgBulletUtil::worldToCableSystem(const tgWorld& world)
+{
+  // Same downcast as worldToDynamicsWorld
+  tgWorldBulletPhysicsImpl& bulletPhysicsImpl =
+    static_cast<tgWorldBulletPhysicsImpl&>(world.implementation());
+  return bulletPhysicsImpl.cableSystem();
+}
+
+tgBulletSpringCableAnchorPool& tgBulletUtil::worldToAnchorPool(const tgWorld& world)
+{
+  // Same downcast as worldToDynamicsWorld
+  tgWorldBulletPhysicsImpl& bulletPhysicsImpl =
+    static_cast<tgWorldBulletPhysicsImpl&>(world.implementation());
+  return bulletPhysicsImpl.anchorPool();
+}
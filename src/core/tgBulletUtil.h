@@ -31,6 +31,8 @@ class btCollisionShape;
 class btDynamicsWorld;
 class btRigidBody;
 class btTransform;
+class tgBulletSpringCableSystem;
+class tgBulletSpringCableAnchorPool;
 class tgWorld;
 
 /**
@@ -54,6 +56,22 @@ public:
      * @todo consider implications of casting to include Corde objects
      */
     static btDynamicsWorld& worldToDynamicsWorld(const tgWorld& world);
+    
+    /**
+     * Assuming that world has a tgWorldBulletPhysicsImpl, return
+     * its batched spring cable system.
+     * @param[in,out] world a tgWorld
+     * @return the world's implementation's tgBulletSpringCableSystem
+     */
+    static tgBulletSpringCableSystem& worldToCableSystem(const tgWorld& world);
+    
+    /**
+     * Assuming that world has a tgWorldBulletPhysicsImpl, return
+     * the pool its contact cables allocate anchors from.
+     * @param[in,out] world a tgWorld
+     * @return the world's implementation's tgBulletSpringCableAnchorPool
+     */
+    static tgBulletSpringCableAnchorPool& worldToAnchorPool(const tgWorld& world);
 };
 
 
@@ -0,0 +1,362 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgEpisodeMonitor.cpp
+ * @brief Contains the definitions of members of class tgEpisodeMonitor
+ * and its rules
+ * $Id$
+ */
+
+// This module
+#include "tgEpisodeMonitor.h"
+// This application
+#include "tgBaseRigid.h"
+#include "tgCast.h"
+#include "tgModel.h"
+// The Bullet Physics library
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    bool isFinite(const btVector3& v)
+    {
+        return std::isfinite(v.x()) && std::isfinite(v.y()) && std::isfinite(v.z());
+    }
+
+    /** The bodies with all of tags, or all bodies if tags is empty */
+    std::vector<tgBaseRigid*> select(const std::vector<tgBaseRigid*>& rigids,
+                                     const tgTags& tags)
+    {
+        if (tags.empty())
+        {
+            return rigids;
+        }
+        std::vector<tgBaseRigid*> selected;
+        for (std::size_t i = 0; i < rigids.size(); i++)
+        {
+            if (rigids[i]->getTags().contains(tags))
+            {
+                selected.push_back(rigids[i]);
+            }
+        }
+        return selected;
+    }
+
+    /** Mass weighted center of the bodies; the plain mean if massless */
+    btVector3 centerOfMass(const std::vector<tgBaseRigid*>& rigids)
+    {
+        btVector3 weighted(0.0, 0.0, 0.0);
+        btVector3 plain(0.0, 0.0, 0.0);
+        double totalMass = 0.0;
+        for (std::size_t i = 0; i < rigids.size(); i++)
+        {
+            const btVector3 com = rigids[i]->centerOfMass();
+            weighted += rigids[i]->mass() * com;
+            plain += com;
+            totalMass += rigids[i]->mass();
+        }
+        if (totalMass > 0.0)
+        {
+            return weighted / totalMass;
+        }
+        return rigids.empty() ? plain : plain / rigids.size();
+    }
+}
+
+tgEpisodeMonitor::tgEpisodeMonitor(double checkInterval) :
+    m_checkInterval(checkInterval),
+    m_started(false),
+    m_time(0.0),
+    m_sinceCheck(0.0),
+    m_reason(eRunning),
+    m_stopTime(0.0)
+{
+    if (checkInterval <= 0.0)
+    {
+        throw std::invalid_argument("checkInterval is not positive");
+    }
+}
+
+tgEpisodeMonitor::~tgEpisodeMonitor()
+{
+    for (std::size_t i = 0; i < m_rules.size(); i++)
+    {
+        delete m_rules[i];
+    }
+}
+
+void tgEpisodeMonitor::addRule(Rule* pRule)
+{
+    if (pRule == NULL)
+    {
+        throw std::invalid_argument("NULL pointer to rule");
+    }
+    m_rules.push_back(pRule);
+}
+
+void tgEpisodeMonitor::reset()
+{
+    // The bodies may have been rebuilt
+    m_rigids.clear();
+    m_started = false;
+    m_time = 0.0;
+    m_sinceCheck = 0.0;
+    m_reason = eRunning;
+    m_stopTime = 0.0;
+}
+
+void tgEpisodeMonitor::step(double dt, const std::vector<tgModel*>& models)
+{
+    if (isStopped())
+    {
+        return;
+    }
+    m_time += dt;
+    m_sinceCheck += dt;
+
+    if (!m_started)
+    {
+        for (std::size_t i = 0; i < models.size(); i++)
+        {
+            const std::vector<tgBaseRigid*> rigids =
+                tgCast::filter<tgModel, tgBaseRigid>(models[i]->getDescendants());
+            m_rigids.insert(m_rigids.end(), rigids.begin(), rigids.end());
+        }
+        for (std::size_t i = 0; i < m_rules.size(); i++)
+        {
+            m_rules[i]->onStart(m_rigids);
+        }
+        m_started = true;
+    }
+
+    if (m_sinceCheck < m_checkInterval)
+    {
+        return;
+    }
+    m_sinceCheck = 0.0;
+
+    for (std::size_t i = 0; i < m_rules.size(); i++)
+    {
+        const Reason reason = m_rules[i]->check(m_rigids, m_time);
+        if (reason != eRunning)
+        {
+            m_reason = reason;
+            m_stopTime = m_time;
+            return;
+        }
+    }
+}
+
+std::string tgEpisodeMonitor::reasonName(Reason reason)
+{
+    switch (reason)
+    {
+    case eRunning:
+        return "running";
+    case eNotFinite:
+        return "not finite";
+    case eEnergy:
+        return "energy";
+    case eHeight:
+        return "height";
+    case eOrientation:
+        return "orientation";
+    case eProgress:
+        return "progress";
+    default:
+        return "other";
+    }
+}
+
+tgEpisodeMonitor::Reason
+tgNotFiniteRule::check(const std::vector<tgBaseRigid*>& rigids, double time)
+{
+    for (std::size_t i = 0; i < rigids.size(); i++)
+    {
+        const btRigidBody* pBody = rigids[i]->getPRigidBody();
+        if (!isFinite(rigids[i]->centerOfMass()) ||
+            !isFinite(pBody->getLinearVelocity()) ||
+            !isFinite(pBody->getAngularVelocity()))
+        {
+            return tgEpisodeMonitor::eNotFinite;
+        }
+    }
+    return tgEpisodeMonitor::eRunning;
+}
+
+tgEnergyRule::tgEnergyRule(double maxSpecificEnergy) :
+    m_maxSpecificEnergy(maxSpecificEnergy)
+{
+    if (maxSpecificEnergy <= 0.0)
+    {
+        throw std::invalid_argument("maxSpecificEnergy is not positive");
+    }
+}
+
+tgEpisodeMonitor::Reason
+tgEnergyRule::check(const std::vector<tgBaseRigid*>& rigids, double time)
+{
+    double energy = 0.0;
+    double totalMass = 0.0;
+    for (std::size_t i = 0; i < rigids.size(); i++)
+    {
+        const double mass = rigids[i]->mass();
+        if (mass <= 0.0)
+        {
+            // Static bodies don't move
+            continue;
+        }
+        const btRigidBody* pBody = rigids[i]->getPRigidBody();
+        const btVector3& v = pBody->getLinearVelocity();
+        // Rotational energy in the body frame, where the inertia is diagonal
+        const btVector3 w = pBody->getAngularVelocity() * pBody->getWorldTransform().getBasis();
+        const btVector3& invInertia = pBody->getInvInertiaDiagLocal();
+        double rotational = 0.0;
+        for (int j = 0; j < 3; j++)
+        {
+            if (invInertia[j] > 0.0)
+            {
+                rotational += w[j] * w[j] / invInertia[j];
+            }
+        }
+        energy += 0.5 * (mass * v.length2() + rotational);
+        totalMass += mass;
+    }
+    // NaN compares false, leaving it to tgNotFiniteRule
+    if (totalMass > 0.0 && energy / totalMass > m_maxSpecificEnergy)
+    {
+        return tgEpisodeMonitor::eEnergy;
+    }
+    return tgEpisodeMonitor::eRunning;
+}
+
+tgHeightRule::tgHeightRule(double minHeight, double maxHeight, const tgTags& tags) :
+    m_minHeight(minHeight),
+    m_maxHeight(maxHeight),
+    m_tags(tags)
+{
+    if (minHeight > maxHeight)
+    {
+        throw std::invalid_argument("minHeight is above maxHeight");
+    }
+}
+
+void tgHeightRule::onStart(const std::vector<tgBaseRigid*>& rigids)
+{
+    m_selected = select(rigids, m_tags);
+}
+
+tgEpisodeMonitor::Reason
+tgHeightRule::check(const std::vector<tgBaseRigid*>& rigids, double time)
+{
+    if (m_selected.empty())
+    {
+        return tgEpisodeMonitor::eRunning;
+    }
+    const double height = centerOfMass(m_selected).y();
+    if (height < m_minHeight || height > m_maxHeight)
+    {
+        return tgEpisodeMonitor::eHeight;
+    }
+    return tgEpisodeMonitor::eRunning;
+}
+
+tgOrientationRule::tgOrientationRule(double maxTilt, const tgTags& tags) :
+    m_maxTilt(maxTilt),
+    m_tags(tags)
+{
+    if (maxTilt <= 0.0)
+    {
+        throw std::invalid_argument("maxTilt is not positive");
+    }
+}
+
+void tgOrientationRule::onStart(const std::vector<tgBaseRigid*>& rigids)
+{
+    m_selected = select(rigids, m_tags);
+    m_startInverse.clear();
+    for (std::size_t i = 0; i < m_selected.size(); i++)
+    {
+        m_startInverse.push_back(m_selected[i]->getPRigidBody()->getOrientation().inverse());
+    }
+}
+
+tgEpisodeMonitor::Reason
+tgOrientationRule::check(const std::vector<tgBaseRigid*>& rigids, double time)
+{
+    if (m_selected.empty())
+    {
+        return tgEpisodeMonitor::eRunning;
+    }
+    const btVector3 up(0.0, 1.0, 0.0);
+    double totalTilt = 0.0;
+    for (std::size_t i = 0; i < m_selected.size(); i++)
+    {
+        const btQuaternion rotation =
+            m_selected[i]->getPRigidBody()->getOrientation() * m_startInverse[i];
+        const double cosine = quatRotate(rotation, up).dot(up);
+        totalTilt += std::acos(std::max(-1.0, std::min(1.0, cosine)));
+    }
+    if (totalTilt / m_selected.size() > m_maxTilt)
+    {
+        return tgEpisodeMonitor::eOrientation;
+    }
+    return tgEpisodeMonitor::eRunning;
+}
+
+tgProgressRule::tgProgressRule(double minDistance, double byTime) :
+    m_minDistance(minDistance),
+    m_byTime(byTime),
+    m_start(0.0, 0.0, 0.0),
+    m_checked(false)
+{
+    if (byTime <= 0.0)
+    {
+        throw std::invalid_argument("byTime is not positive");
+    }
+}
+
+void tgProgressRule::onStart(const std::vector<tgBaseRigid*>& rigids)
+{
+    m_start = centerOfMass(rigids);
+    m_checked = false;
+}
+
+tgEpisodeMonitor::Reason
+tgProgressRule::check(const std::vector<tgBaseRigid*>& rigids, double time)
+{
+    if (m_checked || time < m_byTime)
+    {
+        return tgEpisodeMonitor::eRunning;
+    }
+    m_checked = true;
+
+    btVector3 moved = centerOfMass(rigids) - m_start;
+    moved.setY(0.0);
+    if (moved.length() < m_minDistance)
+    {
+        return tgEpisodeMonitor::eProgress;
+    }
+    return tgEpisodeMonitor::eRunning;
+}
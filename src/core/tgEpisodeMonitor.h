@@ -0,0 +1,259 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_EPISODE_MONITOR_H
+#define TG_EPISODE_MONITOR_H
+
+/**
+ * @file tgEpisodeMonitor.h
+ * @brief Contains the definition of class tgEpisodeMonitor and the rules
+ * it checks
+ * $Id$
+ */
+
+// This library
+#include "tgTags.h"
+// The Bullet Physics library
+#include "LinearMath/btQuaternion.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <string>
+#include <vector>
+
+// Forward declarations
+class tgBaseRigid;
+class tgModel;
+
+/**
+ * Ends an episode early when it has clearly failed. Attached to a
+ * tgSimulation with tgSimulation::setMonitor, it checks its rules every
+ * checkInterval seconds of simulated time; tgSimView::run and
+ * tgSimViewHeadless::run return as soon as a rule fires, and the reason
+ * is kept until the simulation is reset or restored. tgSimViewGraphics
+ * runs until the user stops it, as before.
+ *
+ * The rules see the tgBaseRigid descendants of the simulation's models,
+ * collected at the first step of each episode.
+ */
+class tgEpisodeMonitor
+{
+public:
+
+    /** Why an episode ended */
+    enum Reason
+    {
+        eRunning = 0,
+        /** A position or velocity is NaN or infinite */
+        eNotFinite,
+        /** The kinetic energy grew past the limit */
+        eEnergy,
+        /** The bodies fell below or rose above the allowed heights */
+        eHeight,
+        /** The bodies tipped past the allowed angle */
+        eOrientation,
+        /** Too little distance covered in the allowed time */
+        eProgress,
+        /** Returned by rules defined outside this file */
+        eOther
+    };
+
+    /** A predicate on the state of the bodies */
+    class Rule
+    {
+    public:
+        virtual ~Rule() { }
+
+        /**
+         * Called at the first check of each episode, before check
+         * @param[in] rigids the bodies of all models
+         */
+        virtual void onStart(const std::vector<tgBaseRigid*>& rigids) { }
+
+        /**
+         * @param[in] rigids the bodies of all models
+         * @param[in] time seconds since the start of the episode
+         * @return eRunning to continue, otherwise the reason to stop
+         */
+        virtual Reason check(const std::vector<tgBaseRigid*>& rigids,
+                             double time) = 0;
+    };
+
+    /**
+     * @param[in] checkInterval seconds of simulated time between checks
+     * @throw std::invalid_argument if checkInterval is not positive
+     */
+    tgEpisodeMonitor(double checkInterval = 0.1);
+
+    /** Deletes the rules */
+    ~tgEpisodeMonitor();
+
+    /**
+     * Add a rule, taking ownership of it. Rules are checked in the order
+     * they were added and the first to fire gives the reason.
+     * @throw std::invalid_argument if pRule is NULL
+     */
+    void addRule(Rule* pRule);
+
+    /** Start a new episode. Called by tgSimulation on reset and restore */
+    void reset();
+
+    /**
+     * Advance the episode clock and check the rules if one is due.
+     * Called by tgSimulation::step; does nothing once stopped.
+     */
+    void step(double dt, const std::vector<tgModel*>& models);
+
+    bool isStopped() const
+    {
+        return m_reason != eRunning;
+    }
+
+    Reason getReason() const
+    {
+        return m_reason;
+    }
+
+    /** Seconds into the episode at which it was stopped */
+    double getStopTime() const
+    {
+        return m_stopTime;
+    }
+
+    /** A name for reason, for logs */
+    static std::string reasonName(Reason reason);
+
+private:
+
+    const double m_checkInterval;
+
+    /** Owned */
+    std::vector<Rule*> m_rules;
+
+    /** The bodies of the current episode, empty until the first step */
+    std::vector<tgBaseRigid*> m_rigids;
+    bool m_started;
+
+    double m_time;
+    double m_sinceCheck;
+    Reason m_reason;
+    double m_stopTime;
+
+    /** Not copyable, the rules are owned */
+    tgEpisodeMonitor(const tgEpisodeMonitor&);
+    tgEpisodeMonitor& operator=(const tgEpisodeMonitor&);
+};
+
+/** Stops when a body's position or velocity is NaN or infinite */
+class tgNotFiniteRule : public tgEpisodeMonitor::Rule
+{
+public:
+    virtual tgEpisodeMonitor::Reason check(const std::vector<tgBaseRigid*>& rigids,
+                                           double time);
+};
+
+/**
+ * Stops when the kinetic energy per unit of mass, linear and rotational,
+ * exceeds a limit. Per unit of mass so one limit fits models of any
+ * weight: it is half the mean squared speed, in (length / s)^2.
+ */
+class tgEnergyRule : public tgEpisodeMonitor::Rule
+{
+public:
+    /** @throw std::invalid_argument if maxSpecificEnergy is not positive */
+    tgEnergyRule(double maxSpecificEnergy);
+
+    virtual tgEpisodeMonitor::Reason check(const std::vector<tgBaseRigid*>& rigids,
+                                           double time);
+
+private:
+    const double m_maxSpecificEnergy;
+};
+
+/**
+ * Stops when the center of mass of the selected bodies leaves
+ * [minHeight, maxHeight]. Bodies are selected by tags, or all if the
+ * tags are empty.
+ */
+class tgHeightRule : public tgEpisodeMonitor::Rule
+{
+public:
+    /** @throw std::invalid_argument if minHeight > maxHeight */
+    tgHeightRule(double minHeight, double maxHeight, const tgTags& tags = tgTags());
+
+    virtual void onStart(const std::vector<tgBaseRigid*>& rigids);
+
+    virtual tgEpisodeMonitor::Reason check(const std::vector<tgBaseRigid*>& rigids,
+                                           double time);
+
+private:
+    const double m_minHeight;
+    const double m_maxHeight;
+    const tgTags m_tags;
+    std::vector<tgBaseRigid*> m_selected;
+};
+
+/**
+ * Stops when the selected bodies have, on average, tipped more than
+ * maxTilt radians from their starting orientation: the angle between
+ * the vertical and where the rotation since the start takes it. Bodies
+ * are selected by tags, or all if the tags are empty.
+ */
+class tgOrientationRule : public tgEpisodeMonitor::Rule
+{
+public:
+    /** @throw std::invalid_argument if maxTilt is not positive */
+    tgOrientationRule(double maxTilt, const tgTags& tags = tgTags());
+
+    virtual void onStart(const std::vector<tgBaseRigid*>& rigids);
+
+    virtual tgEpisodeMonitor::Reason check(const std::vector<tgBaseRigid*>& rigids,
+                                           double time);
+
+private:
+    const double m_maxTilt;
+    const tgTags m_tags;
+    std::vector<tgBaseRigid*> m_selected;
+    /** Inverse starting orientation of each selected body */
+    std::vector<btQuaternion> m_startInverse;
+};
+
+/**
+ * Stops when, byTime seconds into the episode, the center of mass of all
+ * bodies has moved less than minDistance in the horizontal (x, z) plane.
+ * Add several for several checkpoints.
+ */
+class tgProgressRule : public tgEpisodeMonitor::Rule
+{
+public:
+    /** @throw std::invalid_argument if byTime is not positive */
+    tgProgressRule(double minDistance, double byTime);
+
+    virtual void onStart(const std::vector<tgBaseRigid*>& rigids);
+
+    virtual tgEpisodeMonitor::Reason check(const std::vector<tgBaseRigid*>& rigids,
+                                           double time);
+
+private:
+    const double m_minDistance;
+    const double m_byTime;
+    btVector3 m_start;
+    /** The checkpoint has been checked this episode */
+    bool m_checked;
+};
+
+#endif  // TG_EPISODE_MONITOR_H
@@ -104,6 +104,9 @@ tgKinematicActuator::tgKinematicActuator(tgBulletSpringCable* muscle,
     m_motorVel(0.0),
     m_motorAcc(0.0),
     m_appliedTorque(0.0),
+    m_snapshotMotorVel(0.0),
+    m_snapshotMotorAcc(0.0),
+    m_snapshotAppliedTorque(0.0),
     m_config(config),
     tgSpringCableActuator(muscle, tags, config)
 {
@@ -156,6 +159,24 @@ void tgKinematicActuator::step(double dt)
     m_desiredTorque = 0.0;
 }
 
+void tgKinematicActuator::snapshot()
+{
+    m_snapshotMotorVel = m_motorVel;
+    m_snapshotMotorAcc = m_motorAcc;
+    m_snapshotAppliedTorque = m_appliedTorque;
+    tgSpringCableActuator::snapshot();
+}
+
+void tgKinematicActuator::restore()
+{
+    m_motorVel = m_snapshotMotorVel;
+    m_motorAcc = m_snapshotMotorAcc;
+    m_appliedTorque = m_snapshotAppliedTorque;
+    m_desiredTorque = 0.0;
+    tgSpringCableActuator::restore();
+    logHistory();
+}
+
 void tgKinematicActuator::onVisit(const tgModelVisitor& r) const
 {
 #ifndef BT_NO_PROFILE 
@@ -168,7 +189,7 @@ void tgKinematicActuator::logHistory()
 {
     m_prevVelocity = getVelocity();
 
-    if (m_config.hist)
+    if (m_config.hist && m_pHistory->sample())
     {
         m_pHistory->lastLengths.push_back(m_springCable->getActualLength());
         m_pHistory->lastVelocities.push_back(m_motorVel);
@@ -129,6 +129,15 @@ public:
      */    
     virtual void step(double dt);
     
+    /** Records the motor state along with the base class state */
+    virtual void snapshot();
+    
+    /**
+     * Restores the motor and base class state, logs the first history
+     * entry and notifies observers of the restore
+     */
+    virtual void restore();
+    
     /**
      * Double dispatch function for a tgModelVisitor. This object
      * will pass itself back to the visitor. Used for rendering and 
@@ -207,6 +216,11 @@ private:
     
     double m_appliedTorque;
     
+    /** Motor state when snapshot() was called */
+    double m_snapshotMotorVel;
+    double m_snapshotMotorAcc;
+    double m_snapshotAppliedTorque;
+    
     /**
      * Override the base config to get the extra parameters
      */
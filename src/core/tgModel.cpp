@@ -27,23 +27,30 @@
 // This application
 #include "tgModelVisitor.h"
 #include "abstractMarker.h"
+#include "tgSubject.h"
 // The C++ Standard Library
 #include <stdexcept>
 
-tgModel::tgModel()
+tgModel::tgModel() :
+  m_pParent(NULL),
+  m_pIndex(NULL)
 {
   // Postcondition
   assert(invariant());
 }
 
 tgModel::tgModel(const tgTags& tags) :
-        tgTaggable(tags)
+        tgTaggable(tags),
+        m_pParent(NULL),
+        m_pIndex(NULL)
 {
   assert(invariant());
 }
 
 tgModel::~tgModel()
 {
+  delete m_pIndex;
+
   const size_t n = m_children.size();
   for (size_t i = 0; i < n; ++i)
   {
@@ -75,12 +82,39 @@ void tgModel::teardown()
   m_children.clear();
   //Clear the markers
   this->m_markers.clear();
+  invalidateIndex();
 
   // Postcondition
   assert(invariant());
   assert(m_children.empty());
 }
 
+void tgModel::snapshot()
+{
+  for (std::size_t i = 0; i < m_children.size(); i++)
+  {
+    m_children[i]->snapshot();
+  }
+}
+
+void tgModel::restore()
+{
+  for (std::size_t i = 0; i < m_children.size(); i++)
+  {
+    m_children[i]->restore();
+  }
+  
+  // Controllers reset against the restored model
+  tgSubjectBase* const pSubject = dynamic_cast<tgSubjectBase*>(this);
+  if (pSubject)
+  {
+    pSubject->notifyRestore();
+  }
+  
+  // Postcondition
+  assert(invariant());
+}
+
 void tgModel::step(double dt) 
 {
   if (dt <= 0.0)
@@ -141,6 +175,8 @@ void tgModel::addChild(tgModel* pChild)
   }
 
   m_children.push_back(pChild);
+  pChild->m_pParent = this;
+  invalidateIndex();
 
   // Postcondition
   assert(invariant());
@@ -169,18 +205,51 @@ std::string tgModel::toString(std::string prefix) const
  */
 std::vector<tgModel*> tgModel::getDescendants() const
 {
+  // Reuse the index if it is current
+  if (m_pIndex != NULL)
+  {
+    return m_pIndex->getDescendants();
+  }
   std::vector<tgModel*> result;
+  appendDescendants(result);
+  return result;
+}
+
+void tgModel::appendDescendants(std::vector<tgModel*>& result) const
+{
   const size_t n = m_children.size();
   for (std::size_t i = 0; i < n; i++)
   {
     tgModel* const pChild = m_children[i];
     assert(pChild != NULL);
     result.push_back(pChild);
-    // Recursion
-    const std::vector<tgModel*> cd = pChild->getDescendants();
-    result.insert(result.end(), cd.begin(), cd.end());
+    // Recursion, into the same vector
+    pChild->appendDescendants(result);
+  }
+}
+
+tgModelIndex& tgModel::index()
+{
+  if (m_pIndex == NULL)
+  {
+    std::vector<tgModel*> descendants;
+    appendDescendants(descendants);
+    m_pIndex = new tgModelIndex(descendants);
+  }
+  return *m_pIndex;
+}
+
+/**
+ * A change below a model changes the descendants of every ancestor, so
+ * their indices go too.
+ */
+void tgModel::invalidateIndex()
+{
+  for (tgModel* pModel = this; pModel != NULL; pModel = pModel->m_pParent)
+  {
+    delete pModel->m_pIndex;
+    pModel->m_pIndex = NULL;
   }
-  return result;
 }
 
 /**
@@ -31,6 +31,7 @@
 #include "tgTaggable.h"
 #include "tgTagSearch.h"
 #include "tgSenseable.h"
+#include "tgModelIndex.h"
 // The C++ Standard Library
 #include <iostream>
 #include <vector>
@@ -82,6 +83,21 @@ public:
      * Deletes the children (undoes setup)
      */
     virtual void teardown();
+    
+    /**
+     * Record any state this model needs for restore(), then snapshot
+     * the children. Bullet state is recorded by tgWorld::snapshot.
+     * Subclasses with their own state should override this and call
+     * tgModel::snapshot().
+     */
+    virtual void snapshot();
+    
+    /**
+     * Return to the state recorded by snapshot(), then restore the
+     * children. If this model is a tgSubject, its observers' onRestore()
+     * is called last, so controllers reset against the restored model.
+     */
+    virtual void restore();
 
     /**
     * Advance the simulation.
@@ -127,7 +143,7 @@ public:
     template <typename T>
     std::vector<T*> find(const tgTagSearch& tagSearch)
     {
-        return tgCast::find<tgModel, T>(tagSearch, getDescendants());
+        return findCached<T>(tagSearch);
     }
 	
 	/**
@@ -140,9 +156,29 @@ public:
     template <typename T>
     std::vector<T*> find(const std::string& tagSearch)
     {
-        return tgCast::find<tgModel, T>(tgTagSearch(tagSearch), getDescendants());
+        return findCached<T>(tgTagSearch(tagSearch));
     }
 
+    /**
+     * As find, but returns the index's stored result without copying it.
+     * For queries made every step, e.g. by controllers.
+     * @param[in] tagSearch, a tagSearch that contains the desired tags
+     * @return a reference that is valid until the model tree changes
+     * (addChild or teardown anywhere in it) or invalidateIndex is called
+     */
+    template <typename T>
+    const std::vector<T*>& findCached(const tgTagSearch& tagSearch)
+    {
+        return index().find<T>(tagSearch);
+    }
+
+    /**
+     * Discard the cached index used by find. Happens automatically when
+     * children are added or torn down anywhere below this model; call it
+     * after changing the tags of a descendant.
+     */
+    void invalidateIndex();
+
     /**
      * Return a std::vector of const pointers to all sub-models.
      * @todo examine whether this should be public, and perhaps create
@@ -168,6 +204,12 @@ private:
     /** Integrity predicate. */
     bool invariant() const;
 
+    /** Append all descendants to result, depth first. */
+    void appendDescendants(std::vector<tgModel*>& result) const;
+
+    /** The index for find, built if necessary. */
+    tgModelIndex& index();
+
 private:
 
     /**
@@ -179,6 +221,12 @@ private:
 
     std::vector<abstractMarker> m_markers;
 
+    /** The model this is a child of, NULL at the root. */
+    tgModel* m_pParent;
+
+    /** Cache for find, NULL until first used or after invalidation. */
+    tgModelIndex* m_pIndex;
+
 };
 
 /**
@@ -0,0 +1,74 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgModelIndex.cpp
+ * @brief Contains the definitions of members of class tgModelIndex
+ * $Id$
+ */
+
+// This module
+#include "tgModelIndex.h"
+// This application
+#include "tgModel.h"
+
+tgModelIndex::tgModelIndex(const std::vector<tgModel*>& descendants) :
+    m_descendants(descendants)
+{
+    for (std::size_t i = 0; i < m_descendants.size(); i++)
+    {
+        tgModel* const pModel = m_descendants[i];
+        const std::vector<tgTags::Id>& ids = pModel->getTags().getIds();
+        for (std::size_t j = 0; j < ids.size(); j++)
+        {
+            m_byTag[ids[j]].push_back(pModel);
+        }
+    }
+}
+
+tgModelIndex::~tgModelIndex()
+{
+    for (std::map<Key, EntryBase*>::iterator it = m_entries.begin();
+         it != m_entries.end();
+         ++it)
+    {
+        delete it->second;
+    }
+}
+
+const std::vector<tgModel*>&
+tgModelIndex::candidates(const tgTagSearch& tagSearch) const
+{
+    const std::vector<tgTags::Id>& ids = tagSearch.getTags().getIds();
+    const std::vector<tgModel*>* pBest = &m_descendants;
+    for (std::size_t i = 0; i < ids.size(); i++)
+    {
+        std::map<tgTags::Id, std::vector<tgModel*> >::const_iterator it =
+            m_byTag.find(ids[i]);
+        if (it == m_byTag.end())
+        {
+            // Nothing carries this tag, so nothing can match
+            return m_none;
+        }
+        else if (it->second.size() < pBest->size())
+        {
+            pBest = &it->second;
+        }
+    }
+    return *pBest;
+}
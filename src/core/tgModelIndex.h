@@ -0,0 +1,149 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_MODEL_INDEX_H
+#define TG_MODEL_INDEX_H
+
+/**
+ * @file tgModelIndex.h
+ * @brief Contains the definition of class tgModelIndex
+ * $Id$
+ */
+
+// This application
+#include "tgCast.h"
+#include "tgTagSearch.h"
+// The C++ Standard Library
+#include <map>
+#include <typeinfo>
+#include <vector>
+
+// Forward declarations
+class tgModel;
+
+/**
+ * A cache of a model's descendants for tgModel::find. Built on the first
+ * query from the model tree as it is then, and discarded by the model
+ * when the tree changes. Holds the descendants in order, a map from each
+ * tag to the descendants carrying it, and the result of every
+ * (type, tag search) query made so far.
+ */
+class tgModelIndex
+{
+public:
+
+    /**
+     * @param[in] descendants all descendants of the model, in the order
+     * of tgModel::getDescendants
+     */
+    tgModelIndex(const std::vector<tgModel*>& descendants);
+
+    ~tgModelIndex();
+
+    /** All descendants, in order. */
+    const std::vector<tgModel*>& getDescendants() const
+    {
+        return m_descendants;
+    }
+
+    /**
+     * The descendants of type T matching tagSearch, in descendant order,
+     * exactly as tgCast::find would return them. Repeated queries return
+     * the stored result.
+     * @return a reference valid until the index is destroyed
+     */
+    template <typename T>
+    const std::vector<T*>& find(const tgTagSearch& tagSearch)
+    {
+        const Key key(typeid(T), tagSearch.getId());
+        std::map<Key, EntryBase*>::const_iterator it = m_entries.find(key);
+        if (it != m_entries.end())
+        {
+            return static_cast<Entry<T>*>(it->second)->items;
+        }
+        
+        Entry<T>* const pEntry = new Entry<T>();
+        pEntry->items =
+            tgCast::find<tgModel, T>(tagSearch, candidates(tagSearch));
+        m_entries[key] = pEntry;
+        return pEntry->items;
+    }
+
+private:
+
+    /** Type erased storage for query results */
+    struct EntryBase
+    {
+        virtual ~EntryBase() { }
+    };
+    
+    template <typename T>
+    struct Entry : public EntryBase
+    {
+        std::vector<T*> items;
+    };
+
+    /**
+     * Key for a query: the type and the compiled search's id, so lookups
+     * neither allocate nor compare strings
+     */
+    struct Key
+    {
+        Key(const std::type_info& t, tgTagSearch::Id s) :
+            type(&t),
+            search(s)
+        {
+        }
+
+        bool operator<(const Key& other) const
+        {
+            // type_info::before, since the objects need not be unique
+            if (*type != *other.type)
+            {
+                return type->before(*other.type);
+            }
+            return search < other.search;
+        }
+
+        const std::type_info* type;
+        tgTagSearch::Id search;
+    };
+
+    /**
+     * A superset of the matches of tagSearch, in descendant order: the
+     * descendants carrying its rarest required tag, or all of them.
+     */
+    const std::vector<tgModel*>& candidates(const tgTagSearch& tagSearch) const;
+
+    std::vector<tgModel*> m_descendants;
+
+    /** Descendants carrying each tag, in descendant order */
+    std::map<tgTags::Id, std::vector<tgModel*> > m_byTag;
+
+    /** Results of queries made so far, owned */
+    std::map<Key, EntryBase*> m_entries;
+
+    /** Returned by candidates() when a tag has no descendants */
+    const std::vector<tgModel*> m_none;
+
+    /** Not copyable */
+    tgModelIndex(const tgModelIndex&);
+    tgModelIndex& operator=(const tgModelIndex&);
+};
+
+#endif // TG_MODEL_INDEX_H
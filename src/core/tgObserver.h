@@ -66,6 +66,14 @@ public:
      */    
     virtual void onTeardown(Subject& subject) { }
     
+    /**
+     * Notify the observers when the simulation has been restored from
+     * a snapshot instead of being torn down and set up again.
+     * Observers that keep per-episode state should reset it here.
+     * @param[in,out] subject the subject being observed
+     */
+    virtual void onRestore(Subject& subject) { }
+    
 };
    
 #endif
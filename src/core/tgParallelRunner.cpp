@@ -0,0 +1,176 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgParallelRunner.cpp
+ * @brief Contains the definitions of members of class tgParallelRunner
+ * $Id$
+ */
+
+// This module
+#include "tgParallelRunner.h"
+// This application
+#include "tgSimulation.h"
+#include "tgSimViewHeadless.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+tgParallelRunner::Config::Config(int st,
+                                 int th,
+                                 double ss,
+                                 const tgWorld::Config& wc) :
+    steps(st),
+    threads(th),
+    stepSize(ss),
+    worldConfig(wc)
+{
+    if (st <= 0)
+    {
+        throw std::invalid_argument("steps is not positive");
+    }
+    else if (th < 0)
+    {
+        throw std::invalid_argument("threads is negative");
+    }
+    else if (ss <= 0.0)
+    {
+        throw std::invalid_argument("step size is not positive");
+    }
+}
+
+tgParallelRunner::tgParallelRunner(const Config& config) :
+    m_config(config),
+    m_threads(config.threads),
+    m_pEpisodes(NULL),
+    m_next(0)
+{
+    if (m_threads == 0)
+    {
+        const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        m_threads = online > 0 ? static_cast<int>(online) : 1;
+    }
+#ifndef BT_NO_PROFILE
+    // CProfileManager is a global that every stepSimulation writes to
+    m_threads = 1;
+#endif //BT_NO_PROFILE
+    // btMLCPSolver builds its matrices in function-local statics
+    if (config.worldConfig.solverType != tgWorld::Config::SEQUENTIAL_IMPULSE)
+    {
+        m_threads = 1;
+    }
+    pthread_mutex_init(&m_mutex, NULL);
+}
+
+tgParallelRunner::~tgParallelRunner()
+{
+    pthread_mutex_destroy(&m_mutex);
+}
+
+std::vector<double>
+tgParallelRunner::run(const std::vector<tgEpisode*>& episodes)
+{
+    m_pEpisodes = &episodes;
+    m_scores.assign(episodes.size(), 0.0);
+    m_next = 0;
+    m_errors.clear();
+
+    // No point starting threads that would find the queue empty
+    const int n = std::min<std::size_t>(m_threads, episodes.size());
+    std::vector<pthread_t> threads(n);
+    int started = 0;
+    for (; started < n; started++)
+    {
+        if (pthread_create(&threads[started], NULL,
+                           &tgParallelRunner::worker, this) != 0)
+        {
+            break;
+        }
+    }
+    if (started == 0 && n > 0)
+    {
+        m_pEpisodes = NULL;
+        throw std::runtime_error("Could not start any worker threads.");
+    }
+    // Whatever started drains the whole queue
+    for (int i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    assert(m_next >= episodes.size());
+    m_pEpisodes = NULL;
+
+    if (!m_errors.empty())
+    {
+        throw std::runtime_error(m_errors);
+    }
+    return m_scores;
+}
+
+bool tgParallelRunner::nextEpisode(std::size_t& index)
+{
+    pthread_mutex_lock(&m_mutex);
+    index = m_next;
+    const bool found = index < m_pEpisodes->size();
+    if (found)
+    {
+        m_next++;
+    }
+    pthread_mutex_unlock(&m_mutex);
+    return found;
+}
+
+void tgParallelRunner::fail(std::size_t index, const std::string& what)
+{
+    std::ostringstream os;
+    os << "Episode " << index << ": " << what << std::endl;
+    pthread_mutex_lock(&m_mutex);
+    m_errors += os.str();
+    pthread_mutex_unlock(&m_mutex);
+}
+
+void* tgParallelRunner::worker(void* pRunner)
+{
+    tgParallelRunner* const self = static_cast<tgParallelRunner*>(pRunner);
+
+    // This thread's world and view, reused for every episode it runs
+    tgWorld world(self->m_config.worldConfig);
+    tgSimViewHeadless view(world, self->m_config.stepSize, false);
+
+    std::size_t index = 0;
+    while (self->nextEpisode(index))
+    {
+        tgEpisode* const pEpisode = (*self->m_pEpisodes)[index];
+        try
+        {
+            // Each index is written by exactly one thread
+            tgSimulation simulation(view);
+            pEpisode->setup(simulation);
+            simulation.run(self->m_config.steps);
+            self->m_scores[index] = pEpisode->score(simulation);
+        }
+        catch (const std::exception& e)
+        {
+            self->fail(index, e.what());
+        }
+    }
+    return NULL;
+}
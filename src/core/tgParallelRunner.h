@@ -0,0 +1,150 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_PARALLEL_RUNNER_H
+#define TG_PARALLEL_RUNNER_H
+
+/**
+ * @file tgParallelRunner.h
+ * @brief Contains the definition of classes tgEpisode and tgParallelRunner
+ * $Id$
+ */
+
+// This application
+#include "tgWorld.h"
+// The C++ Standard Library
+#include <string>
+#include <vector>
+#include <pthread.h>
+
+// Forward declarations
+class tgSimulation;
+
+/**
+ * One independent trial for a tgParallelRunner. Both methods are called
+ * on a worker thread, so an episode must only touch its own state and
+ * the simulation it is given.
+ */
+class tgEpisode
+{
+public:
+
+    virtual ~tgEpisode() { }
+
+    /**
+     * Add this episode's models, obstacles and data managers. The
+     * simulation takes ownership of them, as usual, and deletes them when
+     * the episode is over.
+     * @param[in,out] simulation a fresh simulation on the worker's world
+     */
+    virtual void setup(tgSimulation& simulation) = 0;
+
+    /**
+     * Called after the episode has run, before the simulation is
+     * destroyed.
+     * @return the episode's score
+     */
+    virtual double score(tgSimulation& simulation) = 0;
+};
+
+/**
+ * Runs many independent episodes in one process on a pool of worker
+ * threads. Each worker owns a tgWorld and a tgSimViewHeadless for the
+ * whole run, and builds a new tgSimulation on them for each episode, so
+ * no Bullet objects are shared between threads.
+ *
+ * Bullet's profiler is global and not thread safe. Unless NTRT is built
+ * with -DNTRT_NO_PROFILE=ON (which defines BT_NO_PROFILE), the runner
+ * uses a single worker thread whatever the configuration asks for.
+ * Bullet itself must also be built with BULLET_NO_PROFILE in bullet.conf
+ * for more than one thread to be safe. Bullet's MLCP solvers share
+ * scratch matrices between worlds, so the worker worlds must also use
+ * tgWorld::Config::SEQUENTIAL_IMPULSE to run in parallel.
+ */
+class tgParallelRunner
+{
+public:
+
+    struct Config
+    {
+        /**
+         * @param[in] st the number of steps in each episode, positive
+         * @param[in] th the number of worker threads, 0 for one per
+         * online processor
+         * @param[in] ss the step size, positive
+         * @param[in] wc the configuration of each worker's tgWorld
+         */
+        Config(int st,
+               int th = 0,
+               double ss = 1.0/1000.0,
+               const tgWorld::Config& wc = tgWorld::Config());
+
+        int steps;
+        int threads;
+        double stepSize;
+        tgWorld::Config worldConfig;
+    };
+
+    tgParallelRunner(const Config& config);
+
+    ~tgParallelRunner();
+
+    /**
+     * Run every episode and return their scores in the same order.
+     * The runner does not take ownership of the episodes.
+     * @throw std::runtime_error if any episode threw; the other episodes
+     * still run
+     */
+    std::vector<double> run(const std::vector<tgEpisode*>& episodes);
+
+    /**
+     * The number of worker threads run() will use. Always 1 when
+     * profiling is compiled in or the worlds use an MLCP solver.
+     */
+    int getThreadCount() const { return m_threads; }
+
+private:
+
+    /** Body of each worker thread */
+    static void* worker(void* pRunner);
+
+    /**
+     * Take the index of the next episode to run.
+     * @return false if none are left
+     */
+    bool nextEpisode(std::size_t& index);
+
+    /** Record an error from a worker */
+    void fail(std::size_t index, const std::string& what);
+
+    const Config m_config;
+    int m_threads;
+
+    /** State of the current run, guarded by m_mutex where shared */
+    const std::vector<tgEpisode*>* m_pEpisodes;
+    std::vector<double> m_scores;
+    std::size_t m_next;
+    std::string m_errors;
+    pthread_mutex_t m_mutex;
+
+    /** Not copyable */
+    tgParallelRunner(const tgParallelRunner&);
+    tgParallelRunner& operator=(const tgParallelRunner&);
+};
+
+#endif // TG_PARALLEL_RUNNER_H
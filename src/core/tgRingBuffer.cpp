@@ -0,0 +1,154 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgRingBuffer.cpp
+ * @brief Definitions of members of classes tgRingBuffer and tgRingBufferBlock
+ * $Id$
+ */
+
+// This module
+#include "tgRingBuffer.h"
+// The C++ Standard Library
+#include <cassert>
+#include <stdexcept>
+
+const std::size_t tgRingBufferBlock::initialGrowableCapacity;
+
+tgRingBuffer::tgRingBuffer() :
+    m_pBlock(NULL),
+    m_pData(NULL),
+    m_capacity(0),
+    m_head(0),
+    m_size(0)
+{
+}
+
+std::size_t tgRingBuffer::capacity() const
+{
+    return m_capacity;
+}
+
+void tgRingBuffer::push_back(double value)
+{
+    assert(m_pBlock != NULL);
+    
+    if (m_size == m_capacity && m_pBlock->isGrowable())
+    {
+        // Rebinds m_pData and resets m_head
+        m_pBlock->grow();
+    }
+    
+    if (m_size < m_capacity)
+    {
+        (*this)[m_size] = value;
+        m_size++;
+    }
+    else
+    {
+        // Full, overwrite the oldest
+        m_pData[m_head] = value;
+        m_head++;
+        if (m_head == m_capacity)
+        {
+            m_head = 0;
+        }
+    }
+}
+
+tgRingBufferBlock::tgRingBufferBlock(std::size_t channels, std::size_t capacity) :
+    m_growable(capacity == 0),
+    m_capacity(capacity == 0 ? initialGrowableCapacity : capacity),
+    m_storage(channels * m_capacity),
+    m_channels(channels)
+{
+    if (channels == 0)
+    {
+        throw std::invalid_argument("Ring buffer block has no channels.");
+    }
+    bind();
+}
+
+tgRingBufferBlock::tgRingBufferBlock(const tgRingBufferBlock& other) :
+    m_growable(other.m_growable),
+    m_capacity(other.m_capacity),
+    m_storage(other.m_storage),
+    m_channels(other.m_channels)
+{
+    bind();
+}
+
+tgRingBufferBlock& tgRingBufferBlock::operator=(const tgRingBufferBlock& other)
+{
+    if (this != &other)
+    {
+        assert(m_channels.size() == other.m_channels.size());
+        m_growable = other.m_growable;
+        m_capacity = other.m_capacity;
+        m_storage = other.m_storage;
+        for (std::size_t i = 0; i < m_channels.size(); i++)
+        {
+            m_channels[i].m_head = other.m_channels[i].m_head;
+            m_channels[i].m_size = other.m_channels[i].m_size;
+        }
+        bind();
+    }
+    return *this;
+}
+
+void tgRingBufferBlock::clear()
+{
+    for (std::size_t i = 0; i < m_channels.size(); i++)
+    {
+        m_channels[i].clear();
+    }
+}
+
+void tgRingBufferBlock::grow()
+{
+    assert(m_growable);
+    
+    const std::size_t newCapacity = 2 * m_capacity;
+    std::vector<double> newStorage(m_channels.size() * newCapacity);
+    
+    for (std::size_t i = 0; i < m_channels.size(); i++)
+    {
+        tgRingBuffer& channel = m_channels[i];
+        double* const pDest = &newStorage[i * newCapacity];
+        for (std::size_t j = 0; j < channel.size(); j++)
+        {
+            pDest[j] = channel[j];
+        }
+        channel.m_head = 0;
+    }
+    
+    m_storage.swap(newStorage);
+    m_capacity = newCapacity;
+    bind();
+}
+
+void tgRingBufferBlock::bind()
+{
+    for (std::size_t i = 0; i < m_channels.size(); i++)
+    {
+        tgRingBuffer& channel = m_channels[i];
+        channel.m_pBlock = this;
+        channel.m_pData = &m_storage[i * m_capacity];
+        channel.m_capacity = m_capacity;
+    }
+}
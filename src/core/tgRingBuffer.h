@@ -0,0 +1,247 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef SRC_CORE_TG_RING_BUFFER_H_
+#define SRC_CORE_TG_RING_BUFFER_H_
+
+/**
+ * @file tgRingBuffer.h
+ * @brief Definitions of classes tgRingBuffer and tgRingBufferBlock
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+// Forward declarations
+class tgRingBufferBlock;
+
+/**
+ * A fixed capacity FIFO of doubles that overwrites its oldest entry
+ * when full. Storage belongs to a tgRingBufferBlock, which may instead
+ * be growable, in which case nothing is ever overwritten. Provides the
+ * subset of the std::deque interface used for actuator histories.
+ */
+class tgRingBuffer
+{
+public:
+
+    /** Random access read-only iterator, oldest entry first */
+    class const_iterator :
+        public std::iterator<std::random_access_iterator_tag, double,
+                             std::ptrdiff_t, const double*, const double&>
+    {
+    public:
+        const_iterator() : m_pBuffer(NULL), m_index(0) { }
+        
+        const_iterator(const tgRingBuffer* pBuffer, std::size_t index) :
+            m_pBuffer(pBuffer),
+            m_index(index)
+        { }
+        
+        const double& operator*() const { return (*m_pBuffer)[m_index]; }
+        const double* operator->() const { return &(*m_pBuffer)[m_index]; }
+        const double& operator[](std::ptrdiff_t n) const
+        {
+            return (*m_pBuffer)[m_index + n];
+        }
+        
+        const_iterator& operator++() { ++m_index; return *this; }
+        const_iterator& operator--() { --m_index; return *this; }
+        const_iterator operator++(int)
+        {
+            const_iterator old(*this);
+            ++m_index;
+            return old;
+        }
+        const_iterator operator--(int)
+        {
+            const_iterator old(*this);
+            --m_index;
+            return old;
+        }
+        const_iterator& operator+=(std::ptrdiff_t n) { m_index += n; return *this; }
+        const_iterator& operator-=(std::ptrdiff_t n) { m_index -= n; return *this; }
+        const_iterator operator+(std::ptrdiff_t n) const
+        {
+            return const_iterator(m_pBuffer, m_index + n);
+        }
+        const_iterator operator-(std::ptrdiff_t n) const
+        {
+            return const_iterator(m_pBuffer, m_index - n);
+        }
+        std::ptrdiff_t operator-(const const_iterator& other) const
+        {
+            return (std::ptrdiff_t) m_index - (std::ptrdiff_t) other.m_index;
+        }
+        
+        bool operator==(const const_iterator& other) const
+        {
+            return m_pBuffer == other.m_pBuffer && m_index == other.m_index;
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+        bool operator<(const const_iterator& other) const { return m_index < other.m_index; }
+        bool operator>(const const_iterator& other) const { return m_index > other.m_index; }
+        bool operator<=(const const_iterator& other) const { return m_index <= other.m_index; }
+        bool operator>=(const const_iterator& other) const { return m_index >= other.m_index; }
+        
+    private:
+        const tgRingBuffer* m_pBuffer;
+        std::size_t m_index;
+    };
+
+    /** An empty buffer not yet bound to a block. */
+    tgRingBuffer();
+    
+    /** Number of entries currently held */
+    std::size_t size() const { return m_size; }
+    
+    /** True if there are no entries */
+    bool empty() const { return m_size == 0; }
+    
+    /** Number of entries that fit before the oldest is overwritten */
+    std::size_t capacity() const;
+    
+    /**
+     * Entry i, counting from the oldest. No bounds checking, as with
+     * std::deque
+     */
+    const double& operator[](std::size_t i) const
+    {
+        std::size_t j = m_head + i;
+        if (j >= m_capacity)
+        {
+            j -= m_capacity;
+        }
+        return m_pData[j];
+    }
+    
+    double& operator[](std::size_t i)
+    {
+        std::size_t j = m_head + i;
+        if (j >= m_capacity)
+        {
+            j -= m_capacity;
+        }
+        return m_pData[j];
+    }
+    
+    /** The oldest entry. Must not be empty */
+    const double& front() const { return (*this)[0]; }
+    
+    /** The newest entry. Must not be empty */
+    const double& back() const { return (*this)[m_size - 1]; }
+    
+    /**
+     * Append a value, overwriting the oldest entry if full, or growing
+     * the block if it is growable.
+     */
+    void push_back(double value);
+    
+    /** Remove all entries */
+    void clear() { m_head = 0; m_size = 0; }
+    
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, m_size); }
+
+private:
+
+    friend class tgRingBufferBlock;
+    
+    /** The block this belongs to, for growing */
+    tgRingBufferBlock* m_pBlock;
+    
+    /** This buffer's slice of the block's storage */
+    double* m_pData;
+    
+    /** Length of m_pData */
+    std::size_t m_capacity;
+    
+    /** Index of the oldest entry in m_pData */
+    std::size_t m_head;
+    
+    /** Number of entries */
+    std::size_t m_size;
+};
+
+/**
+ * Owns the storage for a fixed number of equally sized tgRingBuffers
+ * as one contiguous allocation. A block with capacity zero is growable:
+ * it doubles its storage when any buffer fills, so no entries are lost.
+ */
+class tgRingBufferBlock
+{
+public:
+
+    /**
+     * @param[in] channels the number of ring buffers
+     * @param[in] capacity entries per buffer, or 0 for growable buffers
+     */
+    tgRingBufferBlock(std::size_t channels, std::size_t capacity);
+    
+    /** Deep copy, the copy's buffers use the copy's storage */
+    tgRingBufferBlock(const tgRingBufferBlock& other);
+    
+    /** Deep copy, the buffers themselves are not replaced */
+    tgRingBufferBlock& operator=(const tgRingBufferBlock& other);
+    
+    /**
+     * Access a buffer. References remain valid for the block's life,
+     * including through growth and assignment.
+     */
+    tgRingBuffer& operator[](std::size_t channel)
+    {
+        return m_channels[channel];
+    }
+    
+    const tgRingBuffer& operator[](std::size_t channel) const
+    {
+        return m_channels[channel];
+    }
+    
+    /** Whether the buffers grow instead of overwriting */
+    bool isGrowable() const { return m_growable; }
+    
+    /** Entries per buffer at the moment */
+    std::size_t capacity() const { return m_capacity; }
+    
+    /** Clear all buffers */
+    void clear();
+
+private:
+
+    friend class tgRingBuffer;
+    
+    /** Double the capacity, moving every buffer's entries to the front */
+    void grow();
+    
+    /** Point every buffer at its slice of m_storage */
+    void bind();
+
+    /** Initial capacity for growable blocks */
+    static const std::size_t initialGrowableCapacity = 256;
+
+    bool m_growable;
+    std::size_t m_capacity;
+    std::vector<double> m_storage;
+    std::vector<tgRingBuffer> m_channels;
+};
+
+#endif // SRC_CORE_TG_RING_BUFFER_H_
@@ -154,6 +154,12 @@ void tgSimView::run(int steps)
                 //std::cout << totalTime << std::endl;
                 m_renderTime = 0;
             }
+            
+            // The episode has clearly failed
+            if (m_pSimulation->isStopped())
+            {
+                break;
+            }
         }
     }
 }
@@ -82,7 +82,8 @@ public:
     virtual void run();
 	
 	/**
-	 * Run for a specific number of steps
+	 * Run for a specific number of steps, or until the simulation's
+	 * tgEpisodeMonitor ends the episode
 	 */
     virtual void run(int steps);
     
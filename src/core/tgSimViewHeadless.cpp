@@ -0,0 +1,98 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgSimViewHeadless.cpp
+ * @brief Contains the definitions of members of class tgSimViewHeadless
+ * $Id$
+ */
+
+// This module
+#include "tgSimViewHeadless.h"
+// This application
+#include "tgSimulation.h"
+// The C++ Standard Library
+#include <iostream>
+// POSIX, for a wall clock that works without Bullet's profiler
+#include <sys/time.h>
+
+namespace
+{
+    /** Wall clock time in seconds */
+    double wallClock()
+    {
+        timeval tv;
+        gettimeofday(&tv, NULL);
+        return tv.tv_sec + tv.tv_usec * 1.0e-6;
+    }
+}
+
+tgSimViewHeadless::tgSimViewHeadless(tgWorld& world,
+                                     double stepSize,
+                                     bool report) :
+    tgSimView(world, stepSize, stepSize),
+    m_report(report),
+    m_wallTime(0.0),
+    m_stepsTaken(0)
+{
+}
+
+tgSimViewHeadless::~tgSimViewHeadless()
+{
+}
+
+void tgSimViewHeadless::run(int steps)
+{
+    if (m_pSimulation != NULL)
+    {
+        const double dt = m_stepSize;
+        tgSimulation& simulation = *m_pSimulation;
+        
+        const double start = wallClock();
+        int i = 0;
+        while (i < steps && !simulation.isStopped())
+        {
+            simulation.step(dt);
+            i++;
+        }
+        m_wallTime = wallClock() - start;
+        m_stepsTaken = i;
+        
+        if (m_report)
+        {
+            printReport(std::cout);
+        }
+    }
+}
+
+double tgSimViewHeadless::getStepsPerSecond() const
+{
+    return m_wallTime > 0.0 ? m_stepsTaken / m_wallTime : 0.0;
+}
+
+double tgSimViewHeadless::getRealTimeFactor() const
+{
+    return m_wallTime > 0.0 ? m_stepsTaken * m_stepSize / m_wallTime : 0.0;
+}
+
+void tgSimViewHeadless::printReport(std::ostream& os) const
+{
+    os << "tgSimViewHeadless: " << m_stepsTaken << " steps in "
+       << m_wallTime << " s, " << getStepsPerSecond() << " steps/s, "
+       << "real time factor " << getRealTimeFactor() << std::endl;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_SIM_VIEW_HEADLESS_H
+#define TG_SIM_VIEW_HEADLESS_H
+
+/**
+ * @file tgSimViewHeadless.h
+ * @brief Contains the definition of class tgSimViewHeadless
+ * $Id$
+ */
+
+// This application
+#include "tgSimView.h"
+// The C++ Standard Library
+#include <iosfwd>
+
+/**
+ * A view for batch runs that will never be rendered, such as learning
+ * trials. run(steps) is a tight loop over tgSimulation::step with no
+ * render bookkeeping or per-run output, and the throughput of the
+ * most recent run is recorded so it can be tracked across releases.
+ * Configure with -DNTRT_NO_PROFILE=ON to also compile out the
+ * BT_PROFILE scopes in the NTRT libraries.
+ */
+class tgSimViewHeadless : public tgSimView
+{
+public:
+
+    /**
+     * The only constructor.
+     * @param[in] world a reference to the tgWorld being simulated.
+     * @param[in] stepSize the time interval for advancing the simulation;
+     * std::invalid_argument is thrown if not positive
+     * @param[in] report whether to print the timing summary to
+     * std::cout at the end of each run
+     */
+    tgSimViewHeadless(tgWorld& world,
+                      double stepSize = 1.0/1000.0,
+                      bool report = true);
+
+    virtual ~tgSimViewHeadless();
+
+    /**
+     * Run for a specific number of steps without rendering, or until
+     * the simulation's tgEpisodeMonitor ends the episode, then
+     * record (and optionally report) wall time, steps per second
+     * and the real time factor.
+     * @param[in] steps the number of steps to take
+     */
+    virtual void run(int steps);
+
+    /** Rendering is a no-op for this view */
+    virtual void render() const { }
+    
+    /** Rendering is a no-op for this view */
+    virtual void render(const tgModelVisitor& r) const { }
+    
+    /**
+     * Wall clock seconds taken by the most recent run
+     */
+    double getWallTime() const { return m_wallTime; }
+    
+    /**
+     * Number of steps taken by the most recent run
+     */
+    int getStepsTaken() const { return m_stepsTaken; }
+    
+    /**
+     * Steps per wall clock second during the most recent run
+     */
+    double getStepsPerSecond() const;
+    
+    /**
+     * Simulated seconds per wall clock second during the most
+     * recent run
+     */
+    double getRealTimeFactor() const;
+    
+    /**
+     * Print the statistics of the most recent run.
+     * @param[in,out] os the stream to print to
+     */
+    void printReport(std::ostream& os) const;
+
+private:
+
+    /** Whether run prints a report when it finishes */
+    bool m_report;
+    
+    /** Wall clock seconds of the most recent run */
+    double m_wallTime;
+    
+    /** Number of steps in the most recent run */
+    int m_stepsTaken;
+};
+
+#endif  // TG_SIM_VIEW_HEADLESS_H
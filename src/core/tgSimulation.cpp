@@ -26,6 +26,7 @@
 // This module
 #include "tgSimulation.h"
 // This application
+#include "tgEpisodeMonitor.h"
 #include "tgModel.h"
 #include "tgSimView.h"
 #include "tgSimViewGraphics.h"
@@ -38,7 +39,8 @@
 #include <stdexcept>
 
 tgSimulation::tgSimulation(tgSimView& view) :
-  m_view(view)
+  m_view(view),
+  m_pMonitor(NULL)
 {
         m_view.bindToSimulation(*this);
 
@@ -60,6 +62,7 @@ tgSimulation::~tgSimulation()
     for (std::size_t i=0; i < m_dataManagers.size(); i++) {
       delete m_dataManagers[i];
     }
+    delete m_pMonitor;
 }
 
 void tgSimulation::addModel(tgModel* pModel)
@@ -118,6 +121,24 @@ void tgSimulation::addDataManager(tgDataManager* pDataManager)
   assert(!m_dataManagers.empty());
 }
 
+void tgSimulation::setMonitor(tgEpisodeMonitor* pMonitor)
+{
+    if (pMonitor != m_pMonitor)
+    {
+        delete m_pMonitor;
+        m_pMonitor = pMonitor;
+    }
+    if (m_pMonitor != NULL)
+    {
+        m_pMonitor->reset();
+    }
+}
+
+bool tgSimulation::isStopped() const
+{
+    return (m_pMonitor != NULL) && m_pMonitor->isStopped();
+}
+
 void tgSimulation::onVisit(const tgModelVisitor& r) const
 {
 #ifndef BT_NO_PROFILE 
@@ -153,6 +174,11 @@ void tgSimulation::reset()
       m_dataManagers[i]->setup();
     }
     
+    if (m_pMonitor != NULL)
+    {
+        m_pMonitor->reset();
+    }
+    
     // Don't need to set up obstacles since they will be added after this
 }
 
@@ -179,9 +205,50 @@ void tgSimulation::reset(tgGround* newGround)
       m_dataManagers[i]->setup();
     }
     
+    if (m_pMonitor != NULL)
+    {
+        m_pMonitor->reset();
+    }
+    
     // Don't need to set up obstacles since they were just added
 }
 
+void tgSimulation::snapshot()
+{
+    m_view.world().snapshot();
+    for (std::size_t i = 0; i < m_models.size(); i++)
+    {
+        m_models[i]->snapshot();
+    }
+    for (std::size_t i = 0; i < m_obstacles.size(); i++)
+    {
+        m_obstacles[i]->snapshot();
+    }
+}
+
+void tgSimulation::restore()
+{
+    // Bodies and cables first, so models restore against the old state
+    m_view.world().restore();
+    for (std::size_t i = 0; i < m_models.size(); i++)
+    {
+        m_models[i]->restore();
+    }
+    for (std::size_t i = 0; i < m_obstacles.size(); i++)
+    {
+        m_obstacles[i]->restore();
+    }
+    // Start new logs, as reset() does
+    for (std::size_t i = 0; i < m_dataManagers.size(); i++) {
+      m_dataManagers[i]->teardown();
+      m_dataManagers[i]->setup();
+    }
+    if (m_pMonitor != NULL)
+    {
+        m_pMonitor->reset();
+    }
+}
+
 /**
  * @note This is not inlined because it depends on the definition of tgSimView.
  */
@@ -221,6 +288,12 @@ void tgSimulation::step(double dt) const
 	for (std::size_t i = 0; i < m_dataManagers.size(); i++) {
 	  m_dataManagers[i]->step(dt);
 	}
+
+        // Check whether the episode has failed
+        if (m_pMonitor != NULL)
+        {
+            m_pMonitor->step(dt, m_models);
+        }
     }
 }
   
@@ -37,6 +37,7 @@ class tgSimView;
 class tgWorld;
 class tgGround;
 class tgDataManager;
+class tgEpisodeMonitor;
 
 /**
  * Holds objects necessary for simulation, a world, a view
@@ -69,6 +70,7 @@ public:
 
     /**
      * Run for a specific number of steps. Calls tgSimView.run(int steps)
+     * Runs fewer steps if an attached tgEpisodeMonitor stops the episode.
      * @param[in] steps the number of steps to update the graphics
      * @todo Make steps of type size_t.
      */
@@ -82,10 +84,6 @@ public:
      */
     void addModel(tgModel* pModel);
     
-<<<<<<< HEAD
-=======
-    
->>>>>>> manueltest1
     /**
      * Add an obstacle to the simulation.
      * Obstacles are deleted upon reset.
@@ -104,6 +102,25 @@ public:
      */
     void addDataManager(tgDataManager* pDataManager);
     
+    /**
+     * Attach a monitor that ends failing episodes early, replacing and
+     * deleting any previous one. The simulation takes ownership.
+     * @param[in] pMonitor the monitor, or NULL to remove it
+     */
+    void setMonitor(tgEpisodeMonitor* pMonitor);
+
+    /** The attached monitor, or NULL */
+    tgEpisodeMonitor* getMonitor() const
+    {
+        return m_pMonitor;
+    }
+
+    /**
+     * True if the monitor has ended the current episode. The views stop
+     * running when this becomes true.
+     */
+    bool isStopped() const;
+    
     /**
      * Pass the tgModelVisitor to all of the models
      */
@@ -125,6 +142,22 @@ public:
      */
     void reset(tgGround* newGround);
     
+    /**
+     * Record the state of the world, the models and their controllers
+     * so that restore() can return to it. Typically called once after
+     * the models have been added.
+     */
+    void snapshot();
+    
+    /**
+     * Return to the state recorded by snapshot() without tearing down
+     * or rebuilding anything. Data managers are torn down and set up
+     * again, as in reset(). Obstacles must be the same as at the time
+     * of the snapshot.
+     * @throw std::runtime_error if the world has no valid snapshot
+     */
+    void restore();
+    
     /**
      * Returns a reference to the world
      */
@@ -166,6 +199,9 @@ private:
      * All pointers should be non-NULL.
      */
     std::vector<tgDataManager*> m_dataManagers;
+
+    /** Ends episodes early. Owned, may be NULL */
+    tgEpisodeMonitor* m_pMonitor;
 };
 
 #endif  // TG_SIMULATION_H
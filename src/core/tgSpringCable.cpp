@@ -57,6 +57,8 @@ m_dampingCoefficient(dampingCoefficient)
 	}
 	
 	m_prevLength = m_restLength;
+	
+	tgSpringCable::snapshot();
 }
 
 tgSpringCable::~tgSpringCable()
@@ -76,3 +78,19 @@ void tgSpringCable::setRestLength( const double newRestLength)
     
     m_restLength = newRestLength;
 }
+
+void tgSpringCable::snapshot()
+{
+    m_snapshotDamping = m_damping;
+    m_snapshotVelocity = m_velocity;
+    m_snapshotRestLength = m_restLength;
+    m_snapshotPrevLength = m_prevLength;
+}
+
+void tgSpringCable::restore()
+{
+    m_damping = m_snapshotDamping;
+    m_velocity = m_snapshotVelocity;
+    m_restLength = m_snapshotRestLength;
+    m_prevLength = m_snapshotPrevLength;
+}
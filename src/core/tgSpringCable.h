@@ -78,6 +78,18 @@ public:
      */
     virtual void setRestLength( const double newRestLength); 
     
+    /**
+     * Record the rest length, previous length, velocity and damping
+     * so restore() can return to them. Replaces any previous snapshot.
+     */
+    virtual void snapshot();
+    
+    /**
+     * Return to the spring state recorded by the last call to
+     * snapshot(), or to the constructed state if there was none
+     */
+    virtual void restore();
+    
     /**
      * Pure virtual funciton, returns the actual length of the spring
      * cable
@@ -166,6 +178,12 @@ protected:
      * force and velocity
      */
     double m_prevLength;
+    
+    /** Spring state recorded by snapshot() */
+    double m_snapshotDamping;
+    double m_snapshotVelocity;
+    double m_snapshotRestLength;
+    double m_snapshotPrevLength;
 
 };
 
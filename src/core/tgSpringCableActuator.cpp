@@ -28,6 +28,7 @@
 #include "tgSpringCable.h"
 #include "tgWorld.h"
 // The C++ Standard Library
+#include <cassert>
 #include <cmath>
 #include <iostream>
 #include <stdexcept>
@@ -44,11 +45,15 @@ tgSpringCableActuator::Config::Config(double s,
                    double mnRL,
 		   double rot,
    	           bool moveCPA,
-		   bool moveCPB) :
+		   bool moveCPB,
+		   std::size_t histCap,
+		   std::size_t histDec) :
   stiffness(s),
   damping(d),
   pretension(p),
   hist(h),
+  histCapacity(histCap),
+  histDecimation(histDec),
   maxTens(mf),
   targetVelocity(tVel),
   minActualLength(mnAL),
@@ -85,6 +90,65 @@ tgSpringCableActuator::Config::Config(double s,
     {
          throw std::invalid_argument("Abs of rotation is greater than 2pi. Are you sure you're setting the right parameters?");
     }
+    else if (histDec == 0)
+    {
+        throw std::invalid_argument("history decimation is zero.");
+    }
+}
+
+tgSpringCableActuator::SpringCableActuatorHistory::SpringCableActuatorHistory(
+        std::size_t capacity, std::size_t decimation) :
+    m_block(5, capacity),
+    m_decimation(decimation),
+    m_countdown(0),
+    lastLengths(m_block[0]),
+    restLengths(m_block[1]),
+    dampingHistory(m_block[2]),
+    lastVelocities(m_block[3]),
+    tensionHistory(m_block[4])
+{
+    assert(decimation > 0);
+}
+
+tgSpringCableActuator::SpringCableActuatorHistory::SpringCableActuatorHistory(
+        const SpringCableActuatorHistory& other) :
+    m_block(other.m_block),
+    m_decimation(other.m_decimation),
+    m_countdown(other.m_countdown),
+    lastLengths(m_block[0]),
+    restLengths(m_block[1]),
+    dampingHistory(m_block[2]),
+    lastVelocities(m_block[3]),
+    tensionHistory(m_block[4])
+{
+}
+
+tgSpringCableActuator::SpringCableActuatorHistory&
+tgSpringCableActuator::SpringCableActuatorHistory::operator=(
+        const SpringCableActuatorHistory& other)
+{
+    // The series references stay bound to this block
+    m_block = other.m_block;
+    m_decimation = other.m_decimation;
+    m_countdown = other.m_countdown;
+    return *this;
+}
+
+bool tgSpringCableActuator::SpringCableActuatorHistory::sample()
+{
+    if (m_countdown == 0)
+    {
+        m_countdown = m_decimation - 1;
+        return true;
+    }
+    m_countdown--;
+    return false;
+}
+
+void tgSpringCableActuator::SpringCableActuatorHistory::clear()
+{
+    m_block.clear();
+    m_countdown = 0;
 }
 
 void tgSpringCableActuator::Config::scale (double sf)
@@ -119,10 +183,13 @@ tgSpringCableActuator::tgSpringCableActuator(tgSpringCable* springCable,
     tgModel(tags),
     m_springCable(springCable),
     m_config(config),
-    m_pHistory(new SpringCableActuatorHistory()),
+    m_pHistory(new SpringCableActuatorHistory(config.histCapacity,
+                                              config.histDecimation)),
     m_restLength(springCable->getRestLength()),
     m_startLength(springCable->getActualLength()),
-    m_prevVelocity(0.0)
+    m_prevVelocity(0.0),
+    m_snapshotRestLength(m_restLength),
+    m_snapshotPrevVelocity(0.0)
 {
     constructorAux();
 
@@ -159,6 +226,27 @@ void tgSpringCableActuator::step(double dt)
     }
 }
 
+void tgSpringCableActuator::snapshot()
+{
+    m_snapshotRestLength = m_restLength;
+    m_snapshotPrevVelocity = m_prevVelocity;
+    m_springCable->snapshot();
+    tgModel::snapshot();
+}
+
+void tgSpringCableActuator::restore()
+{
+    m_restLength = m_snapshotRestLength;
+    m_prevVelocity = m_snapshotPrevVelocity;
+    m_springCable->restore();
+    m_springCable->setRestLength(m_restLength);
+    
+    // A rebuilt actuator would start with an empty history
+    m_pHistory->clear();
+    
+    tgModel::restore();
+}
+
 const double tgSpringCableActuator::getStartLength() const
 {
     return m_startLength;
@@ -31,8 +31,9 @@
 #include "tgModel.h"
 #include "tgControllable.h"
 #include "tgSubject.h"
-
-#include <deque> // For history
+#include "tgRingBuffer.h" // For history
+// The C++ Standard Library
+#include <cstddef>
 // Forward declarations
 class tgWorld;
 class tgSpringCable;
@@ -66,7 +67,9 @@ public:
         double mnRL = 0.1,
 	double rot = 0,
 	bool moveCPA = true,
-	bool moveCPB = true);
+	bool moveCPB = true,
+	std::size_t histCap = 0,
+	std::size_t histDec = 1);
       
       /**
        * Scale parameters that depend on the length of the simulation.
@@ -105,6 +108,18 @@ public:
        * in deque objects. Useful for computing the energy of a trial.
        */
       bool hist;
+      
+      /**
+       * Number of samples kept per history series. Once full, the oldest
+       * sample is overwritten. Zero, the default, keeps every sample.
+       */
+      std::size_t histCapacity;
+      
+      /**
+       * Record history every histDecimation steps. Must be positive,
+       * 1 records every step.
+       */
+      std::size_t histDecimation;
               
       // Motor model parameters
       /**
@@ -178,23 +193,60 @@ public:
       
     };
     
-    /** Encapsulate the history members. */
+    /**
+     * Encapsulate the history members. All series share one contiguous
+     * allocation, see tgRingBufferBlock.
+     */
     struct SpringCableActuatorHistory
     {
+    public:
+        /**
+         * @param[in] capacity samples per series, 0 for unbounded
+         * @param[in] decimation record one sample per this many steps
+         */
+        SpringCableActuatorHistory(std::size_t capacity = 0,
+                                   std::size_t decimation = 1);
+        
+        SpringCableActuatorHistory(const SpringCableActuatorHistory& other);
+        
+        SpringCableActuatorHistory&
+        operator=(const SpringCableActuatorHistory& other);
+        
+        /**
+         * Call once per step. Returns true if this step's sample should
+         * be recorded according to the decimation factor.
+         */
+        bool sample();
+        
+        /** Clear all series and restart the decimation count */
+        void clear();
+        
+    private:
+        
+        /** Storage for all series, must precede them */
+        tgRingBufferBlock m_block;
+        
+        std::size_t m_decimation;
+        
+        /** Steps until the next recorded sample */
+        std::size_t m_countdown;
+        
+    public:
+        
         /** Length history. */
-        std::deque<double> lastLengths;
+        tgRingBuffer& lastLengths;
         
         /** Rest length history. */
-        std::deque<double> restLengths;
+        tgRingBuffer& restLengths;
 
         /** Damping history. */
-        std::deque<double> dampingHistory;
+        tgRingBuffer& dampingHistory;
 
         /** Velocity history. */
-        std::deque<double> lastVelocities;
+        tgRingBuffer& lastVelocities;
         
         /** Tension history. */
-        std::deque<double> tensionHistory;
+        tgRingBuffer& tensionHistory;
     };
 
     /** Deletes history and spring cable instantiation */
@@ -209,6 +261,15 @@ public:
     /** Just calls tgModel::step(dt) - steps any children */
     virtual void step(double dt);
     
+    /** Records the rest length and velocity, then snapshots children */
+    virtual void snapshot();
+    
+    /**
+     * Restores the rest length and velocity, clears the history, then
+     * restores children
+     */
+    virtual void restore();
+    
     /**
      * Functions for interfacing with tgSpringCable
      */
@@ -312,6 +373,12 @@ protected:
      * history is off.
      */
     double m_prevVelocity;
+    
+    /** m_restLength when snapshot() was called */
+    double m_snapshotRestLength;
+    
+    /** m_prevVelocity when snapshot() was called */
+    double m_snapshotPrevVelocity;
 private:
 
     /**
@@ -30,8 +30,28 @@
 // This application
 #include "tgObserver.h"
 // The C++ standard library
+#include <algorithm>
 #include <vector>
 
+/**
+ * The part of tgSubject that does not depend on the type of the subject,
+ * so tgModel::restore() can notify the observers of any model that is
+ * a subject.
+ */
+class tgSubjectBase
+{
+public:
+
+    /** The virtual destructor has nothing to do. */
+    virtual ~tgSubjectBase() { }
+    
+    /**
+     * Call onRestore() on all observers in the order in which they
+     * were attached.
+     */
+    virtual void notifyRestore() = 0;
+};
+
 /**
  * A mixin base class for the subject in the observer design pattern.
  * Observers are attached to the subject, and their onStep() member functions
@@ -41,7 +61,7 @@
  * or submodels such as a tgLinearString
  */
 template <typename T>
-class tgSubject
+class tgSubject : public tgSubjectBase
 {
 public:
 
@@ -58,6 +78,14 @@ public:
      */
     void attach(tgObserver<T>* pObserver);
     
+    /**
+     * Detach an observer, so it is no longer notified. Observers that
+     * rebuild themselves on restore detach the parts they replace.
+     * @param[in] pObserver a pointer to an observer for the subject;
+     * do nothing if it is not attached
+     */
+    void detach(tgObserver<T>* pObserver);
+    
     /**
      * Call tgObserver<T>::onStep() on all observers in the order in which they
      * were attached.
@@ -78,6 +106,13 @@ public:
      */
     void notifyTeardown();
     
+    /**
+     * Call tgObserver<T>::onRestore() on all observers in the order in which they
+     * were attached. tgModel::restore() calls this once the model and
+     * its children have been restored.
+     */
+    virtual void notifyRestore();
+    
 private:
 
     /**
@@ -94,6 +129,17 @@ void tgSubject<Subject>::attach(tgObserver<Subject>* pObserver)
         pObserver->onAttach(static_cast<Subject&>(*this));}
 }
 
+template <typename Subject>
+void tgSubject<Subject>::detach(tgObserver<Subject>* pObserver)
+{
+    typename std::vector<tgObserver<Subject> * >::iterator it =
+        std::find(m_observers.begin(), m_observers.end(), pObserver);
+    if (it != m_observers.end())
+    {
+        m_observers.erase(it);
+    }
+}
+
 template <typename Subject>
 void tgSubject<Subject>::notifyStep(double dt)
 {
@@ -129,5 +175,16 @@ void tgSubject<Subject>::notifyTeardown()
         if (pObserver) { pObserver->onTeardown(static_cast<Subject&>(*this)); }
     }
 }
+template <typename Subject> 
+void tgSubject<Subject>::notifyRestore()
+{
+    const std::size_t n = m_observers.size();
+    for (std::size_t i = 0; i < n; ++i) 
+    {
+        tgObserver<Subject>* const pObserver = m_observers[i];
+        if (pObserver) { pObserver->onRestore(static_cast<Subject&>(*this)); }
+    }
+}
+
 #endif  // TG_SUBJECT_H
 
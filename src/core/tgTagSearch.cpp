@@ -0,0 +1,83 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgTagSearch.cpp
+ * @brief Contains the definition of the compiled search interning table
+ * $Id$
+ */
+
+// This module
+#include "tgTagSearch.h"
+// The C++ Standard Library
+#include <map>
+// POSIX
+#include <pthread.h>
+
+namespace
+{
+    typedef std::map<std::string, tgTagSearch::Id> IdMap;
+
+    /** Guards the table; statically initialized so it is usable at once */
+    pthread_mutex_t tableMutex = PTHREAD_MUTEX_INITIALIZER;
+
+    /** Constructed on first use so static tgTagSearches are safe to build */
+    IdMap& table()
+    {
+        static IdMap ids;
+        return ids;
+    }
+
+    void appendIds(std::string& key, const std::vector<tgTags::Id>& ids)
+    {
+        // Ids are sorted, so equal tag sets give equal keys
+        for (std::size_t i = 0; i < ids.size(); i++)
+        {
+            key += ' ';
+            key.append(reinterpret_cast<const char*>(&ids[i]),
+                       sizeof(tgTags::Id));
+        }
+    }
+}
+
+void tgTagSearch::updateId()
+{
+    // Only built when the search changes, never when it is used
+    std::string key;
+    appendIds(key, m_search.getIds());
+    for (std::size_t i = 0; i < m_clauses.size(); i++)
+    {
+        key += m_clauses[i].negated ? '-' : '|';
+        appendIds(key, m_clauses[i].alternatives.getIds());
+    }
+    if (m_unsatisfiable)
+    {
+        key += '!';
+    }
+
+    pthread_mutex_lock(&tableMutex);
+    IdMap& ids = table();
+    IdMap::iterator it = ids.lower_bound(key);
+    if (it == ids.end() || it->first != key)
+    {
+        const Id id = static_cast<Id>(ids.size());
+        it = ids.insert(it, IdMap::value_type(key, id));
+    }
+    m_id = it->second;
+    pthread_mutex_unlock(&tableMutex);
+}
@@ -27,32 +27,57 @@
 #define TG_TAG_SEARCH_H
 
 #include <string>
+#include <vector>
 
 #include "tgTags.h"
 #include "tgTaggable.h"
 
-/*  @todo: Implement more advanced search capability
-
-    Currently, tag searches just matches all tags, so something like
-    tgTagSearch("a b").matches(tgTags("a b c")) is true. 
-
-    Plans: search operators like 'or' and 'not', for instance
-    - tgTagSearch("a -b") would match tgTags("a c") but not tgTags("a b")
-    - tgTagSearch("a b|c") would match tgTags("a b") and tgTags("a c") 
-      but not tgTags("a d")
-*/
-
 /**
- * Represents a search to be performed on a tgTaggable
+ * Represents a search to be performed on a tgTaggable.
+ *
+ * A search is a space separated list of terms, all of which must match:
+ * - "a" matches tags containing a
+ * - "a|b" matches tags containing a or b
+ * - "-a" (or "-a|b") matches tags containing none of them
+ * so tgTagSearch("a -b") matches tgTags("a c") but not tgTags("a b"), and
+ * tgTagSearch("a b|c") matches tgTags("a b") and tgTags("a c") but not
+ * tgTags("a d").
+ *
+ * The search is compiled to interned tag ids when constructed, so
+ * matching is a handful of sorted id list comparisons. Equivalent
+ * searches also share an id, so caches such as tgModelIndex can key on
+ * a search without building strings.
  */
 class tgTagSearch
 {
 public:
+
+    /**
+     * A term with alternatives or a negation
+     */
+    struct Clause
+    {
+        Clause() : negated(false) {}
+
+        /** The term matches if the tags contain any of these */
+        tgTags alternatives;
+
+        /** Inverts the term: matches if the tags contain none of them */
+        bool negated;
+    };
     
-    tgTagSearch() {}
+    typedef unsigned int Id;
 
-    tgTagSearch(std::string search_string) : m_search(search_string)
-    {}
+    tgTagSearch() : m_unsatisfiable(false)
+    {
+        updateId();
+    }
+
+    tgTagSearch(std::string search_string) : m_unsatisfiable(false)
+    {
+        compile(search_string);
+        updateId();
+    }
     
     virtual ~tgTagSearch() {}
 
@@ -61,9 +86,19 @@ public:
      */
     const bool matches(const tgTags& tags) const
     {
-        // Simple for now, just check that the tags contain the tags in the 
-        // search
-        return tags.contains(m_search);
+        if (m_unsatisfiable || !tags.contains(m_search))
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < m_clauses.size(); i++)
+        {
+            const Clause& clause = m_clauses[i];
+            if (tags.containsAny(clause.alternatives) == clause.negated)
+            {
+                return false;
+            }
+        }
+        return true;
     }
 
     const bool matches(const tgTaggable& taggable) const
@@ -84,19 +119,120 @@ public:
     }
     
     /**
-     * Remove the given tags from the search
+     * The tags a match must contain. Terms with alternatives or negation
+     * are in getClauses().
+     */
+    const tgTags& getTags() const
+    {
+        return m_search;
+    }
+
+    /**
+     * The terms that are not plain required tags
+     */
+    const std::vector<Clause>& getClauses() const
+    {
+        return m_clauses;
+    }
+
+    /**
+     * True if removing tags left a negated term that can no longer be met
+     */
+    bool isUnsatisfiable() const
+    {
+        return m_unsatisfiable;
+    }
+
+    /**
+     * Process-wide id of this search. Searches that compile to the same
+     * required tags and clauses, in the same clause order, have the same
+     * id, so "a b" and "b a" share one.
+     */
+    Id getId() const
+    {
+        return m_id;
+    }
+
+    /**
+     * Remove the given tags from the search. This is the same as adding
+     * them to everything that is searched: terms they satisfy are
+     * dropped, and a negated term they contain makes the search fail.
      */
     void remove(const tgTags& tags)
     {
-        tgTags s(tags);
         m_search.remove(tags);
+        std::vector<Clause>::iterator it = m_clauses.begin();
+        while (it != m_clauses.end())
+        {
+            if (!tags.containsAny(it->alternatives))
+            {
+                ++it;
+            }
+            else if (it->negated)
+            {
+                m_unsatisfiable = true;
+                ++it;
+            }
+            else
+            {
+                it = m_clauses.erase(it);
+            }
+        }
+        updateId();
     }
     
 private:
+
+    /** Intern the compiled search and store its id in m_id */
+    void updateId();
+
+    void compile(const std::string& search_string)
+    {
+        const std::deque<std::string> terms =
+            tgTags::splitTags(search_string);
+        for (std::size_t i = 0; i < terms.size(); i++)
+        {
+            std::string term = terms[i];
+            Clause clause;
+            if (term[0] == '-')
+            {
+                clause.negated = true;
+                term.erase(0, 1);
+            }
+            const std::deque<std::string> alternatives =
+                tgTags::splitTags(term, '|');
+            if (alternatives.empty())
+            {
+                throw tgTagException("Empty term '" + terms[i] +
+                                     "' in tag search '" + search_string + "'");
+            }
+            else if (alternatives.size() == 1 && !clause.negated)
+            {
+                m_search.append(alternatives[0]);
+            }
+            else
+            {
+                for (std::size_t j = 0; j < alternatives.size(); j++)
+                {
+                    clause.alternatives.append(alternatives[j]);
+                }
+                m_clauses.push_back(clause);
+            }
+        }
+    }
     
-    // @todo: change this to a parsed representation of the and/or/not setup
+    /** Plain terms: tags a match must contain */
     tgTags m_search;
 
+    /** Terms with alternatives or negation */
+    std::vector<Clause> m_clauses;
+
+    /** Set when remove() hits a negated term */
+    bool m_unsatisfiable;
+
+    /** Interned id of the compiled search, kept current by updateId() */
+    Id m_id;
+
 };
 
 
@@ -0,0 +1,85 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgTags.cpp
+ * @brief Contains the definition of the tag interning table
+ * $Id$
+ */
+
+// This module
+#include "tgTags.h"
+// The C++ Standard Library
+#include <map>
+// POSIX
+#include <pthread.h>
+
+namespace
+{
+    typedef std::map<std::string, tgTagTable::Id> IdMap;
+
+    /**
+     * Guards the table; statically initialized so it is usable at once.
+     * Almost every call finds a tag that is already interned, so readers
+     * share the lock and only new tags take it exclusively.
+     */
+    pthread_rwlock_t tableLock = PTHREAD_RWLOCK_INITIALIZER;
+
+    /** Constructed on first use so static tgTags are safe to build */
+    IdMap& table()
+    {
+        static IdMap ids;
+        return ids;
+    }
+}
+
+tgTagTable::Id tgTagTable::intern(const std::string& tag)
+{
+    Id result;
+    if (lookup(tag, result))
+    {
+        return result;
+    }
+
+    pthread_rwlock_wrlock(&tableLock);
+    IdMap& ids = table();
+    // Another thread may have added the tag since lookup released the lock
+    IdMap::iterator it = ids.lower_bound(tag);
+    if (it == ids.end() || it->first != tag)
+    {
+        const Id id = static_cast<Id>(ids.size());
+        it = ids.insert(it, IdMap::value_type(tag, id));
+    }
+    result = it->second;
+    pthread_rwlock_unlock(&tableLock);
+    return result;
+}
+
+bool tgTagTable::lookup(const std::string& tag, Id& id)
+{
+    pthread_rwlock_rdlock(&tableLock);
+    const IdMap& ids = table();
+    IdMap::const_iterator it = ids.find(tag);
+    const bool found = (it != ids.end());
+    if (found)
+    {
+        id = it->second;
+    }
+    pthread_rwlock_unlock(&tableLock);
+    return found;
+}
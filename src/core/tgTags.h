@@ -29,6 +29,7 @@
 #include <deque>
 #include <set>
 #include <string>
+#include <vector>
 #include <algorithm>
 #include <iostream>
 #include <sstream>
@@ -41,9 +42,36 @@ struct tgTagException : public tgException
    tgTagException(std::string ss) : tgException(ss) {}
 };
 
+/**
+ * Process-wide table of interned tags. Each distinct tag string gets a
+ * small integer id the first time it is interned and keeps it for the
+ * life of the process, so tag sets can be compared as sorted id lists
+ * instead of strings. Safe to use from several threads; lookups of known
+ * tags share a read lock.
+ */
+class tgTagTable
+{
+public:
+    typedef unsigned int Id;
+
+    /**
+     * Return the id of tag, assigning a new one if it has not been seen
+     */
+    static Id intern(const std::string& tag);
+
+    /**
+     * Find the id of tag without interning it
+     * @param[out] id the id, if found
+     * @return false if tag has never been interned
+     */
+    static bool lookup(const std::string& tag, Id& id);
+};
+
 class tgTags
 {
 public:
+    typedef tgTagTable::Id Id;
+
     tgTags() {}
     tgTags(const std::string& space_separated_tags)
     {
@@ -58,18 +86,31 @@ public:
 
     bool contains(const tgTags& tags) const
     {
-        return contains(tags.getTags());
+        return std::includes(m_ids.begin(), m_ids.end(),
+                             tags.m_ids.begin(), tags.m_ids.end());
     }
         
-    bool containsAny(const std::string& space_separated_tags)
+    bool containsAny(const std::string& space_separated_tags) const
     {
         std::deque<std::string> tags = splitTags(space_separated_tags);
         return containsAny(tags);
     }
 
-    bool containsAny(const tgTags& tags) 
+    bool containsAny(const tgTags& tags) const
     {
-        return containsAny(tags.getTags());
+        // Walk both sorted id lists looking for a common id
+        std::vector<Id>::const_iterator a = m_ids.begin();
+        std::vector<Id>::const_iterator b = tags.m_ids.begin();
+        while (a != m_ids.end() && b != tags.m_ids.end())
+        {
+            if (*a < *b)
+                ++a;
+            else if (*b < *a)
+                ++b;
+            else
+                return true;
+        }
+        return false;
     }
 
     void append(const std::string& space_separated_tags)
@@ -99,7 +140,9 @@ public:
 
     void remove(const tgTags& tags)
     {
-        remove(tags.getTags());
+        for(std::size_t i = 0; i < tags.m_tags.size(); i++) {
+            removeOne(tags.m_tags[i]);
+        }
     }
 
     const int size() const
@@ -187,14 +230,20 @@ public:
         return true;
     }
 
-    std::deque<std::string>& getTags()
+    /**
+     * The tags in the order they were added
+     */
+    const std::deque<std::string>& getTags() const
     {
         return m_tags;
     }
 
-    const std::deque<std::string>& getTags() const
+    /**
+     * The interned ids of the tags, sorted ascending
+     */
+    const std::vector<Id>& getIds() const
     {
-        return m_tags;
+        return m_ids;
     }
 
     /**
@@ -206,15 +255,10 @@ public:
     }
 
     /**
-     * Return a non-const reference to the tag that is indexed by the
-     * int key. It must be in m_tags.
+     * Return the tag that is indexed by the int key. It must be in m_tags.
      * @param[in] key the key of the tag to retrieve
      * @reeturn a const reference to the tag that is indexed by key
      */
-    std::string& operator[](int key) { 
-        return m_tags[key]; 
-    }
-    
     const std::string& operator[](int key) const { 
         return m_tags[key]; 
     }
@@ -222,15 +266,19 @@ public:
     /**
      * Check if we contain the same tags regardless of ordering
      */
-    bool operator==(const tgTags& rhs)
+    bool operator==(const tgTags& rhs) const
     {
-        return rhs.asSet() == asSet(); 
+        return rhs.m_ids == m_ids; 
     }
 
     tgTags& operator+=(const tgTags& rhs)
     {
-        const std::deque<std::string>& other = rhs.getTags();
-        m_tags.insert(m_tags.end(), other.begin(), other.end());
+        for(std::size_t i = 0; i < rhs.m_tags.size(); i++) {
+            const std::string& tag = rhs.m_tags[i];
+            if(insertId(tgTagTable::intern(tag))) {
+                m_tags.push_back(tag);
+            }
+        }
         return *this;
     }
 
@@ -244,7 +292,7 @@ private:
         if(!isValid(tag)) {
             throw tgTagException("Invalid tag '" + tag + "' - tags must be alphanumeric and may not be castable to int.");
         }
-        if(!containsOne(tag)) {
+        if(insertId(tgTagTable::intern(tag))) {
             m_tags.push_back(tag);
         }
     }
@@ -257,7 +305,7 @@ private:
     }
     
     void prependOne(std::string tag) {
-        if(isValid(tag) && !containsOne(tag)) {
+        if(isValid(tag) && insertId(tgTagTable::intern(tag))) {
             m_tags.push_front(tag);
         }
     }
@@ -288,21 +336,50 @@ private:
     /**
      * Check whether we contain a tag that is known to be valid
      */
-    bool containsOne(std::string tag) const {
-        return (std::find(m_tags.begin(), m_tags.end(), tag) != m_tags.end());
+    bool containsOne(const std::string& tag) const {
+        Id id;
+        return tgTagTable::lookup(tag, id) &&
+            std::binary_search(m_ids.begin(), m_ids.end(), id);
     }
     
-    void removeOne(std::string tag) {
-        m_tags.erase(std::remove(m_tags.begin(), m_tags.end(), tag), m_tags.end());
+    void removeOne(const std::string& tag) {
+        Id id;
+        if(!tgTagTable::lookup(tag, id)) {
+            return;
+        }
+        std::vector<Id>::iterator it =
+            std::lower_bound(m_ids.begin(), m_ids.end(), id);
+        if(it != m_ids.end() && *it == id) {
+            m_ids.erase(it);
+            m_tags.erase(std::remove(m_tags.begin(), m_tags.end(), tag), m_tags.end());
+        }
     }
     
-    void remove(std::deque<std::string> tags) {
+    void remove(const std::deque<std::string>& tags) {
         for(std::size_t i = 0; i < tags.size(); i++) {
             removeOne(tags[i]);
         }
     }
+
+    /**
+     * Add id to the sorted id list
+     * @return false if it was already there
+     */
+    bool insertId(Id id) {
+        std::vector<Id>::iterator it =
+            std::lower_bound(m_ids.begin(), m_ids.end(), id);
+        if(it != m_ids.end() && *it == id) {
+            return false;
+        }
+        m_ids.insert(it, id);
+        return true;
+    }
     
+    /** The tags in the order they were added */
     std::deque<std::string> m_tags;
+
+    /** The same tags as interned ids, sorted for set operations */
+    std::vector<Id> m_ids;
 };
 
 /**
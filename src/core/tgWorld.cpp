@@ -32,14 +32,37 @@
 #include <cassert>
 #include <stdexcept>
 
-tgWorld::Config::Config(double g, double ws) :
+tgWorld::Config::Config(double g,
+                        double ws,
+                        SolverType st,
+                        int si,
+                        BroadphaseType bt,
+                        int bc,
+                        int ss) :
 gravity(g),
-worldSize(ws)
+worldSize(ws),
+solverType(st),
+solverIterations(si),
+broadphaseType(bt),
+broadphaseCapacity(bc),
+substeps(ss)
 {
   if (ws <= 0.0)
   {
     throw std::invalid_argument("worldSize is not postive");
   }
+  else if (si <= 0)
+  {
+    throw std::invalid_argument("solverIterations is not positive");
+  }
+  else if (bc <= 0)
+  {
+    throw std::invalid_argument("broadphaseCapacity is not positive");
+  }
+  else if (ss <= 0)
+  {
+    throw std::invalid_argument("substeps is not positive");
+  }
 }
 
 /**
@@ -129,6 +152,16 @@ void tgWorld::step(double dt) const
   }
 }
 
+void tgWorld::snapshot()
+{
+  m_pImpl->snapshot();
+}
+
+void tgWorld::restore()
+{
+  m_pImpl->restore();
+}
+
 // Add a function that returns the amount of gravity in the world.
 // This is useful for calculating the forces applied by rigid bodies
 // inside models (e.g., ForcePlateModel.)
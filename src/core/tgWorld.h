@@ -44,7 +44,33 @@ public:
    */
   struct Config
   {
-	Config(double g = 9.81, double ws = 1000);
+    /** The constraint solvers available to the world */
+    enum SolverType
+    {
+        /** MLCP solver using Bullet's Dantzig LCP. Accurate but slow */
+        DANTZIG_MLCP,
+        /** MLCP solver using projected Gauss-Seidel */
+        PGS_MLCP,
+        /** Bullet's default sequential impulse solver. Fastest */
+        SEQUENTIAL_IMPULSE
+    };
+    
+    /** The broadphase collision detection algorithms available */
+    enum BroadphaseType
+    {
+        /** Sweep and prune over a fixed cube of size worldSize */
+        AXIS_SWEEP_3,
+        /** Dynamic AABB tree, no size limits */
+        DBVT
+    };
+    
+	Config(double g = 9.81,
+           double ws = 1000,
+           SolverType st = DANTZIG_MLCP,
+           int si = 10,
+           BroadphaseType bt = AXIS_SWEEP_3,
+           int bc = 16384,
+           int ss = 1);
     /**
      * Gravitational acceleration.
      * The units are application depenent.
@@ -56,6 +82,33 @@ public:
      * the length of one side of the detection cube. Must be positive.
      */
     double worldSize;
+    /**
+     * Which constraint solver to use for contacts and constraints.
+     */
+    SolverType solverType;
+    /**
+     * Number of solver iterations per step. Must be positive.
+     * More iterations reduce penetration but increase runtime.
+     */
+    int solverIterations;
+    /**
+     * Which broadphase collision detection algorithm to use.
+     */
+    BroadphaseType broadphaseType;
+    /**
+     * Maximum number of collision objects for AXIS_SWEEP_3. Values
+     * above 32766 switch to the 32 bit version. Must be positive.
+     * Ignored by DBVT.
+     */
+    int broadphaseCapacity;
+    /**
+     * Number of Bullet substeps per call to step(dt). Must be positive.
+     * The models and controllers are stepped once per step(dt), while
+     * Bullet integrates, and tgBulletSpringCableSystem recomputes cable
+     * forces, every dt / substeps seconds. Use this to keep stiff
+     * cables stable while running controllers at a lower rate.
+     */
+    int substeps;
   };
 
   /** Construct with the default configuration. */
@@ -100,6 +153,19 @@ public:
    */
   void step(double dt) const;
 
+  /**
+   * Record the state of every body in the world. Objects added or
+   * removed after this call invalidate the snapshot.
+   */
+  void snapshot();
+
+  /**
+   * Return every body to the state recorded by snapshot(), much
+   * faster than reset() since nothing is rebuilt.
+   * @throw std::runtime_error if there is no valid snapshot
+   */
+  void restore();
+
   /**
    * Return a pointer to the implementation.
    * @return a pointer to the implementation; may be NULL.
@@ -29,6 +29,8 @@
 // This application
 #include "tgWorld.h"
 #include "tgCast.h"
+#include "tgBulletSpringCableSystem.h"
+#include "tgBulletSpringCableAnchorPool.h"
 #include "terrain/tgBulletGround.h"
 #include "terrain/tgEmptyGround.h"
 // The Bullet Physics library
@@ -50,77 +52,141 @@
 #include "LinearMath/btTransform.h"
 #include "LinearMath/btVector3.h"
 #include "LinearMath/btQuickprof.h"
+#include "LinearMath/btMotionState.h"
+// The C++ Standard Library
+#include <stdexcept>
 
 // Ghost objects
 #include "BulletCollision/CollisionDispatch/btGhostObject.h"
 #include "BulletCollision/BroadphaseCollision/btOverlappingPairCache.h"
 
-#define MLCP_SOLVER
-
-#ifdef MLCP_SOLVER
-
 #include "BulletDynamics/MLCPSolvers/btDantzigSolver.h"
 #include "BulletDynamics/MLCPSolvers/btSolveProjectedGaussSeidel.h"
 #include "BulletDynamics/MLCPSolvers/btMLCPSolver.h"
 
-#endif //MLCP_SOLVER
+namespace
+{
+    /**
+     * Registered as Bullet's pre-tick callback so cable forces are
+     * recomputed before every internal substep. The world's user info
+     * is the tgBulletSpringCableSystem.
+     */
+    void applyCableForces(btDynamicsWorld* world, btScalar timeStep)
+    {
+        tgBulletSpringCableSystem* const pCableSystem =
+            static_cast<tgBulletSpringCableSystem*>(world->getWorldUserInfo());
+        pCableSystem->step(timeStep);
+    }
+}
 
 /**
  * Helper class to bundle objects that have the same life cycle, so they can be
- * constructed and destructed together.
+ * constructed and destructed together. The broadphase and solver are
+ * chosen by the tgWorld::Config.
  */
 class IntermediateBuildProducts
 {
     public:
-        IntermediateBuildProducts(double worldSize) : 
-            corner1 (-worldSize,-worldSize, -worldSize),
-            corner2 (worldSize, worldSize, worldSize),
+        IntermediateBuildProducts(const tgWorld::Config& config) : 
+            corner1 (-config.worldSize, -config.worldSize, -config.worldSize),
+            corner2 (config.worldSize, config.worldSize, config.worldSize),
             dispatcher(&collisionConfiguration),
             ghostCallback(),
-#ifndef   MLCP_SOLVER       
-	#if (1) // More acc broadphase - remeber the comma (consider doing ifndef)
-				broadphase(corner1, corner2, 16384)
-	#endif // Broadphase
-#else
-			broadphase(corner1, corner2, 16384),
-			solver(&mlcp)
-#endif //MLCP_SOLVER  
-			
+            broadphase(createBroadphase(config)),
+            mlcp(createMLCP(config)),
+            solver(createSolver(mlcp))
+  {
+	  broadphase->getOverlappingPairCache()->setInternalGhostPairCallback(&ghostCallback);
+  }
+  
+  ~IntermediateBuildProducts()
   {
-	  broadphase.getOverlappingPairCache()->setInternalGhostPairCallback(&ghostCallback);
+      delete solver;
+      delete mlcp;
+      delete broadphase;
   }
+  
   const btVector3 corner1;
   const btVector3 corner2;
   btSoftBodyRigidBodyCollisionConfiguration collisionConfiguration;
   btCollisionDispatcher dispatcher;
   btGhostPairCallback ghostCallback;
-#if (0) // Default broadphase
-        btDbvtBroadphase broadphase;
-#else
-        // More accurate broadphase:
-        btAxisSweep3 broadphase;
-#endif
-
-#ifdef MLCP_SOLVER
-		btDantzigSolver mlcp;
-        //btSolveProjectedGaussSeidel mlcp;
-		btMLCPSolver solver;
-#else
-		btSequentialImpulseConstraintSolver solver;
-#endif
-	
+  btBroadphaseInterface * const broadphase;
+  /** NULL unless using an MLCP solver */
+  btMLCPSolverInterface * const mlcp;
+  btConstraintSolver * const solver;
+  
+  private:
+  
+    btBroadphaseInterface* createBroadphase(const tgWorld::Config& config) const
+    {
+        switch (config.broadphaseType)
+        {
+            case tgWorld::Config::DBVT:
+                return new btDbvtBroadphase();
+            case tgWorld::Config::AXIS_SWEEP_3:
+            default:
+                // More accurate broadphase, handles are 16 bit
+                if (config.broadphaseCapacity < 32767)
+                {
+                    return new btAxisSweep3(corner1, corner2,
+                                (unsigned short) config.broadphaseCapacity);
+                }
+                else
+                {
+                    return new bt32BitAxisSweep3(corner1, corner2,
+                                config.broadphaseCapacity);
+                }
+        }
+    }
+    
+    btMLCPSolverInterface* createMLCP(const tgWorld::Config& config) const
+    {
+        switch (config.solverType)
+        {
+            case tgWorld::Config::SEQUENTIAL_IMPULSE:
+                return NULL;
+            case tgWorld::Config::PGS_MLCP:
+                return new btSolveProjectedGaussSeidel();
+            case tgWorld::Config::DANTZIG_MLCP:
+            default:
+                return new btDantzigSolver();
+        }
+    }
+    
+    btConstraintSolver* createSolver(btMLCPSolverInterface* pMLCP) const
+    {
+        if (pMLCP)
+        {
+            return new btMLCPSolver(pMLCP);
+        }
+        else
+        {
+            return new btSequentialImpulseConstraintSolver();
+        }
+    }
 };
 
 tgWorldBulletPhysicsImpl::tgWorldBulletPhysicsImpl(const tgWorld::Config& config,
         tgBulletGround* ground) :
     tgWorldImpl(config, ground),
-    m_pIntermediateBuildProducts(new IntermediateBuildProducts(config.worldSize)),
-    m_pDynamicsWorld(createDynamicsWorld())
+    m_pIntermediateBuildProducts(new IntermediateBuildProducts(config)),
+    m_pDynamicsWorld(createDynamicsWorld()),
+    m_pCableSystem(new tgBulletSpringCableSystem()),
+    m_pAnchorPool(new tgBulletSpringCableAnchorPool()),
+    m_substeps(config.substeps),
+    m_hasSnapshot(false)
 {
 
     // Gravitational acceleration is down on the Y axis
     const btVector3 gravityVector(0, -config.gravity, 0);
     m_pDynamicsWorld->setGravity(gravityVector);
+    
+    m_pDynamicsWorld->getSolverInfo().m_numIterations = config.solverIterations;
+    
+    // Cable forces are applied before each substep
+    m_pDynamicsWorld->setInternalTickCallback(applyCableForces,
+                                              m_pCableSystem, true);
 	
 	if (!tgCast::cast<tgBulletGround, tgEmptyGround>(ground) && ground != NULL)
 	{
@@ -136,10 +202,6 @@ tgWorldBulletPhysicsImpl::tgWorldBulletPhysicsImpl(const tgWorld::Config& config
         m_pDynamicsWorld->getSolverInfo().m_splitImpulse = true;
         m_pDynamicsWorld->getSolverInfo().m_splitImpulsePenetrationThreshold = -0.02;
         
-        // Default is 10 - increases runtime but decreases odds of penetration
-        // Makes tetraspine sine waves more accurate and static test less accurate
-        m_pDynamicsWorld->getSolverInfo().m_numIterations = 20;
-        
         // Ground contact params:
         m_pDynamicsWorld->getSolverInfo().m_erp = 0.8;
         
@@ -153,6 +215,13 @@ tgWorldBulletPhysicsImpl::tgWorldBulletPhysicsImpl(const tgWorld::Config& config
 
 tgWorldBulletPhysicsImpl::~tgWorldBulletPhysicsImpl()
 {
+    // Any cables still attached keep their state and go back to
+    // computing their own forces
+    delete m_pCableSystem;
+    
+    // The contact cables, and so their anchors, are gone by now
+    delete m_pAnchorPool;
+    
     // Delete all the collision objects. The dynamics world must exist.
     // Delete in reverse order of creation.
     const size_t nco = m_pDynamicsWorld->getNumCollisionObjects();
@@ -197,8 +266,8 @@ btDynamicsWorld* tgWorldBulletPhysicsImpl::createDynamicsWorld() const
    
   btSoftRigidDynamicsWorld* const result =
     new btSoftRigidDynamicsWorld(&m_pIntermediateBuildProducts->dispatcher,
-                 &m_pIntermediateBuildProducts->broadphase,
-                 &m_pIntermediateBuildProducts->solver, 
+                 m_pIntermediateBuildProducts->broadphase,
+                 m_pIntermediateBuildProducts->solver, 
                  &m_pIntermediateBuildProducts->collisionConfiguration);
 #ifdef MLCPSOLVER	
 		result ->getSolverInfo().m_minimumSolverBatchSize = 1;//for direct solver it is better to have a small A matrix
@@ -211,15 +280,111 @@ void tgWorldBulletPhysicsImpl::step(double dt)
     // Precondition
     assert(dt > 0.0);
 
+    // Cable forces are applied as impulses before each substep by
+    // applyCableForces, as the per cable step() used to before each step
     const btScalar timeStep = dt;
-    const int maxSubSteps = 1;
-    const btScalar fixedTimeStep = dt;
+    const int maxSubSteps = m_substeps;
+    const btScalar fixedTimeStep = dt / m_substeps;
     m_pDynamicsWorld->stepSimulation(timeStep, maxSubSteps, fixedTimeStep);
 
     // Postcondition
     assert(invariant());
 }
 
+void tgWorldBulletPhysicsImpl::snapshot()
+{
+    const int n = m_pDynamicsWorld->getNumCollisionObjects();
+    btCollisionObjectArray& oa = m_pDynamicsWorld->getCollisionObjectArray();
+    
+    m_snapshot.resize(n);
+    for (int i = 0; i < n; i++)
+    {
+        const btCollisionObject* const pObject = oa[i];
+        BodyState& state = m_snapshot[i];
+        
+        state.transform = pObject->getWorldTransform();
+        state.activationState = pObject->getActivationState();
+        state.deactivationTime = pObject->getDeactivationTime();
+        
+        const btRigidBody* const pRigidBody = btRigidBody::upcast(pObject);
+        if (pRigidBody)
+        {
+            state.linearVelocity = pRigidBody->getLinearVelocity();
+            state.angularVelocity = pRigidBody->getAngularVelocity();
+        }
+        else
+        {
+            state.linearVelocity.setZero();
+            state.angularVelocity.setZero();
+        }
+    }
+    
+    m_pCableSystem->snapshot();
+    m_hasSnapshot = true;
+}
+
+void tgWorldBulletPhysicsImpl::restore()
+{
+#ifndef BT_NO_PROFILE 
+    BT_PROFILE("tgWorldBulletPhysicsImpl::restore");
+#endif //BT_NO_PROFILE
+    const int n = m_pDynamicsWorld->getNumCollisionObjects();
+    if (!m_hasSnapshot)
+    {
+        throw std::runtime_error("No world snapshot to restore.");
+    }
+    else if (n != m_snapshot.size())
+    {
+        throw std::runtime_error("Collision objects changed since the world snapshot.");
+    }
+    
+    btCollisionObjectArray& oa = m_pDynamicsWorld->getCollisionObjectArray();
+    btOverlappingPairCache* const pPairCache =
+        m_pDynamicsWorld->getBroadphase()->getOverlappingPairCache();
+    btDispatcher* const pDispatcher = m_pDynamicsWorld->getDispatcher();
+    
+    for (int i = 0; i < n; i++)
+    {
+        btCollisionObject* const pObject = oa[i];
+        const BodyState& state = m_snapshot[i];
+        
+        pObject->setWorldTransform(state.transform);
+        pObject->setInterpolationWorldTransform(state.transform);
+        pObject->forceActivationState(state.activationState);
+        pObject->setDeactivationTime(state.deactivationTime);
+        
+        btRigidBody* const pRigidBody = btRigidBody::upcast(pObject);
+        if (pRigidBody)
+        {
+            pRigidBody->setLinearVelocity(state.linearVelocity);
+            pRigidBody->setAngularVelocity(state.angularVelocity);
+            pRigidBody->setInterpolationLinearVelocity(state.linearVelocity);
+            pRigidBody->setInterpolationAngularVelocity(state.angularVelocity);
+            pRigidBody->clearForces();
+            // Cable impulses before the next integration need the restored inertia
+            pRigidBody->updateInertiaTensor();
+            if (pRigidBody->getMotionState())
+            {
+                pRigidBody->getMotionState()->setWorldTransform(state.transform);
+            }
+        }
+        
+        // Drop contacts computed for the old configuration
+        if (pObject->getBroadphaseHandle())
+        {
+            pPairCache->cleanProxyFromPairs(pObject->getBroadphaseHandle(),
+                                            pDispatcher);
+        }
+    }
+    
+    m_pDynamicsWorld->updateAabbs();
+    m_pDynamicsWorld->getConstraintSolver()->reset();
+    m_pCableSystem->restore();
+    
+    // Postcondition
+    assert(invariant());
+}
+
 void tgWorldBulletPhysicsImpl::addCollisionShape(btCollisionShape* pShape)
 {
 #ifndef BT_NO_PROFILE 
@@ -262,6 +427,7 @@ void tgWorldBulletPhysicsImpl::deleteCollisionShape(btCollisionShape* pShape)
 
 bool tgWorldBulletPhysicsImpl::invariant() const
 {
-    return (m_pDynamicsWorld != 0);
+    return (m_pDynamicsWorld != 0) && (m_pCableSystem != 0) &&
+            (m_substeps > 0);
 }
 
@@ -31,6 +31,8 @@
 #include "tgWorld.h"
 #include "tgWorldImpl.h"
 #include "LinearMath/btAlignedObjectArray.h"
+#include "LinearMath/btTransform.h"
+#include "LinearMath/btVector3.h"
 
 
 
@@ -44,6 +46,8 @@ class btBroadphaseInterface;
 class btDispatcher;
 class tgBulletGround;
 class tgHillyGround;
+class tgBulletSpringCableSystem;
+class tgBulletSpringCableAnchorPool;
 
 /**
  * Concrete class derived from tgWorldImpl for Bullet Physics
@@ -73,6 +77,20 @@ class tgWorldBulletPhysicsImpl : public tgWorldImpl
    */
   virtual void step(double dt);
 
+  /**
+   * Record the transform, velocities and activation state of every
+   * collision object, and the state of the cable system.
+   */
+  virtual void snapshot();
+
+  /**
+   * Write the recorded state back into the existing Bullet objects,
+   * and clear contact caches so no stale manifolds survive.
+   * @throw std::runtime_error if no snapshot has been taken or the
+   * collision objects changed since
+   */
+  virtual void restore();
+
   /**
    * Return a reference to the dynamics world.
    * @return a reference to the dynamics world
@@ -82,6 +100,26 @@ class tgWorldBulletPhysicsImpl : public tgWorldImpl
     return *m_pDynamicsWorld;
   }
   
+  /**
+   * Return a reference to the batched spring cable system, which
+   * applies its forces at the start of each step.
+   * @return a reference to the cable system
+   */
+  tgBulletSpringCableSystem& cableSystem() const
+  {
+    return *m_pCableSystem;
+  }
+  
+  /**
+   * Return a reference to the pool that contact cables allocate their
+   * anchors from.
+   * @return a reference to the anchor pool
+   */
+  tgBulletSpringCableAnchorPool& anchorPool() const
+  {
+    return *m_pAnchorPool;
+  }
+  
 	/**
 	 * Add a btCollisionShape the a collection for deletion upon
 	 * destruction.
@@ -135,6 +173,21 @@ private:
     /** The Bullet Physics representation of the tgWorld. 
      */
    btDynamicsWorld* m_pDynamicsWorld;
+   
+    /**
+     * Computes the forces of all tgBulletSpringCables registered
+     * with this world in one pass. Owned by this object.
+     */
+    tgBulletSpringCableSystem * const m_pCableSystem;
+    
+    /**
+     * Memory for the anchors of this world's contact cables. Owned by
+     * this object.
+     */
+    tgBulletSpringCableAnchorPool * const m_pAnchorPool;
+    
+    /** Number of Bullet substeps per step, from tgWorld::Config */
+    const int m_substeps;
     
     /* 
      * A btAlignedObjectArray of collision shapes for easy reference. Does not affect
@@ -150,6 +203,25 @@ private:
      * world.
      */
     btAlignedObjectArray<btTypedConstraint*> m_constraints;
+    
+    /** The dynamic state of one collision object */
+    struct BodyState
+    {
+        btTransform transform;
+        btVector3 linearVelocity;
+        btVector3 angularVelocity;
+        int activationState;
+        btScalar deactivationTime;
+    };
+    
+    /**
+     * The state of each collision object, in the order of the
+     * dynamics world's collision object array, recorded by snapshot()
+     */
+    btAlignedObjectArray<BodyState> m_snapshot;
+    
+    /** Whether m_snapshot holds a snapshot */
+    bool m_hasSnapshot;
 };
 
 #endif  // TG_WORLDBULLETPHYSICSIMPL_H
@@ -55,6 +55,18 @@ public:
    * must be positive
    */
   virtual void step(double dt) = 0;
+
+  /**
+   * Record the dynamic state of everything in the world so that
+   * restore() can return to it. Replaces any previous snapshot.
+   */
+  virtual void snapshot() = 0;
+
+  /**
+   * Return to the state recorded by the last call to snapshot()
+   * without creating or destroying any objects.
+   */
+  virtual void restore() = 0;
 };
 
 
@@ -45,7 +45,7 @@
 #include "util/CPGEquationsFB.h"
 #include "examples/learningSpines/tgCPGCableControl.h"
 
-#include "neuralNet/Neural Network v2/neuralNetwork.h"
+#include "learning/MLP/MLPNetwork.h"
 
 #include <json/json.h>
 
@@ -120,7 +120,8 @@ JSONQuadFeedbackControl::JSONQuadFeedbackControl(JSONQuadFeedbackControl::Config
                                                 std::string args,
                                                 std::string resourcePath) :
 JSONCPGControl(config, args, resourcePath),
-m_config(config)
+m_config(config),
+nn(NULL)
 {
     // Path and filename handled by base class
     
@@ -133,6 +134,8 @@ JSONQuadFeedbackControl::~JSONQuadFeedbackControl()
 
 void JSONQuadFeedbackControl::onSetup(BaseSpineModelLearning& subject)
 {
+    applyControlFile();
+
 	// spine, 4 legs, 4 hips/shoulers
 	n_bodyParts = 9;
 
@@ -193,9 +196,7 @@ void JSONQuadFeedbackControl::onSetup(BaseSpineModelLearning& subject)
     
     std::string nnFile = controlFilePath + feedbackParams.get("neuralFilename", "UTF-8").asString();
     
-    nn = new neuralNetwork(m_config.numStates, m_config.numStates*2, m_config.numActions);
-    
-    nn->loadWeights(nnFile.c_str());
+    nn = new MLPNetwork(m_config.numStates, m_config.numStates*2, m_config.numActions, nnFile);
     
     initConditions = subject.getSegmentCOM(m_config.segmentNumber);
     for (int i = 0; i < initConditions.size(); i++)
@@ -337,13 +338,18 @@ void JSONQuadFeedbackControl::onTeardown(BaseSpineModelLearning& subject)
     
     payloadLog << root << std::endl;
     
-    delete m_pCPGSys;
-    m_pCPGSys = NULL;
+    deleteCPGs(subject);
+}
+
+void JSONQuadFeedbackControl::deleteCPGs(BaseSpineModelLearning& subject)
+{
+    JSONCPGControl::deleteCPGs(subject);
     
 	for (size_t b = 0; b < 9; b++)
 	{
 		for(size_t i = 0; i < m_controllers[b].size(); i++)
 		{
+			detachFromMuscles(subject, m_controllers[b][i]);
 			delete m_controllers[b][i];
 		}
     	m_controllers[b].clear();    
@@ -354,6 +360,9 @@ void JSONQuadFeedbackControl::onTeardown(BaseSpineModelLearning& subject)
 		delete m_highControllers[i];
 	}
 	m_highControllers.clear();
+    
+    delete nn;
+    nn = NULL;
 }
 
 void JSONQuadFeedbackControl::setupCPGs(BaseSpineModelLearning& subject, array_2D nodeActions, array_4D edgeActions)
@@ -852,63 +861,46 @@ std::vector<double> JSONQuadFeedbackControl::getFeedback(BaseSpineModelLearning&
     
 	const std::vector <tgSpringCableActuator*> allCables[9] = { spineCables, leftShoulderCables, leftFrontLegCables, rightShoulderCables, rightFrontLegCables, leftHipCables, leftHindLegCables, rightHipCables, rightHindLegCables };
 
-    double *inputs = new double[m_config.numStates];
+    std::vector<tgSpringCableActuator*> cables;
+    for (size_t b = 0; b < 9; b++)
+    {
+        cables.insert(cables.end(), allCables[b].begin(), allCables[b].end());
+    }
     
-	for (size_t b = 0; b < 9; b++)
-	{
-    	std::size_t n = allCables[b].size();
-		for(std::size_t i = 0; i != n; i++)
-		{
-			std::vector< std::vector<double> > actions;
-			
-			const tgSpringCableActuator& cable = *(allCables[b][i]);
-			std::vector<double > state = getCableState(cable);
-			
-			// Rescale to 0 to 1 (consider doing this inside getState
-			for (std::size_t i = 0; i < state.size(); i++)
-			{
-				inputs[i]=state[i] / 2.0 + 0.5;
-			}
-			
-			double *output = nn->feedForwardPattern(inputs);
-			vector<double> tmpAct;
-			for(int j=0;j<m_config.numActions;j++)
-			{
-				tmpAct.push_back(output[j]);
-			}
-			actions.push_back(tmpAct);
-
-			std::vector<double> cableFeedback = transformFeedbackActions(actions);
-			
-			feedback.insert(feedback.end(), cableFeedback.begin(), cableFeedback.end());
-		}
-	}
+    // One row of inputs per cable, so the network runs once per step
+    const std::size_t numStates = m_config.numStates;
+    std::vector<double> inputs(cables.size() * numStates, 0.0);
     
-	// inputting 0 for now
-    std::size_t n = m_highControllers.size();
-	for (size_t i = 0; i != n; i++)
-	{
-		std::vector< std::vector<double> > actions;
-		
-		// Rescale to 0 to 1 (consider doing this inside getState
-		for (std::size_t i = 0; i < m_config.numStates; i++)
-		{
-			inputs[i] = 0;
-		}
-		
-		double *output = nn->feedForwardPattern(inputs);
-		vector<double> tmpAct;
-		for(int j=0;j<m_config.numActions;j++)
-		{
-			tmpAct.push_back(output[j]);
-		}
-		actions.push_back(tmpAct);
-
-		std::vector<double> cableFeedback = transformFeedbackActions(actions);
-		
-		feedback.insert(feedback.end(), cableFeedback.begin(), cableFeedback.end());
-	}
+    std::size_t n = cables.size();
+    for(std::size_t i = 0; i != n; i++)
+    {
+        const tgSpringCableActuator& cable = *(cables[i]);
+        std::vector<double > state = getCableState(cable);
+        
+        // Rescale to 0 to 1 (consider doing this inside getState
+        for (std::size_t j = 0; j < state.size() && j < numStates; j++)
+        {
+            inputs[i * numStates + j] = state[j] / 2.0 + 0.5;
+        }
+    }
+    
+    // inputting 0 for now, one row per higher level controller
+    inputs.resize(inputs.size() + m_highControllers.size() * numStates, 0.0);
+    
+    std::vector<double> outputs;
+    nn->feedForward(inputs, outputs);
+    
+    const std::size_t numActions = m_config.numActions;
+    for(std::size_t i = 0; i != outputs.size() / numActions; i++)
+    {
+        std::vector<double>::const_iterator output = outputs.begin() + i * numActions;
+        std::vector< std::vector<double> > actions(1, std::vector<double>(output, output + numActions));
 
+        std::vector<double> cableFeedback = transformFeedbackActions(actions);
+        
+        feedback.insert(feedback.end(), cableFeedback.begin(), cableFeedback.end());
+    }
+    
     return feedback;
 }
 
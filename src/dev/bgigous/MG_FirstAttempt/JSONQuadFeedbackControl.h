@@ -32,7 +32,7 @@
 #include <json/value.h>
 
 // Forward Declarations
-class neuralNetwork;
+class MLPNetwork;
 class tgSpringCableActuator;
 
 /**
@@ -116,6 +116,10 @@ struct Config : public JSONCPGControl::Config
 protected:
 
     virtual void setupCPGs(BaseSpineModelLearning& subject, array_2D nodeActions, array_4D edgeActions);
+    
+    /** Also deletes the controllers and network made by onSetup */
+    virtual void deleteCPGs(BaseSpineModelLearning& subject);
+
 	virtual void setupHighCPGs(array_2D nodeActions, array_4D highEdgeActions, Json::Value highLowEdgeActions);
 	//virtual void setupHighCouplings(array_4D highEdgeActions);
 	// I'm cheating and just using the Json thing directly. ~B
@@ -141,7 +145,7 @@ protected:
 	std::vector<tgCPGActuatorControl*> m_highControllers;
     
     /// @todo generalize this if we need more than one
-    neuralNetwork* nn;
+    MLPNetwork* nn;
 
 	// How many different body parts we're using in the goat/puppy dealy thing
 	int n_bodyParts;
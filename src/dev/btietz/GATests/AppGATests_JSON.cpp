@@ -30,7 +30,7 @@
 
 #include "helpers/FileHelpers.h"
 
-#include "neuralNet/Neural Network v2/neuralNetwork.h"
+#include "learning/MLP/MLPNetwork.h"
 
 #include <json/json.h>
 
@@ -129,47 +129,27 @@ int main(int argc, char** argv)
     
     std::string nnFile = fullPath + feedbackParams.get("neuralFilename", "UTF-8").asString();
     
-    neuralNetwork* nn = new neuralNetwork(numberOfInputs,numberHidden, numberOfOutputs);
+    MLPNetwork nn(numberOfInputs, numberHidden, numberOfOutputs, nnFile);
     
-    nn->loadWeights(nnFile.c_str());
-    
-    std::vector<double> state;
-    for (int i = 0; i < numberOfInputs; i++)
-    {
-        //state.push_back((rand() / (double)RAND_MAX));
-        state.push_back(1.0);
-    }
     double goal = 1.0 * (double) numberOfOutputs;
 
     
     int steps = 0;
-    double *inputs = new double[numberOfInputs];    
-    for (std::size_t i = 0; i < state.size(); i++)
-    {
-        inputs[i] = state[i];
-    }
+    // Test both directions in one batch
+    std::vector<double> inputs(numberOfInputs, 1.0);
+    inputs.resize(2 * numberOfInputs, -1.0);
+    
+    std::vector<double> outputs;
+    nn.feedForward(inputs, outputs);
+    const double* output = &outputs[0];
+    const double* output2 = output + numberOfOutputs;
     
-    double *output = nn->feedForwardPattern(inputs);
     double score1 = 0.0;
     for(std::size_t i = 0; i < numberOfOutputs; i++)
     {
         score1 +=  output[i];
     }
     
-    // Test other direction
-    state.clear();
-    for (int i = 0; i < numberOfInputs; i++)
-    {
-        //state.push_back((rand() / (double)RAND_MAX));
-        state.push_back(-1.0);
-    }
-
-    for (std::size_t i = 0; i < state.size(); i++)
-    {
-        inputs[i] = state[i];
-    }
-    
-    double *output2 = nn->feedForwardPattern(inputs);
     double score2 = 0.0;
     for(std::size_t i = 0; i < numberOfOutputs; i++)
     {
@@ -163,6 +163,8 @@ JSONCPGControl::~JSONCPGControl()
 
 void JSONCPGControl::onSetup(BaseSpineModelLearning& subject)
 {
+    applyControlFile();
+
     // Maximum number of sub-steps allowed by CPG
 	m_pCPGSys = new CPGEquations(200);
     //Initialize the Learning Adapters
@@ -357,20 +359,64 @@ void JSONCPGControl::onTeardown(BaseSpineModelLearning& subject)
     
     payloadLog << root << std::endl;
     
+    deleteCPGs(subject);
+}
+
+const double JSONCPGControl::getCPGValue(std::size_t i) const
+{
+	// Error handling on input done in CPG_Equations
+	return (*m_pCPGSys)[i];
+}
+
+void JSONCPGControl::setControlFile(const std::string& args)
+{
+    nextControlFilename = controlFilePath + args;
+}
+
+void JSONCPGControl::onRestore(BaseSpineModelLearning& subject)
+{
+    // The muscles persist through a restore, so the old controllers
+    // must come off them before onSetup attaches new ones
+    deleteCPGs(subject);
+    onSetup(subject);
+}
+
+void JSONCPGControl::deleteCPGs(BaseSpineModelLearning& subject)
+{
     delete m_pCPGSys;
     m_pCPGSys = NULL;
     
     for(size_t i = 0; i < m_allControllers.size(); i++)
     {
-		delete m_allControllers[i];
-	}
-	m_allControllers.clear();
+        detachFromMuscles(subject, m_allControllers[i]);
+        delete m_allControllers[i];
+    }
+    m_allControllers.clear();
 }
 
-const double JSONCPGControl::getCPGValue(std::size_t i) const
+void JSONCPGControl::detachFromMuscles(BaseSpineModelLearning& subject,
+                                       tgObserver<tgSpringCableActuator>* pController)
 {
-	// Error handling on input done in CPG_Equations
-	return (*m_pCPGSys)[i];
+    // Subclasses attach to muscle lists of their own, so check them all
+    std::vector<tgModel*> descendants = subject.getDescendants();
+    for (std::size_t i = 0; i < descendants.size(); i++)
+    {
+        tgSpringCableActuator* const pMuscle =
+            dynamic_cast<tgSpringCableActuator*>(descendants[i]);
+        if (pMuscle)
+        {
+            pMuscle->detach(pController);
+        }
+    }
+}
+
+void JSONCPGControl::applyControlFile()
+{
+    if (!nextControlFilename.empty())
+    {
+        controlFilename = nextControlFilename;
+        nextControlFilename.clear();
+    }
 }
 
 double JSONCPGControl::getScore() const
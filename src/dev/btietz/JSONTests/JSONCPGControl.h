@@ -42,6 +42,7 @@ class tgCPGActuatorControl;
 class CPGEquations;
 class tgCPGLogger;
 class BaseSpineModelLearning;
+class tgSpringCableActuator;
 class BaseSpineCPGControl;
 
 typedef boost::multi_array<double, 2> array_2D;
@@ -120,10 +121,41 @@ struct Config
     virtual void onSetup(BaseSpineModelLearning& subject);
     
     virtual void onTeardown(BaseSpineModelLearning& subject);
+    
+    /**
+     * Rebuild the CPGs as onSetup does, against the restored model.
+     * The episode that was running is not scored.
+     */
+    virtual void onRestore(BaseSpineModelLearning& subject);
 
 	const double getCPGValue(std::size_t i) const;
 	
 	double getScore() const;
+
+    /** The scores computed at the last teardown */
+    const std::vector<double>& getScores() const
+    {
+        return scores;
+    }
+
+    /**
+     * Read parameters from a different file from the next setup on.
+     * Scores are still written to the file read at the last setup, so
+     * this can be called before the reset that ends an episode.
+     * @param[in] args the file name, relative to the resource path as
+     * for the constructor
+     */
+    void setControlFile(const std::string& args);
+
+    /**
+     * Score the running episode as failed at the next teardown, as when
+     * the height leaves its bounds. For episodes ended from outside,
+     * such as by a tgEpisodeMonitor.
+     */
+    void markFailed()
+    {
+        bogus = true;
+    }
 	
 protected:
     /**
@@ -136,6 +168,26 @@ protected:
     
     virtual void setupCPGs(BaseSpineModelLearning& subject, array_2D nodeActions, array_4D edgeActions);
 
+    /**
+     * Switch to the file given to setControlFile, if any. Call at the
+     * start of onSetup, before controlFilename is read.
+     */
+    void applyControlFile();
+    
+    /**
+     * Detach the cable controllers from the muscles and delete them and
+     * the CPG system, undoing onSetup. Subclasses that allocate more in
+     * onSetup should delete it here too.
+     */
+    virtual void deleteCPGs(BaseSpineModelLearning& subject);
+    
+    /**
+     * Detach a controller from whichever actuators of subject it is
+     * attached to, so it can be deleted while they live on
+     */
+    void detachFromMuscles(BaseSpineModelLearning& subject,
+                           tgObserver<tgSpringCableActuator>* pController);
+
     CPGEquations* m_pCPGSys;
     
     std::vector<tgCPGActuatorControl*> m_allControllers;
@@ -156,6 +208,9 @@ protected:
     
     std::string controlFilename;
     std::string controlFilePath;
+    
+    /** Set by setControlFile, used from the next setup on */
+    std::string nextControlFilename;
 };
 
 #endif // BASE_SPINE_CPG_CONTROL_H
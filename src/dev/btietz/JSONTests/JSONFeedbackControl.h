@@ -32,7 +32,7 @@
 #include <json/value.h>
 
 // Forward Declarations
-class neuralNetwork;
+class MLPNetwork;
 class tgSpringCableActuator;
 
 /**
@@ -107,6 +107,9 @@ protected:
 
     virtual void setupCPGs(BaseSpineModelLearning& subject, array_2D nodeActions, array_4D edgeActions);
     
+    /** Also deletes the network made by onSetup */
+    virtual void deleteCPGs(BaseSpineModelLearning& subject);
+    
     virtual array_2D scaleNodeActions (Json::Value actions);
     
     std::vector<double> getFeedback(BaseSpineModelLearning& subject);
@@ -118,7 +121,7 @@ protected:
     JSONFeedbackControl::Config m_config;
     
     /// @todo generalize this if we need more than one
-    neuralNetwork* nn;
+    MLPNetwork* nn;
     
 };
 
@@ -46,7 +46,7 @@
 #include "util/CPGEquationsFB.h"
 #include "examples/learningSpines/tgCPGCableControl.h"
 
-#include "neuralNet/Neural Network v2/neuralNetwork.h"
+#include "learning/MLP/MLPNetwork.h"
 
 #include <json/json.h>
 
@@ -123,9 +123,7 @@ void OctahedralTensionControl::onSetup(BaseSpineModelLearning& subject)
     
     std::string nnFile_goal = controlFilePath + goalParams.get("neuralFilename", "UTF-8").asString();
     
-    nn_goal = new neuralNetwork(m_config.goalStates, m_config.goalHidden, m_config.goalActions);
-    
-    nn_goal->loadWeights(nnFile_goal.c_str());
+    nn_goal = new MLPNetwork(m_config.goalStates, m_config.goalHidden, m_config.goalActions, nnFile_goal);
     
     const OctahedralComplex* ocSubject = tgCast::cast<BaseSpineModelLearning, OctahedralComplex>(subject);
     setupSaddleControllers(ocSubject);
@@ -268,22 +266,19 @@ void OctahedralTensionControl::onTeardown(BaseSpineModelLearning& subject)
     
     payloadLog << root << std::endl;
     
-    delete m_pCPGSys;
-    m_pCPGSys = NULL;
-    
-    for(size_t i = 0; i < m_allControllers.size(); i++)
-    {
-        delete m_allControllers[i];
-    }
-    m_allControllers.clear();
+    deleteCPGs(subject);
+}
+
+void OctahedralTensionControl::deleteCPGs(BaseSpineModelLearning& subject)
+{
+    JSONGoalTension::deleteCPGs(subject);
     
-    for(size_t i = 0; i < m_allControllers.size(); i++)
+    for(size_t i = 0; i < m_saddleControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_saddleControllers[i]);
         delete m_saddleControllers[i];
     }
     m_saddleControllers.clear(); 
-    
-    delete nn_goal;
 }
 
 void OctahedralTensionControl::setupSaddleControllers(const OctahedralComplex* subject)
@@ -344,7 +339,7 @@ std::vector<double> OctahedralTensionControl::getGoalFeedback(const BaseSpineMod
     state.push_back(currentHeading.getX());
     state.push_back(currentHeading.getZ());
     
-    double *inputs = new double[m_config.goalStates];
+    std::vector<double> inputs(m_config.goalStates, 0.0);
     for (std::size_t i = 0; i < state.size(); i++)
     {
         assert(state[i] >= -1.0 && state[i] <= 1.0);
@@ -352,7 +347,8 @@ std::vector<double> OctahedralTensionControl::getGoalFeedback(const BaseSpineMod
         inputs[i]=state[i];
     }
         
-    double *output = nn_goal->feedForwardPattern(inputs);
+    std::vector<double> output;
+    nn_goal->feedForward(inputs, output);
     
     vector<double> actions;
     
@@ -63,6 +63,9 @@ public:
 	
 protected:
  
+    /** Also deletes the saddle controllers */
+    virtual void deleteCPGs(BaseSpineModelLearning& subject);
+    
     virtual void setupSaddleControllers(const OctahedralComplex* subject);
  
     virtual std::vector<double> getGoalFeedback(const BaseSpineModelGoal* subject);
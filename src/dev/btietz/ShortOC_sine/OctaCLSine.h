@@ -48,14 +48,17 @@ public:
     
     ~OctaCLSine() {}
 	
-	virtual void onSetup(BaseSpineModelLearning& subject);
-	
 	virtual void onStep(BaseSpineModelLearning& subject, double dt);
     
     virtual void onTeardown(BaseSpineModelLearning& subject);
 
 protected:
 	
+    virtual void setupEpisode(BaseSpineModelLearning& subject);
+    
+    /** Deletes the sine controllers instead of the CPGs */
+    virtual void deleteCPGs(BaseSpineModelLearning& subject);
+    
 	virtual void setupWaves(BaseSpineModelLearning& subject, array_2D nodeActions, array_2D edgeActions);
 
     /**
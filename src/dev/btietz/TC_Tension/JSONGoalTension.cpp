@@ -44,7 +44,7 @@
 #include "util/CPGEquationsFB.h"
 #include "examples/learningSpines/tgCPGCableControl.h"
 
-#include "neuralNet/Neural Network v2/neuralNetwork.h"
+#include "learning/MLP/MLPNetwork.h"
 
 #include <json/json.h>
 
@@ -124,9 +124,7 @@ void JSONGoalTension::onSetup(BaseSpineModelLearning& subject)
     
     std::string nnFile_goal = controlFilePath + goalParams.get("neuralFilename", "UTF-8").asString();
     
-    nn_goal = new neuralNetwork(m_config.goalStates, m_config.goalHidden, m_config.goalActions);
-    
-    nn_goal->loadWeights(nnFile_goal.c_str());
+    nn_goal = new MLPNetwork(m_config.goalStates, m_config.goalHidden, m_config.goalActions, nnFile_goal);
     
     initConditions = subject.getSegmentCOM(m_config.segmentNumber);
 #ifdef LOGGING // Conditional compile for data logging    
@@ -267,16 +265,7 @@ void JSONGoalTension::onTeardown(BaseSpineModelLearning& subject)
     
     payloadLog << root << std::endl;
     
-    delete m_pCPGSys;
-    m_pCPGSys = NULL;
-    
-    for(size_t i = 0; i < m_allControllers.size(); i++)
-    {
-        delete m_allControllers[i];
-    }
-    m_allControllers.clear();
-    
-    delete nn_goal;
+    deleteCPGs(subject);
 }
 
 array_2D JSONGoalTension::scaleNodeActions (Json::Value actions)
@@ -352,7 +341,7 @@ std::vector<double> JSONGoalTension::getGoalFeedback(const BaseSpineModelGoal* s
     state.push_back(currentHeading.getX());
     state.push_back(currentHeading.getZ());
     
-    double *inputs = new double[m_config.goalStates];
+    std::vector<double> inputs(m_config.goalStates, 0.0);
     for (std::size_t i = 0; i < state.size(); i++)
     {
         assert(state[i] >= -1.0 && state[i] <= 1.0);
@@ -360,7 +349,8 @@ std::vector<double> JSONGoalTension::getGoalFeedback(const BaseSpineModelGoal* s
         inputs[i]=state[i];
     }
         
-    double *output = nn_goal->feedForwardPattern(inputs);
+    std::vector<double> output;
+    nn_goal->feedForward(inputs, output);
     
     vector<double> actions;
     
@@ -44,7 +44,7 @@
 #include "util/CPGEquationsFB.h"
 #include "examples/learningSpines/tgCPGCableControl.h"
 
-#include "neuralNet/Neural Network v2/neuralNetwork.h"
+#include "learning/MLP/MLPNetwork.h"
 
 #include <json/json.h>
 
@@ -116,6 +116,8 @@ JSONGoalControl::~JSONGoalControl()
 
 void JSONGoalControl::onSetup(BaseSpineModelLearning& subject)
 {
+    applyControlFile();
+
 	m_pCPGSys = new CPGEquationsFB(200);
 
     Json::Value root; // will contains the root value after parsing.
@@ -153,9 +155,7 @@ void JSONGoalControl::onSetup(BaseSpineModelLearning& subject)
     
     std::string nnFile = controlFilePath + feedbackParams.get("neuralFilename", "UTF-8").asString();
     
-    nn = new neuralNetwork(m_config.numStates, m_config.numHidden, m_config.numActions);
-    
-    nn->loadWeights(nnFile.c_str());
+    nn = new MLPNetwork(m_config.numStates, m_config.numHidden, m_config.numActions, nnFile);
     
     Json::Value goalParams = root.get("goalVals", "UTF-8");
     goalParams = goalParams.get("params", "UTF-8");
@@ -167,9 +167,7 @@ void JSONGoalControl::onSetup(BaseSpineModelLearning& subject)
     
     std::string nnFile_goal = controlFilePath + goalParams.get("neuralFilename", "UTF-8").asString();
     
-    nn_goal = new neuralNetwork(m_config.goalStates, m_config.goalHidden, m_config.goalActions);
-    
-    nn_goal->loadWeights(nnFile_goal.c_str());
+    nn_goal = new MLPNetwork(m_config.goalStates, m_config.goalHidden, m_config.goalActions, nnFile_goal);
     
     initConditions = subject.getSegmentCOM(m_config.segmentNumber);
 #ifdef LOGGING // Conditional compile for data logging    
@@ -320,17 +318,17 @@ void JSONGoalControl::onTeardown(BaseSpineModelLearning& subject)
     
     payloadLog << root << std::endl;
     
-    delete m_pCPGSys;
-    m_pCPGSys = NULL;
-    
-    for(size_t i = 0; i < m_allControllers.size(); i++)
-    {
-        delete m_allControllers[i];
-    }
-    m_allControllers.clear();
+    deleteCPGs(subject);
+}
+
+void JSONGoalControl::deleteCPGs(BaseSpineModelLearning& subject)
+{
+    JSONCPGControl::deleteCPGs(subject);
     
     delete nn;
+    nn = NULL;
     delete nn_goal;
+    nn_goal = NULL;
 }
 
 void JSONGoalControl::setupCPGs(BaseSpineModelLearning& subject, array_2D nodeActions, array_4D edgeActions)
@@ -444,7 +442,7 @@ std::vector<double> JSONGoalControl::getGoalFeedback(const BaseSpineModelGoal* s
     state.push_back(currentHeading.getX());
     state.push_back(currentHeading.getZ());
     
-    double *inputs = new double[m_config.goalStates];
+    std::vector<double> inputs(m_config.goalStates, 0.0);
     for (std::size_t i = 0; i < state.size(); i++)
     {
         assert(state[i] >= -1.0 && state[i] <= 1.0);
@@ -452,7 +450,8 @@ std::vector<double> JSONGoalControl::getGoalFeedback(const BaseSpineModelGoal* s
         inputs[i]=state[i];
     }
         
-    double *output = nn_goal->feedForwardPattern(inputs);
+    std::vector<double> output;
+    nn_goal->feedForward(inputs, output);
     
     vector<double> actions;
     
@@ -486,7 +485,9 @@ std::vector<double> JSONGoalControl::getFeedback(BaseSpineModelLearning& subject
     
     const std::vector<tgSpringCableActuator*>& allCables = subject.getAllMuscles();
     
-    double *inputs = new double[m_config.numStates];
+    // One row of inputs per cable, so the network runs once per step
+    const std::size_t numStates = m_config.numStates;
+    std::vector<double> inputs(allCables.size() * numStates, 0.0);
     
     std::size_t n = allCables.size();
     for(std::size_t i = 0; i != n; i++)
@@ -494,18 +495,20 @@ std::vector<double> JSONGoalControl::getFeedback(BaseSpineModelLearning& subject
         const tgSpringCableActuator& cable = *(allCables[i]);
         std::vector<double > state = getCableState(cable);
         
-        // Rescale to 0 to 1 (consider doing this inside getState
-        for (std::size_t i = 0; i < state.size(); i++)
+        for (std::size_t j = 0; j < state.size() && j < numStates; j++)
         {
-            inputs[i]=state[i];
-        }
-        
-        double *output = nn->feedForwardPattern(inputs);
-        vector<double> actions;
-        for(int j=0;j<m_config.numActions;j++)
-        {
-            actions.push_back(output[j]);
+            inputs[i * numStates + j] = state[j];
         }
+    }
+    
+    std::vector<double> outputs;
+    nn->feedForward(inputs, outputs);
+    
+    const std::size_t numActions = m_config.numActions;
+    for(std::size_t i = 0; i != n; i++)
+    {
+        std::vector<double>::const_iterator output = outputs.begin() + i * numActions;
+        vector<double> actions(output, output + numActions);
 
         transformFeedbackActions(actions);
         
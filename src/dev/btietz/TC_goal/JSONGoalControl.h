@@ -32,7 +32,7 @@
 #include <json/value.h>
 
 // Forward Declarations
-class neuralNetwork;
+class MLPNetwork;
 class tgSpringCableActuator;
 class BaseSpineModelGoal;
 class tgSCASineControl;
@@ -118,6 +118,9 @@ protected:
 
     virtual void setupCPGs(BaseSpineModelLearning& subject, array_2D nodeActions, array_4D edgeActions);
     
+    /** Also deletes the networks made by onSetup */
+    virtual void deleteCPGs(BaseSpineModelLearning& subject);
+    
     virtual array_2D scaleNodeActions (Json::Value actions);
 
     std::vector<double> getGoalFeedback(const BaseSpineModelGoal* subject);
@@ -134,8 +137,8 @@ protected:
     JSONGoalControl::Config m_config;
     
     /// @todo generalize this if we need more than one
-    neuralNetwork* nn;
-    neuralNetwork* nn_goal;
+    MLPNetwork* nn;
+    MLPNetwork* nn_goal;
     
     
 };
@@ -132,22 +132,20 @@ goalLearning(false)
     
 }
 
-void SpineGoalControl::onSetup(BaseSpineModelLearning& subject)
+void SpineGoalControl::initializeAdapters()
 {
-	m_pCPGSys = new CPGEquationsFB(200);
-    //Initialize the Learning Adapters
-    nodeAdapter.initialize(&nodeEvolution,
-                            nodeLearning,
-                            nodeConfigData);
-    edgeAdapter.initialize(&edgeEvolution,
-                            edgeLearning,
-                            edgeConfigData);
+    BaseSpineCPGControl::initializeAdapters();
     feedbackAdapter.initialize(&feedbackEvolution,
                                 feedbackLearning,
                                 feedbackConfigData);
     goalAdapter.initialize(&goalEvolution,
                             goalLearning,
                             goalConfigData);
+}
+
+void SpineGoalControl::setupEpisode(BaseSpineModelLearning& subject)
+{
+	m_pCPGSys = new CPGEquationsFB(200);
     /* Empty vector signifying no state information
      * All parameters are stateless parameters, so we can get away with
      * only doing this once
@@ -273,14 +271,7 @@ void SpineGoalControl::onTeardown(BaseSpineModelLearning& subject)
     feedbackAdapter.endEpisode(scores);
     goalAdapter.endEpisode(scores);
     
-    delete m_pCPGSys;
-    m_pCPGSys = NULL;
-    
-    for(size_t i = 0; i < m_allControllers.size(); i++)
-    {
-        delete m_allControllers[i];
-    }
-    m_allControllers.clear();    
+    deleteCPGs(subject);
 }
 
 void SpineGoalControl::setupCPGs(BaseSpineModelLearning& subject, array_2D nodeActions, array_4D edgeActions)
@@ -103,14 +103,17 @@ struct Config : public BaseSpineCPGControl::Config
     
     virtual ~SpineGoalControl() {}
     
-    virtual void onSetup(BaseSpineModelLearning& subject);
-    
     virtual void onStep(BaseSpineModelLearning& subject, double dt);
     
     virtual void onTeardown(BaseSpineModelLearning& subject);
 	
 protected:
 
+    /** Also initializes the adapters of this class */
+    virtual void initializeAdapters();
+    
+    virtual void setupEpisode(BaseSpineModelLearning& subject);
+    
     virtual void setupCPGs(BaseSpineModelLearning& subject, array_2D nodeActions, array_4D edgeActions);
     
     virtual array_2D scaleNodeActions (std::vector< std::vector <double> > actions);
@@ -44,7 +44,7 @@
 #include "util/CPGEquationsFB.h"
 #include "examples/learningSpines/tgCPGCableControl.h"
 
-#include "neuralNet/Neural Network v2/neuralNetwork.h"
+#include "learning/MLP/MLPNetwork.h"
 
 #include <json/json.h>
 
@@ -114,9 +114,7 @@ void JSONGoalTensionNNW::onSetup(BaseSpineModelLearning& subject)
     
     std::string nnFile = controlFilePath + feedbackParams.get("neuralFilename", "UTF-8").asString();
     
-    nn = new neuralNetwork(m_config.numStates, m_config.numHidden, m_config.numActions);
-    
-    nn->loadWeights(nnFile.c_str());
+    nn = new MLPNetwork(m_config.numStates, m_config.numHidden, m_config.numActions, nnFile);
     
     
     Json::Value goalParams = root.get("goalVals", "UTF-8");
@@ -129,9 +127,7 @@ void JSONGoalTensionNNW::onSetup(BaseSpineModelLearning& subject)
     
     std::string nnFile_goal = controlFilePath + goalParams.get("neuralFilename", "UTF-8").asString();
     
-    nn_goal = new neuralNetwork(m_config.goalStates, m_config.goalHidden, m_config.goalActions);
-    
-    nn_goal->loadWeights(nnFile_goal.c_str());
+    nn_goal = new MLPNetwork(m_config.goalStates, m_config.goalHidden, m_config.goalActions, nnFile_goal);
     
     initConditions = subject.getSegmentCOM(m_config.segmentNumber);
 #ifdef LOGGING // Conditional compile for data logging    
@@ -307,16 +303,7 @@ void JSONGoalTensionNNW::onTeardown(BaseSpineModelLearning& subject)
     
     payloadLog << root << std::endl;
     
-    delete m_pCPGSys;
-    m_pCPGSys = NULL;
-    
-    for(size_t i = 0; i < m_allControllers.size(); i++)
-    {
-        delete m_allControllers[i];
-    }
-    m_allControllers.clear();
-    
-    delete nn_goal;
+    deleteCPGs(subject);
 }
 
 std::vector<double> JSONGoalTensionNNW::getGoalFeedback(const BaseSpineModelGoal* subject)
@@ -346,7 +333,7 @@ std::vector<double> JSONGoalTensionNNW::getGoalFeedback(const BaseSpineModelGoal
     state.push_back(currentHeading.getX());
     state.push_back(currentHeading.getZ());
     
-    double *inputs = new double[m_config.goalStates];
+    std::vector<double> inputs(m_config.goalStates, 0.0);
     for (std::size_t i = 0; i < state.size(); i++)
     {
         assert(state[i] >= -1.0 && state[i] <= 1.0);
@@ -354,7 +341,8 @@ std::vector<double> JSONGoalTensionNNW::getGoalFeedback(const BaseSpineModelGoal
         inputs[i]=state[i];
     }
         
-    double *output = nn_goal->feedForwardPattern(inputs);
+    std::vector<double> output;
+    nn_goal->feedForward(inputs, output);
     
     vector<double> actions;
     
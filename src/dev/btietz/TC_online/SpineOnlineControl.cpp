@@ -104,7 +104,7 @@ m_feedbackControlTime(0.0)
 {
 }
 
-void SpineOnlineControl::onSetup(BaseSpineModelLearning& subject)
+void SpineOnlineControl::setupEpisode(BaseSpineModelLearning& subject)
 {
     m_feedbackControlTime = 0.0;
     
@@ -113,7 +113,7 @@ void SpineOnlineControl::onSetup(BaseSpineModelLearning& subject)
     m_lastGoalDist = getGoalDist(goalSubject);
     m_controllerStartDist = m_lastGoalDist;
     
-    SpineGoalControl::onSetup(subject);
+    SpineGoalControl::setupEpisode(subject);
 }
 
 void SpineOnlineControl::onStep(BaseSpineModelLearning& subject, double dt)
@@ -239,14 +239,7 @@ void SpineOnlineControl::onTeardown(BaseSpineModelLearning& subject)
     tempScores.push_back(0.0);
     goalAdapter.endEpisode(tempScores);
     
-    delete m_pCPGSys;
-    m_pCPGSys = NULL;
-    
-    for(size_t i = 0; i < m_allControllers.size(); i++)
-    {
-        delete m_allControllers[i];
-    }
-    m_allControllers.clear();    
+    deleteCPGs(subject);
 }
 
 double SpineOnlineControl::getGoalDist(const BaseSpineModelGoal* subject) const
@@ -99,14 +99,14 @@ struct Config : public SpineGoalControl::Config
     
     virtual ~SpineOnlineControl() {}
     
-    virtual void onSetup(BaseSpineModelLearning& subject);
-    
     virtual void onStep(BaseSpineModelLearning& subject, double dt);
     
     virtual void onTeardown(BaseSpineModelLearning& subject);
 
 protected:
     
+    virtual void setupEpisode(BaseSpineModelLearning& subject);
+    
     double getGoalDist(const BaseSpineModelGoal* subject) const;
     
     SpineOnlineControl::Config m_config;
@@ -46,7 +46,7 @@
 #include "util/CPGEquationsFB.h"
 #include "examples/learningSpines/tgCPGCableControl.h"
 
-#include "neuralNet/Neural Network v2/neuralNetwork.h"
+#include "learning/MLP/MLPNetwork.h"
 
 #include <json/json.h>
 
@@ -115,9 +115,7 @@ void OctahedralGoalControl::onSetup(BaseSpineModelLearning& subject)
     
     std::string nnFile = controlFilePath + feedbackParams.get("neuralFilename", "UTF-8").asString();
     
-    nn = new neuralNetwork(m_config.numStates, m_config.numHidden, m_config.numActions);
-    
-    nn->loadWeights(nnFile.c_str());
+    nn = new MLPNetwork(m_config.numStates, m_config.numHidden, m_config.numActions, nnFile);
     
     const OctahedralComplex* ocSubject = tgCast::cast<BaseSpineModelLearning, OctahedralComplex>(subject);
     setupSaddleControllers(ocSubject);
@@ -264,17 +262,16 @@ void OctahedralGoalControl::onTeardown(BaseSpineModelLearning& subject)
     
     payloadLog << root << std::endl;
     
-    delete m_pCPGSys;
-    m_pCPGSys = NULL;
-    
-    for(size_t i = 0; i < m_allControllers.size(); i++)
-    {
-        delete m_allControllers[i];
-    }
-    m_allControllers.clear();
+    deleteCPGs(subject);
+}
+
+void OctahedralGoalControl::deleteCPGs(BaseSpineModelLearning& subject)
+{
+    JSONGoalControl::deleteCPGs(subject);
     
-    for(size_t i = 0; i < m_allControllers.size(); i++)
+    for(size_t i = 0; i < m_saddleControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_saddleControllers[i]);
         delete m_saddleControllers[i];
     }
     m_saddleControllers.clear(); 
@@ -331,7 +328,7 @@ void OctahedralGoalControl::setGoalTensions(const BaseSpineModelGoal* subject)
     assert(state[0] >= -1.0 && state[0] <= 1.0);
     assert(state[1] >= -1.0 && state[1] <= 1.0);
     
-    double *inputs = new double[m_config.numStates];
+    std::vector<double> inputs(m_config.numStates, 0.0);
     
     // Rescale to 0 to 1 (consider doing this inside getState
     for (std::size_t i = 0; i < state.size(); i++)
@@ -341,7 +338,8 @@ void OctahedralGoalControl::setGoalTensions(const BaseSpineModelGoal* subject)
     
     const int nSeg = subject->getSegments() - 1;
     
-    double *output = nn->feedForwardPattern(inputs);
+    std::vector<double> output;
+    nn->feedForward(inputs, output);
     
     vector<double> actions;
     for(int j=0;j<m_config.numActions;j++)
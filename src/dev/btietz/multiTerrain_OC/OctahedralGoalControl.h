@@ -32,7 +32,7 @@
 #include <json/value.h>
 
 // Forward Declarations
-class neuralNetwork;
+class MLPNetwork;
 class tgSpringCableActuator;
 class BaseSpineModelGoal;
 class tgSCASineControl;
@@ -64,6 +64,9 @@ public:
 	
 protected:
  
+    /** Also deletes the saddle controllers */
+    virtual void deleteCPGs(BaseSpineModelLearning& subject);
+    
     virtual void setupSaddleControllers(const OctahedralComplex* subject);
  
     void setGoalTensions(const BaseSpineModelGoal* subject);
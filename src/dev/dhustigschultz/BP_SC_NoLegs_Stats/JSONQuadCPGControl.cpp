@@ -356,14 +356,44 @@ void JSONQuadCPGControl::onTeardown(BaseQuadModelLearning& subject)
     
     payloadLog << root << std::endl;
     
+    deleteCPGs(subject);
+}
+
+void JSONQuadCPGControl::onRestore(BaseQuadModelLearning& subject)
+{
+    // The muscles persist through a restore, so the old controllers
+    // must come off them before onSetup attaches new ones
+    deleteCPGs(subject);
+    onSetup(subject);
+}
+
+void JSONQuadCPGControl::deleteCPGs(BaseQuadModelLearning& subject)
+{
     delete m_pCPGSys;
     m_pCPGSys = NULL;
     
     for(size_t i = 0; i < m_allControllers.size(); i++)
     {
-		delete m_allControllers[i];
-	}
-	m_allControllers.clear();
+        detachFromMuscles(subject, m_allControllers[i]);
+        delete m_allControllers[i];
+    }
+    m_allControllers.clear();
+}
+
+void JSONQuadCPGControl::detachFromMuscles(BaseQuadModelLearning& subject,
+                                           tgObserver<tgSpringCableActuator>* pController)
+{
+    // Subclasses attach to muscle lists of their own, so check them all
+    std::vector<tgModel*> descendants = subject.getDescendants();
+    for (std::size_t i = 0; i < descendants.size(); i++)
+    {
+        tgSpringCableActuator* const pMuscle =
+            dynamic_cast<tgSpringCableActuator*>(descendants[i]);
+        if (pMuscle)
+        {
+            pMuscle->detach(pController);
+        }
+    }
 }
 
 const double JSONQuadCPGControl::getCPGValue(std::size_t i) const
@@ -42,6 +42,7 @@
 
 // Forward Declarations
 class tgImpedanceController;
+class tgSpringCableActuator;
 class tgCPGActuatorControl;
 class CPGEquations;
 class tgCPGLogger;
@@ -124,6 +125,12 @@ struct Config
     virtual void onSetup(BaseQuadModelLearning& subject);
     
     virtual void onTeardown(BaseQuadModelLearning& subject);
+    
+    /**
+     * Rebuild the CPGs as onSetup does, against the restored model.
+     * The episode that was running is not scored.
+     */
+    virtual void onRestore(BaseQuadModelLearning& subject);
 
 	const double getCPGValue(std::size_t i) const;
 	
@@ -139,6 +146,20 @@ protected:
     virtual array_2D scaleNodeActions (Json::Value actions);
     
     virtual void setupCPGs(BaseQuadModelLearning& subject, array_2D nodeActions, array_4D edgeActions);
+    
+    /**
+     * Detach the cable controllers from the muscles and delete them and
+     * the CPG system, undoing onSetup. Subclasses that allocate more in
+     * onSetup should delete it here too.
+     */
+    virtual void deleteCPGs(BaseQuadModelLearning& subject);
+    
+    /**
+     * Detach a controller from whichever actuators of subject it is
+     * attached to, so it can be deleted while they live on
+     */
+    void detachFromMuscles(BaseQuadModelLearning& subject,
+                           tgObserver<tgSpringCableActuator>* pController);
 
     CPGEquations* m_pCPGSys;
     
@@ -33,7 +33,7 @@
 #include <json/value.h>
 
 // Forward Declarations
-class neuralNetwork;
+class MLPNetwork;
 class tgSpringCableActuator;
 
 /**
@@ -113,6 +113,9 @@ protected:
 
     virtual void setupCPGs(BaseQuadModelLearning& subject, array_2D nodeActions, array_4D edgeActions);
     
+    /** Also deletes the controllers and network made by onSetup */
+    virtual void deleteCPGs(BaseQuadModelLearning& subject);
+    
     virtual array_2D scaleNodeActions (Json::Value actions);
     
     std::vector<double> getFeedback(BaseQuadModelLearning& subject);
@@ -126,7 +129,7 @@ protected:
     std::vector<tgCPGActuatorControl*> m_spineControllers;
     
     /// @todo generalize this if we need more than one
-    neuralNetwork* nn;
+    MLPNetwork* nn;
     
 };
 
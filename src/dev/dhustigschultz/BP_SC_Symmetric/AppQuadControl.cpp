@@ -31,11 +31,14 @@
 AppQuadControl::AppQuadControl(int argc, char** argv)
 {
     bSetup = false;
+    controller = NULL;
+    worker = NULL;
     use_graphics = false;
     add_controller = true;
     add_blocks = false;
     add_hills = false;
     all_terrain = false;
+    early_stop = false;
     timestep_physics = 1.0f/1000.0f;
     timestep_graphics = 1.0f/60.0f;
     nEpisodes = 1;
@@ -56,6 +59,21 @@ AppQuadControl::AppQuadControl(int argc, char** argv)
 
 bool AppQuadControl::setup()
 {
+    // In worker mode the first job names the parameter file
+    if (!workerSocket.empty())
+    {
+        if (!add_controller || use_graphics)
+        {
+            throw std::invalid_argument("Worker mode needs the controller and no graphics");
+        }
+        worker = new LearningWorker(workerSocket);
+        if (!worker->nextJob(job))
+        {
+            return false;
+        }
+        suffix = job.args;
+    }
+    
     // First create the world
     world = createWorld();
 
@@ -65,6 +83,15 @@ bool AppQuadControl::setup()
     else
         view = createView(world);         // For running multiple episodes
 
+    // Third to sixth: the simulation, model and controller
+    createSimulation();
+    
+    bSetup = true;
+    return bSetup;
+}
+
+void AppQuadControl::createSimulation()
+{
     // Third create the simulation
     simulation = new tgSimulation(*view);
 
@@ -151,19 +178,22 @@ bool AppQuadControl::setup()
     myControl->attach(myLogger);
 #endif        
         myModel->attach(myControl);
+        controller = myControl;
     }
 
     // Sixth add model & controller to simulation
     simulation->addModel(myModel);
     
+    if (early_stop)
+    {
+        simulation->setMonitor(createMonitor());
+    }
+    
     if (add_blocks)
     {
         tgModel* blockField = getBlocks();
         simulation->addObstacle(blockField);
     }
-    
-    bSetup = true;
-    return bSetup;
 }
 
 void AppQuadControl::handleOptions(int argc, char **argv)
@@ -177,6 +207,7 @@ void AppQuadControl::handleOptions(int argc, char **argv)
         ("blocks,b", po::value<bool>(&add_blocks)->implicit_value(false), "Add a block field as obstacles.")
         ("hills,H", po::value<bool>(&add_hills)->implicit_value(false), "Use hilly terrain.")
         ("all_terrain,A", po::value<bool>(&all_terrain)->implicit_value(false), "Alternate through terrain types. Only works with graphics off")
+        ("early_stop,E", po::value<bool>(&early_stop), "End episodes that have clearly failed early. Only works with graphics off")
         ("phys_time,p", po::value<double>(), "Physics timestep value (Hz). Default=1000")
         ("graph_time,g", po::value<double>(), "Graphics timestep value a.k.a. render rate (Hz). Default = 60")
         ("episodes,e", po::value<int>(&nEpisodes), "Number of episodes to run. Default=1")
@@ -189,6 +220,7 @@ void AppQuadControl::handleOptions(int argc, char **argv)
         ("goal_angle,B", po::value<double>(&goalAngle), "Angle of starting rotation for goal box. Degrees. Default = 0")
         ("learning_controller,l", po::value<std::string>(&suffix), "Which learned controller to write to or use. Default = default")
 	("lower_path,P", po::value<std::string>(&lowerPath), "Which resources folder in which you want to store controllers. Default = default")
+        ("worker,W", po::value<std::string>(&workerSocket), "Run as a persistent learning worker, taking jobs from the scheduler on this Unix socket")
     ;
 
     po::variables_map vm;
@@ -303,6 +335,11 @@ bool AppQuadControl::run()
         // Run until the user stops
         simulation->run();
     }
+    else if (worker)
+    {
+        // or run jobs until the scheduler is done
+        serve();
+    }
     else
     {
         // or run for a specific number of steps
@@ -313,6 +350,7 @@ bool AppQuadControl::run()
    delete simulation;
    delete view;
    delete world;
+   delete worker;
     
     return true;
 }
@@ -329,6 +367,7 @@ void AppQuadControl::simulate(tgSimulation *simulation)
         {
             // Nothing to do here, score will be set to -1
         }
+        checkEarlyStop();
         
         // Don't change the terrain before the last episode to avoid leaks
         if (all_terrain && i != nEpisodes - 1)
@@ -365,6 +404,107 @@ void AppQuadControl::simulate(tgSimulation *simulation)
     }
 }
 
+void AppQuadControl::serve()
+{
+    while (true)
+    {
+        try
+        {
+            simulation->run(job.steps);
+        }
+        catch (const std::runtime_error&)
+        {
+            // Nothing to do here, score will be set to -1
+        }
+        checkEarlyStop();
+        
+        // Ask for the next job before tearing down: the controller scores
+        // this job on teardown, and setup must read the next one's file
+        LearningWorker::Job next;
+        const LearningWorker::Reply reply = worker->followingJob(next);
+        if (reply == LearningWorker::JOB)
+        {
+            controller->setControlFile(next.args);
+            try
+            {
+                simulation->reset();
+            }
+            catch (std::exception& e)
+            {
+                worker->reportError(job, e.what());
+                worker->reportError(next, e.what());
+                throw;
+            }
+            
+            // Obstacles are deleted by reset
+            if (add_blocks)
+            {
+                simulation->addObstacle(getBlocks());
+            }
+            worker->reportScores(job, controller->getScores());
+        }
+        else
+        {
+            // Nothing to set up yet, so tear down for good. Resetting
+            // instead would score an episode that never ran on the next
+            // teardown.
+            delete simulation;
+            simulation = NULL;
+            worker->reportScores(job, controller->getScores());
+            delete controller;
+            controller = NULL;
+            
+            if (reply == LearningWorker::QUIT || !worker->nextJob(next))
+            {
+                return;
+            }
+            // Keep the world and view, rebuild the rest
+            suffix = next.args;
+            createSimulation();
+        }
+        job = next;
+    }
+}
+
+tgEpisodeMonitor* AppQuadControl::createMonitor()
+{
+    const double checkInterval = 0.1; // Seconds
+    // Half the mean squared speed, (cm/s)^2: about 14 m/s
+    const double maxSpecificEnergy = 1.0e6;
+    // Tipped onto its side, on average over all bodies
+    const double maxTilt = M_PI / 2.0;
+    // cm by seconds
+    const double minDistance = 10.0;
+    const double byTime = 15.0;
+    
+    tgEpisodeMonitor* monitor = new tgEpisodeMonitor(checkInterval);
+    monitor->addRule(new tgNotFiniteRule());
+    monitor->addRule(new tgEnergyRule(maxSpecificEnergy));
+    monitor->addRule(new tgOrientationRule(maxTilt));
+    monitor->addRule(new tgProgressRule(minDistance, byTime));
+    // The controller checks the height itself
+    return monitor;
+}
+
+void AppQuadControl::checkEarlyStop()
+{
+    const tgEpisodeMonitor* monitor = simulation->getMonitor();
+    if (monitor == NULL || !monitor->isStopped())
+    {
+        return;
+    }
+    
+    const tgEpisodeMonitor::Reason reason = monitor->getReason();
+    std::cout << "Stopped at " << monitor->getStopTime() << " s: "
+              << tgEpisodeMonitor::reasonName(reason) << std::endl;
+    
+    // Too slow still earns its distance, a broken robot earns nothing
+    if (controller != NULL && reason != tgEpisodeMonitor::eProgress)
+    {
+        controller->markFailed();
+    }
+}
+
 /**
  * The entry point.
  * @param[in] argc the number of command-line arguments
@@ -32,10 +32,14 @@
 // controller 
 #include "JSONQuadFeedbackControl.h"
 
+// learning
+#include "learning/Adapters/LearningWorker.h"
+
 // obstacles
 #include "models/obstacles/tgBlockField.h"
 
 // This library
+#include "core/tgEpisodeMonitor.h"
 #include "core/tgModel.h"
 #include "core/tgSubject.h"
 #include "core/tgSimViewGraphics.h"
@@ -73,6 +77,9 @@ private:
     
     tgModel* getBlocks();
     
+    /** Create the simulation, model and controller on the view */
+    void createSimulation();
+    
     /** Create the tgWorld object */
     tgWorld *createWorld();
 
@@ -85,17 +92,32 @@ private:
     /** Run a series of episodes for nSteps each */
     void simulate(tgSimulation *simulation);
     
+    /** Run the worker's jobs until it is told to quit */
+    void serve();
+    
+    /** Rules for ending failing episodes early */
+    tgEpisodeMonitor* createMonitor();
+    
+    /** Report an episode the monitor ended, failing it if the robot broke */
+    void checkEarlyStop();
+    
     
     // Keep these around for cleanup
     tgWorld* world;
     tgSimView* view;
     tgSimulation* simulation;
+    JSONQuadFeedbackControl* controller;
+    
+    // Set in worker mode, with the job being run
+    LearningWorker* worker;
+    LearningWorker::Job job;
 
     bool use_graphics;
     bool add_controller;
     bool add_blocks;
     bool add_hills;
     bool all_terrain;
+    bool early_stop;
     double timestep_physics; //Seconds
     double timestep_graphics; // Seconds, AKA render rate. Leave at 1/60 for real-time viewing
     int nEpisodes; // Number of episodes ("trial runs")
@@ -111,6 +133,7 @@ private:
     
     std::string lowerPath; 
     std::string suffix;
+    std::string workerSocket;
     
     bool bSetup;
 };
@@ -45,7 +45,7 @@
 #include "util/CPGEquationsFB.h"
 #include "examples/learningSpines/tgCPGCableControl.h"
 
-#include "neuralNet/Neural Network v2/neuralNetwork.h"
+#include "learning/MLP/MLPNetwork.h"
 
 #include <json/json.h>
 
@@ -105,7 +105,8 @@ JSONQuadFeedbackControl::JSONQuadFeedbackControl(JSONQuadFeedbackControl::Config
                                                 std::string args,
                                                 std::string resourcePath) :
 JSONCPGControl(config, args, resourcePath),
-m_config(config)
+m_config(config),
+nn(NULL)
 {
     // Path and filename handled by base class
     
@@ -118,6 +119,8 @@ JSONQuadFeedbackControl::~JSONQuadFeedbackControl()
 
 void JSONQuadFeedbackControl::onSetup(BaseSpineModelLearning& subject)
 {
+    applyControlFile();
+
 	m_pCPGSys = new CPGEquationsFB(100);
 
     Json::Value root; // will contains the root value after parsing.
@@ -156,9 +159,7 @@ void JSONQuadFeedbackControl::onSetup(BaseSpineModelLearning& subject)
     
     std::string nnFile = controlFilePath + feedbackParams.get("neuralFilename", "UTF-8").asString();
     
-    nn = new neuralNetwork(m_config.numStates, m_config.numStates*2, m_config.numActions);
-    
-    nn->loadWeights(nnFile.c_str());
+    nn = new MLPNetwork(m_config.numStates, m_config.numStates*2, m_config.numActions, nnFile);
     
     initConditions = subject.getSegmentCOM(m_config.segmentNumber);
     for (int i = 0; i < initConditions.size(); i++)
@@ -298,14 +299,22 @@ void JSONQuadFeedbackControl::onTeardown(BaseSpineModelLearning& subject)
     
     payloadLog << root << std::endl;
     
-    delete m_pCPGSys;
-    m_pCPGSys = NULL;
+    deleteCPGs(subject);
+}
+
+void JSONQuadFeedbackControl::deleteCPGs(BaseSpineModelLearning& subject)
+{
+    JSONCPGControl::deleteCPGs(subject);
     
     for(size_t i = 0; i < m_spineControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_spineControllers[i]);
         delete m_spineControllers[i];
     }
-    m_spineControllers.clear();    
+    m_spineControllers.clear();
+    
+    delete nn;
+    nn = NULL;
 }
 
 void JSONQuadFeedbackControl::setupCPGs(BaseSpineModelLearning& subject, array_2D nodeActions, array_4D edgeActions)
@@ -399,36 +408,37 @@ std::vector<double> JSONQuadFeedbackControl::getFeedback(BaseSpineModelLearning&
     
     const std::vector<tgSpringCableActuator*>& spineCables = subject.find<tgSpringCableActuator> ("spine ");
     
-    double *inputs = new double[m_config.numStates];
+    // One row of inputs per cable, so the network runs once per step
+    const std::size_t numStates = m_config.numStates;
+    std::vector<double> inputs(spineCables.size() * numStates, 0.0);
     
     std::size_t n = spineCables.size();
     for(std::size_t i = 0; i != n; i++)
     {
-        std::vector< std::vector<double> > actions;
-        
         const tgSpringCableActuator& cable = *(spineCables[i]);
         std::vector<double > state = getCableState(cable);
         
         // Rescale to 0 to 1 (consider doing this inside getState
-        for (std::size_t i = 0; i < state.size(); i++)
+        for (std::size_t j = 0; j < state.size() && j < numStates; j++)
         {
-            inputs[i]=state[i] / 2.0 + 0.5;
+            inputs[i * numStates + j] = state[j] / 2.0 + 0.5;
         }
-        
-        double *output = nn->feedForwardPattern(inputs);
-        vector<double> tmpAct;
-        for(int j=0;j<m_config.numActions;j++)
-        {
-            tmpAct.push_back(output[j]);
-        }
-        actions.push_back(tmpAct);
+    }
+    
+    std::vector<double> outputs;
+    nn->feedForward(inputs, outputs);
+    
+    const std::size_t numActions = m_config.numActions;
+    for(std::size_t i = 0; i != outputs.size() / numActions; i++)
+    {
+        std::vector<double>::const_iterator output = outputs.begin() + i * numActions;
+        std::vector< std::vector<double> > actions(1, std::vector<double>(output, output + numActions));
 
         std::vector<double> cableFeedback = transformFeedbackActions(actions);
         
         feedback.insert(feedback.end(), cableFeedback.begin(), cableFeedback.end());
     }
     
-    
     return feedback;
 }
 
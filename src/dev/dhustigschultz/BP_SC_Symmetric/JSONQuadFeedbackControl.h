@@ -32,7 +32,7 @@
 #include <json/value.h>
 
 // Forward Declarations
-class neuralNetwork;
+class MLPNetwork;
 class tgSpringCableActuator;
 
 /**
@@ -112,6 +112,9 @@ protected:
 
     virtual void setupCPGs(BaseSpineModelLearning& subject, array_2D nodeActions, array_4D edgeActions);
     
+    /** Also deletes the controllers and network made by onSetup */
+    virtual void deleteCPGs(BaseSpineModelLearning& subject);
+    
     virtual array_2D scaleNodeActions (Json::Value actions);
     
     std::vector<double> getFeedback(BaseSpineModelLearning& subject);
@@ -125,7 +128,7 @@ protected:
     std::vector<tgCPGActuatorControl*> m_spineControllers;
     
     /// @todo generalize this if we need more than one
-    neuralNetwork* nn;
+    MLPNetwork* nn;
     
 };
 
@@ -33,7 +33,7 @@
 #include <json/value.h>
 
 // Forward Declarations
-class neuralNetwork;
+class MLPNetwork;
 class tgSpringCableActuator;
 
 /**
@@ -113,6 +113,9 @@ protected:
 
     virtual void setupCPGs(BaseQuadModelLearning& subject, array_2D nodeActions, array_4D edgeActions);
     
+    /** Also deletes the controllers and network made by onSetup */
+    virtual void deleteCPGs(BaseQuadModelLearning& subject);
+    
     virtual array_2D scaleNodeActions (Json::Value actions);
     
     std::vector<double> getFeedback(BaseQuadModelLearning& subject);
@@ -128,7 +131,7 @@ protected:
     std::vector<tgCPGActuatorControl*> m_spineControllers;
     
     // @todo generalize this if we need more than one
-    neuralNetwork* nn;
+    MLPNetwork* nn;
 
     //One vector for each muscle in the controller, so can save metrics from onStep(), and then print to console at the end (will be redirected into a file in a way that is more easily useable as a .csv file. Names are arbitrary numbers for now, later can make them into more biological-sounding analogs.
     std::vector<double> m_muscleTensionZero;
@@ -46,7 +46,7 @@
 #include "util/CPGEquationsFB.h"
 #include "examples/learningSpines/tgCPGCableControl.h"
 
-#include "neuralNet/Neural Network v2/neuralNetwork.h"
+#include "learning/MLP/MLPNetwork.h"
 
 #include <json/json.h>
 
@@ -114,7 +114,8 @@ JSONSegmentsFeedbackControl::JSONSegmentsFeedbackControl(JSONSegmentsFeedbackCon
                                                 std::string args,
                                                 std::string resourcePath) :
 JSONQuadCPGControl(config, args, resourcePath),
-m_config(config)
+m_config(config),
+nn(NULL)
 {
     // Path and filename handled by base class
     
@@ -175,9 +176,7 @@ void JSONSegmentsFeedbackControl::onSetup(BaseQuadModelLearning& subject)
     
     std::string nnFile = controlFilePath + feedbackParams.get("neuralFilename", "UTF-8").asString();
     
-    nn = new neuralNetwork(m_config.numStates, m_config.numStates*2, m_config.numActions);
-    
-    nn->loadWeights(nnFile.c_str());
+    nn = new MLPNetwork(m_config.numStates, m_config.numStates*2, m_config.numActions, nnFile);
     
     initConditions = subject.getSegmentCOM(m_config.segmentNumber);
     for (int i = 0; i < initConditions.size(); i++)
@@ -471,14 +470,22 @@ void JSONSegmentsFeedbackControl::onTeardown(BaseQuadModelLearning& subject)
     
     payloadLog << root << std::endl;
     
-    delete m_pCPGSys;
-    m_pCPGSys = NULL;
+    deleteCPGs(subject);
+}
+
+void JSONSegmentsFeedbackControl::deleteCPGs(BaseQuadModelLearning& subject)
+{
+    JSONQuadCPGControl::deleteCPGs(subject);
     
     for(size_t i = 0; i < m_spineControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_spineControllers[i]);
         delete m_spineControllers[i];
     }
-    m_spineControllers.clear();    
+    m_spineControllers.clear();
+    
+    delete nn;
+    nn = NULL;
 }
 
 void JSONSegmentsFeedbackControl::setupCPGs(BaseQuadModelLearning& subject, array_2D nodeActions, array_4D edgeActions, array_4D hipEdgeActions, array_4D legEdgeActions)
@@ -723,94 +730,41 @@ std::vector<double> JSONSegmentsFeedbackControl::getFeedback(BaseQuadModelLearni
     
     const std::vector<tgSpringCableActuator*>& spineCables = subject.find<tgSpringCableActuator> ("spine ");
     
-    double *inputs = new double[m_config.numStates];
+    const std::vector<tgSpringCableActuator*>& hipCables = subject.find<tgSpringCableActuator> ("hip ");
+    
+    std::vector<tgSpringCableActuator*> cables(spineCables);
+    cables.insert(cables.end(), hipCables.begin(), hipCables.end());
+    
+    // One row of inputs per cable, so the network runs once per step
+    const std::size_t numStates = m_config.numStates;
+    std::vector<double> inputs(cables.size() * numStates, 0.0);
     
-    std::size_t n = spineCables.size();
+    std::size_t n = cables.size();
     for(std::size_t i = 0; i != n; i++)
     {
-        std::vector< std::vector<double> > actions;
-        
-        const tgSpringCableActuator& cable = *(spineCables[i]);
+        const tgSpringCableActuator& cable = *(cables[i]);
         std::vector<double > state = getCableState(cable);
         
         // Rescale to 0 to 1 (consider doing this inside getState
-        for (std::size_t i = 0; i < state.size(); i++)
+        for (std::size_t j = 0; j < state.size() && j < numStates; j++)
         {
-            inputs[i]=state[i] / 2.0 + 0.5;
+            inputs[i * numStates + j] = state[j] / 2.0 + 0.5;
         }
-        
-        double *output = nn->feedForwardPattern(inputs);
-        vector<double> tmpAct;
-        for(int j=0;j<m_config.numActions;j++)
-        {
-            tmpAct.push_back(output[j]);
-        }
-        actions.push_back(tmpAct);
-
-        std::vector<double> cableFeedback = transformFeedbackActions(actions);
-        
-        feedback.insert(feedback.end(), cableFeedback.begin(), cableFeedback.end());
     }
     
-    //Doing the same for the hips and legs... consider changing this to allMuscles, by including the short muscles in the spine, to shorten this function. 
-    const std::vector<tgSpringCableActuator*>& hipCables = subject.find<tgSpringCableActuator> ("hip ");
+    std::vector<double> outputs;
+    nn->feedForward(inputs, outputs);
     
-    std::size_t n2 = hipCables.size();
-    for(std::size_t i = 0; i != n2; i++)
+    const std::size_t numActions = m_config.numActions;
+    for(std::size_t i = 0; i != outputs.size() / numActions; i++)
     {
-        std::vector< std::vector<double> > actions;
-        
-        const tgSpringCableActuator& cable = *(hipCables[i]);
-        std::vector<double > state = getCableState(cable);
-        
-        // Rescale to 0 to 1 (consider doing this inside getState
-        for (std::size_t i = 0; i < state.size(); i++)
-        {
-            inputs[i]=state[i] / 2.0 + 0.5;
-        }
-        
-        double *output = nn->feedForwardPattern(inputs);
-        vector<double> tmpAct;
-        for(int j=0;j<m_config.numActions;j++)
-        {
-            tmpAct.push_back(output[j]);
-        }
-        actions.push_back(tmpAct);
+        std::vector<double>::const_iterator output = outputs.begin() + i * numActions;
+        std::vector< std::vector<double> > actions(1, std::vector<double>(output, output + numActions));
 
         std::vector<double> cableFeedback = transformFeedbackActions(actions);
         
         feedback.insert(feedback.end(), cableFeedback.begin(), cableFeedback.end());
     }
-
-    /*const std::vector<tgSpringCableActuator*>& legCables = subject.find<tgSpringCableActuator> ("legAct ");
-    
-    std::size_t n3 = legCables.size();
-    for(std::size_t i = 0; i != n3; i++)
-    {
-        std::vector< std::vector<double> > actions;
-        
-        const tgSpringCableActuator& cable = *(legCables[i]);
-        std::vector<double > state = getCableState(cable);
-        
-        // Rescale to 0 to 1 (consider doing this inside getState
-        for (std::size_t i = 0; i < state.size(); i++)
-        {
-            inputs[i]=state[i] / 2.0 + 0.5;
-        }
-        
-        double *output = nn->feedForwardPattern(inputs);
-        vector<double> tmpAct;
-        for(int j=0;j<m_config.numActions;j++)
-        {
-            tmpAct.push_back(output[j]);
-        }
-        actions.push_back(tmpAct);
-
-        std::vector<double> cableFeedback = transformFeedbackActions(actions);
-        
-        feedback.insert(feedback.end(), cableFeedback.begin(), cableFeedback.end());
-    }*/
-    
     
     return feedback;
 }
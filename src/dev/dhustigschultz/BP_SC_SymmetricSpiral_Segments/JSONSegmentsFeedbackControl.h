@@ -33,7 +33,7 @@
 #include <json/value.h>
 
 // Forward Declarations
-class neuralNetwork;
+class MLPNetwork;
 class tgSpringCableActuator;
 
 /**
@@ -122,6 +122,9 @@ struct Config : public JSONQuadCPGControl::Config
 protected:
 
     virtual void setupCPGs(BaseQuadModelLearning& subject, array_2D nodeActions, array_4D edgeActions, array_4D hipEdgeActions, array_4D legEdgeActions);
+    
+    /** Also deletes the controllers and network made by onSetup */
+    virtual void deleteCPGs(BaseQuadModelLearning& subject);
 
 
     virtual array_4D scaleEdgeActions (Json::Value actions, int theirMuscles, int ourMuscles);    
@@ -140,7 +143,7 @@ protected:
     std::vector<tgCPGActuatorControl*> m_legControllers;
     
     /// @todo generalize this if we need more than one
-    neuralNetwork* nn;
+    MLPNetwork* nn;
     
 };
 
@@ -46,7 +46,7 @@
 #include "util/CPGEquationsFB.h"
 #include "examples/learningSpines/tgCPGCableControl.h"
 
-#include "neuralNet/Neural Network v2/neuralNetwork.h"
+#include "learning/MLP/MLPNetwork.h"
 
 #include <json/json.h>
 
@@ -127,7 +127,8 @@ JSONAOHierarchyControl::JSONAOHierarchyControl(JSONAOHierarchyControl::Config co
                                                 std::string args,
                                                 std::string resourcePath) :
 JSONQuadCPGControl(config, args, resourcePath),
-m_config(config)
+m_config(config),
+nn(NULL)
 {
     // Path and filename handled by base class
     
@@ -196,9 +197,7 @@ void JSONAOHierarchyControl::onSetup(BaseQuadModelLearning& subject)
     
     std::string nnFile = controlFilePath + feedbackParams.get("neuralFilename", "UTF-8").asString();
     
-    nn = new neuralNetwork(m_config.numStates, m_config.numStates*2, m_config.numActions);
-    
-    nn->loadWeights(nnFile.c_str());
+    nn = new MLPNetwork(m_config.numStates, m_config.numStates*2, m_config.numActions, nnFile);
     
     initConditions = subject.getSegmentCOM(m_config.segmentNumber);
     for (int i = 0; i < initConditions.size(); i++)
@@ -413,39 +412,46 @@ void JSONAOHierarchyControl::onTeardown(BaseQuadModelLearning& subject)
     
     payloadLog << root << std::endl;
     
-    delete m_pCPGSys;
-    m_pCPGSys = NULL;
+    deleteCPGs(subject);
+}
+
+void JSONAOHierarchyControl::deleteCPGs(BaseQuadModelLearning& subject)
+{
+    JSONQuadCPGControl::deleteCPGs(subject);
     
     // This is ugly, will clean up later:
 
     //Achilles controllers
     for(size_t i = 0; i < m_leftFrontAchillesControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_leftFrontAchillesControllers[i]);
         delete m_leftFrontAchillesControllers[i];
     }
     m_leftFrontAchillesControllers.clear();  
 
     for(size_t i = 0; i < m_rightFrontAchillesControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_rightFrontAchillesControllers[i]);
         delete m_rightFrontAchillesControllers[i];
     }
     m_rightFrontAchillesControllers.clear(); 
 
     for(size_t i = 0; i < m_leftRearAchillesControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_leftRearAchillesControllers[i]);
         delete m_leftRearAchillesControllers[i];
     }
     m_leftRearAchillesControllers.clear();  
 
     for(size_t i = 0; i < m_rightRearAchillesControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_rightRearAchillesControllers[i]);
         delete m_rightRearAchillesControllers[i];
     }
-    m_rightRearAchillesControllers.clear();  
-
-    // Trying to delete here instead, to fix the leak
+    m_rightRearAchillesControllers.clear();
+    
     delete nn;
-
+    nn = NULL;
 }
 
 //Note: Will make a more compact, reuseable function later when I decide on how want to handle m_xControllers for different body parts
@@ -741,29 +747,31 @@ std::vector<double> JSONAOHierarchyControl::getFeedback(BaseQuadModelLearning& s
     
     const std::vector<tgSpringCableActuator*>& allCables = subject.find<tgSpringCableActuator> ("only ");
     
-    double *inputs = new double[m_config.numStates];
+    // One row of inputs per cable, so the network runs once per step
+    const std::size_t numStates = m_config.numStates;
+    std::vector<double> inputs(allCables.size() * numStates, 0.0);
     
     std::size_t n = allCables.size();
     for(std::size_t i = 0; i != n; i++)
     {
-        std::vector< std::vector<double> > actions;
-        
         const tgSpringCableActuator& cable = *(allCables[i]);
         std::vector<double > state = getCableState(cable);
         
         // Rescale to 0 to 1 (consider doing this inside getState
-        for (std::size_t i = 0; i < state.size(); i++)
+        for (std::size_t j = 0; j < state.size() && j < numStates; j++)
         {
-            inputs[i]=state[i] / 2.0 + 0.5;
+            inputs[i * numStates + j] = state[j] / 2.0 + 0.5;
         }
-        
-        double *output = nn->feedForwardPattern(inputs);
-        vector<double> tmpAct;
-        for(int j=0;j<m_config.numActions;j++)
-        {
-            tmpAct.push_back(output[j]);
-        }
-        actions.push_back(tmpAct);
+    }
+    
+    std::vector<double> outputs;
+    nn->feedForward(inputs, outputs);
+    
+    const std::size_t numActions = m_config.numActions;
+    for(std::size_t i = 0; i != outputs.size() / numActions; i++)
+    {
+        std::vector<double>::const_iterator output = outputs.begin() + i * numActions;
+        std::vector< std::vector<double> > actions(1, std::vector<double>(output, output + numActions));
 
         std::vector<double> cableFeedback = transformFeedbackActions(actions);
         
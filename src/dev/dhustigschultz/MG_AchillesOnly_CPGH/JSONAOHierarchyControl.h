@@ -33,7 +33,7 @@
 #include <json/value.h>
 
 // Forward Declarations
-class neuralNetwork;
+class MLPNetwork;
 class tgSpringCableActuator;
 
 
@@ -140,6 +140,9 @@ protected:
 
     virtual void setupCPGs(BaseQuadModelLearning& subject, array_2D achillesNodeActions, array_4D achillesEdgeActions); 
     
+    /** Also deletes the controllers and network made by onSetup */
+    virtual void deleteCPGs(BaseQuadModelLearning& subject);
+    
     virtual array_2D scaleNodeActions (Json::Value actions, double highFreq, double freqFeedbackMax);
 
     virtual array_4D scaleEdgeActions (Json::Value actions, int segmentSpan, int theirMuscles, int ourMuscles); 
@@ -161,7 +164,7 @@ protected:
     std::vector<tgCPGActuatorControl*> m_rightRearAchillesControllers;
 
     // @todo generalize this if we need more than one
-    neuralNetwork* nn;
+    MLPNetwork* nn;
 
     std::vector< std::vector<double> > m_quadCOM;
 
@@ -46,7 +46,7 @@
 #include "util/CPGEquationsFB.h"
 #include "examples/learningSpines/tgCPGCableControl.h"
 
-#include "neuralNet/Neural Network v2/neuralNetwork.h"
+#include "learning/MLP/MLPNetwork.h"
 
 #include <json/json.h>
 
@@ -123,7 +123,8 @@ JSONHierarchyFeedbackControl::JSONHierarchyFeedbackControl(JSONHierarchyFeedback
                                                 std::string args,
                                                 std::string resourcePath) :
 JSONQuadCPGControl(config, args, resourcePath),
-m_config(config)
+m_config(config),
+nn(NULL)
 {
     // Path and filename handled by base class
     
@@ -137,6 +138,7 @@ JSONHierarchyFeedbackControl::~JSONHierarchyFeedbackControl()
 void JSONHierarchyFeedbackControl::onSetup(BaseQuadModelLearning& subject)
 {
     m_pCPGSys = new CPGEquationsFB(100);
+    m_allCables = tgTagSearch("all ");
 
     Json::Value root; // will contains the root value after parsing.
     Json::Reader reader;
@@ -207,9 +209,7 @@ void JSONHierarchyFeedbackControl::onSetup(BaseQuadModelLearning& subject)
     
     std::string nnFile = controlFilePath + feedbackParams.get("neuralFilename", "UTF-8").asString();
     
-    nn = new neuralNetwork(m_config.numStates, m_config.numStates*2, m_config.numActions);
-    
-    nn->loadWeights(nnFile.c_str());
+    nn = new MLPNetwork(m_config.numStates, m_config.numStates*2, m_config.numActions, nnFile);
     
     initConditions = subject.getSegmentCOM(m_config.segmentNumber);
     for (int i = 0; i < initConditions.size(); i++)
@@ -398,59 +398,72 @@ void JSONHierarchyFeedbackControl::onTeardown(BaseQuadModelLearning& subject)
     
     payloadLog << root << std::endl;
     
-    delete m_pCPGSys;
-    m_pCPGSys = NULL;
+    deleteCPGs(subject);
+}
+
+void JSONHierarchyFeedbackControl::deleteCPGs(BaseQuadModelLearning& subject)
+{
+    JSONQuadCPGControl::deleteCPGs(subject);
     
     for(size_t i = 0; i < m_spineControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_spineControllers[i]);
         delete m_spineControllers[i];
     }
     m_spineControllers.clear();    
 
     for(size_t i = 0; i < m_leftShoulderControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_leftShoulderControllers[i]);
         delete m_leftShoulderControllers[i];
     }
     m_leftShoulderControllers.clear(); 
 
     for(size_t i = 0; i < m_rightShoulderControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_rightShoulderControllers[i]);
         delete m_rightShoulderControllers[i];
     }
     m_rightShoulderControllers.clear(); 
 
     for(size_t i = 0; i < m_leftHipControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_leftHipControllers[i]);
         delete m_leftHipControllers[i];
     }
     m_leftHipControllers.clear(); 
 
     for(size_t i = 0; i < m_rightHipControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_rightHipControllers[i]);
         delete m_rightHipControllers[i];
     }
     m_rightHipControllers.clear(); 
 
     for(size_t i = 0; i < m_leftForelegControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_leftForelegControllers[i]);
         delete m_leftForelegControllers[i];
     }
     m_leftForelegControllers.clear();  
 
     for(size_t i = 0; i < m_rightForelegControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_rightForelegControllers[i]);
         delete m_rightForelegControllers[i];
     }
     m_rightForelegControllers.clear(); 
 
     for(size_t i = 0; i < m_leftHindlegControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_leftHindlegControllers[i]);
         delete m_leftHindlegControllers[i];
     }
     m_leftHindlegControllers.clear();  
 
     for(size_t i = 0; i < m_rightHindlegControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_rightHindlegControllers[i]);
         delete m_rightHindlegControllers[i];
     }
     m_rightHindlegControllers.clear();  
@@ -459,8 +472,10 @@ void JSONHierarchyFeedbackControl::onTeardown(BaseQuadModelLearning& subject)
     {
         delete m_highControllers[i];
     }
-    m_highControllers.clear();  
-
+    m_highControllers.clear();
+    
+    delete nn;
+    nn = NULL;
 }
 
 //Note: Will make a more compact, reuseable function later when I decide on how want to handle m_xControllers for different body parts
@@ -1179,61 +1194,41 @@ std::vector<double> JSONHierarchyFeedbackControl::getFeedback(BaseQuadModelLearn
     // Placeholder
     std::vector<double> feedback;
     
-    const std::vector<tgSpringCableActuator*>& allCables = subject.find<tgSpringCableActuator> ("all ");
+    const std::vector<tgSpringCableActuator*>& allCables = subject.findCached<tgSpringCableActuator>(m_allCables);
     
-    double *inputs = new double[m_config.numStates];
+    // One row of inputs per cable, so the network runs once per step
+    const std::size_t numStates = m_config.numStates;
+    std::vector<double> inputs(allCables.size() * numStates, 0.0);
     
     std::size_t n = allCables.size();
     for(std::size_t i = 0; i != n; i++)
     {
-        std::vector< std::vector<double> > actions;
-        
         const tgSpringCableActuator& cable = *(allCables[i]);
         std::vector<double > state = getCableState(cable);
         
         // Rescale to 0 to 1 (consider doing this inside getState
-        for (std::size_t i = 0; i < state.size(); i++)
-        {
-            inputs[i]=state[i] / 2.0 + 0.5;
-        }
-        
-        double *output = nn->feedForwardPattern(inputs);
-        vector<double> tmpAct;
-        for(int j=0;j<m_config.numActions;j++)
+        for (std::size_t j = 0; j < state.size() && j < numStates; j++)
         {
-            tmpAct.push_back(output[j]);
+            inputs[i * numStates + j] = state[j] / 2.0 + 0.5;
         }
-        actions.push_back(tmpAct);
+    }
+    
+    // inputting 0 for now, one row per higher level controller
+    inputs.resize(inputs.size() + m_highControllers.size() * numStates, 0.0);
+    
+    std::vector<double> outputs;
+    nn->feedForward(inputs, outputs);
+    
+    const std::size_t numActions = m_config.numActions;
+    for(std::size_t i = 0; i != outputs.size() / numActions; i++)
+    {
+        std::vector<double>::const_iterator output = outputs.begin() + i * numActions;
+        std::vector< std::vector<double> > actions(1, std::vector<double>(output, output + numActions));
 
         std::vector<double> cableFeedback = transformFeedbackActions(actions);
         
         feedback.insert(feedback.end(), cableFeedback.begin(), cableFeedback.end());
     }
-
-    // inputting 0 for now
-    std::size_t n2 = m_highControllers.size();
-    for (size_t i = 0; i != n2; i++)
-    {
-	std::vector< std::vector<double> > actions;
-		
-	// Rescale to 0 to 1 (consider doing this inside getState)
-	for (std::size_t i = 0; i < m_config.numStates; i++)
-	{
-	    inputs[i] = 0;
-	}
-		
-	double *output = nn->feedForwardPattern(inputs);
-	vector<double> tmpAct;
-	for(int j=0;j<m_config.numActions;j++)
-	{
-	    tmpAct.push_back(output[j]);
-	}
-	actions.push_back(tmpAct);
-
-	std::vector<double> cableFeedback = transformFeedbackActions(actions);
-		
-	feedback.insert(feedback.end(), cableFeedback.begin(), cableFeedback.end());
-    }
     
     return feedback;
 }
@@ -30,10 +30,12 @@
 
 #include "dev/dhustigschultz/BP_SC_NoLegs_Stats/JSONQuadCPGControl.h"
 
+#include "core/tgTagSearch.h"
+
 #include <json/value.h>
 
 // Forward Declarations
-class neuralNetwork;
+class MLPNetwork;
 class tgSpringCableActuator;
 
 
@@ -133,6 +135,9 @@ struct Config : public JSONQuadCPGControl::Config
 protected:
 
     virtual void setupCPGs(BaseQuadModelLearning& subject, array_2D spineNodeActions, array_2D legNodeActions, array_4D spineEdgeActions, array_4D hipEdgeActions, array_4D legEdgeActions);
+    
+    /** Also deletes the controllers and network made by onSetup */
+    virtual void deleteCPGs(BaseQuadModelLearning& subject);
 
     virtual void setupHighCPGs(BaseQuadModelLearning& subject, array_2D highNodeActions, array_4D highEdgeActions);
 
@@ -172,7 +177,10 @@ protected:
     std::vector<tgCPGActuatorControl*> m_highControllers;
     
     // @todo generalize this if we need more than one
-    neuralNetwork* nn;
+    MLPNetwork* nn;
+    
+    /// Compiled in onSetup, for the cable lookup made every step
+    tgTagSearch m_allCables;
 
     std::vector< std::vector<double> > m_quadCOM;
 
@@ -30,10 +30,12 @@
 
 #include "JSONMGCPGGeneralControl.h"
 
+#include "core/tgTagSearch.h"
+
 #include <json/value.h>
 
 // Forward Declarations
-class neuralNetwork;
+class MLPNetwork;
 class tgSpringCableActuator;
 
 typedef boost::multi_array<double, 3> array_3D; //Will treat entire spine (and eventually body) as one big segment, so reducing the multi_array by one dimension.
@@ -115,6 +117,9 @@ protected:
 //ToDo: Need to restructure the for loops in here, so that have separate cases for the first and last segments (long muscles)....
     virtual void setupCPGs(BaseQuadModelLearning& subject, array_2D nodeActions, array_3D edgeActions);
     
+    /** Also deletes the controllers and network made by onSetup */
+    virtual void deleteCPGs(BaseQuadModelLearning& subject);
+    
     virtual array_3D scaleEdgeActions (Json::Value edgeParam);
     virtual array_2D scaleNodeActions (Json::Value actions);
 
@@ -131,7 +136,10 @@ protected:
     std::vector<tgCPGMGActuatorControl*> m_spineControllers;
     
     /// @todo generalize this if we need more than one
-    neuralNetwork* nn;
+    MLPNetwork* nn;
+    
+    /// Compiled in onSetup, for the cable lookup made every step
+    tgTagSearch m_allCables;
     
 };
 
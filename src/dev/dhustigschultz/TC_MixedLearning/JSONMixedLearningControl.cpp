@@ -45,7 +45,7 @@
 #include "util/CPGEquationsFB.h"
 #include "examples/learningSpines/tgCPGCableControl.h"
 
-#include "neuralNet/Neural Network v2/neuralNetwork.h"
+#include "learning/MLP/MLPNetwork.h"
 
 #include <json/json.h>
 
@@ -105,7 +105,8 @@ JSONMixedLearningControl::JSONMixedLearningControl(JSONMixedLearningControl::Con
                                                 std::string args,
                                                 std::string resourcePath) :
 JSONCPGControl(config, args, resourcePath),
-m_config(config)
+m_config(config),
+nn(NULL)
 {
     // Path and filename handled by base class
     
@@ -118,6 +119,8 @@ JSONMixedLearningControl::~JSONMixedLearningControl()
 
 void JSONMixedLearningControl::onSetup(BaseSpineModelLearning& subject)
 {
+    applyControlFile();
+
 	m_pCPGSys = new CPGEquationsFB(200);
 
     Json::Value root; // will contains the root value after parsing.
@@ -162,9 +165,7 @@ void JSONMixedLearningControl::onSetup(BaseSpineModelLearning& subject)
     
     std::string nnFile = controlFilePath + feedbackParams.get("neuralFilename", "UTF-8").asString();
     
-    nn = new neuralNetwork(m_config.numStates, m_config.numHidden, m_config.numActions);
-    
-    nn->loadWeights(nnFile.c_str());
+    nn = new MLPNetwork(m_config.numStates, m_config.numHidden, m_config.numActions, nnFile);
     
     initConditions = subject.getSegmentCOM(m_config.segmentNumber);
     for (int i = 0; i < initConditions.size(); i++)
@@ -304,27 +305,36 @@ void JSONMixedLearningControl::onTeardown(BaseSpineModelLearning& subject)
     
     payloadLog << root << std::endl;
     
-    delete m_pCPGSys;
-    m_pCPGSys = NULL;
-    
+    deleteCPGs(subject);
+}
+
+void JSONMixedLearningControl::deleteCPGs(BaseSpineModelLearning& subject)
+{
+    JSONCPGControl::deleteCPGs(subject);
     
     for(size_t i = 0; i < m_startingControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_startingControllers[i]);
         delete m_startingControllers[i];
     }
     m_startingControllers.clear();
 
     for(size_t i = 0; i < m_middleControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_middleControllers[i]);
         delete m_middleControllers[i];
     }
     m_middleControllers.clear(); 
 
     for(size_t i = 0; i < m_endingControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_endingControllers[i]);
         delete m_endingControllers[i];
     }
-    m_endingControllers.clear();    
+    m_endingControllers.clear();
+    
+    delete nn;
+    nn = NULL;
 }
 
 void JSONMixedLearningControl::setupCPGs(BaseSpineModelLearning& subject, array_2D nodeActions, array_4D startingEdgeActions, array_4D middleEdgeActions, array_4D endingEdgeActions)
@@ -489,36 +499,37 @@ std::vector<double> JSONMixedLearningControl::getFeedback(BaseSpineModelLearning
     
     const std::vector<tgSpringCableActuator*>& allCables = subject.getAllMuscles();
     
-    double *inputs = new double[m_config.numStates];
+    // One row of inputs per cable, so the network runs once per step
+    const std::size_t numStates = m_config.numStates;
+    std::vector<double> inputs(allCables.size() * numStates, 0.0);
     
     std::size_t n = allCables.size();
     for(std::size_t i = 0; i != n; i++)
     {
-        std::vector< std::vector<double> > actions;
-        
         const tgSpringCableActuator& cable = *(allCables[i]);
         std::vector<double > state = getCableState(cable);
         
         // Rescale to 0 to 1 (consider doing this inside getState
-        for (std::size_t i = 0; i < state.size(); i++)
+        for (std::size_t j = 0; j < state.size() && j < numStates; j++)
         {
-            inputs[i]=state[i] / 2.0 + 0.5;
+            inputs[i * numStates + j] = state[j] / 2.0 + 0.5;
         }
-        
-        double *output = nn->feedForwardPattern(inputs);
-        vector<double> tmpAct;
-        for(int j=0;j<m_config.numActions;j++)
-        {
-            tmpAct.push_back(output[j]);
-        }
-        actions.push_back(tmpAct);
+    }
+    
+    std::vector<double> outputs;
+    nn->feedForward(inputs, outputs);
+    
+    const std::size_t numActions = m_config.numActions;
+    for(std::size_t i = 0; i != outputs.size() / numActions; i++)
+    {
+        std::vector<double>::const_iterator output = outputs.begin() + i * numActions;
+        std::vector< std::vector<double> > actions(1, std::vector<double>(output, output + numActions));
 
         std::vector<double> cableFeedback = transformFeedbackActions(actions);
         
         feedback.insert(feedback.end(), cableFeedback.begin(), cableFeedback.end());
     }
     
-    
     return feedback;
 }
 
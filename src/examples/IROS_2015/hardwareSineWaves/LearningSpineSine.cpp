@@ -59,15 +59,8 @@ BaseSpineCPGControl(config, args, resourcePath)
 {    
 }
 
-void LearningSpineSine::onSetup(BaseSpineModelLearning& subject)
+void LearningSpineSine::setupEpisode(BaseSpineModelLearning& subject)
 {
-    //Initialize the Learning Adapters
-    nodeAdapter.initialize(&nodeEvolution,
-                            nodeLearning,
-                            nodeConfigData);
-    edgeAdapter.initialize(&edgeEvolution,
-                            edgeLearning,
-                            edgeConfigData);
     /* Empty vector signifying no state information
      * All parameters are stateless parameters, so we can get away with
      * only doing this once
@@ -150,8 +143,14 @@ void LearningSpineSine::onTeardown(BaseSpineModelLearning& subject)
     edgeAdapter.endEpisode(scores);
     nodeAdapter.endEpisode(scores);
 
+    deleteCPGs(subject);
+}
+
+void LearningSpineSine::deleteCPGs(BaseSpineModelLearning& subject)
+{
     for(size_t i = 0; i < m_sineControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_sineControllers[i]);
 		delete m_sineControllers[i];
 	}
 	m_sineControllers.clear();
@@ -174,8 +174,20 @@ BaseSpineCPGControl::~BaseSpineCPGControl()
 
 void BaseSpineCPGControl::onSetup(BaseSpineModelLearning& subject)
 {
-    // Maximum number of sub-steps allowed by CPG
-	m_pCPGSys = new CPGEquations(200);
+    initializeAdapters();
+    setupEpisode(subject);
+}
+
+void BaseSpineCPGControl::onRestore(BaseSpineModelLearning& subject)
+{
+    // The muscles persist through a restore, so the old controllers
+    // must come off them before new ones are attached
+    deleteCPGs(subject);
+    setupEpisode(subject);
+}
+
+void BaseSpineCPGControl::initializeAdapters()
+{
     //Initialize the Learning Adapters
     nodeAdapter.initialize(&nodeEvolution,
                             nodeLearning,
@@ -183,6 +195,12 @@ void BaseSpineCPGControl::onSetup(BaseSpineModelLearning& subject)
     edgeAdapter.initialize(&edgeEvolution,
                             edgeLearning,
                             edgeConfigData);
+}
+
+void BaseSpineCPGControl::setupEpisode(BaseSpineModelLearning& subject)
+{
+    // Maximum number of sub-steps allowed by CPG
+	m_pCPGSys = new CPGEquations(200);
     /* Empty vector signifying no state information
      * All parameters are stateless parameters, so we can get away with
      * only doing this once
@@ -331,16 +349,38 @@ void BaseSpineCPGControl::onTeardown(BaseSpineModelLearning& subject)
     edgeAdapter.endEpisode(scores);
     nodeAdapter.endEpisode(scores);
     
+    deleteCPGs(subject);
+}
+
+void BaseSpineCPGControl::deleteCPGs(BaseSpineModelLearning& subject)
+{
     delete m_pCPGSys;
     m_pCPGSys = NULL;
     
     for(size_t i = 0; i < m_allControllers.size(); i++)
     {
+        detachFromMuscles(subject, m_allControllers[i]);
 		delete m_allControllers[i];
 	}
 	m_allControllers.clear();
 }
 
+void BaseSpineCPGControl::detachFromMuscles(BaseSpineModelLearning& subject,
+                                            tgObserver<tgSpringCableActuator>* pController)
+{
+    // Subclasses attach to muscle lists of their own, so check them all
+    std::vector<tgModel*> descendants = subject.getDescendants();
+    for (std::size_t i = 0; i < descendants.size(); i++)
+    {
+        tgSpringCableActuator* const pMuscle =
+            dynamic_cast<tgSpringCableActuator*>(descendants[i]);
+        if (pMuscle)
+        {
+            pMuscle->detach(pController);
+        }
+    }
+}
+
 const double BaseSpineCPGControl::getCPGValue(std::size_t i) const
 {
 	// Error handling on input done in CPG_Equations
@@ -41,6 +41,7 @@
 
 // Forward Declarations
 class tgImpedanceController;
+class tgSpringCableActuator;
 class AnnealEvolution;
 class configuration;
 class tgCPGActuatorControl;
@@ -125,6 +126,13 @@ struct Config
     virtual void onSetup(BaseSpineModelLearning& subject);
     
     virtual void onTeardown(BaseSpineModelLearning& subject);
+    
+    /**
+     * Rebuild the CPGs against the restored model with the parameters
+     * of the running trial. The adapters are not advanced and the
+     * episode that was running is not scored.
+     */
+    virtual void onRestore(BaseSpineModelLearning& subject);
 
 	const double getCPGValue(std::size_t i) const;
 	
@@ -140,6 +148,32 @@ protected:
     virtual array_2D scaleNodeActions (std::vector< std::vector <double> > actions);
     
     virtual void setupCPGs(BaseSpineModelLearning& subject, array_2D nodeActions, array_4D edgeActions);
+    
+    /**
+     * Initialize the learning adapters, which moves them on to the next
+     * trial. Called by onSetup but not by onRestore.
+     */
+    virtual void initializeAdapters();
+    
+    /**
+     * Build the CPGs from the adapters' current parameters and start
+     * a new episode. Called by onSetup and onRestore.
+     */
+    virtual void setupEpisode(BaseSpineModelLearning& subject);
+    
+    /**
+     * Detach the cable controllers from the muscles and delete them and
+     * the CPG system, undoing setupEpisode. Subclasses that allocate
+     * more in setupEpisode should delete it here too.
+     */
+    virtual void deleteCPGs(BaseSpineModelLearning& subject);
+    
+    /**
+     * Detach a controller from whichever actuators of subject it is
+     * attached to, so it can be deleted while they live on
+     */
+    void detachFromMuscles(BaseSpineModelLearning& subject,
+                           tgObserver<tgSpringCableActuator>* pController);
 
     CPGEquations* m_pCPGSys;
     
@@ -119,19 +119,17 @@ feedbackLearning(false)
     
 }
 
-void SpineFeedbackControl::onSetup(BaseSpineModelLearning& subject)
+void SpineFeedbackControl::initializeAdapters()
 {
-	m_pCPGSys = new CPGEquationsFB(100);
-    //Initialize the Learning Adapters
-    nodeAdapter.initialize(&nodeEvolution,
-                            nodeLearning,
-                            nodeConfigData);
-    edgeAdapter.initialize(&edgeEvolution,
-                            edgeLearning,
-                            edgeConfigData);
+    BaseSpineCPGControl::initializeAdapters();
     feedbackAdapter.initialize(&feedbackEvolution,
                                 feedbackLearning,
                                 feedbackConfigData);
+}
+
+void SpineFeedbackControl::setupEpisode(BaseSpineModelLearning& subject)
+{
+	m_pCPGSys = new CPGEquationsFB(100);
     /* Empty vector signifying no state information
      * All parameters are stateless parameters, so we can get away with
      * only doing this once
@@ -253,14 +251,7 @@ void SpineFeedbackControl::onTeardown(BaseSpineModelLearning& subject)
     nodeAdapter.endEpisode(scores);
     feedbackAdapter.endEpisode(scores);
     
-    delete m_pCPGSys;
-    m_pCPGSys = NULL;
-    
-    for(size_t i = 0; i < m_allControllers.size(); i++)
-    {
-        delete m_allControllers[i];
-    }
-    m_allControllers.clear();    
+    deleteCPGs(subject);
 }
 
 void SpineFeedbackControl::setupCPGs(BaseSpineModelLearning& subject, array_2D nodeActions, array_4D edgeActions)
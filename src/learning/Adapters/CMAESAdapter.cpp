@@ -0,0 +1,85 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file CMAESAdapter.cpp
+ * @brief Contains the implementation of class CMAESAdapter.
+ * $Id$
+ */
+
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include "CMAESAdapter.h"
+#include "learning/Configuration/configuration.h"
+
+using namespace std;
+
+CMAESAdapter::CMAESAdapter() :
+cmaesEvo(NULL),
+totalTime(0.0)
+{
+}
+CMAESAdapter::~CMAESAdapter(){};
+
+void CMAESAdapter::initialize(CMAESEvolution *evo, bool isLearning, configuration configdata)
+{
+    totalTime = 0.0;
+
+    this->cmaesEvo = evo;
+    currentControllers = this->cmaesEvo->nextSetOfControllers();
+    if(!isLearning)
+    {
+        for(size_t i = 0; i < currentControllers.size(); i++)
+        {
+            stringstream ss;
+            ss << cmaesEvo->resourcePath << "logs/bestParameters-" << this->cmaesEvo->suffix << "-" << i << ".nnw";
+            currentControllers[i]->loadFromFile(ss.str().c_str());
+        }
+    }
+}
+
+vector<vector<double> > CMAESAdapter::step(double deltaTimeSeconds, vector<double> state)
+{
+    totalTime += deltaTimeSeconds;
+    vector< vector<double> > actions;
+
+    for(size_t i = 0; i < currentControllers.size(); i++)
+    {
+        actions.push_back(currentControllers[i]->statelessParameters);
+    }
+
+    return actions;
+}
+
+void CMAESAdapter::endEpisode(vector<double> scores)
+{
+    if(scores.size() == 0)
+    {
+        vector< double > tmp(1);
+        tmp[0] = -1;
+        cmaesEvo->updateScores(tmp);
+        cout << "Exploded" << endl;
+    }
+    else
+    {
+        cout << "Dist Moved: " << scores[0] << endl;
+        cmaesEvo->updateScores(scores);
+    }
+    return;
+}
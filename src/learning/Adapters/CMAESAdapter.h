@@ -0,0 +1,58 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef CMAESADAPTER_H_
+#define CMAESADAPTER_H_
+
+/**
+ * @file CMAESAdapter.h
+ * @brief Defines a class CMAESAdapter to pass parameters from CMAESEvolution to a controller.
+ * $Id$
+ */
+
+#include <vector>
+#include "learning/CMAES/CMAESEvolution.h"
+#include "learning/CMAES/CMAESMember.h"
+
+class configuration;
+
+/**
+ * Drives CMAESEvolution with the same calls AnnealAdapter makes on
+ * AnnealEvolution, so a controller can switch engines by swapping the
+ * adapter and evolution types.
+ */
+class CMAESAdapter
+{
+public:
+    CMAESAdapter();
+    ~CMAESAdapter();
+    /**
+     * Initialize needs to be called at the beginning of each trial
+     * main or simulator owns the pointer to CMAESEvolution
+     */
+    void initialize(CMAESEvolution *evo, bool isLearning, configuration config);
+    std::vector<std::vector<double> > step(double deltaTimeSeconds, std::vector<double> state);
+    void endEpisode(std::vector<double> scores);
+
+private:
+    CMAESEvolution *cmaesEvo;
+    std::vector<CMAESMember *> currentControllers;
+    double totalTime;
+};
+
+#endif /* CMAESADAPTER_H_ */
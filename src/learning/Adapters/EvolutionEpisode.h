@@ -0,0 +1,259 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef EVOLUTION_EPISODE_H_
+#define EVOLUTION_EPISODE_H_
+
+/**
+ * @file EvolutionEpisode.h
+ * @brief Contains the definition of class template EvolutionEpisode and
+ * the function template evaluateGeneration
+ * $Id$
+ */
+
+// This application
+#include "core/tgParallelRunner.h"
+#include "learning/FitnessCache/FitnessCache.h"
+// The C++ Standard Library
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * The parameters of a set of controllers, one member after another, as
+ * they are hashed for FitnessCache keys and episode seeds
+ */
+template <class Member>
+std::vector<double> evolutionParameters(const std::vector<Member*>& controllers)
+{
+    std::vector<double> parameters;
+    for (std::size_t i = 0; i < controllers.size(); i++)
+    {
+        const std::vector<double> p = controllers[i]->getParameters();
+        parameters.insert(parameters.end(), p.begin(), p.end());
+    }
+    return parameters;
+}
+
+/**
+ * One evaluation of a set of controllers from AnnealEvolution or
+ * NeuroEvolution, run by evaluateGeneration on a tgParallelRunner.
+ * Subclasses build the model and controller from getControllers() in
+ * setup() and return the scores updateScores expects from evaluate().
+ *
+ * Several episodes may share a member and run at the same time, so
+ * members must only be read. In particular a NeuroEvoMember's network
+ * keeps state while feeding forward: copy its weights into a network
+ * owned by the episode instead of calling it directly.
+ */
+template <class Member>
+class EvolutionEpisode : public tgEpisode
+{
+public:
+
+    EvolutionEpisode(const std::vector<Member*>& controllers) :
+        m_controllers(controllers),
+        m_evaluated(false)
+    {
+    }
+
+    virtual ~EvolutionEpisode() { }
+
+    /**
+     * Called after the episode has run.
+     * @return the scores to pass to updateScores, usually the distance
+     * moved and the energy spent; empty if the episode failed
+     */
+    virtual std::vector<double> evaluate(tgSimulation& simulation) = 0;
+
+    /** Records evaluate()'s result and returns its first score */
+    virtual double score(tgSimulation& simulation)
+    {
+        m_scores = evaluate(simulation);
+        m_evaluated = true;
+        return m_scores.empty() ? -1.0 : m_scores[0];
+    }
+
+    const std::vector<Member*>& getControllers() const
+    {
+        return m_controllers;
+    }
+
+    /**
+     * A seed that depends only on the controllers' parameters. Seed any
+     * randomness in setup() from it, so that running the same parameters
+     * again gives the same scores and FitnessCache entries stay valid.
+     */
+    unsigned long getSeed() const
+    {
+        return FitnessCache::seedFor(
+            FitnessCache::hashParameters(evolutionParameters(m_controllers)));
+    }
+
+    /** evaluate()'s result, empty if the episode has not been scored */
+    const std::vector<double>& getScores() const
+    {
+        return m_scores;
+    }
+
+    /** False until score() has returned, e.g. if setup() threw */
+    bool isEvaluated() const
+    {
+        return m_evaluated;
+    }
+
+private:
+
+    const std::vector<Member*> m_controllers;
+    std::vector<double> m_scores;
+    bool m_evaluated;
+};
+
+/**
+ * Evaluate one generation of an evolution on a pool of simulations.
+ * Takes every set of controllers from evolution.nextGeneration(), makes
+ * an episode for each with factory.create(controllers), runs them on
+ * runner and reports their scores. The selection that follows is the
+ * same as if the episodes had run one after another.
+ *
+ * With a cache, sets it already has scores for are not simulated, nor
+ * are repeats of a set within the generation, and the scores of the
+ * episodes that ran are stored in it. Members need a getParameters()
+ * method returning everything that defines them.
+ *
+ * Episodes that fail are scored as exploded, -1, so the generation can
+ * continue; the runner's error is then rethrown. Episodes that threw are
+ * not cached.
+ *
+ * @param[in,out] evolution an AnnealEvolution, NeuroEvolution or
+ * CMAESEvolution
+ * @param[in] runner the thread pool, one simulation per worker
+ * @param[in] factory has a method
+ * EvolutionEpisode<Evolution::Member>* create(const std::vector<Evolution::Member*>&)
+ * returning a new episode; it is called on this thread
+ * @param[in,out] pCache scores already known, may be NULL
+ * @throw std::runtime_error if any episode threw
+ */
+template <class Evolution, class Factory>
+void evaluateGeneration(Evolution& evolution,
+                        tgParallelRunner& runner,
+                        Factory& factory,
+                        FitnessCache* pCache)
+{
+    typedef typename Evolution::Member Member;
+    typedef EvolutionEpisode<Member> Episode;
+    
+    const std::vector< std::vector<Member*> > sets =
+        evolution.nextGeneration();
+    const std::size_t n = sets.size();
+
+    // Which episode scores each set, or the cached scores
+    std::vector<Episode*> episodes(n, static_cast<Episode*>(NULL));
+    std::vector<std::size_t> scoredBy(n);
+    std::vector< std::vector<double> > cached(n);
+    std::vector<bool> isCached(n, false);
+    std::vector<FitnessCache::Key> keys(n, 0);
+    std::map<FitnessCache::Key, std::size_t> firstWithKey;
+
+    std::vector<tgEpisode*> toRun;
+    try
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            scoredBy[i] = i;
+            if (pCache != NULL)
+            {
+                keys[i] = pCache->key(evolutionParameters(sets[i]));
+                if (pCache->lookup(keys[i], cached[i]))
+                {
+                    isCached[i] = true;
+                    continue;
+                }
+                typename std::map<FitnessCache::Key, std::size_t>::const_iterator
+                    first = firstWithKey.find(keys[i]);
+                if (first != firstWithKey.end())
+                {
+                    scoredBy[i] = first->second;
+                    continue;
+                }
+                firstWithKey[keys[i]] = i;
+            }
+            episodes[i] = factory.create(sets[i]);
+            toRun.push_back(episodes[i]);
+        }
+    }
+    catch (...)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            delete episodes[i];
+        }
+        throw;
+    }
+
+    std::string error;
+    try
+    {
+        runner.run(toRun);
+    }
+    catch (const std::runtime_error& e)
+    {
+        error = e.what();
+    }
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        if (isCached[i])
+        {
+            evolution.updateScores(i, cached[i]);
+            continue;
+        }
+        const Episode& episode = *episodes[scoredBy[i]];
+        // As AnnealAdapter::endEpisode scores an exploded episode
+        const std::vector<double> scores =
+            episode.isEvaluated() && !episode.getScores().empty() ?
+            episode.getScores() : std::vector<double>(1, -1.0);
+        if (pCache != NULL && scoredBy[i] == i && episode.isEvaluated())
+        {
+            pCache->store(keys[i], scores);
+        }
+        evolution.updateScores(i, scores);
+    }
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        delete episodes[i];
+    }
+
+    if (!error.empty())
+    {
+        throw std::runtime_error(error);
+    }
+}
+
+/** evaluateGeneration without a FitnessCache */
+template <class Evolution, class Factory>
+void evaluateGeneration(Evolution& evolution,
+                        tgParallelRunner& runner,
+                        Factory& factory)
+{
+    evaluateGeneration(evolution, runner, factory, static_cast<FitnessCache*>(NULL));
+}
+
+#endif // EVOLUTION_EPISODE_H_
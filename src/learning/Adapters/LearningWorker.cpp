@@ -0,0 +1,197 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file LearningWorker.cpp
+ * @brief Contains the implementation of class LearningWorker
+ * $Id$
+ */
+
+// This module
+#include "LearningWorker.h"
+// The C++ Standard Library
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+// POSIX
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+LearningWorker::LearningWorker(const std::string& socketPath) :
+    m_socket(-1)
+{
+    sockaddr_un address;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        throw std::invalid_argument("Socket path is too long: " + socketPath);
+    }
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, socketPath.c_str());
+
+    m_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (m_socket < 0 ||
+        connect(m_socket,
+                reinterpret_cast<sockaddr*>(&address),
+                sizeof(address)) != 0)
+    {
+        const std::string reason(std::strerror(errno));
+        if (m_socket >= 0)
+        {
+            close(m_socket);
+        }
+        throw std::runtime_error("Could not connect to scheduler at " +
+                                 socketPath + ": " + reason);
+    }
+}
+
+LearningWorker::LearningWorker(int connectedSocket) :
+    m_socket(connectedSocket)
+{
+    if (connectedSocket < 0)
+    {
+        throw std::invalid_argument("Socket is not valid");
+    }
+}
+
+LearningWorker::~LearningWorker()
+{
+    close(m_socket);
+}
+
+bool LearningWorker::nextJob(Job& job)
+{
+    const Reply reply = request("ready", job);
+    if (reply == NO_JOB)
+    {
+        throw std::runtime_error("Scheduler answered ready with none");
+    }
+    return reply == JOB;
+}
+
+LearningWorker::Reply LearningWorker::followingJob(Job& job)
+{
+    return request("next", job);
+}
+
+LearningWorker::Reply LearningWorker::request(const std::string& verb,
+                                              Job& job)
+{
+    std::ostringstream message;
+    message << verb << " " << getpid();
+    send(message.str());
+    
+    std::string line;
+    if (!receive(line) || line == "quit")
+    {
+        return QUIT;
+    }
+    else if (line == "none")
+    {
+        return NO_JOB;
+    }
+
+    std::istringstream in(line);
+    std::string command;
+    const bool parsed = (in >> command >> job.id >> job.steps) &&
+        std::getline(in >> std::ws, job.args);
+    if (!parsed || command != "job" || job.steps <= 0)
+    {
+        throw std::runtime_error("Bad message from scheduler: " + line);
+    }
+    return JOB;
+}
+
+void LearningWorker::reportScores(const Job& job,
+                                  const std::vector<double>& scores)
+{
+    std::ostringstream done;
+    done.precision(17);
+    done << "done " << job.id;
+    for (std::size_t i = 0; i < scores.size(); i++)
+    {
+        done << " " << scores[i];
+    }
+    send(done.str());
+}
+
+void LearningWorker::reportError(const Job& job, const std::string& what)
+{
+    std::string message(what);
+    // Keep the message on one line
+    for (std::size_t i = 0; i < message.size(); i++)
+    {
+        if (message[i] == '\n')
+        {
+            message[i] = ' ';
+        }
+    }
+    send("error " + job.id + " " + message);
+}
+
+void LearningWorker::send(const std::string& line)
+{
+    const std::string data(line + "\n");
+    std::size_t sent = 0;
+    while (sent < data.size())
+    {
+        // MSG_NOSIGNAL: a vanished scheduler is an error, not SIGPIPE
+        const ssize_t n = ::send(m_socket, data.data() + sent,
+                                 data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno != EINTR)
+        {
+            throw std::runtime_error(std::string("Lost the scheduler: ") +
+                                     std::strerror(errno));
+        }
+        else if (n > 0)
+        {
+            sent += n;
+        }
+    }
+}
+
+bool LearningWorker::receive(std::string& line)
+{
+    std::size_t end = m_buffer.find('\n');
+    while (end == std::string::npos)
+    {
+        char chunk[512];
+        const ssize_t n = recv(m_socket, chunk, sizeof(chunk), 0);
+        if (n == 0)
+        {
+            return false;
+        }
+        else if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::runtime_error(std::string("Lost the scheduler: ") +
+                                     std::strerror(errno));
+        }
+        m_buffer.append(chunk, n);
+        end = m_buffer.find('\n');
+    }
+    line = m_buffer.substr(0, end);
+    m_buffer.erase(0, end + 1);
+    return true;
+}
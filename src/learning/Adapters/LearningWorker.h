@@ -0,0 +1,135 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef LEARNING_WORKER_H_
+#define LEARNING_WORKER_H_
+
+/**
+ * @file LearningWorker.h
+ * @brief Contains the definition of class LearningWorker
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <string>
+#include <vector>
+
+/**
+ * The connection of a long lived learning app to a scheduler, such as
+ * scripts/learning/src/worker_scheduler.py. The app builds its world
+ * once and then evaluates one parameter file after another, instead of
+ * being started again for every trial.
+ *
+ * The scheduler listens on a Unix socket; the worker connects to it and
+ * they exchange text lines:
+ * - worker: "ready <pid>" asks for a job when it has nothing to report;
+ *   the scheduler may hold its answer until it has work
+ * - worker: "next <pid>" asks for a job to follow the one it just ran,
+ *   before reporting it, since the JSON controllers only score on
+ *   teardown and setup needs the next file; the scheduler answers at once
+ * - scheduler: "job <id> <steps> <file>" runs file for steps steps, where
+ *   file is what the app would be given with -l; "none" (to "next" only)
+ *   if there is no job now; or "quit"
+ * - worker: "done <id> <score>..." or "error <id> <message>"
+ */
+class LearningWorker
+{
+public:
+
+    /** The scheduler's answer to followingJob */
+    enum Reply
+    {
+        JOB,
+        NO_JOB,
+        QUIT
+    };
+
+    struct Job
+    {
+        Job() : steps(0) { }
+        
+        /** Chosen by the scheduler, echoed back with the scores */
+        std::string id;
+        int steps;
+        /** The parameter file, relative to the app's resource path */
+        std::string args;
+    };
+
+    /**
+     * Connect to the scheduler
+     * @param[in] socketPath the path of the scheduler's Unix socket
+     * @throw std::runtime_error if the connection fails
+     */
+    LearningWorker(const std::string& socketPath);
+
+    /**
+     * Use a connection made elsewhere, such as one end of a socketpair
+     * @param[in] connectedSocket a connected stream socket, closed by
+     * the destructor
+     * @throw std::invalid_argument if connectedSocket is negative
+     */
+    explicit LearningWorker(int connectedSocket);
+
+    ~LearningWorker();
+
+    /**
+     * Ask for the next job and wait for it
+     * @param[out] job the job, if there is one
+     * @return false if the scheduler said quit or closed the connection
+     * @throw std::runtime_error on a malformed message
+     */
+    bool nextJob(Job& job);
+
+    /**
+     * Ask for a job to follow the one that just ran, before reporting it
+     * @param[out] job the job, if the reply is JOB
+     * @throw std::runtime_error on a malformed message
+     */
+    Reply followingJob(Job& job);
+
+    /** Report the scores of a finished job */
+    void reportScores(const Job& job, const std::vector<double>& scores);
+
+    /** Report that a job could not be run */
+    void reportError(const Job& job, const std::string& what);
+
+private:
+
+    /** Send a request and parse the reply */
+    Reply request(const std::string& verb, Job& job);
+
+    /** Send one line, adding the newline */
+    void send(const std::string& line);
+
+    /**
+     * Receive one line, without the newline
+     * @return false if the connection was closed
+     */
+    bool receive(std::string& line);
+
+    int m_socket;
+
+    /** Bytes received after the last complete line */
+    std::string m_buffer;
+
+    /** Not copyable */
+    LearningWorker(const LearningWorker&);
+    LearningWorker& operator=(const LearningWorker&);
+};
+
+#endif // LEARNING_WORKER_H_
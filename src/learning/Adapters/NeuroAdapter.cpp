@@ -27,7 +27,6 @@
 #include "NeuroAdapter.h"
 #include "learning/Configuration/configuration.h"
 #include "helpers/FileHelpers.h"
-#include "neuralNet/Neural Network v2/neuralNetwork.h"
 
 #include <vector>
 #include <iostream>
@@ -66,6 +65,14 @@ void NeuroAdapter::initialize(NeuroEvolution *evo,bool isLearning,configuration
 			currentControllers[i]->loadFromFile(ss.str().c_str());
 		}
 	}
+	currentNetworks.clear();
+	if(numberOfStates>0)
+	{
+		for(std::size_t i=0;i<currentControllers.size();i++)
+		{
+			currentNetworks.push_back(currentControllers[i]->getNetwork());
+		}
+	}
 	errorOfFirstController=0.0;
 }
 
@@ -76,7 +83,7 @@ vector<vector<double> > NeuroAdapter::step(double deltaTimeSeconds,vector<double
 	vector< vector<double> > actions;
 	if(numberOfStates>0)
 	{
-		double *inputs = new double[numberOfStates];
+		inputs.resize(numberOfStates);
 
 		//scale inputs to 0-1 from -1 to 1 (unit vector provided from the controller).
 		// Assumes inputs are already scaled -1 to 1
@@ -85,17 +92,11 @@ vector<vector<double> > NeuroAdapter::step(double deltaTimeSeconds,vector<double
 		{
 			inputs[i]=state[i] / 2.0 + 0.5;
 		}
-		for(std::size_t i=0;i<currentControllers.size();i++)
+		for(std::size_t i=0;i<currentNetworks.size();i++)
 		{
-			double *output=currentControllers[i]->getNn()->feedForwardPattern(inputs);
-			vector<double> tmpAct;
-			for(int j=0;j<numberOfActions;j++)
-			{
-				tmpAct.push_back(output[j]);
-			}
-			actions.push_back(tmpAct);
+			currentNetworks[i].feedForward(inputs, outputs);
+			actions.push_back(vector<double>(outputs.begin(), outputs.begin() + numberOfActions));
 		}
-		delete[]inputs;
 	}
 	else
 	{
@@ -30,6 +30,7 @@
 #include <vector>
 #include "../NeuroEvolution/NeuroEvolution.h"
 #include "../NeuroEvolution/NeuroEvoMember.h"
+#include "../MLP/MLPNetwork.h"
 
 class NeuroAdapter
 {
@@ -51,6 +52,10 @@ private:
 	int numberOfControllers;
 	NeuroEvolution *neuroEvo;
 	std::vector< NeuroEvoMember *>currentControllers;
+	/** The controllers' networks, copied for inference once per episode */
+	std::vector<MLPNetwork> currentNetworks;
+	std::vector<double> inputs;
+	std::vector<double> outputs;
 	std::vector<double> initialPosition;
 	double errorOfFirstController;
     /** Appears unused */
@@ -33,16 +33,17 @@
 
 using namespace std;
 
-AnnealEvoMember::AnnealEvoMember(configuration config)
+AnnealEvoMember::AnnealEvoMember(configuration config, std::tr1::ranlux64_base_01 *eng)
 {
     //readConfigFromXML(configFile);
     this->numOutputs=config.getintvalue("numberOfActions");
     this->devBase=config.getDoubleValue("deviation");
     this->monteCarlo=config.getintvalue("MonteCarlo");
     
+    std::tr1::uniform_real<double> unif(0, 1);
     statelessParameters.resize(numOutputs);
     for(int i=0;i<numOutputs;i++)
-        statelessParameters[i]=rand()*1.0/RAND_MAX;
+        statelessParameters[i]=unif(*eng);
 
     maxScore=-1000;
 }
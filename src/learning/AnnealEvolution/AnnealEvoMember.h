@@ -37,7 +37,8 @@
 class AnnealEvoMember
 {
 public:
-    AnnealEvoMember(configuration config);
+    /** Parameters start uniformly random in [0, 1), drawn from eng */
+    AnnealEvoMember(configuration config, std::tr1::ranlux64_base_01 *eng);
     ~AnnealEvoMember();
     void mutate(std::tr1::ranlux64_base_01 *eng, double T);
 
@@ -45,6 +46,12 @@ public:
     void saveToFile(const char* outputFilename);
     void loadFromFile(const char* inputFilename);
 
+    /** Everything that defines this member, for FitnessCache keys */
+    const std::vector<double>& getParameters() const
+    {
+        return statelessParameters;
+    }
+
     std::vector<double> statelessParameters;
     //scores for evaluation
     std::vector<double> pastScores;
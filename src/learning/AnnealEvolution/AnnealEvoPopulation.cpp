@@ -35,7 +35,7 @@
 
 using namespace std;
 
-AnnealEvoPopulation::AnnealEvoPopulation(int populationSize,configuration config)
+AnnealEvoPopulation::AnnealEvoPopulation(int populationSize,configuration config,std::tr1::ranlux64_base_01 *eng)
 {
     compareAverageScores=true;
     clearScoresBetweenGenerations=false;
@@ -45,7 +45,7 @@ AnnealEvoPopulation::AnnealEvoPopulation(int populationSize,configuration config
     for(int i=0;i<populationSize;i++)
     {
         //cout<<"  creating members"<<endl;
-        controllers.push_back(new AnnealEvoMember(config));
+        controllers.push_back(new AnnealEvoMember(config, eng));
     }
 }
 
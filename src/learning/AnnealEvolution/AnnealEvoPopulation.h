@@ -33,7 +33,7 @@
 
 class AnnealEvoPopulation {
 public:
-    AnnealEvoPopulation(int numControllers,configuration config);
+    AnnealEvoPopulation(int numControllers,configuration config,std::tr1::ranlux64_base_01 *eng);
     ~AnnealEvoPopulation();
     std::vector<AnnealEvoMember *> controllers;
     void mutate(std::tr1::ranlux64_base_01 *eng,std::size_t numToMutate, double T);
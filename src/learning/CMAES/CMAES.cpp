@@ -0,0 +1,588 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file CMAES.cpp
+ * @brief Contains the implementation of class CMAES
+ * $Id$
+ */
+
+// This module
+#include "CMAES.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    /** Square tiles small enough that both operands stay in cache */
+    const std::size_t tileSize = 32;
+
+    /**
+     * C[i][j] += sum_k A[i][k] * B[j][k], the product of A and the
+     * transpose of B, computed tile by tile. Both operands are read
+     * along their rows. If lower, only entries with j <= i are touched.
+     */
+    void multiplyTransposed(const std::vector<double>& A, std::size_t rowsA,
+                            const std::vector<double>& B, std::size_t rowsB,
+                            std::size_t inner, std::vector<double>& C,
+                            bool lower)
+    {
+        for (std::size_t i0 = 0; i0 < rowsA; i0 += tileSize)
+        {
+            const std::size_t i1 = std::min(i0 + tileSize, rowsA);
+            for (std::size_t j0 = 0; j0 < rowsB && (!lower || j0 < i1);
+                 j0 += tileSize)
+            {
+                const std::size_t j1 = std::min(j0 + tileSize, rowsB);
+                for (std::size_t i = i0; i < i1; ++i)
+                {
+                    const double* a = &A[i * inner];
+                    const std::size_t jEnd = lower ? std::min(j1, i + 1) : j1;
+                    for (std::size_t j = j0; j < jEnd; ++j)
+                    {
+                        const double* b = &B[j * inner];
+                        double sum = 0.0;
+                        for (std::size_t k = 0; k < inner; ++k)
+                        {
+                            sum += a[k] * b[k];
+                        }
+                        C[i * rowsB + j] += sum;
+                    }
+                }
+            }
+        }
+    }
+
+    double hypotenuse(double a, double b)
+    {
+        return std::sqrt(a * a + b * b);
+    }
+
+    /**
+     * Householder reduction of the symmetric matrix V to tridiagonal
+     * form, accumulating the transformation in V. After the EISPACK
+     * routine tred2, by way of the public domain JAMA library.
+     */
+    void tridiagonalize(std::vector<double>& V, std::vector<double>& d,
+                        std::vector<double>& e, std::size_t n)
+    {
+        for (std::size_t j = 0; j < n; j++)
+        {
+            d[j] = V[(n - 1) * n + j];
+        }
+
+        for (std::size_t i = n - 1; i > 0; i--)
+        {
+            double scale = 0.0;
+            double h = 0.0;
+            for (std::size_t k = 0; k < i; k++)
+            {
+                scale += std::fabs(d[k]);
+            }
+            if (scale == 0.0)
+            {
+                e[i] = d[i - 1];
+                for (std::size_t j = 0; j < i; j++)
+                {
+                    d[j] = V[(i - 1) * n + j];
+                    V[i * n + j] = 0.0;
+                    V[j * n + i] = 0.0;
+                }
+            }
+            else
+            {
+                // Generate the Householder vector
+                for (std::size_t k = 0; k < i; k++)
+                {
+                    d[k] /= scale;
+                    h += d[k] * d[k];
+                }
+                double f = d[i - 1];
+                double g = std::sqrt(h);
+                if (f > 0)
+                {
+                    g = -g;
+                }
+                e[i] = scale * g;
+                h = h - f * g;
+                d[i - 1] = f - g;
+                for (std::size_t j = 0; j < i; j++)
+                {
+                    e[j] = 0.0;
+                }
+
+                // Apply the similarity transformation to the remaining columns
+                for (std::size_t j = 0; j < i; j++)
+                {
+                    f = d[j];
+                    V[j * n + i] = f;
+                    g = e[j] + V[j * n + j] * f;
+                    for (std::size_t k = j + 1; k <= i - 1; k++)
+                    {
+                        g += V[k * n + j] * d[k];
+                        e[k] += V[k * n + j] * f;
+                    }
+                    e[j] = g;
+                }
+                f = 0.0;
+                for (std::size_t j = 0; j < i; j++)
+                {
+                    e[j] /= h;
+                    f += e[j] * d[j];
+                }
+                const double hh = f / (h + h);
+                for (std::size_t j = 0; j < i; j++)
+                {
+                    e[j] -= hh * d[j];
+                }
+                for (std::size_t j = 0; j < i; j++)
+                {
+                    f = d[j];
+                    g = e[j];
+                    for (std::size_t k = j; k <= i - 1; k++)
+                    {
+                        V[k * n + j] -= (f * e[k] + g * d[k]);
+                    }
+                    d[j] = V[(i - 1) * n + j];
+                    V[i * n + j] = 0.0;
+                }
+            }
+            d[i] = h;
+        }
+
+        // Accumulate the transformations
+        for (std::size_t i = 0; i + 1 < n; i++)
+        {
+            V[(n - 1) * n + i] = V[i * n + i];
+            V[i * n + i] = 1.0;
+            const double h = d[i + 1];
+            if (h != 0.0)
+            {
+                for (std::size_t k = 0; k <= i; k++)
+                {
+                    d[k] = V[k * n + i + 1] / h;
+                }
+                for (std::size_t j = 0; j <= i; j++)
+                {
+                    double g = 0.0;
+                    for (std::size_t k = 0; k <= i; k++)
+                    {
+                        g += V[k * n + i + 1] * V[k * n + j];
+                    }
+                    for (std::size_t k = 0; k <= i; k++)
+                    {
+                        V[k * n + j] -= g * d[k];
+                    }
+                }
+            }
+            for (std::size_t k = 0; k <= i; k++)
+            {
+                V[k * n + i + 1] = 0.0;
+            }
+        }
+        for (std::size_t j = 0; j < n; j++)
+        {
+            d[j] = V[(n - 1) * n + j];
+            V[(n - 1) * n + j] = 0.0;
+        }
+        V[(n - 1) * n + n - 1] = 1.0;
+        e[0] = 0.0;
+    }
+
+    /**
+     * Eigenvalues d and eigenvectors V of the tridiagonal matrix left by
+     * tridiagonalize, by the implicit QL method. After tql2.
+     * @throw std::runtime_error if it fails to converge
+     */
+    void diagonalize(std::vector<double>& V, std::vector<double>& d,
+                     std::vector<double>& e, std::size_t n)
+    {
+        for (std::size_t i = 1; i < n; i++)
+        {
+            e[i - 1] = e[i];
+        }
+        e[n - 1] = 0.0;
+
+        double f = 0.0;
+        double tst1 = 0.0;
+        const double eps = std::pow(2.0, -52.0);
+        for (std::size_t l = 0; l < n; l++)
+        {
+            // Find a small subdiagonal element
+            tst1 = std::max(tst1, std::fabs(d[l]) + std::fabs(e[l]));
+            std::size_t m = l;
+            while (m < n - 1 && std::fabs(e[m]) > eps * tst1)
+            {
+                m++;
+            }
+
+            // If m == l, d[l] is an eigenvalue, otherwise iterate
+            if (m > l)
+            {
+                std::size_t iterations = 0;
+                do
+                {
+                    if (++iterations > 30 * n)
+                    {
+                        throw std::runtime_error("CMAES eigendecomposition did not converge");
+                    }
+
+                    // Compute the implicit shift
+                    double g = d[l];
+                    double p = (d[l + 1] - g) / (2.0 * e[l]);
+                    double r = hypotenuse(p, 1.0);
+                    if (p < 0)
+                    {
+                        r = -r;
+                    }
+                    d[l] = e[l] / (p + r);
+                    d[l + 1] = e[l] * (p + r);
+                    const double dl1 = d[l + 1];
+                    double h = g - d[l];
+                    for (std::size_t i = l + 2; i < n; i++)
+                    {
+                        d[i] -= h;
+                    }
+                    f = f + h;
+
+                    // Implicit QL transformation
+                    p = d[m];
+                    double c = 1.0;
+                    double c2 = c;
+                    double c3 = c;
+                    const double el1 = e[l + 1];
+                    double s = 0.0;
+                    double s2 = 0.0;
+                    for (std::size_t i = m; i-- > l; )
+                    {
+                        c3 = c2;
+                        c2 = c;
+                        s2 = s;
+                        g = c * e[i];
+                        h = c * p;
+                        r = hypotenuse(p, e[i]);
+                        e[i + 1] = s * r;
+                        s = e[i] / r;
+                        c = p / r;
+                        p = c * d[i] - s * g;
+                        d[i + 1] = h + s * (c * g + s * d[i]);
+
+                        // Accumulate the transformation
+                        for (std::size_t k = 0; k < n; k++)
+                        {
+                            h = V[k * n + i + 1];
+                            V[k * n + i + 1] = s * V[k * n + i] + c * h;
+                            V[k * n + i] = c * V[k * n + i] - s * h;
+                        }
+                    }
+                    p = -s * s2 * c3 * el1 * e[l] / dl1;
+                    e[l] = s * p;
+                    d[l] = c * p;
+                }
+                while (std::fabs(e[l]) > eps * tst1);
+            }
+            d[l] = d[l] + f;
+            e[l] = 0.0;
+        }
+    }
+}
+
+CMAES::CMAES(const std::vector<double>& mean, double sigma,
+             std::size_t lambda, unsigned long seed) :
+m_n(mean.size()),
+m_mean(mean),
+m_sigma(sigma),
+m_generation(0),
+m_evaluations(0),
+m_eigenEvaluations(0),
+m_asked(false)
+{
+    if (m_n == 0)
+    {
+        throw std::invalid_argument("CMAES needs at least one parameter");
+    }
+    if (!(sigma > 0.0))
+    {
+        throw std::invalid_argument("CMAES step size must be positive");
+    }
+    if (lambda == 1)
+    {
+        throw std::invalid_argument("CMAES needs at least two candidates per generation");
+    }
+
+    const double n = m_n;
+    m_lambda = lambda != 0 ? lambda :
+        4 + static_cast<std::size_t>(3.0 * std::log(n));
+    m_mu = m_lambda / 2;
+
+    // Weights decrease log-linearly with rank and sum to one
+    m_weights.resize(m_mu);
+    double sum = 0.0;
+    for (std::size_t i = 0; i < m_mu; i++)
+    {
+        m_weights[i] = std::log(m_mu + 0.5) - std::log(i + 1.0);
+        sum += m_weights[i];
+    }
+    double sumSquares = 0.0;
+    for (std::size_t i = 0; i < m_mu; i++)
+    {
+        m_weights[i] /= sum;
+        sumSquares += m_weights[i] * m_weights[i];
+    }
+    m_mueff = 1.0 / sumSquares;
+
+    m_cc = (4.0 + m_mueff / n) / (n + 4.0 + 2.0 * m_mueff / n);
+    m_cs = (m_mueff + 2.0) / (n + m_mueff + 5.0);
+    m_c1 = 2.0 / ((n + 1.3) * (n + 1.3) + m_mueff);
+    m_cmu = std::min(1.0 - m_c1,
+                     2.0 * (m_mueff - 2.0 + 1.0 / m_mueff) /
+                     ((n + 2.0) * (n + 2.0) + m_mueff));
+    m_damps = 1.0 + 2.0 * std::max(0.0, std::sqrt((m_mueff - 1.0) / (n + 1.0)) - 1.0) + m_cs;
+    m_chiN = std::sqrt(n) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+
+    m_pc.assign(m_n, 0.0);
+    m_ps.assign(m_n, 0.0);
+    m_C.assign(m_n * m_n, 0.0);
+    m_B.assign(m_n * m_n, 0.0);
+    for (std::size_t i = 0; i < m_n; i++)
+    {
+        m_C[i * m_n + i] = 1.0;
+        m_B[i * m_n + i] = 1.0;
+    }
+    m_D.assign(m_n, 1.0);
+
+    m_eng.seed(seed);
+}
+
+const std::vector< std::vector<double> >& CMAES::ask()
+{
+    if (m_asked)
+    {
+        throw std::logic_error("CMAES generation was asked for twice without being told");
+    }
+
+    std::tr1::normal_distribution<double> normal(0.0, 1.0);
+    std::vector<double> Z(m_lambda * m_n);
+    for (std::size_t i = 0; i < Z.size(); i++)
+    {
+        Z[i] = normal(m_eng);
+    }
+
+    // Y = Z (B D)^T, so each row of Y is B D z ~ N(0, C)
+    std::vector<double> BD(m_B);
+    for (std::size_t i = 0; i < m_n; i++)
+    {
+        for (std::size_t j = 0; j < m_n; j++)
+        {
+            BD[i * m_n + j] *= m_D[j];
+        }
+    }
+    std::vector<double> Y(m_lambda * m_n, 0.0);
+    multiplyTransposed(Z, m_lambda, BD, m_n, m_n, Y, false);
+
+    m_candidates.resize(m_lambda);
+    for (std::size_t k = 0; k < m_lambda; k++)
+    {
+        m_candidates[k].resize(m_n);
+        for (std::size_t i = 0; i < m_n; i++)
+        {
+            m_candidates[k][i] = m_mean[i] + m_sigma * Y[k * m_n + i];
+        }
+    }
+
+    m_asked = true;
+    return m_candidates;
+}
+
+namespace
+{
+    /** Orders candidate indices by decreasing fitness */
+    class ByFitness
+    {
+    public:
+        ByFitness(const std::vector<double>& fitness) :
+        m_fitness(fitness)
+        {
+        }
+
+        bool operator()(std::size_t a, std::size_t b) const
+        {
+            return m_fitness[a] > m_fitness[b];
+        }
+
+    private:
+        const std::vector<double>& m_fitness;
+    };
+}
+
+void CMAES::tell(const std::vector< std::vector<double> >& candidates,
+                 const std::vector<double>& fitness)
+{
+    if (!m_asked)
+    {
+        throw std::logic_error("CMAES was told a generation it did not ask for");
+    }
+    if (candidates.size() != m_lambda || fitness.size() != m_lambda)
+    {
+        throw std::invalid_argument("CMAES needs every candidate of the generation");
+    }
+    for (std::size_t k = 0; k < m_lambda; k++)
+    {
+        if (candidates[k].size() != m_n)
+        {
+            throw std::invalid_argument("CMAES candidate has the wrong dimension");
+        }
+    }
+
+    m_asked = false;
+    m_generation++;
+    m_evaluations += m_lambda;
+
+    std::vector<std::size_t> order(m_lambda);
+    for (std::size_t k = 0; k < m_lambda; k++)
+    {
+        order[k] = k;
+    }
+    std::stable_sort(order.begin(), order.end(), ByFitness(fitness));
+
+    // Recombine the mu best into the new mean
+    const std::vector<double> oldMean(m_mean);
+    m_mean.assign(m_n, 0.0);
+    for (std::size_t r = 0; r < m_mu; r++)
+    {
+        const std::vector<double>& x = candidates[order[r]];
+        for (std::size_t i = 0; i < m_n; i++)
+        {
+            m_mean[i] += m_weights[r] * x[i];
+        }
+    }
+
+    std::vector<double> step(m_n);
+    for (std::size_t i = 0; i < m_n; i++)
+    {
+        step[i] = (m_mean[i] - oldMean[i]) / m_sigma;
+    }
+
+    // Conjugate evolution path: C^(-1/2) step = B D^-1 B^T step
+    std::vector<double> t(m_n, 0.0);
+    for (std::size_t i = 0; i < m_n; i++)
+    {
+        for (std::size_t j = 0; j < m_n; j++)
+        {
+            t[j] += m_B[i * m_n + j] * step[i];
+        }
+    }
+    for (std::size_t j = 0; j < m_n; j++)
+    {
+        t[j] /= m_D[j];
+    }
+    const double csFactor = std::sqrt(m_cs * (2.0 - m_cs) * m_mueff);
+    double psNorm = 0.0;
+    for (std::size_t i = 0; i < m_n; i++)
+    {
+        double whitened = 0.0;
+        for (std::size_t j = 0; j < m_n; j++)
+        {
+            whitened += m_B[i * m_n + j] * t[j];
+        }
+        m_ps[i] = (1.0 - m_cs) * m_ps[i] + csFactor * whitened;
+        psNorm += m_ps[i] * m_ps[i];
+    }
+    psNorm = std::sqrt(psNorm);
+
+    // Stall the covariance path while the step size is growing fast
+    const double n = m_n;
+    const bool hsig = psNorm /
+        std::sqrt(1.0 - std::pow(1.0 - m_cs, 2.0 * m_generation)) / m_chiN <
+        1.4 + 2.0 / (n + 1.0);
+    const double ccFactor = std::sqrt(m_cc * (2.0 - m_cc) * m_mueff);
+    for (std::size_t i = 0; i < m_n; i++)
+    {
+        m_pc[i] = (1.0 - m_cc) * m_pc[i] + (hsig ? ccFactor * step[i] : 0.0);
+    }
+
+    // Rank-mu update: sum_r w_r y_r y_r^T as the product of the weighted
+    // and plain n x mu matrices of the selected steps
+    std::vector<double> steps(m_n * m_mu);
+    std::vector<double> weightedSteps(m_n * m_mu);
+    for (std::size_t r = 0; r < m_mu; r++)
+    {
+        const std::vector<double>& x = candidates[order[r]];
+        for (std::size_t i = 0; i < m_n; i++)
+        {
+            const double y = (x[i] - oldMean[i]) / m_sigma;
+            steps[i * m_mu + r] = y;
+            weightedSteps[i * m_mu + r] = m_weights[r] * y;
+        }
+    }
+    std::vector<double> rankMu(m_n * m_n, 0.0);
+    multiplyTransposed(weightedSteps, m_n, steps, m_n, m_mu, rankMu, true);
+
+    const double keep = 1.0 - m_c1 - m_cmu +
+        (hsig ? 0.0 : m_c1 * m_cc * (2.0 - m_cc));
+    for (std::size_t i = 0; i < m_n; i++)
+    {
+        for (std::size_t j = 0; j <= i; j++)
+        {
+            double& c = m_C[i * m_n + j];
+            c = keep * c + m_c1 * m_pc[i] * m_pc[j] + m_cmu * rankMu[i * m_n + j];
+        }
+    }
+
+    m_sigma *= std::exp((m_cs / m_damps) * (psNorm / m_chiN - 1.0));
+
+    if (m_evaluations - m_eigenEvaluations >
+        m_lambda / (m_c1 + m_cmu) / n / 10.0)
+    {
+        updateEigensystem();
+    }
+}
+
+void CMAES::updateEigensystem()
+{
+    m_eigenEvaluations = m_evaluations;
+
+    for (std::size_t i = 0; i < m_n; i++)
+    {
+        for (std::size_t j = 0; j < i; j++)
+        {
+            m_B[i * m_n + j] = m_B[j * m_n + i] = m_C[i * m_n + j];
+        }
+        m_B[i * m_n + i] = m_C[i * m_n + i];
+    }
+
+    std::vector<double> eigenvalues(m_n);
+    std::vector<double> e(m_n);
+    tridiagonalize(m_B, eigenvalues, e, m_n);
+    diagonalize(m_B, eigenvalues, e, m_n);
+
+    // Rounding can leave tiny eigenvalues slightly negative
+    const double largest = *std::max_element(eigenvalues.begin(), eigenvalues.end());
+    for (std::size_t i = 0; i < m_n; i++)
+    {
+        m_D[i] = std::sqrt(std::max(eigenvalues[i], largest * 1e-20));
+    }
+}
+
+double CMAES::getAxisRatio() const
+{
+    return *std::max_element(m_D.begin(), m_D.end()) /
+        *std::min_element(m_D.begin(), m_D.end());
+}
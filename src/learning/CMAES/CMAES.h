@@ -0,0 +1,150 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef CMAES_H_
+#define CMAES_H_
+
+/**
+ * @file CMAES.h
+ * @brief Contains the definition of class CMAES, a covariance matrix
+ * adaptation evolution strategy with an ask/tell interface
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+#include <tr1/random>
+
+/**
+ * (mu/mu_w, lambda)-CMA-ES as described in Hansen, "The CMA Evolution
+ * Strategy: A Tutorial", maximizing the fitness it is told.
+ *
+ * Each generation, ask() returns lambda candidates. Evaluate them in any
+ * order, possibly concurrently, then pass them back to tell() with their
+ * fitness. The caller may repair candidates before evaluation, e.g. to
+ * keep them within bounds, and should tell the repaired ones.
+ *
+ * Matrices are row major n x n. Sampling and the rank-mu covariance
+ * update are blocked matrix products, and the eigendecomposition of the
+ * covariance is only refreshed every O(n / lambda) generations, as the
+ * tutorial recommends, so a generation costs O(lambda n^2).
+ */
+class CMAES
+{
+public:
+
+    /**
+     * @param[in] mean the initial mean of the search distribution
+     * @param[in] sigma the initial step size, > 0
+     * @param[in] lambda the number of candidates per generation, or 0
+     * for the default of 4 + 3 ln(n)
+     * @param[in] seed for the generator of the candidates
+     * @throw std::invalid_argument if mean is empty, sigma is not
+     * positive or lambda is 1
+     */
+    CMAES(const std::vector<double>& mean, double sigma,
+          std::size_t lambda = 0, unsigned long seed = 0);
+
+    /**
+     * Sample this generation's candidates
+     * @throw std::logic_error if the last generation was not told
+     */
+    const std::vector< std::vector<double> >& ask();
+
+    /**
+     * Update the distribution from the evaluated generation
+     * @param[in] candidates as returned by ask, or repaired versions
+     * @param[in] fitness of each candidate, higher is better
+     * @throw std::logic_error if ask was not called first
+     * @throw std::invalid_argument if the sizes don't match
+     */
+    void tell(const std::vector< std::vector<double> >& candidates,
+              const std::vector<double>& fitness);
+
+    std::size_t getDimension() const
+    {
+        return m_n;
+    }
+
+    std::size_t getLambda() const
+    {
+        return m_lambda;
+    }
+
+    const std::vector<double>& getMean() const
+    {
+        return m_mean;
+    }
+
+    double getSigma() const
+    {
+        return m_sigma;
+    }
+
+    /** The number of generations told so far */
+    std::size_t getGeneration() const
+    {
+        return m_generation;
+    }
+
+    /** The square root of the largest over the smallest eigenvalue of C */
+    double getAxisRatio() const;
+
+private:
+
+    /** Recompute m_B and m_D from m_C */
+    void updateEigensystem();
+
+    std::size_t m_n;
+    std::size_t m_lambda;
+    std::size_t m_mu;
+    std::vector<double> m_weights;
+    double m_mueff;
+
+    // Learning rates and damping, from the tutorial's defaults
+    double m_cc;
+    double m_cs;
+    double m_c1;
+    double m_cmu;
+    double m_damps;
+    double m_chiN;
+
+    std::vector<double> m_mean;
+    double m_sigma;
+    std::vector<double> m_pc;
+    std::vector<double> m_ps;
+
+    /** The covariance matrix; only the lower triangle is maintained */
+    std::vector<double> m_C;
+    /** Eigenvectors of m_C, one per column */
+    std::vector<double> m_B;
+    /** Square roots of the eigenvalues of m_C */
+    std::vector<double> m_D;
+
+    std::size_t m_generation;
+    std::size_t m_evaluations;
+    std::size_t m_eigenEvaluations;
+
+    std::vector< std::vector<double> > m_candidates;
+    bool m_asked;
+
+    std::tr1::ranlux64_base_01 m_eng;
+};
+
+#endif // CMAES_H_
@@ -0,0 +1,333 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file CMAESEvolution.cpp
+ * @brief Contains the implementation of class CMAESEvolution
+ * $Id$
+ */
+
+// This module
+#include "CMAESEvolution.h"
+// This application
+#include "learning/Configuration/configuration.h"
+#include "core/tgString.h"
+#include "helpers/FileHelpers.h"
+// The C++ Standard Library
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <tr1/random>
+
+namespace
+{
+#ifdef _WIN32
+
+    //  Windows
+    unsigned long long cycleCount()
+    {
+        return __rdtsc();
+    }
+
+#else
+
+    //  For everything else
+    unsigned long long cycleCount()
+    {
+        unsigned int lo,hi;
+        __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+        return ((unsigned long long)hi << 32) | lo;
+    }
+
+#endif
+}
+
+CMAESEvolution::CMAESEvolution(std::string suff, std::string config, std::string path) :
+suffix(suff),
+cmaes(NULL),
+currentTest(0),
+subTests(0),
+selectedCandidate(0),
+bestScore(-HUGE_VAL),
+nextPending(0)
+{
+    if (path != "")
+    {
+        resourcePath = FileHelpers::getResourcePath(path);
+    }
+    else
+    {
+        resourcePath = "";
+    }
+
+    configuration configData;
+    configData.readFile(resourcePath + config);
+    numberOfControllers = configData.getintvalue("numberOfControllers");
+    numberOfActions = configData.getintvalue("numberOfActions");
+    const int populationSize = configData.getintvalue("populationSize");
+    numberOfSubtests = configData.iskey("numberOfSubtests") ?
+        configData.getintvalue("numberOfSubtests") : 1;
+    const double initialSigma = configData.iskey("initialSigma") ?
+        configData.getDoubleValue("initialSigma") : 0.3;
+    const bool seeded = configData.getintvalue("startSeed");
+    learning = configData.getintvalue("learning");
+
+    if (numberOfControllers == 0 || numberOfActions == 0)
+    {
+        throw std::invalid_argument("CMAESEvolution needs at least one parameter");
+    }
+    if (numberOfSubtests < 1 || populationSize < 0)
+    {
+        throw std::invalid_argument("CMAESEvolution needs positive numberOfSubtests and populationSize");
+    }
+
+    // A randomSeed in the config makes runs repeatable, with the suffix
+    // mixed in as for AnnealEvolution
+    unsigned long long seed = cycleCount();
+    if (configData.iskey("randomSeed"))
+    {
+        seed = configData.getintvalue("randomSeed");
+        for (std::size_t i = 0; i < suffix.size(); i++)
+        {
+            seed = seed * 31 + suffix[i];
+        }
+    }
+
+    // Start from the saved best parameters, or uniformly at random
+    std::vector<double> mean(numberOfControllers * numberOfActions);
+    if (seeded)
+    {
+        for (std::size_t i = 0; i < numberOfControllers; i++)
+        {
+            CMAESMember saved(numberOfActions);
+            std::stringstream ss;
+            ss << resourcePath << "logs/bestParameters-" << suffix << "-" << i << ".nnw";
+            saved.loadFromFile(ss.str().c_str());
+            std::copy(saved.statelessParameters.begin(), saved.statelessParameters.end(),
+                      mean.begin() + i * numberOfActions);
+        }
+    }
+    else
+    {
+        std::tr1::ranlux64_base_01 eng(seed + 1);
+        std::tr1::uniform_real<double> unif(0, 1);
+        for (std::size_t i = 0; i < mean.size(); i++)
+        {
+            mean[i] = unif(eng);
+        }
+    }
+    cmaes = new CMAES(mean, initialSigma, populationSize, seed);
+
+    if (learning)
+    {
+        evolutionLog.open((resourcePath + "logs/evolution" + suffix + ".csv").c_str(), std::ios::out);
+        if (!evolutionLog.is_open())
+        {
+            throw std::runtime_error("Logs does not exist. Please create a logs folder in your build directory or update your cmake file");
+        }
+    }
+
+    startGeneration();
+}
+
+CMAESEvolution::~CMAESEvolution()
+{
+    for (std::size_t k = 0; k < candidates.size(); k++)
+    {
+        for (std::size_t i = 0; i < candidates[k].size(); i++)
+        {
+            delete candidates[k][i];
+        }
+    }
+    delete cmaes;
+}
+
+void CMAESEvolution::startGeneration()
+{
+    const std::vector< std::vector<double> >& asked = cmaes->ask();
+    const std::size_t lambda = asked.size();
+
+    if (candidates.empty())
+    {
+        candidates.resize(lambda);
+        for (std::size_t k = 0; k < lambda; k++)
+        {
+            for (std::size_t i = 0; i < numberOfControllers; i++)
+            {
+                candidates[k].push_back(new CMAESMember(numberOfActions));
+            }
+        }
+    }
+
+    clipped = asked;
+    for (std::size_t k = 0; k < lambda; k++)
+    {
+        std::vector<double>& x = clipped[k];
+        for (std::size_t j = 0; j < x.size(); j++)
+        {
+            x[j] = std::min(1.0, std::max(0.0, x[j]));
+        }
+        for (std::size_t i = 0; i < numberOfControllers; i++)
+        {
+            CMAESMember* member = candidates[k][i];
+            member->statelessParameters.assign(x.begin() + i * numberOfActions,
+                                               x.begin() + (i + 1) * numberOfActions);
+            member->pastScores.clear();
+        }
+    }
+
+    scoreTotals.assign(lambda, 0.0);
+    scoreCounts.assign(lambda, 0);
+    currentTest = 0;
+    subTests = 0;
+}
+
+void CMAESEvolution::finishGeneration()
+{
+    const std::size_t lambda = candidates.size();
+    std::vector<double> fitness(lambda);
+    std::size_t best = 0;
+    for (std::size_t k = 0; k < lambda; k++)
+    {
+        // Unscored candidates count as an exploded episode
+        fitness[k] = scoreCounts[k] > 0 ? scoreTotals[k] / scoreCounts[k] : -1.0;
+        if (fitness[k] > fitness[best])
+        {
+            best = k;
+        }
+    }
+    cmaes->tell(clipped, fitness);
+
+    if (!learning)
+    {
+        return;
+    }
+
+    const double average = std::accumulate(fitness.begin(), fitness.end(), 0.0) / lambda;
+    evolutionLog << cmaes->getGeneration() * lambda * numberOfSubtests << ","
+                 << average << "," << fitness[best] << ","
+                 << cmaes->getSigma() << "," << cmaes->getAxisRatio() << std::endl;
+
+    if (fitness[best] > bestScore)
+    {
+        bestScore = fitness[best];
+        for (std::size_t i = 0; i < numberOfControllers; i++)
+        {
+            std::stringstream ss;
+            ss << resourcePath << "logs/bestParameters-" << suffix << "-" << i << ".nnw";
+            candidates[best][i]->saveToFile(ss.str().c_str());
+        }
+    }
+}
+
+std::vector<CMAESMember*> CMAESEvolution::nextSetOfControllers()
+{
+    if (currentTest == candidates.size())
+    {
+        finishGeneration();
+        startGeneration();
+    }
+
+    selectedCandidate = currentTest;
+
+    subTests++;
+    if (subTests == numberOfSubtests)
+    {
+        currentTest++;
+        subTests = 0;
+    }
+
+    return candidates[selectedCandidate];
+}
+
+void CMAESEvolution::updateScores(std::vector<double> multiscore)
+{
+    if (multiscore.empty())
+    {
+        multiscore.push_back(-1.0);
+    }
+    const double score = multiscore[0];
+    scoreTotals[selectedCandidate] += score;
+    scoreCounts[selectedCandidate]++;
+
+    //Record it to the file
+    std::ofstream payloadLog((resourcePath + "logs/scores.csv").c_str(), std::ios::app);
+    payloadLog << multiscore[0];
+    if (multiscore.size() > 1)
+    {
+        payloadLog << "," << multiscore[1];
+    }
+
+    const std::vector<CMAESMember*>& selected = candidates[selectedCandidate];
+    for (std::size_t i = 0; i < selected.size(); i++)
+    {
+        CMAESMember* member = selected[i];
+        member->pastScores.push_back(score);
+        if (score > member->maxScore)
+        {
+            member->maxScore = score;
+        }
+        for (std::size_t j = 0; j < member->statelessParameters.size(); j++)
+        {
+            payloadLog << "," << member->statelessParameters[j];
+        }
+    }
+    payloadLog << std::endl;
+}
+
+std::vector< std::vector<CMAESMember*> > CMAESEvolution::nextGeneration()
+{
+    if (nextPending != pendingCandidates.size())
+    {
+        throw std::runtime_error("Sets of the last generation have not all been scored");
+    }
+
+    std::vector< std::vector<CMAESMember*> > sets;
+    pendingCandidates.clear();
+    do
+    {
+        sets.push_back(nextSetOfControllers());
+        pendingCandidates.push_back(selectedCandidate);
+    }
+    while (currentTest != candidates.size() || subTests != 0);
+
+    pendingScores.assign(sets.size(), std::vector<double>());
+    pendingScored.assign(sets.size(), false);
+    nextPending = 0;
+    return sets;
+}
+
+void CMAESEvolution::updateScores(std::size_t episode, std::vector<double> multiscore)
+{
+    if (episode >= pendingCandidates.size() || pendingScored[episode])
+    {
+        throw std::invalid_argument("Episode " + tgString("", episode) + " is not waiting for a score");
+    }
+    pendingScores[episode] = multiscore;
+    pendingScored[episode] = true;
+
+    // Apply scores in order so scores.csv reads as in the serial loop
+    while (nextPending < pendingCandidates.size() && pendingScored[nextPending])
+    {
+        selectedCandidate = pendingCandidates[nextPending];
+        updateScores(pendingScores[nextPending]);
+        nextPending++;
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef CMAESEVOLUTION_H_
+#define CMAESEVOLUTION_H_
+
+/**
+ * @file CMAESEvolution.h
+ * @brief Contains the definition of class CMAESEvolution, which learns
+ * stateless controller parameters with CMA-ES
+ * $Id$
+ */
+
+// This module
+#include "CMAES.h"
+#include "CMAESMember.h"
+// The C++ Standard Library
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * A drop in alternative to AnnealEvolution, driven by CMAESAdapter the
+ * way AnnealAdapter drives AnnealEvolution. The parameters of all
+ * controllers form one search space, so there is no coevolution: each
+ * CMA-ES candidate is a full set of controllers.
+ *
+ * Reads from the config file:
+ * - numberOfControllers, numberOfActions: as for AnnealEvolution
+ * - populationSize: candidates per generation, 0 for the CMA-ES default
+ * - numberOfSubtests: optional, episodes averaged per candidate (1)
+ * - initialSigma: optional, the initial step size (0.3)
+ * - learning, startSeed, randomSeed: as for AnnealEvolution
+ *
+ * Parameters are kept in [0, 1] by clipping each candidate before it is
+ * evaluated; CMA-ES is told the clipped candidates.
+ */
+class CMAESEvolution
+{
+public:
+    CMAESEvolution(std::string suffix, std::string config = "config.ini", std::string path = "");
+    ~CMAESEvolution();
+
+    /** The next set to evaluate, updating the distribution between generations */
+    std::vector<CMAESMember*> nextSetOfControllers();
+
+    /** Score the set last returned by nextSetOfControllers */
+    void updateScores(std::vector<double> scores);
+
+    /**
+     * Hand out every set still to be evaluated in this generation, as
+     * AnnealEvolution::nextGeneration does. This is the CMA-ES ask step;
+     * the tell step happens once all sets are scored and the next
+     * generation is requested.
+     * @throw std::runtime_error if sets from the last call are unscored
+     */
+    std::vector< std::vector<CMAESMember*> > nextGeneration();
+
+    /**
+     * Score one set returned by nextGeneration
+     * @throw std::invalid_argument if episode is out of range or already
+     * scored
+     */
+    void updateScores(std::size_t episode, std::vector<double> scores);
+
+    /** The type of member, for templates driving any evolution */
+    typedef CMAESMember Member;
+
+    const std::string suffix;
+    std::string resourcePath;
+
+private:
+
+    /** Sample the next generation into the members */
+    void startGeneration();
+
+    /** Tell CMA-ES the scores, log them and save the best parameters */
+    void finishGeneration();
+
+    std::size_t numberOfControllers;
+    std::size_t numberOfActions;
+    int numberOfSubtests;
+    bool learning;
+
+    CMAES* cmaes;
+
+    /** One set of members per candidate, holding its clipped parameters */
+    std::vector< std::vector<CMAESMember*> > candidates;
+    std::vector< std::vector<double> > clipped;
+    std::vector<double> scoreTotals;
+    std::vector<int> scoreCounts;
+
+    std::size_t currentTest;
+    int subTests;
+    /** The candidate whose set was handed out last */
+    std::size_t selectedCandidate;
+
+    double bestScore;
+    std::ofstream evolutionLog;
+
+    /** The candidates of the sets handed out by nextGeneration and their scores */
+    std::vector<std::size_t> pendingCandidates;
+    std::vector< std::vector<double> > pendingScores;
+    std::vector<bool> pendingScored;
+    /** The first set whose scores have not been applied */
+    std::size_t nextPending;
+};
+
+#endif /* CMAESEVOLUTION_H_ */
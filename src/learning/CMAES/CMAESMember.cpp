@@ -0,0 +1,71 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file CMAESMember.cpp
+ * @brief Contains the implementation of class CMAESMember
+ * $Id$
+ */
+
+// This module
+#include "CMAESMember.h"
+// The C++ Standard Library
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+CMAESMember::CMAESMember(std::size_t numParameters) :
+statelessParameters(numParameters, 0.0),
+maxScore(-1000)
+{
+}
+
+void CMAESMember::saveToFile(const char* outputFilename) const
+{
+    std::ofstream ss(outputFilename);
+    ss.precision(std::numeric_limits<double>::digits10 + 2);
+    for (std::size_t i = 0; i < statelessParameters.size(); i++)
+    {
+        ss << statelessParameters[i];
+        if (i != statelessParameters.size() - 1)
+        {
+            ss << ",";
+        }
+    }
+}
+
+void CMAESMember::loadFromFile(const char* inputFilename)
+{
+    std::ifstream ss(inputFilename);
+    if (!ss.is_open())
+    {
+        std::cout << "File of name " << inputFilename << " does not exist" << std::endl;
+        std::cout << "Try turning learning on in config.ini to generate parameters" << std::endl;
+        throw std::invalid_argument("Parameter file does not exist");
+    }
+
+    std::string value;
+    std::size_t i = 0;
+    while (i < statelessParameters.size() && std::getline(ss, value, ','))
+    {
+        statelessParameters[i++] = std::atof(value.c_str());
+    }
+}
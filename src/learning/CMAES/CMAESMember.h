@@ -0,0 +1,60 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef CMAESMEMBER_H_
+#define CMAESMEMBER_H_
+
+/**
+ * @file CMAESMember.h
+ * @brief Contains the definition of class CMAESMember, the parameters
+ * of one controller in a CMAESEvolution candidate
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+class CMAESMember
+{
+public:
+    /** All parameters start at zero */
+    CMAESMember(std::size_t numParameters);
+
+    /** Comma separated, as AnnealEvoMember writes them */
+    void saveToFile(const char* outputFilename) const;
+
+    /**
+     * @throw std::invalid_argument if the file does not exist
+     */
+    void loadFromFile(const char* inputFilename);
+
+    /** Everything that defines this member, for FitnessCache keys */
+    const std::vector<double>& getParameters() const
+    {
+        return statelessParameters;
+    }
+
+    /** In [0, 1], as for AnnealEvoMember */
+    std::vector<double> statelessParameters;
+    //scores for evaluation
+    std::vector<double> pastScores;
+    double maxScore;
+};
+
+#endif /* CMAESMEMBER_H_ */
@@ -0,0 +1,214 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file FitnessCache.cpp
+ * @brief Contains the definitions of members of class FitnessCache
+ * $Id$
+ */
+
+// This module
+#include "FitnessCache.h"
+// The C++ Standard Library
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    /**
+     * Diverged episodes can score NaN or infinity, which streams write in
+     * a form they cannot read back, so these are spelled out
+     */
+    void putScore(std::ostream& out, double score)
+    {
+        if (score != score)
+        {
+            out << "nan";
+        }
+        else if (score == std::numeric_limits<double>::infinity())
+        {
+            out << "inf";
+        }
+        else if (score == -std::numeric_limits<double>::infinity())
+        {
+            out << "-inf";
+        }
+        else
+        {
+            out << std::setprecision(17) << score;
+        }
+    }
+
+    /** Reads what putScore wrote, setting in's failbit on anything else */
+    void getScore(std::istream& in, double& score)
+    {
+        std::string word;
+        if (!(in >> word))
+        {
+            return;
+        }
+        if (word == "nan")
+        {
+            score = std::numeric_limits<double>::quiet_NaN();
+        }
+        else if (word == "inf")
+        {
+            score = std::numeric_limits<double>::infinity();
+        }
+        else if (word == "-inf")
+        {
+            score = -std::numeric_limits<double>::infinity();
+        }
+        else
+        {
+            std::istringstream number(word);
+            if (!(number >> score) || !number.eof())
+            {
+                in.setstate(std::ios::failbit);
+            }
+        }
+    }
+}
+
+const FitnessCache::Key FitnessCache::initialHash;
+
+FitnessCache::FitnessCache(const std::string& filename, Key context) :
+    m_context(context),
+    m_hits(0),
+    m_misses(0)
+{
+    if (filename.empty())
+    {
+        return;
+    }
+    load(filename);
+    m_file.open(filename.c_str(), std::ios::out | std::ios::app);
+    if (!m_file.is_open())
+    {
+        throw std::runtime_error("Cannot open fitness cache " + filename);
+    }
+}
+
+void FitnessCache::load(const std::string& filename)
+{
+    std::ifstream in(filename.c_str());
+    std::string line;
+    while (std::getline(in, line))
+    {
+        // getline stops at the end of the file on a line with no newline,
+        // which was being written when the run stopped
+        if (in.eof())
+        {
+            break;
+        }
+        std::istringstream entry(line);
+        Key key;
+        std::size_t count;
+        entry >> std::hex >> key >> std::dec >> count;
+        std::vector<double> scores(count);
+        for (std::size_t i = 0; i < count && entry; i++)
+        {
+            getScore(entry, scores[i]);
+        }
+        if (entry)
+        {
+            m_entries[key] = scores;
+        }
+    }
+}
+
+FitnessCache::Key FitnessCache::key(const std::vector<double>& parameters) const
+{
+    return hashParameters(parameters, m_context);
+}
+
+bool FitnessCache::lookup(Key key, std::vector<double>& scores)
+{
+    std::map<Key, std::vector<double> >::const_iterator it = m_entries.find(key);
+    if (it == m_entries.end())
+    {
+        m_misses++;
+        return false;
+    }
+    m_hits++;
+    scores = it->second;
+    return true;
+}
+
+void FitnessCache::store(Key key, const std::vector<double>& scores)
+{
+    m_entries[key] = scores;
+    if (m_file.is_open())
+    {
+        m_file << std::hex << key << std::dec << " " << scores.size();
+        for (std::size_t i = 0; i < scores.size(); i++)
+        {
+            m_file << " ";
+            putScore(m_file, scores[i]);
+        }
+        // Flush each entry so a crash loses at most the last one
+        m_file << std::endl;
+    }
+}
+
+FitnessCache::Key FitnessCache::hash(const void* data, std::size_t bytes, Key seed)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    Key h = seed;
+    for (std::size_t i = 0; i < bytes; i++)
+    {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+FitnessCache::Key FitnessCache::hashString(const std::string& text, Key seed)
+{
+    return hash(text.data(), text.size(), seed);
+}
+
+FitnessCache::Key FitnessCache::hashFile(const std::string& filename, Key seed)
+{
+    std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!in.is_open())
+    {
+        throw std::runtime_error("Cannot read " + filename);
+    }
+    std::ostringstream content;
+    content << in.rdbuf();
+    return hashString(content.str(), seed);
+}
+
+FitnessCache::Key FitnessCache::hashParameters(const std::vector<double>& parameters,
+                                               Key seed)
+{
+    // The count first, so sets that split differently don't collide
+    const std::size_t count = parameters.size();
+    Key h = hash(&count, sizeof(count), seed);
+    return parameters.empty() ? h :
+        hash(&parameters[0], count * sizeof(double), h);
+}
+
+unsigned long FitnessCache::seedFor(Key key)
+{
+    // Fold the high bits in, for 32 bit unsigned long
+    return static_cast<unsigned long>(key ^ (key >> 32));
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef FITNESS_CACHE_H_
+#define FITNESS_CACHE_H_
+
+/**
+ * @file FitnessCache.h
+ * @brief Contains the definition of class FitnessCache
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Scores of parameter sets that have already been simulated, kept in a
+ * file so they survive between runs. Evolution re-evaluates the same
+ * parameters often: elites carried over, duplicate children, runs resumed
+ * after a crash. evaluateGeneration (EvolutionEpisode.h) looks each set
+ * up here before simulating it.
+ *
+ * A key hashes the parameters together with a context: a hash of
+ * everything else the score depends on, such as the model or YAML file
+ * and the simulation settings. Build it with the hash functions below;
+ * a cache file can then hold entries of several contexts.
+ *
+ * Entries are only valid if the episodes are deterministic: seed any
+ * randomness from the parameters, e.g. with EvolutionEpisode::getSeed().
+ *
+ * The file holds one line per entry, "key count score...", appended and
+ * flushed as entries are stored; non-finite scores are written as nan,
+ * inf and -inf. A last line cut short by a crash is ignored when loading.
+ *
+ * The long lived worker apps (LearningWorker) don't use a cache: their
+ * JSON controllers append each score to the parameter file on teardown,
+ * where the scheduler reads it, and the parameters span more than one
+ * file, so a hit can't simply skip the episode there.
+ */
+class FitnessCache
+{
+public:
+
+    typedef unsigned long long Key;
+
+    /**
+     * Open a cache, loading the entries already in filename
+     * @param[in] filename the cache file, created if missing; if empty
+     * the cache is kept in memory only
+     * @param[in] context combined into every key
+     * @throw std::runtime_error if filename cannot be opened to append
+     */
+    FitnessCache(const std::string& filename, Key context);
+
+    /** The key of a parameter set in this cache's context */
+    Key key(const std::vector<double>& parameters) const;
+
+    /**
+     * @param[out] scores the stored scores, if found
+     * @return true if key has an entry
+     */
+    bool lookup(Key key, std::vector<double>& scores);
+
+    /** Add or replace an entry, and append it to the file */
+    void store(Key key, const std::vector<double>& scores);
+
+    std::size_t size() const
+    {
+        return m_entries.size();
+    }
+
+    /** Lookups that found an entry, since construction */
+    std::size_t getHits() const
+    {
+        return m_hits;
+    }
+
+    std::size_t getMisses() const
+    {
+        return m_misses;
+    }
+
+    /** The seed hashes start from when not chaining */
+    static const Key initialHash = 14695981039346656037ULL;
+
+    /** 64 bit FNV-1a of bytes, continuing from seed */
+    static Key hash(const void* data, std::size_t bytes, Key seed = initialHash);
+
+    static Key hashString(const std::string& text, Key seed = initialHash);
+
+    /**
+     * Hash the content of a file, such as a model's YAML
+     * @throw std::runtime_error if the file cannot be read
+     */
+    static Key hashFile(const std::string& filename, Key seed = initialHash);
+
+    /** Hash the exact values of parameters */
+    static Key hashParameters(const std::vector<double>& parameters,
+                              Key seed = initialHash);
+
+    /** A random number generator seed derived from a key */
+    static unsigned long seedFor(Key key);
+
+private:
+
+    /** Read the entries of filename, if it exists */
+    void load(const std::string& filename);
+
+    const Key m_context;
+    std::map<Key, std::vector<double> > m_entries;
+    std::ofstream m_file;
+    std::size_t m_hits;
+    std::size_t m_misses;
+
+    /** Not copyable, the file is open */
+    FitnessCache(const FitnessCache&);
+    FitnessCache& operator=(const FitnessCache&);
+};
+
+#endif // FITNESS_CACHE_H_
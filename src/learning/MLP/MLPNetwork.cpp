@@ -0,0 +1,233 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file MLPNetwork.cpp
+ * @brief Contains the definition of class MLPNetwork
+ * $Id$
+ */
+
+// This module
+#include "MLPNetwork.h"
+// The C++ Standard Library
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    /**
+     * out[r][j] = sum_i in[r][i] * weights[i][j] - weights[fanIn][j],
+     * for rows [r0, r1) and columns [j0, j1). Sums run over i in order.
+     */
+    void multiplyBlock(const double* in, std::size_t fanIn,
+                       const double* weights, std::size_t fanOut,
+                       double* out,
+                       std::size_t r0, std::size_t r1,
+                       std::size_t j0, std::size_t j1)
+    {
+        const double* bias = weights + fanIn * fanOut;
+        for (std::size_t r = r0; r < r1; ++r)
+        {
+            const double* row = in + r * fanIn;
+            for (std::size_t j = j0; j < j1; ++j)
+            {
+                double sum = 0.0;
+                for (std::size_t i = 0; i < fanIn; ++i)
+                {
+                    sum += row[i] * weights[i * fanOut + j];
+                }
+                out[r * fanOut + j] = sum - bias[j];
+            }
+        }
+    }
+
+    /**
+     * One layer before activation: a rows x fanIn matrix times the
+     * (fanIn + 1) x fanOut weights, whose last row is the bias weight
+     */
+    void multiplyLayer(const double* in, std::size_t rows, std::size_t fanIn,
+                       const double* weights, std::size_t fanOut,
+                       double* out)
+    {
+        std::size_t r = 0;
+#ifdef __SSE2__
+        // Two patterns by four outputs at a time, so each weight load
+        // is used twice and the eight sums stay in registers. Each lane
+        // accumulates in the same order as the scalar loop.
+        const std::size_t blockCols = fanOut - fanOut % 4;
+        const double* bias = weights + fanIn * fanOut;
+        for (; r + 2 <= rows; r += 2)
+        {
+            const double* in0 = in + r * fanIn;
+            const double* in1 = in0 + fanIn;
+            double* out0 = out + r * fanOut;
+            double* out1 = out0 + fanOut;
+            for (std::size_t j = 0; j < blockCols; j += 4)
+            {
+                __m128d a0 = _mm_setzero_pd();
+                __m128d a1 = _mm_setzero_pd();
+                __m128d b0 = _mm_setzero_pd();
+                __m128d b1 = _mm_setzero_pd();
+                for (std::size_t i = 0; i < fanIn; ++i)
+                {
+                    const double* w = weights + i * fanOut + j;
+                    const __m128d w0 = _mm_loadu_pd(w);
+                    const __m128d w1 = _mm_loadu_pd(w + 2);
+                    const __m128d x0 = _mm_set1_pd(in0[i]);
+                    const __m128d x1 = _mm_set1_pd(in1[i]);
+                    a0 = _mm_add_pd(a0, _mm_mul_pd(x0, w0));
+                    a1 = _mm_add_pd(a1, _mm_mul_pd(x0, w1));
+                    b0 = _mm_add_pd(b0, _mm_mul_pd(x1, w0));
+                    b1 = _mm_add_pd(b1, _mm_mul_pd(x1, w1));
+                }
+                const __m128d c0 = _mm_loadu_pd(bias + j);
+                const __m128d c1 = _mm_loadu_pd(bias + j + 2);
+                _mm_storeu_pd(out0 + j, _mm_sub_pd(a0, c0));
+                _mm_storeu_pd(out0 + j + 2, _mm_sub_pd(a1, c1));
+                _mm_storeu_pd(out1 + j, _mm_sub_pd(b0, c0));
+                _mm_storeu_pd(out1 + j + 2, _mm_sub_pd(b1, c1));
+            }
+            multiplyBlock(in, fanIn, weights, fanOut, out,
+                          r, r + 2, blockCols, fanOut);
+        }
+#endif
+        multiplyBlock(in, fanIn, weights, fanOut, out, r, rows, 0, fanOut);
+    }
+
+    void activate(std::vector<double>& values)
+    {
+        const std::size_t n = values.size();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            values[i] = 1.0 / (1.0 + std::exp(-values[i]));
+        }
+    }
+}
+
+MLPNetwork::MLPNetwork(int numInput, int numHidden, int numOutput) :
+m_numInput(numInput),
+m_numHidden(numHidden),
+m_numOutput(numOutput)
+{
+    checkLayers();
+    m_inputHidden.resize((numInput + 1) * numHidden, 0.0);
+    m_hiddenOutput.resize((numHidden + 1) * numOutput, 0.0);
+}
+
+MLPNetwork::MLPNetwork(int numInput, int numHidden, int numOutput,
+                       const std::string& filename) :
+m_numInput(numInput),
+m_numHidden(numHidden),
+m_numOutput(numOutput)
+{
+    checkLayers();
+    m_inputHidden.resize((numInput + 1) * numHidden, 0.0);
+    m_hiddenOutput.resize((numHidden + 1) * numOutput, 0.0);
+    loadWeights(filename);
+}
+
+void MLPNetwork::checkLayers() const
+{
+    if (m_numInput <= 0 || m_numHidden <= 0 || m_numOutput <= 0)
+    {
+        throw std::invalid_argument("MLPNetwork layers must not be empty");
+    }
+}
+
+void MLPNetwork::loadWeights(const std::string& filename)
+{
+    std::ifstream file(filename.c_str());
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Unable to open weight file " + filename);
+    }
+
+    // Comma separated, on any number of lines
+    std::vector<double> weights;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        std::string field;
+        while (std::getline(fields, field, ','))
+        {
+            if (field.find_first_not_of(" \t\r") != std::string::npos)
+            {
+                weights.push_back(std::atof(field.c_str()));
+            }
+        }
+    }
+
+    if (weights.size() != getNumWeights())
+    {
+        std::ostringstream msg;
+        msg << "Weight file " << filename << " has " << weights.size()
+            << " weights, expected " << getNumWeights();
+        throw std::runtime_error(msg.str());
+    }
+    setWeights(weights);
+}
+
+void MLPNetwork::setWeights(const std::vector<double>& weights)
+{
+    if (weights.size() != getNumWeights())
+    {
+        throw std::invalid_argument("Wrong number of weights for MLPNetwork");
+    }
+    const std::vector<double>::const_iterator split =
+        weights.begin() + m_inputHidden.size();
+    m_inputHidden.assign(weights.begin(), split);
+    m_hiddenOutput.assign(split, weights.end());
+}
+
+std::vector<double> MLPNetwork::getWeights() const
+{
+    std::vector<double> weights(m_inputHidden);
+    weights.insert(weights.end(), m_hiddenOutput.begin(), m_hiddenOutput.end());
+    return weights;
+}
+
+void MLPNetwork::feedForward(const std::vector<double>& inputs,
+                             std::vector<double>& outputs)
+{
+    if (inputs.size() % m_numInput != 0)
+    {
+        throw std::invalid_argument("Inputs are not a whole number of patterns");
+    }
+    const std::size_t batch = inputs.size() / m_numInput;
+
+    m_hidden.resize(batch * m_numHidden);
+    outputs.resize(batch * m_numOutput);
+    if (batch == 0)
+    {
+        return;
+    }
+
+    multiplyLayer(&inputs[0], batch, m_numInput,
+                  &m_inputHidden[0], m_numHidden, &m_hidden[0]);
+    activate(m_hidden);
+    multiplyLayer(&m_hidden[0], batch, m_numHidden,
+                  &m_hiddenOutput[0], m_numOutput, &outputs[0]);
+    activate(outputs);
+}
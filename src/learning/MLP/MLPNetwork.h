@@ -0,0 +1,130 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef MLPNETWORK_H_
+#define MLPNETWORK_H_
+
+/**
+ * @file MLPNetwork.h
+ * @brief Defines a class MLPNetwork for batched inference of the
+ * three layer networks evolved by NeuroEvolution
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * A feed forward network with one hidden layer, computing the same
+ * function as neuralNetwork::feedForwardPattern: sigmoid units, with a
+ * bias unit of -1 appended to the input and hidden layers.
+ *
+ * The weights are held contiguously in the order of the .nnw format,
+ * which makes each layer a row major (fanIn + 1) x fanOut matrix.
+ * feedForward evaluates a whole batch of patterns as matrix products,
+ * so a controller should collect the states of all its cables and make
+ * one call per step. Each output is summed in the same order as
+ * neuralNetwork does, so the results are identical.
+ */
+class MLPNetwork
+{
+public:
+
+    /**
+     * An untrained network with all weights zero
+     * @throw std::invalid_argument if a layer is empty
+     */
+    MLPNetwork(int numInput, int numHidden, int numOutput);
+
+    /**
+     * A network with the weights of a .nnw file written by
+     * neuralNetwork::saveWeights or NeuroEvoMember::saveToFile
+     * @throw std::runtime_error if the file can't be read or has the
+     * wrong number of weights
+     */
+    MLPNetwork(int numInput, int numHidden, int numOutput,
+               const std::string& filename);
+
+    /**
+     * Replace the weights with those of a .nnw file
+     * @throw std::runtime_error as for the constructor
+     */
+    void loadWeights(const std::string& filename);
+
+    /**
+     * Replace the weights. In .nnw order: input to hidden, then hidden
+     * to output, each indexed [from][to] with the bias unit last
+     * @throw std::invalid_argument if the size is wrong
+     */
+    void setWeights(const std::vector<double>& weights);
+
+    /** The weights, in the order setWeights takes them */
+    std::vector<double> getWeights() const;
+
+    /**
+     * Evaluate a batch of patterns
+     * @param[in] inputs batch x getNumInputs() values, one pattern per row
+     * @param[out] outputs resized to batch x getNumOutputs() values
+     * @throw std::invalid_argument if inputs isn't a whole number of
+     * patterns
+     */
+    void feedForward(const std::vector<double>& inputs,
+                     std::vector<double>& outputs);
+
+    int getNumInputs() const
+    {
+        return m_numInput;
+    }
+
+    int getNumHidden() const
+    {
+        return m_numHidden;
+    }
+
+    int getNumOutputs() const
+    {
+        return m_numOutput;
+    }
+
+    /** The number of weights setWeights expects */
+    std::size_t getNumWeights() const
+    {
+        return m_inputHidden.size() + m_hiddenOutput.size();
+    }
+
+private:
+
+    void checkLayers() const;
+
+    int m_numInput;
+    int m_numHidden;
+    int m_numOutput;
+
+    /** (m_numInput + 1) x m_numHidden, row major */
+    std::vector<double> m_inputHidden;
+
+    /** (m_numHidden + 1) x m_numOutput, row major */
+    std::vector<double> m_hiddenOutput;
+
+    /** Hidden activations of the last batch, kept to avoid reallocation */
+    std::vector<double> m_hidden;
+};
+
+#endif // MLPNETWORK_H_
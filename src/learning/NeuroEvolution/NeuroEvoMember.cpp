@@ -33,20 +33,52 @@
 
 using namespace std;
 
-NeuroEvoMember::NeuroEvoMember(configuration config)
+/**
+ * The evolved network, exposing the weights that neuralNetwork keeps
+ * to itself so they can be copied into an MLPNetwork
+ */
+class NeuroEvoNetwork : public neuralNetwork
+{
+public:
+	NeuroEvoNetwork(int numInput, int numHidden, int numOutput) :
+	neuralNetwork(numInput, numHidden, numOutput)
+	{
+	}
+
+	MLPNetwork toMLP() const
+	{
+		MLPNetwork result(nInput, nHidden, nOutput);
+		std::vector<double> weights;
+		weights.reserve(result.getNumWeights());
+		for (int i = 0; i <= nInput; i++)
+		{
+			weights.insert(weights.end(), wInputHidden[i], wInputHidden[i] + nHidden);
+		}
+		for (int i = 0; i <= nHidden; i++)
+		{
+			weights.insert(weights.end(), wHiddenOutput[i], wHiddenOutput[i] + nOutput);
+		}
+		result.setWeights(weights);
+		return result;
+	}
+};
+
+NeuroEvoMember::NeuroEvoMember(configuration config, std::tr1::ranlux64_base_01 *eng)
 {
 	this->numInputs=config.getintvalue("numberOfStates");
     this->numOutputs=config.getintvalue("numberOfActions");
 	int numHidden = config.getintvalue("numberHidden");
     assert(numOutputs > 0);
 	cout<<"creating NN"<<endl;
+	nn = NULL;
 	if(numInputs>0)
-		nn = new neuralNetwork(numInputs, numHidden,numOutputs);
+		nn = new NeuroEvoNetwork(numInputs, numHidden,numOutputs);
 	else
 	{
+		std::tr1::uniform_real<double> unif(0, 1);
 		statelessParameters.resize(numOutputs);
 		for(int i=0;i<numOutputs;i++)
-			statelessParameters[i]=rand()*1.0/RAND_MAX;
+			statelessParameters[i]=unif(*eng);
 	}
 	maxScore=-1000;
 }
@@ -56,6 +88,31 @@ NeuroEvoMember::~NeuroEvoMember()
 	delete nn;
 }
 
+neuralNetwork* NeuroEvoMember::getNn()
+{
+	return nn;
+}
+
+MLPNetwork NeuroEvoMember::getNetwork() const
+{
+	if (nn == NULL)
+	{
+		throw std::logic_error("Stateless NeuroEvoMember has no network");
+	}
+	return nn->toMLP();
+}
+
+std::vector<double> NeuroEvoMember::getParameters() const
+{
+	std::vector<double> parameters(statelessParameters);
+	if (nn != NULL)
+	{
+		const std::vector<double> weights = nn->toMLP().getWeights();
+		parameters.insert(parameters.end(), weights.begin(), weights.end());
+	}
+	return parameters;
+}
+
 void NeuroEvoMember::mutate(std::tr1::ranlux64_base_01 *eng){
 	std::tr1::uniform_real<double> unif(0, 1);
 	if(unif(*eng)  > 0.5)
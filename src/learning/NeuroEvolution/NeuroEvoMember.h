@@ -31,26 +31,40 @@
 #include <vector>
 #include <tr1/random>
 #include "learning/Configuration/configuration.h"
+#include "learning/MLP/MLPNetwork.h"
 
 // Forward Declarations
 class neuralNetwork;
+class NeuroEvoNetwork;
 
 class NeuroEvoMember
 {
 public:
-	NeuroEvoMember(configuration config);
+	/** Stateless parameters start uniformly random in [0, 1), drawn from eng */
+	NeuroEvoMember(configuration config, std::tr1::ranlux64_base_01 *eng);
 	~NeuroEvoMember();
 	void mutate(std::tr1::ranlux64_base_01 *eng);
 
-	neuralNetwork* getNn(){
-		return nn;
-	}
+	neuralNetwork* getNn();
+
+	/**
+	 * A copy of this member's network for inference. Take it once per
+	 * episode: it does not follow later mutation.
+	 * @throw std::logic_error for stateless members, which have no network
+	 */
+	MLPNetwork getNetwork() const;
 
     void copyFrom(NeuroEvoMember *otherMember);
     void copyFrom(NeuroEvoMember *otherMember1, NeuroEvoMember *otherMember2, std::tr1::ranlux64_base_01 *eng);
 	void saveToFile(const char* outputFilename);
 	void loadFromFile(const char* inputFilename);
 
+	/**
+	 * Everything that defines this member, for FitnessCache keys: the
+	 * stateless parameters and then the network's weights, if any
+	 */
+	std::vector<double> getParameters() const;
+
 	std::vector<double> statelessParameters;
 	//scores for evaluation
 	std::vector<double> pastScores;
@@ -60,7 +74,7 @@ public:
 	double averageScore;
 
 private:
-	neuralNetwork *nn;
+	NeuroEvoNetwork *nn;
 
 	int numInputs;
 	int numOutputs;
@@ -37,7 +37,7 @@
 
 using namespace std;
 
-NeuroEvoPopulation::NeuroEvoPopulation(int populationSize,configuration& config) :
+NeuroEvoPopulation::NeuroEvoPopulation(int populationSize,configuration& config,std::tr1::ranlux64_base_01 *eng) :
 m_config(config),
 compareAverageScores(true),
 clearScoresBetweenGenerations(false)
@@ -48,7 +48,7 @@ clearScoresBetweenGenerations(false)
 	for(int i=0;i<populationSize;i++)
 	{
 		cout<<"  creating members"<<endl;
-		controllers.push_back(new NeuroEvoMember(config));
+		controllers.push_back(new NeuroEvoMember(config, eng));
 	}
 }
 
@@ -110,7 +110,7 @@ void NeuroEvoPopulation::combineAndMutate(std::tr1::ranlux64_base_01 *eng, std::
             }
         }
         
-        NeuroEvoMember* newController = new NeuroEvoMember(m_config);
+        NeuroEvoMember* newController = new NeuroEvoMember(m_config, eng);
         newController->copyFrom(controllers[index1], controllers[index2], eng);
         
         if(unif(*eng) > 0.9)
@@ -125,7 +125,7 @@ void NeuroEvoPopulation::combineAndMutate(std::tr1::ranlux64_base_01 *eng, std::
     {
         double val1 = unif(*eng);
         int index1 = getIndexFromProbability(probabilities, val1);
-        NeuroEvoMember* newController = new NeuroEvoMember(m_config);
+        NeuroEvoMember* newController = new NeuroEvoMember(m_config, eng);
         newController->copyFrom(controllers[index1]);
         newController->mutate(eng);
         newControllers.push_back(newController);
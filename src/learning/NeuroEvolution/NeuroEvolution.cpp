@@ -57,7 +57,9 @@ NeuroEvolution::NeuroEvolution(std::string suff, std::string config, std::string
 suffix(suff)
 {
 	currentTest=0;
+	subTests=0;
 	generationNumber=0;
+	nextPending=0;
 	if (path != "")
 	{
 		resourcePath = FileHelpers::getResourcePath(path);
@@ -88,13 +90,28 @@ suffix(suff)
         throw std::invalid_argument("Population will grow with given parameters");
     }
     
-   srand(rdtsc());
-	eng.seed(rdtsc());
+	// All randomness comes from eng, so that instances on different
+	// threads don't share the C library's generator. A randomSeed in the
+	// config makes runs repeatable; the suffix is mixed in so evolutions
+	// sharing a config draw different numbers
+	if (myconfigdataaa.iskey("randomSeed"))
+	{
+		unsigned long long seed = myconfigdataaa.getintvalue("randomSeed");
+		for (std::size_t i = 0; i < suffix.size(); i++)
+		{
+			seed = seed * 31 + suffix[i];
+		}
+		eng.seed(seed);
+	}
+	else
+	{
+		eng.seed(rdtsc());
+	}
 
 	for(int j=0;j<numberOfControllers;j++)
 	{
 		cout<<"creating Populations"<<endl;
-		populations.push_back(new NeuroEvoPopulation(populationSize,myconfigdataaa));
+		populations.push_back(new NeuroEvoPopulation(populationSize,myconfigdataaa,&eng));
 	}
 
     // Overwrite the random parameters based on data
@@ -191,15 +208,17 @@ double diffclock(clock_t clock1,clock_t clock2)
 	return diffms;
 }
 
-vector <NeuroEvoMember *> NeuroEvolution::nextSetOfControllers()
+int NeuroEvolution::testsToDo() const
 {
-	int testsToDo=0;
 	if(coevolution)
-		testsToDo=numberOfTestsBetweenGenerations; //stop when we reach x amount of random tests
+		return numberOfTestsBetweenGenerations; //stop when we reach x amount of random tests
 	else
-		testsToDo=populationSize; //stop when we test each element once
+		return populationSize; //stop when we test each element once
+}
 
-	if(currentTest == testsToDo)
+vector <NeuroEvoMember *> NeuroEvolution::nextSetOfControllers()
+{
+	if(currentTest == testsToDo())
 	{
 		orderAllPopulations();
         if (numberOfChildren == 0)
@@ -224,7 +243,10 @@ vector <NeuroEvoMember *> NeuroEvolution::nextSetOfControllers()
 	{
 		int selectedOne=0;
 		if(coevolution)
-			selectedOne=rand()%populationSize; //select random one from each pool
+		{
+			std::tr1::uniform_int<int> pick(0, populationSize - 1);
+			selectedOne=pick(eng); //select random one from each pool
+		}
 		else
 			selectedOne=currentTest; //select the same from each pool
 
@@ -276,3 +298,42 @@ void NeuroEvolution::updateScores(vector <double> multiscore)
 	payloadLog.close();
 	return;
 }
+
+vector< vector <NeuroEvoMember *> > NeuroEvolution::nextGeneration()
+{
+	if(nextPending != pendingSets.size())
+	{
+		throw std::runtime_error("Sets of the last generation have not all been scored");
+	}
+
+	pendingSets.clear();
+	// Draw sets exactly as the serial loop would until the generation ends
+	do
+	{
+		pendingSets.push_back(nextSetOfControllers());
+	}
+	while(currentTest != testsToDo() || subTests != 0);
+
+	pendingScores.assign(pendingSets.size(), vector<double>());
+	pendingScored.assign(pendingSets.size(), false);
+	nextPending = 0;
+	return pendingSets;
+}
+
+void NeuroEvolution::updateScores(std::size_t episode, vector <double> multiscore)
+{
+	if(episode >= pendingSets.size() || pendingScored[episode])
+	{
+		throw std::invalid_argument("Episode " + tgString("", episode) + " is not waiting for a score");
+	}
+	pendingScores[episode] = multiscore;
+	pendingScored[episode] = true;
+
+	// Apply every score that is now in sequence, as the serial loop would
+	while(nextPending < pendingSets.size() && pendingScored[nextPending])
+	{
+		selectedControllers = pendingSets[nextPending];
+		updateScores(pendingScores[nextPending]);
+		nextPending++;
+	}
+}
@@ -43,6 +43,30 @@ public:
 	void evaluatePopulation();
 	std::vector< NeuroEvoMember *> nextSetOfControllers();
 	void updateScores(std::vector<double> scores);
+
+    /**
+     * Hand out every set of controllers still to be evaluated in this
+     * generation, in the order nextSetOfControllers would, first moving
+     * to the next generation if this one is complete. The sets may be
+     * evaluated concurrently and scored with updateScores(episode, scores)
+     * in any order: scores are applied in episode order, so selection is
+     * the same as in the serial nextSetOfControllers/updateScores loop.
+     * @throw std::runtime_error if sets from the last call are unscored
+     */
+    std::vector< std::vector<NeuroEvoMember *> > nextGeneration();
+
+    /**
+     * Score one set returned by nextGeneration
+     * @param[in] episode the index of the set in nextGeneration's result
+     * @param[in] scores as for updateScores(scores)
+     * @throw std::invalid_argument if episode is out of range or already
+     * scored
+     */
+    void updateScores(std::size_t episode, std::vector<double> scores);
+
+    /** The type of member, for templates driving either evolution */
+    typedef NeuroEvoMember Member;
+    
     const std::string suffix;
     /// @todo make this const if we decide to force everyone to put their logs in resources
     std::string resourcePath;
@@ -66,6 +90,16 @@ private:
     int numberOfChildren;
     int numberOfSubtests;
     int subTests;
+
+    /** Tests to run before the populations are ordered and mutated */
+    int testsToDo() const;
+
+    /** The sets handed out by nextGeneration and their scores */
+    std::vector< std::vector<NeuroEvoMember *> > pendingSets;
+    std::vector< std::vector<double> > pendingScores;
+    std::vector<bool> pendingScored;
+    /** The first set whose scores have not been applied */
+    std::size_t nextPending;
 };
 
 #endif /* NEUROEVOLUTION_H_ */
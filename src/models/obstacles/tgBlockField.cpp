@@ -37,7 +37,7 @@
 // The C++ Standard Library
 #include <stdexcept>
 #include <vector>
-#include <numeric> // RAND_MAX
+#include <tr1/random>
 
 tgBlockField::Config::Config(btVector3 origin,
                              btScalar friction, 
@@ -70,18 +70,12 @@ tgBlockField::tgBlockField() :
 tgModel(),
 m_config()
 {
-    // Seed the random number generator
-    /// @todo assess if doing this multiple times in a trial (here and evolution) causes problems
-    tgUtil::seedRandom(1);
 }
 
 tgBlockField::tgBlockField(tgBlockField::Config& config) :
 tgModel(),
 m_config(config)
 {
-    // Seed the random number generator
-    /// @todo assess if doing this multiple times in a trial (here and evolution) causes problems
-    tgUtil::seedRandom(1);
 }
 
 tgBlockField::~tgBlockField() {}
@@ -131,10 +125,15 @@ void tgBlockField::addNodes(tgStructure& s) {
     
     btVector3 fieldSize = m_config.m_maxPos - m_config.m_minPos;
     
+    // A fixed seed gives the same field every setup. The generator is
+    // local so that fields built on other threads don't interfere.
+    std::tr1::mt19937 eng(1);
+    std::tr1::uniform_real<double> unif(0, 1);
+    
     for(size_t i = 0; i < 2 * m_config.m_nBlocks; i += 2) {
-        double xOffset = fieldSize.getX() * rand() / RAND_MAX;
-        double yOffset = fieldSize.getY() * rand() / RAND_MAX;
-        double zOffset = fieldSize.getZ() * rand() / RAND_MAX;
+        double xOffset = fieldSize.getX() * unif(eng);
+        double yOffset = fieldSize.getY() * unif(eng);
+        double zOffset = fieldSize.getZ() * unif(eng);
         
         btVector3 offset(xOffset, yOffset, zOffset);
         
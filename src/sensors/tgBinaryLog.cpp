@@ -0,0 +1,146 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgBinaryLog.cpp
+ * @brief Contains the implementation of class tgBinaryLog.
+ * $Id$
+ */
+
+// This module
+#include "tgBinaryLog.h"
+// The C++ Standard Library
+#include <cstring>
+#include <stdexcept>
+#include <stdint.h>
+
+namespace
+{
+  const char magic[8] = { 'N', 'T', 'R', 'T', 'L', 'O', 'G', '2' };
+
+  /** Guard against reading garbage as a huge allocation */
+  const unsigned int maxStringLength = 1 << 20;
+}
+
+const unsigned int tgBinaryLog::version;
+
+void tgBinaryLog::writeUInt(std::ostream& os, unsigned int value)
+{
+  const uint32_t v = value;
+  os.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+unsigned int tgBinaryLog::readUInt(std::istream& is)
+{
+  uint32_t v = 0;
+  if (!is.read(reinterpret_cast<char*>(&v), sizeof(v))) {
+    throw std::runtime_error("Binary log header is truncated.");
+  }
+  return v;
+}
+
+void tgBinaryLog::writeString(std::ostream& os, const std::string& s)
+{
+  writeUInt(os, s.size());
+  os.write(s.data(), s.size());
+}
+
+std::string tgBinaryLog::readString(std::istream& is)
+{
+  const unsigned int length = readUInt(is);
+  if (length > maxStringLength) {
+    throw std::runtime_error("Binary log header is corrupt.");
+  }
+  std::string s(length, '\0');
+  if (length > 0 && !is.read(&s[0], length)) {
+    throw std::runtime_error("Binary log header is truncated.");
+  }
+  return s;
+}
+
+void tgBinaryLog::writeHeader(std::ostream& os, const std::string& preamble,
+			      const std::vector<std::string>& names)
+{
+  os.write(magic, sizeof(magic));
+  writeUInt(os, version);
+  writeString(os, preamble);
+  writeUInt(os, names.size());
+  for (std::size_t i = 0; i < names.size(); i++) {
+    const char type = DOUBLE;
+    os.write(&type, 1);
+    writeString(os, names[i]);
+  }
+}
+
+void tgBinaryLog::readHeader(std::istream& is, std::string& preamble,
+			     std::vector<std::string>& names)
+{
+  char m[sizeof(magic)];
+  if (!is.read(m, sizeof(m)) || std::memcmp(m, magic, sizeof(magic)) != 0) {
+    throw std::runtime_error("Not a tgDataLogger2 binary log.");
+  }
+  if (readUInt(is) != version) {
+    throw std::runtime_error("Unsupported binary log version.");
+  }
+  preamble = readString(is);
+  const unsigned int numColumns = readUInt(is);
+  names.clear();
+  for (unsigned int i = 0; i < numColumns; i++) {
+    char type = 0;
+    if (!is.read(&type, 1)) {
+      throw std::runtime_error("Binary log header is truncated.");
+    }
+    if (type != DOUBLE) {
+      throw std::runtime_error("Binary log has an unsupported column type.");
+    }
+    names.push_back(readString(is));
+  }
+}
+
+std::size_t tgBinaryLog::toCSV(std::istream& is, std::ostream& os)
+{
+  std::string preamble;
+  std::vector<std::string> names;
+  readHeader(is, preamble, names);
+  if (names.empty()) {
+    throw std::runtime_error("Binary log has no columns.");
+  }
+
+  // Same layout as tgDataLogger2's CSV mode, trailing commas included.
+  os << preamble << std::endl;
+  for (std::size_t i = 0; i < names.size(); i++) {
+    os << names[i] << ",";
+  }
+  os << std::endl;
+
+  std::vector<double> row(names.size());
+  const std::streamsize rowBytes = row.size() * sizeof(double);
+  std::size_t numRows = 0;
+  while (is.read(reinterpret_cast<char*>(&row[0]), rowBytes)) {
+    for (std::size_t i = 0; i < row.size(); i++) {
+      os << row[i] << ",";
+    }
+    os << "\n";
+    numRows++;
+  }
+  if (is.gcount() != 0) {
+    throw std::runtime_error("Binary log ends with a partial row.");
+  }
+  os.flush();
+  return numRows;
+}
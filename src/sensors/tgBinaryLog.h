@@ -0,0 +1,90 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_BINARY_LOG_H
+#define TG_BINARY_LOG_H
+
+/**
+ * @file tgBinaryLog.h
+ * @brief Contains the definition of class tgBinaryLog.
+ * $Id$
+ */
+
+// Includes from the C++ standard library
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * The binary columnar log format written by tgDataLogger2 in BINARY mode.
+ * The file is a header followed by fixed size rows:
+ * - 8 bytes of magic, "NTRTLOG2"
+ * - uint32 version, uint32 preamble length, then the preamble text
+ *   (the first line of the equivalent CSV log)
+ * - uint32 column count, then for each column a uint8 type and a
+ *   uint32 name length followed by the name
+ * - rows of one native-endian value per column, until end of file.
+ * Only DOUBLE columns are written at present; the first is "time".
+ */
+class tgBinaryLog
+{
+public:
+
+  /** Storage type of a column */
+  enum ColumnType { DOUBLE = 0 };
+
+  /**
+   * Write the header.
+   * @param[in] os an output stream opened in binary mode
+   * @param[in] preamble a line of free text describing the log
+   * @param[in] names the column names, all of type DOUBLE
+   */
+  static void writeHeader(std::ostream& os, const std::string& preamble,
+			  const std::vector<std::string>& names);
+
+  /**
+   * Read and check the header, leaving the stream at the first row.
+   * @throw std::runtime_error if the stream is not a supported log
+   */
+  static void readHeader(std::istream& is, std::string& preamble,
+			 std::vector<std::string>& names);
+
+  /**
+   * Convert a binary log to the CSV layout written by tgDataLogger2 in
+   * CSV mode. Values are formatted with the default stream precision,
+   * as the sensors format them.
+   * @return the number of rows converted
+   */
+  static std::size_t toCSV(std::istream& is, std::ostream& os);
+
+  /** Format version written into the header */
+  static const unsigned int version = 1;
+
+private:
+
+  static void writeUInt(std::ostream& os, unsigned int value);
+
+  static unsigned int readUInt(std::istream& is);
+
+  static void writeString(std::ostream& os, const std::string& s);
+
+  static std::string readString(std::istream& is);
+
+};
+
+#endif // TG_BINARY_LOG_H
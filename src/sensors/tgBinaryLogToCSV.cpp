@@ -0,0 +1,84 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgBinaryLogToCSV.cpp
+ * @brief Converts a binary tgDataLogger2 log to its CSV layout
+ * $Id$
+ */
+
+// This module
+#include "tgBinaryLog.h"
+// The C++ Standard Library
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Usage: tgBinaryLogToCSV <log.bin> [out.txt]
+ * Without an output name, the .bin extension is replaced by .txt.
+ */
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <log.bin> [out.txt]"
+                  << std::endl;
+        return 1;
+    }
+
+    const std::string inName = argv[1];
+    std::string outName;
+    if (argc == 3)
+    {
+        outName = argv[2];
+    }
+    else
+    {
+        const std::string::size_type dot = inName.rfind(".bin");
+        outName = (dot != std::string::npos && dot + 4 == inName.size()) ?
+            inName.substr(0, dot) + ".txt" : inName + ".txt";
+    }
+
+    std::ifstream in(inName.c_str(), std::ios::in | std::ios::binary);
+    if (!in.is_open())
+    {
+        std::cerr << "Could not open " << inName << std::endl;
+        return 1;
+    }
+    std::ofstream out(outName.c_str());
+    if (!out.is_open())
+    {
+        std::cerr << "Could not open " << outName << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        const std::size_t numRows = tgBinaryLog::toCSV(in, out);
+        std::cout << "Wrote " << numRows << " rows to " << outName
+                  << std::endl;
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cerr << inName << ": " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -82,7 +82,8 @@ public:
    * of the consistutent rigid bodies?
    */
   virtual std::vector<std::string> getSensorDataHeadings();
-  virtual std::vector<std::string> getSensorData();
+  virtual std::size_t getSensorDataSize();
+  virtual void readSensorData(double* pData);
 
  private:
 
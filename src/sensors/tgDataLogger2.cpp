@@ -27,6 +27,7 @@
 #include "tgDataLogger2.h"
 // This application
 #include "tgSensor.h"
+#include "tgBinaryLog.h"
 // The C++ Standard Library
 #include <stdexcept>
 #include <cassert>
@@ -36,6 +37,12 @@
 #include <sstream> // for converting a size_t to a string.
 #include <cstdlib> // for getenv, converting ~ to $HOME.
 
+namespace
+{
+  /** Size of the log file's write buffer, in bytes. */
+  const std::size_t fileBufferSize = 1 << 20;
+}
+
 /**
  * The constructor for this class only assigns the filename prefix.
  * The actual filename is created in setup.
@@ -43,10 +50,13 @@
  * appending to the same one.)
  * Call the constructor of the parent class anyway, though it does nothing.
  */
-tgDataLogger2::tgDataLogger2(std::string fileNamePrefix, double timeInterval) :
+tgDataLogger2::tgDataLogger2(std::string fileNamePrefix, double timeInterval,
+			     Format format) :
   tgDataManager(),
   m_fileNamePrefix(fileNamePrefix),
-  m_timeInterval(timeInterval)
+  m_fileBuffer(fileBufferSize),
+  m_timeInterval(timeInterval),
+  m_format(format)
 {
   // A quick check on the passed-in string: it must not be the empty
   // string. Must be a correct linux path.
@@ -84,19 +94,25 @@ tgDataLogger2::tgDataLogger2(std::string fileNamePrefix, double timeInterval) :
  * lets the simulator compile, but then complains when it's called.
  * DO NOT USE THIS ONE: use the one with the string passed in!
  */
-tgDataLogger2::tgDataLogger2()
+tgDataLogger2::tgDataLogger2() :
+  m_format(CSV)
 {
   throw std::invalid_argument("Cannot create a tgDataLogger2 without a path to the log file! Please use the constructor that takes a string.");
 }
 
 /**
- * The destructor should not have to do anything.
- * Closing the log file is handled by teardown(), and the parent class
- * handles deletion of the sensors and sensor infos.
+ * Closing the log file is normally handled by teardown(), and the parent
+ * class handles deletion of the sensors and sensor infos. If teardown was
+ * never called, the file is flushed and closed here, once the writer has
+ * stopped and while m_fileBuffer is still alive.
  */
 tgDataLogger2::~tgDataLogger2()
 {
-  // TO-DO: should we double-check and close the tgOutput filestream here too?
+  stopWriter();
+  if (tgOutput.is_open()) {
+    tgOutput.flush();
+    tgOutput.close();
+  }
 }
 
 /**
@@ -104,7 +120,7 @@ tgDataLogger2::~tgDataLogger2()
  * (1) create the full filename, based on the current time from the operating system,
  * (2) create the sensors based on the sensor infos that have been added and 
  *     the senseable objects that have also been added,
- * (3) opens the log file and writes a heading line (then closes the file.)
+ * (3) opens the log file and writes a heading, leaving the file open.
  */
 void tgDataLogger2::setup()
 {
@@ -125,26 +141,33 @@ void tgDataLogger2::setup()
   currentTime = localtime(&rawtime);
   strftime(fileTime, fileTimeSize, "%m%d%Y_%H%M%S", currentTime);
   // Result: fileTime is a string with the time information.
-  m_fileName = m_fileNamePrefix + "_" + fileTime + ".txt";
+  m_fileName = m_fileNamePrefix + "_" + fileTime
+    + (m_format == BINARY ? ".bin" : ".txt");
 
   // DEBUGGING output:
   std::cout << "tgDataLogger2 will be saving data to the file: " << std::endl
 	    << m_fileName << std::endl;
 
-  // Attempt to open the log file
-  tgOutput.open(m_fileName.c_str());
+  // Attempt to open the log file. The buffer must be installed before
+  // opening for it to take effect.
+  tgOutput.rdbuf()->pubsetbuf(&m_fileBuffer[0], m_fileBuffer.size());
+  tgOutput.open(m_fileName.c_str(),
+		m_format == BINARY ? std::ios::out | std::ios::binary
+		                   : std::ios::out);
   if (!tgOutput.is_open()) {
     throw std::runtime_error("Log file could not be opened. Usually, this is because the directory you specified does not exist. Check for spelling errors.");
   }
 
-  // Output a first line of the header.
-  tgOutput << "tgDataLogger2 started logging at time " << fileTime << ", with "
+  // The first line of the header.
+  std::ostringstream preamble;
+  preamble << "tgDataLogger2 started logging at time " << fileTime << ", with "
 	   << m_sensors.size() << " sensors on " << m_senseables.size()
-	   << " senseable objects." << std::endl;
+	   << " senseable objects.";
 
   // The first column of data will be "time", the m_totalTime since beginning
   // of the simulation.
-  tgOutput << "time,";
+  std::vector<std::string> columns;
+  columns.push_back("time");
 
   // Iterate. For each sensor, output its header.
   // Prepend each label with the sensor number, which we choose to be the index in
@@ -153,18 +176,35 @@ void tgDataLogger2::setup()
   for (std::size_t i=0; i < m_sensors.size(); i++) {
     // Get the vector of sensor data headings from this sensor
     std::vector<std::string> headings = m_sensors[i]->getSensorDataHeadings();
-    // Iterate and output each heading
+    if (headings.size() != m_sensorColumns[i]) {
+      throw std::runtime_error("Sensor returns a different number of values than headings. Log rows would be misaligned.");
+    }
+    // Prepend each heading with the sensor number and an underscore.
     for (std::size_t j=0; j < headings.size(); j++) {
-      // Prepend with the sensor number and an underscore.
-      // Also, end with a comma, since this is a comma-separated-value log file.
-      tgOutput << i << "_" << headings[j] << ",";
+      std::ostringstream column;
+      column << i << "_" << headings[j];
+      columns.push_back(column.str());
+    }
+  }
+
+  if (m_format == BINARY) {
+    tgBinaryLog::writeHeader(tgOutput, preamble.str(), columns);
+  }
+  else {
+    tgOutput << preamble.str() << std::endl;
+    // End each column with a comma, since this is a comma-separated-value
+    // log file.
+    for (std::size_t i=0; i < columns.size(); i++) {
+      tgOutput << columns[i] << ",";
     }
+    // End with a new line.
+    tgOutput << std::endl;
   }
-  // End with a new line.
-  tgOutput << std::endl;
+  m_row.assign(columns.size(), 0.0);
+  assert(m_row.size() == m_numColumns + 1);
 
-  // Done! Close the output for now, will be re-opened during step.
-  tgOutput.close();
+  // The header is written, so rows may now go to a writer thread.
+  startWriter(m_row.size());
 
   // Initialize/reset the values of the time variables.
   m_totalTime = 0.0;
@@ -181,8 +221,11 @@ void tgDataLogger2::teardown()
 {
   // Call the parent's teardown method! This is important!
   tgDataManager::teardown();
-  // Close the log file.
-  tgOutput.close();
+  // Flush the buffered rows and close the log file.
+  if (tgOutput.is_open()) {
+    tgOutput.flush();
+    tgOutput.close();
+  }
   // Postcondition
   assert(invariant());
 }
@@ -191,7 +234,7 @@ void tgDataLogger2::teardown()
  * The step method is where data is actually collected!
  * This data logger will do two things here:
  * (1) iterate through all the sensors, collect their data, 
- * (2) write that line of data to the log file (then close the log again.)
+ * (2) write that row of data to the buffered log file.
  */
 void tgDataLogger2::step(double dt) 
 {
@@ -207,23 +250,10 @@ void tgDataLogger2::step(double dt)
     m_updateTime += dt;
     // Then, if enough time has elapsed between the previous sensor reading,
     if (m_updateTime >= m_timeInterval) {
-      // Open the log file for writing, appending and not overwriting.
-      tgOutput.open(m_fileName.c_str(), std::ios::app);
-      // Then output the time.
-      tgOutput << m_totalTime << ",";
-      // Collect the data and output it to the file!
-      for (size_t i=0; i < m_sensors.size(); i++) {
-	// Get the vector of sensor data from this sensor
-	std::vector<std::string> sensordata = m_sensors[i]->getSensorData();
-	// Iterate and output each data sample
-	for (std::size_t j=0; j < sensordata.size(); j++) {
-	  // Include a comma, since this is a comma-separated-value log file.
-	  tgOutput << sensordata[j] << ",";
-	}
-      }
-      tgOutput << std::endl;
-      // Close the output, to be re-opened next step.
-      tgOutput.close();
+      // The time, then every sensor's values, read straight into the row.
+      m_row[0] = m_totalTime;
+      readSensors(&m_row[0] + 1);
+      submitRow(&m_row[0]);
       // Now that the sensors have been read, reset the counter.
       m_updateTime = 0.0;
     }
@@ -233,6 +263,23 @@ void tgDataLogger2::step(double dt)
   assert(invariant());
 }
 
+void tgDataLogger2::writeRow(const double* pRow)
+{
+  if (m_format == BINARY) {
+    tgOutput.write(reinterpret_cast<const char*>(pRow),
+		   m_row.size() * sizeof(double));
+  }
+  else {
+    // Include a comma after each value, since this is a comma-separated-value
+    // log file. Values are formatted as the sensors' string data would be.
+    for (std::size_t i=0; i < m_row.size(); i++) {
+      tgOutput << pRow[i] << ",";
+    }
+    // No std::endl: the buffer is flushed at teardown, not every row.
+    tgOutput << "\n";
+  }
+}
+
 /**
  * The toString method for tgDataLogger2 should have some specific information
  * about (for example) the log file...
@@ -242,7 +289,9 @@ std::string tgDataLogger2::toString() const
   std::string p = "  ";  
   std::ostringstream os;
   os << tgDataManager::toString()
-     << "This tgDataManager is a tgDataLogger2. " << std::endl;
+     << "This tgDataManager is a tgDataLogger2, writing "
+     << (m_format == BINARY ? "binary" : "CSV") << " to "
+     << m_fileName << std::endl;
 
   return os.str();
 }
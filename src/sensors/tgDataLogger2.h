@@ -30,15 +30,21 @@
 #include "tgDataManager.h"
 // Includes from the C++ standard library
 #include <fstream> // for writing to a file
+#include <vector>
 
 /**
  * tgDataLogger2 is a tgDataManager. It records data from sensors and outputs
- * that data to a log file, in comma-separated-value (CSV) format.
+ * that data to a log file, in comma-separated-value (CSV) format, or in the
+ * binary columnar format described in tgBinaryLog.h. The log file is kept
+ * open, through a large buffer, from setup to teardown.
  */
 class tgDataLogger2 : public tgDataManager
 {
  public:
 
+  /** Output format of the log file */
+  enum Format { CSV, BINARY };
+
   /**
    * The constructor for tgDataLogger2 takes in a string that specifies the location
    * of the log file to create, as well as an optional variable that controls
@@ -47,8 +53,11 @@ class tgDataLogger2 : public tgDataManager
    * will be written. The current time will be appended to this prefix.
    * @param[in] timeInterval the time interval for querying sensors. Note that an updateTime
    * of 0 means that sensors will be queried at each call of step().
+   * @param[in] format CSV writes text, BINARY writes raw doubles that
+   * tgBinaryLogToCSV converts back to the CSV layout.
    */
-  tgDataLogger2(std::string fileNamePrefix, double timeInterval = 0.0);
+  tgDataLogger2(std::string fileNamePrefix, double timeInterval = 0.0,
+		Format format = CSV);
 
   /**
    * Since folks will probably forget that a file name is needed,
@@ -57,8 +66,8 @@ class tgDataLogger2 : public tgDataManager
   tgDataLogger2();
 
   /**
-   * The base class handles destruction of the sensors and sensorInfos,
-   * so nothing to do here.
+   * The base class handles destruction of the sensors and sensorInfos.
+   * This stops the writer thread, if any, while writeRow is still ours.
    */
   ~tgDataLogger2();
 
@@ -71,15 +80,15 @@ class tgDataLogger2 : public tgDataManager
   virtual void setup();
 
   /**
-   * The teardown function closes the log file.
+   * The teardown function flushes and closes the log file.
    * TO-DO: should this class also teardown the sensors, or should we let
    * the superclass handle it??
    */
   virtual void teardown();
 
   /**
-   * The step function for tgDataLogger2 will open the log file for output,
-   * write a line of sensor data, then close the log file.
+   * The step function for tgDataLogger2 will write a row of sensor data
+   * to the log file.
    * Declared virtual here just in case any classes inherit from this.
    * @param[in] dt a double, the amount of time since the last step. 
    */
@@ -111,6 +120,13 @@ class tgDataLogger2 : public tgDataManager
    */
   std::string m_fileNamePrefix;
 
+  /**
+   * Buffer for tgOutput, so that rows reach the disk in large writes
+   * rather than one per step. Declared before tgOutput so that it is
+   * destroyed after the stream is done with it.
+   */
+  std::vector<char> m_fileBuffer;
+
   /**
    * A file stream, based on m_fileName.
    */
@@ -134,6 +150,20 @@ class tgDataLogger2 : public tgDataManager
    * check m_timeInterval.
    */
   double m_updateTime;
+
+  /** CSV or BINARY, fixed at construction. */
+  const Format m_format;
+
+  /**
+   * One row of data, time first, reused every step.
+   */
+  std::vector<double> m_row;
+
+  /**
+   * Write a row of m_row's width to the log file, in m_format. Runs on
+   * the writer thread if asynchronous mode is enabled.
+   */
+  virtual void writeRow(const double* pRow);
   
 };
 
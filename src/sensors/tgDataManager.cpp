@@ -29,6 +29,7 @@
 #include "tgSensor.h"
 #include "core/tgSenseable.h"
 #include "tgSensorInfo.h"
+#include "tgRowQueue.h"
 // The C++ Standard Library
 //#include <stdio.h> // for sprintf
 #include <iostream>
@@ -38,7 +39,13 @@
 /**
  * Nothing to do, in this abstract base class.
  */
-tgDataManager::tgDataManager()
+tgDataManager::tgDataManager() :
+  m_numColumns(0),
+  m_asyncRows(0),
+  m_backPressure(BLOCK),
+  m_pQueue(NULL),
+  m_droppedSamples(0),
+  m_queueHighWater(0)
 {
   // Postcondition
   assert(invariant());
@@ -54,6 +61,10 @@ tgDataManager::~tgDataManager()
 {
   //DEBUGGING
   //std::cout << "tgDataManager destructor." << std::endl;
+
+  // Normally done by teardown. Any rows still queued go to this class's
+  // writeRow, since subclasses have already been destroyed.
+  stopWriter();
   
   // First, delete everything in m_sensors.
   const size_t n_Sens = m_sensors.size();
@@ -134,6 +145,16 @@ void tgDataManager::setup()
       addSensorsHelper(descendants[k]);
     }
   }
+
+  // Ask each sensor once how many values it returns, so that stepping
+  // can read them straight into a row.
+  m_sensorColumns.clear();
+  m_numColumns = 0;
+  for (size_t i=0; i < m_sensors.size(); i++) {
+    const std::size_t n = m_sensors[i]->getSensorDataSize();
+    m_sensorColumns.push_back(n);
+    m_numColumns += n;
+  }
   
   // Postcondition
   assert(invariant());
@@ -148,6 +169,9 @@ void tgDataManager::setup()
  */
 void tgDataManager::teardown()
 {  
+  // Write out every queued row before anything else is torn down.
+  stopWriter();
+
   // First, delete the sensors.
   // Note that it's good practice to set deleted pointers to NULL here.
   for (std::size_t i = 0; i < m_sensors.size(); i++)
@@ -160,6 +184,8 @@ void tgDataManager::teardown()
   // Clear the list so that the destructor for this class doesn't have to
   // do anything.
   m_sensors.clear();
+  m_sensorColumns.clear();
+  m_numColumns = 0;
 
   // Don't touch the list of senseable objects.
   // These tgModels are not re-created when teardown is called (I think?),
@@ -190,6 +216,119 @@ void tgDataManager::step(double dt)
   assert(invariant());
 }
 
+/**
+ * Collect a whole sample. Each sensor writes its values directly after
+ * the previous sensor's.
+ */
+void tgDataManager::readSensors(double* pRow) const
+{
+  assert(m_sensorColumns.size() == m_sensors.size());
+  for (std::size_t i = 0; i < m_sensors.size(); i++)
+  {
+    m_sensors[i]->readSensorData(pRow);
+    pRow += m_sensorColumns[i];
+  }
+}
+
+/**
+ * Asynchronous mode only changes how rows are written, so it is picked
+ * up by the next setup rather than changing a running writer.
+ */
+void tgDataManager::enableAsync(std::size_t queueRows, BackPressure policy)
+{
+  if (queueRows == 0)
+  {
+    throw std::invalid_argument("queueRows must be positive.");
+  }
+  m_asyncRows = queueRows;
+  m_backPressure = policy;
+}
+
+void tgDataManager::disableAsync()
+{
+  m_asyncRows = 0;
+}
+
+void tgDataManager::startWriter(std::size_t rowWidth)
+{
+  assert(m_pQueue == NULL);
+  m_droppedSamples = 0;
+  m_queueHighWater = 0;
+  if (m_asyncRows == 0 || rowWidth == 0)
+  {
+    return;
+  }
+
+  m_pQueue = new tgRowQueue(m_asyncRows, rowWidth);
+  if (pthread_create(&m_writer, NULL, &tgDataManager::writerThread, this) != 0)
+  {
+    delete m_pQueue;
+    m_pQueue = NULL;
+    throw std::runtime_error("Could not start the data manager's writer thread.");
+  }
+}
+
+void tgDataManager::stopWriter()
+{
+  if (m_pQueue != NULL)
+  {
+    m_pQueue->close();
+    pthread_join(m_writer, NULL);
+    delete m_pQueue;
+    m_pQueue = NULL;
+  }
+}
+
+void* tgDataManager::writerThread(void* pManager)
+{
+  tgDataManager* const self = static_cast<tgDataManager*>(pManager);
+  tgRowQueue* const pQueue = self->m_pQueue;
+  while (true)
+  {
+    // Sleeps until there is a row, or the queue is closed and empty:
+    // rows pushed before the close are all written.
+    pQueue->waitForRow();
+    const double* pRow = pQueue->front();
+    if (pRow == NULL)
+    {
+      break;
+    }
+    self->writeRow(pRow);
+    pQueue->pop();
+  }
+  return NULL;
+}
+
+void tgDataManager::submitRow(const double* pRow)
+{
+  if (m_pQueue == NULL)
+  {
+    writeRow(pRow);
+    return;
+  }
+
+  while (!m_pQueue->tryPush(pRow))
+  {
+    if (m_backPressure == DROP)
+    {
+      m_droppedSamples++;
+      return;
+    }
+    // BLOCK: sleep until the writer frees a slot.
+    m_pQueue->waitForSpace();
+  }
+
+  const std::size_t queued = m_pQueue->size();
+  if (queued > m_queueHighWater)
+  {
+    m_queueHighWater = queued;
+  }
+}
+
+void tgDataManager::writeRow(const double* pRow)
+{
+}
+
 /**
  * This method adds sensor info objects to this data manager.
  * It takes in a pointer to a sensor info and pushes it to the
@@ -250,6 +389,13 @@ std::string tgDataManager::toString() const
      << " with " << m_sensors.size() << " sensors, " << m_sensorInfos.size()
      << " sensorInfos, and " << m_senseables.size() << " senseable objects."
      << std::endl;
+  if (m_asyncRows > 0)
+  {
+    os << "Writing asynchronously through a " << m_asyncRows << " row queue ("
+       << (m_backPressure == DROP ? "drop" : "block") << " when full), "
+       << m_droppedSamples << " samples dropped, high-water mark "
+       << m_queueHighWater << " rows." << std::endl;
+  }
 
   return os.str();
 }
@@ -260,7 +406,8 @@ bool tgDataManager::invariant() const
   // TO-DO:
   // m_sensors and m_sensorInfos are sane, check somehow...?
   // For example, check if any of the pointers in m_sensors are NULL.
-  return true;
+  return m_sensorColumns.empty() ||
+    (m_sensorColumns.size() == m_sensors.size());
 }
 
 std::ostream&
@@ -33,10 +33,12 @@
 #include <sstream>
 #include <iostream>
 #include <vector>
+#include <pthread.h> // for the asynchronous writer
 
 // Forward declarations
 class tgSensor;
 class tgSensorInfo;
+class tgRowQueue;
 
 /**
  * Abstract class for objects that will manage data within NTRTsim.
@@ -48,6 +50,13 @@ class tgDataManager
 {
 public: 
 
+    /**
+     * What submitRow does in asynchronous mode when the queue is full.
+     * BLOCK waits for the writer, so no samples are lost. DROP discards
+     * the sample and counts it, so the simulation never waits on disk.
+     */
+    enum BackPressure { BLOCK, DROP };
+
     /**
     * The default constructor. Nothing to do in this base class,
     * but subclasses might do something (e.g. set up a path name for
@@ -103,8 +112,32 @@ public:
      */
     virtual std::string toString() const;
 
+    /**
+     * Hand rows to a background writer thread instead of writing them on
+     * the simulation thread. Takes effect at the next setup().
+     * @param[in] queueRows the number of rows the queue holds, positive
+     * @param[in] policy what to do when the queue is full
+     */
+    void enableAsync(std::size_t queueRows = 4096,
+		     BackPressure policy = BLOCK);
+
+    /** Write rows on the simulation thread again, from the next setup(). */
+    void disableAsync();
+
+    /** Whether the writer thread is running. */
+    bool isAsyncRunning() const { return m_pQueue != NULL; }
+
+    /** Rows discarded under the DROP policy since the last setup(). */
+    std::size_t getDroppedSamples() const { return m_droppedSamples; }
+
+    /** The most rows queued at once since the last setup(). */
+    std::size_t getQueueHighWater() const { return m_queueHighWater; }
+
  private:
 
+    /** Body of the writer thread: drain the queue through writeRow. */
+    static void* writerThread(void* pManager);
+
     /**
      * A helper function for setup. Since there will be a loop over
      * the sensor infos, this function abstracts it away.
@@ -117,6 +150,42 @@ protected:
     // Integrity predicate.
     bool invariant() const;
 
+    /**
+     * Read every sensor into one row, in the order of m_sensors, with no
+     * formatting or allocation.
+     * @param[out] pRow room for m_numColumns doubles
+     */
+    void readSensors(double* pRow) const;
+
+    /**
+     * Record a row. Calls writeRow directly, or queues a copy for the
+     * writer thread if asynchronous mode is running.
+     * @param[in] pRow the width given to startWriter
+     */
+    void submitRow(const double* pRow);
+
+    /**
+     * Write one row to the output. Runs on the writer thread in
+     * asynchronous mode, so it must only touch state that the
+     * simulation thread leaves alone between startWriter and stopWriter.
+     * The default does nothing.
+     */
+    virtual void writeRow(const double* pRow);
+
+    /**
+     * Start the writer thread if asynchronous mode is enabled. Subclasses
+     * call this at the end of setup, once their output is ready.
+     * @param[in] rowWidth the number of doubles in each submitted row
+     */
+    void startWriter(std::size_t rowWidth);
+
+    /**
+     * Drain the queue and join the writer thread, if it is running.
+     * Called by teardown; subclasses that write in writeRow must also
+     * call it from their destructors.
+     */
+    void stopWriter();
+
     /**
      * A data manager has a list of sensors that it 
      * has created (during setup.)
@@ -136,6 +205,31 @@ protected:
      */
     std::vector<tgSenseable*> m_senseables;
 
+    /**
+     * The number of values each sensor in m_sensors returns, fixed at
+     * setup from the sensors' headings.
+     */
+    std::vector<std::size_t> m_sensorColumns;
+
+    /**
+     * The sum of m_sensorColumns, the width of a row from readSensors.
+     */
+    std::size_t m_numColumns;
+
+private:
+
+    /** Settings for asynchronous mode. m_asyncRows == 0 means off. */
+    std::size_t m_asyncRows;
+    BackPressure m_backPressure;
+
+    /** Rows waiting for the writer thread, NULL when not running. */
+    tgRowQueue* m_pQueue;
+
+    pthread_t m_writer;
+
+    std::size_t m_droppedSamples;
+    std::size_t m_queueHighWater;
+
 };
 
 /**
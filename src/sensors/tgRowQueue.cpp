@@ -0,0 +1,163 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgRowQueue.cpp
+ * @brief Contains the implementation of class tgRowQueue.
+ * $Id$
+ */
+
+// This module
+#include "tgRowQueue.h"
+// Includes from the C++ standard library
+#include <algorithm>
+#include <stdexcept>
+
+tgRowQueue::tgRowQueue(std::size_t capacity, std::size_t width) :
+  m_capacity(capacity),
+  m_width(width),
+  m_data((capacity + 1) * width),
+  m_tail(0),
+  m_head(0),
+  m_closed(false),
+  m_consumerWaiting(false),
+  m_producerWaiting(false)
+{
+  if (capacity == 0) {
+    throw std::invalid_argument("Row queue capacity must be positive.");
+  }
+  if (width == 0) {
+    throw std::invalid_argument("Row queue width must be positive.");
+  }
+  pthread_mutex_init(&m_mutex, NULL);
+  pthread_cond_init(&m_rowReady, NULL);
+  pthread_cond_init(&m_spaceReady, NULL);
+}
+
+tgRowQueue::~tgRowQueue()
+{
+  pthread_cond_destroy(&m_spaceReady);
+  pthread_cond_destroy(&m_rowReady);
+  pthread_mutex_destroy(&m_mutex);
+}
+
+bool tgRowQueue::tryPush(const double* pRow)
+{
+  const std::size_t tail = m_tail.load(boost::memory_order_relaxed);
+  const std::size_t next = (tail == m_capacity) ? 0 : tail + 1;
+  if (next == m_head.load(boost::memory_order_acquire)) {
+    return false;
+  }
+  std::copy(pRow, pRow + m_width, &m_data[tail * m_width]);
+  // Publish the row to the consumer.
+  m_tail.store(next, boost::memory_order_release);
+  wake(m_consumerWaiting, m_rowReady);
+  return true;
+}
+
+const double* tgRowQueue::front() const
+{
+  const std::size_t head = m_head.load(boost::memory_order_relaxed);
+  if (head == m_tail.load(boost::memory_order_acquire)) {
+    return NULL;
+  }
+  return &m_data[head * m_width];
+}
+
+void tgRowQueue::pop()
+{
+  const std::size_t head = m_head.load(boost::memory_order_relaxed);
+  // Hand the slot back to the producer.
+  m_head.store((head == m_capacity) ? 0 : head + 1,
+	       boost::memory_order_release);
+  wake(m_producerWaiting, m_spaceReady);
+}
+
+void tgRowQueue::waitForRow()
+{
+  if (front() != NULL || isClosed()) {
+    return;
+  }
+  pthread_mutex_lock(&m_mutex);
+  m_consumerWaiting.store(true, boost::memory_order_relaxed);
+  // Either the producer sees the flag, or this sees its row.
+  boost::atomic_thread_fence(boost::memory_order_seq_cst);
+  while (front() == NULL && !isClosed()) {
+    pthread_cond_wait(&m_rowReady, &m_mutex);
+  }
+  m_consumerWaiting.store(false, boost::memory_order_relaxed);
+  pthread_mutex_unlock(&m_mutex);
+}
+
+void tgRowQueue::waitForSpace()
+{
+  if (!isFull()) {
+    return;
+  }
+  pthread_mutex_lock(&m_mutex);
+  m_producerWaiting.store(true, boost::memory_order_relaxed);
+  // Either the consumer sees the flag, or this sees its pop.
+  boost::atomic_thread_fence(boost::memory_order_seq_cst);
+  while (isFull()) {
+    pthread_cond_wait(&m_spaceReady, &m_mutex);
+  }
+  m_producerWaiting.store(false, boost::memory_order_relaxed);
+  pthread_mutex_unlock(&m_mutex);
+}
+
+void tgRowQueue::close()
+{
+  // Under the mutex, so a consumer between its check and its wait
+  // can't miss the wakeup.
+  pthread_mutex_lock(&m_mutex);
+  m_closed.store(true, boost::memory_order_release);
+  pthread_cond_broadcast(&m_rowReady);
+  pthread_mutex_unlock(&m_mutex);
+}
+
+bool tgRowQueue::isClosed() const
+{
+  return m_closed.load(boost::memory_order_acquire);
+}
+
+bool tgRowQueue::isFull() const
+{
+  const std::size_t tail = m_tail.load(boost::memory_order_relaxed);
+  const std::size_t next = (tail == m_capacity) ? 0 : tail + 1;
+  return next == m_head.load(boost::memory_order_acquire);
+}
+
+void tgRowQueue::wake(boost::atomic<bool>& waiting, pthread_cond_t& cond)
+{
+  // Pairs with the fence in waitForRow and waitForSpace.
+  boost::atomic_thread_fence(boost::memory_order_seq_cst);
+  if (waiting.load(boost::memory_order_relaxed)) {
+    // The sleeper holds the mutex until it is inside pthread_cond_wait,
+    // so this signal can't arrive between its check and its wait.
+    pthread_mutex_lock(&m_mutex);
+    pthread_cond_signal(&cond);
+    pthread_mutex_unlock(&m_mutex);
+  }
+}
+
+std::size_t tgRowQueue::size() const
+{
+  const std::size_t tail = m_tail.load(boost::memory_order_acquire);
+  const std::size_t head = m_head.load(boost::memory_order_acquire);
+  return (tail >= head) ? tail - head : tail + m_capacity + 1 - head;
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_ROW_QUEUE_H
+#define TG_ROW_QUEUE_H
+
+/**
+ * @file tgRowQueue.h
+ * @brief Contains the definition of class tgRowQueue.
+ * $Id$
+ */
+
+// Includes from the C++ standard library
+#include <cstddef>
+#include <vector>
+#include <stdint.h> // Boost 1.53's atomic.hpp uses uintptr_t without it
+#include <pthread.h>
+// Includes from Boost
+#include "boost/atomic.hpp"
+
+/**
+ * A bounded, lock-free queue of fixed-width rows of doubles, for exactly
+ * one producer thread and one consumer thread. Rows are copied in by
+ * tryPush and read in place by the consumer through front() and pop().
+ *
+ * A thread with nothing to do sleeps in waitForRow or waitForSpace
+ * instead of polling. Pushes and pops only take the mutex when the other
+ * thread is asleep, so the common case stays lock-free at the cost of one
+ * memory fence per call.
+ */
+class tgRowQueue
+{
+public:
+
+  /**
+   * @param[in] capacity the number of rows the queue can hold, positive
+   * @param[in] width the number of doubles in a row, positive
+   */
+  tgRowQueue(std::size_t capacity, std::size_t width);
+
+  ~tgRowQueue();
+
+  /**
+   * Producer only. Copy a row into the queue.
+   * @return false, without copying, if the queue is full
+   */
+  bool tryPush(const double* pRow);
+
+  /**
+   * Consumer only. The oldest row, or NULL if the queue is empty.
+   * Valid until pop().
+   */
+  const double* front() const;
+
+  /** Consumer only. Release the row returned by front(). */
+  void pop();
+
+  /**
+   * Consumer only. Sleep until front() has a row or the queue is closed.
+   */
+  void waitForRow();
+
+  /**
+   * Producer only. Sleep until tryPush has room for a row.
+   */
+  void waitForSpace();
+
+  /**
+   * Producer only. Signal that no more rows will be pushed; rows already
+   * queued can still be read. Wakes the consumer.
+   */
+  void close();
+
+  /** Whether close() has been called. */
+  bool isClosed() const;
+
+  /**
+   * The number of rows queued. Exact from either thread's own point of
+   * view, approximate from the other's.
+   */
+  std::size_t size() const;
+
+  std::size_t capacity() const { return m_capacity; }
+
+  std::size_t width() const { return m_width; }
+
+private:
+
+  /** Rows are stored in slots 0..m_capacity, one slot is always free. */
+  const std::size_t m_capacity;
+  const std::size_t m_width;
+  std::vector<double> m_data;
+
+  /** Next slot the producer writes. Written by the producer only. */
+  boost::atomic<std::size_t> m_tail;
+
+  /** Next slot the consumer reads. Written by the consumer only. */
+  boost::atomic<std::size_t> m_head;
+
+  boost::atomic<bool> m_closed;
+
+  /**
+   * Set by a thread about to sleep, so the other thread knows to signal.
+   * The flag and the index it depends on are ordered by full fences.
+   */
+  boost::atomic<bool> m_consumerWaiting;
+  boost::atomic<bool> m_producerWaiting;
+
+  /** Guards sleeping only, never the rows. */
+  pthread_mutex_t m_mutex;
+  pthread_cond_t m_rowReady;
+  pthread_cond_t m_spaceReady;
+
+  /** Whether there is no room for another row */
+  bool isFull() const;
+
+  /** Wake a thread sleeping on cond if it flagged that it is */
+  void wake(boost::atomic<bool>& waiting, pthread_cond_t& cond);
+
+  /** Not copyable */
+  tgRowQueue(const tgRowQueue&);
+  tgRowQueue& operator=(const tgRowQueue&);
+};
+
+#endif // TG_ROW_QUEUE_H
@@ -30,6 +30,7 @@
 
 // Includes from the c++ standard library:
 #include <stdexcept>
+#include <sstream>
 
 /**
  * This cpp file only implements the constructor for tgSensor.
@@ -55,3 +56,33 @@ tgSensor::~tgSensor()
 }
 
 //end.
+
+/**
+ * Sensors know their column count from their headings.
+ */
+std::size_t tgSensor::getSensorDataSize()
+{
+  return getSensorDataHeadings().size();
+}
+
+/**
+ * The string interface is an adapter over readSensorData, formatting
+ * each value the way a default std::stringstream does.
+ */
+std::vector<std::string> tgSensor::getSensorData()
+{
+  std::vector<double> values(getSensorDataSize());
+  if (!values.empty()) {
+    readSensorData(&values[0]);
+  }
+
+  std::vector<std::string> sensordata;
+  sensordata.reserve(values.size());
+  std::stringstream ss;
+  for (std::size_t i = 0; i < values.size(); i++) {
+    ss.str("");
+    ss << values[i];
+    sensordata.push_back( ss.str() );
+  }
+  return sensordata;
+}
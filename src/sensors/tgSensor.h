@@ -33,6 +33,7 @@ class tgSenseable;
 // From the C++ standard library:
 #include <iostream> //for strings
 #include <vector> // for returning lists of strings
+#include <cstddef> // for std::size_t
 
 /**
  * This class defines methods for use with sensors.
@@ -80,14 +81,29 @@ public:
    */
   virtual std::vector<std::string> getSensorDataHeadings() = 0;
 
+  /**
+   * The number of values this sensor returns, which is the number of
+   * headings. Callers should ask once, at setup.
+   */
+  virtual std::size_t getSensorDataSize();
+
+  /**
+   * Write the data from this class into a caller-provided buffer,
+   * in the same order as the headings. This is the interface to use
+   * inside the simulation loop: it does no formatting or allocation.
+   * @param[out] pData room for getSensorDataSize() doubles
+   */
+  virtual void readSensorData(double* pData) = 0;
+
   /**
    * Return the data from this class itself.
    * Note that this MUST have the same number of elements as is returned by
    * the getDataHeading function.
+   * The default formats the values of readSensorData.
    * @return a list of strings, each being a piece of sensor data,
    * in the same order as the headings.
    */
-  virtual std::vector<std::string> getSensorData() = 0;
+  virtual std::vector<std::string> getSensorData();
 
   // TO-DO: should any of this be const?
 
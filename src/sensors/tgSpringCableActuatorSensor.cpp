@@ -109,10 +109,17 @@ std::vector<std::string> tgSpringCableActuatorSensor::getSensorDataHeadings() {
   return headings;
 }
 
+/**
+ * Rest length, current length and tension, as in the headings.
+ */
+std::size_t tgSpringCableActuatorSensor::getSensorDataSize() {
+  return 3;
+}
+
 /**
  * The method that collects the actual data from this tgSpringCableActuator.
  */
-std::vector<std::string> tgSpringCableActuatorSensor::getSensorData() {
+void tgSpringCableActuatorSensor::readSensorData(double* pData) {
   // Similar to getSensorDataHeading, cast the a pointer
   // to a tgSpringCableActuator right now.
   tgSpringCableActuator* m_pSCA =
@@ -122,29 +129,9 @@ std::vector<std::string> tgSpringCableActuatorSensor::getSensorData() {
   // to a tgSpringCableActuator!!!
   assert( m_pSCA != 0);
 
-  // The list of sensor data that will be returned:
-  std::vector<std::string> sensordata;
-
-  // The floats doubles need to be converted to strings via a stringstream.
-  std::stringstream ss;
-
-  // rest length
-  ss << m_pSCA->getRestLength();
-  sensordata.push_back( ss.str() );
-  // Reset the stream.
-  ss.str("");
-
-  // current length
-  ss << m_pSCA->getCurrentLength();
-  sensordata.push_back( ss.str() );
-  ss.str("");
-
-  // tension
-  ss << m_pSCA->getTension();
-  sensordata.push_back( ss.str() );
-  ss.str("");
-  
-  return sensordata;
+  pData[0] = m_pSCA->getRestLength();
+  pData[1] = m_pSCA->getCurrentLength();
+  pData[2] = m_pSCA->getTension();
 }
 
 //end.
@@ -55,7 +55,8 @@ public:
    * Similarly, this class will implement the two data colleciton methods.
    */
   virtual std::vector<std::string> getSensorDataHeadings();
-  virtual std::vector<std::string> getSensorData();
+  virtual std::size_t getSensorDataSize();
+  virtual void readSensorData(double* pData);
 
 };
 
@@ -0,0 +1,187 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file AutoCompoundBenchmark.cpp
+ * @brief Times the grouping of tgRigidAutoCompound on synthetic
+ * structures and checks it against the previous pairwise search.
+ * $Id$
+ */
+
+// This library
+#include "tgPair.h"
+#include "tgRigidAutoCompound.h"
+#include "tgRodInfo.h"
+#include "core/tgRod.h"
+// Bullet Physics
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    typedef std::vector< std::deque<tgRigidInfo*> > Groups;
+
+    /** Exposes the grouping step, which has no side effects on the rigids */
+    class Grouping : public tgRigidAutoCompound
+    {
+    public:
+        Grouping(std::vector<tgRigidInfo*> rigids) :
+            tgRigidAutoCompound(rigids)
+        {
+        }
+
+        const Groups& group()
+        {
+            groupRigids();
+            return m_groups;
+        }
+    };
+
+    /** The pairwise search tgRigidAutoCompound used before */
+    std::deque<tgRigidInfo*> findGroup(tgRigidInfo* rigid,
+                                       std::deque<tgRigidInfo*>& ungrouped)
+    {
+        std::deque<tgRigidInfo*> group;
+        group.push_back(rigid);
+        ungrouped.erase(std::remove(ungrouped.begin(), ungrouped.end(), rigid),
+                        ungrouped.end());
+        std::size_t i = 0;
+        while (i < ungrouped.size())
+        {
+            tgRigidInfo* other = ungrouped[i];
+            if (rigid->sharesNodesWith(*other))
+            {
+                std::deque<tgRigidInfo*> links = findGroup(other, ungrouped);
+                group.insert(group.end(), links.begin(), links.end());
+                i = 0;
+            }
+            else
+            {
+                i++;
+            }
+        }
+        return group;
+    }
+
+    Groups pairwiseGroups(const std::vector<tgRigidInfo*>& rigids)
+    {
+        Groups groups;
+        std::deque<tgRigidInfo*> ungrouped(rigids.begin(), rigids.end());
+        while (!ungrouped.empty())
+        {
+            groups.push_back(findGroup(ungrouped[0], ungrouped));
+        }
+        return groups;
+    }
+
+    /**
+     * Rods in random order: stars of rods meeting at a hub, chains of
+     * rods meeting end to end, and free rods, in equal numbers
+     */
+    std::vector<tgRigidInfo*> makeStructure(int count)
+    {
+        const tgRod::Config config;
+        std::vector<tgRigidInfo*> rigids;
+        int made = 0;
+        for (int cluster = 0; made < count; cluster++)
+        {
+            const btVector3 origin(10.0 * (cluster % 100), 10.0 * (cluster / 100), 0.0);
+            const int kind = cluster % 3;
+            for (int j = 0; j < 6 && made < count; j++, made++)
+            {
+                btVector3 from = origin;
+                btVector3 to = origin + btVector3(1.0, j, 1.0);
+                if (kind == 1)
+                {
+                    from = origin + btVector3(j, 0.0, 0.0);
+                    to = origin + btVector3(j + 1, 0.0, 0.0);
+                }
+                else if (kind == 2)
+                {
+                    from = origin + btVector3(j, 1.0, 0.0);
+                    to = origin + btVector3(j, 1.0, 1.0);
+                }
+                rigids.push_back(new tgRodInfo(config, tgPair(from, to)));
+            }
+        }
+        std::srand(1);
+        std::random_shuffle(rigids.begin(), rigids.end());
+        return rigids;
+    }
+
+    double secondsSince(std::clock_t start)
+    {
+        return static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+    }
+}
+
+/**
+ * The entry point.
+ * @param[in] argc the number of command-line arguments
+ * @param[in] argv argv[0] is the executable name
+ * @param[in] argv argv[1], optional, is the largest structure the
+ * pairwise search is also timed on, 2000 by default
+ * @return 0 if both searches found the same groups, 1 otherwise
+ */
+int main(int argc, char** argv)
+{
+    const int maxPairwise = (argc > 1) ? std::atoi(argv[1]) : 2000;
+    const int sizes[] = {100, 300, 1000, 3000, 10000};
+
+    int status = 0;
+    for (std::size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        const int count = sizes[s];
+        const std::vector<tgRigidInfo*> rigids = makeStructure(count);
+
+        std::clock_t start = std::clock();
+        Grouping grouping(rigids);
+        const Groups groups = grouping.group();
+        const double indexed = secondsSince(start);
+
+        std::cout << count << " rigids, " << groups.size() << " groups: "
+                  << indexed * 1.0e3 << " ms";
+
+        if (count <= maxPairwise)
+        {
+            start = std::clock();
+            const Groups reference = pairwiseGroups(rigids);
+            const double pairwise = secondsSince(start);
+            const bool same = (groups == reference);
+            std::cout << ", pairwise " << pairwise * 1.0e3 << " ms"
+                      << (same ? ", same groups" : ", DIFFERENT GROUPS");
+            if (!same)
+            {
+                status = 1;
+            }
+        }
+        std::cout << std::endl;
+
+        for (std::size_t i = 0; i < rigids.size(); i++)
+        {
+            delete rigids[i];
+        }
+    }
+    return status;
+}
@@ -28,6 +28,8 @@
 
 #include "core/tgBulletSpringCable.h"
 #include "core/tgBulletSpringCableAnchor.h"
+#include "core/tgBulletSpringCableSystem.h"
+#include "core/tgBulletUtil.h"
 
 tgBasicActuatorInfo::tgBasicActuatorInfo(const tgBasicActuator::Config& config) : 
 m_config(config),
@@ -54,6 +56,8 @@ void tgBasicActuatorInfo::initConnector(tgWorld& world)
 {
     // Note: tgBulletSpringCable holds pointers to things in the world, but it doesn't actually have any in-world representation.
     m_bulletSpringCable = createTgBulletSpringCable();
+    // The world's cable system computes the forces for all cables at once
+    tgBulletUtil::worldToCableSystem(world).addCable(m_bulletSpringCable);
 }
 
 tgModel* tgBasicActuatorInfo::createModel(tgWorld& world)
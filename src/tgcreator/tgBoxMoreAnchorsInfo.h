@@ -152,6 +152,16 @@ public:
      */
     virtual bool containsNode(const btVector3& nodeVector) const;
 
+    /**
+     * Nodes on the surface count as contained, so this box cannot be
+     * found by its endpoints alone.
+     * @retval false
+     */
+    virtual bool containsOnlyNodes() const
+    {
+        return false;
+    }
+
     /**
      * Return a set containing all the nodes in this box. Note that
      * tgBoxInfo has this same function, and we're redefining it here
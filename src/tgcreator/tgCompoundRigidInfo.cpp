@@ -177,6 +177,18 @@ bool tgCompoundRigidInfo::containsNode(const btVector3& nodeVector) const
     return false;
 }
     
+bool tgCompoundRigidInfo::containsOnlyNodes() const
+{
+    for (std::size_t ii = 0; ii < m_rigids.size(); ii++)
+    {
+        if (!m_rigids[ii]->containsOnlyNodes())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+    
 bool tgCompoundRigidInfo::sharesNodesWith(const tgRigidInfo& other) const
 {
     /// @todo Use std::find_if()
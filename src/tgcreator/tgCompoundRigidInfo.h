@@ -188,6 +188,12 @@ class tgCompoundRigidInfo : public tgRigidInfo
      * @retval false if nodeVector is not a node anywhere in this compound
      */
     virtual bool containsNode(const btVector3& nodeVector) const;
+
+    /**
+     * @retval true if containsOnlyNodes is true for every rigid in
+     * this compound
+     */
+    virtual bool containsOnlyNodes() const;
     
     /**
      * @todo Make this const in all base classes and all derived classes.
@@ -35,6 +35,7 @@ class tgPair;
 class tgPairs;
 class tgTagSearch;
 class tgRigidInfo;
+class tgRigidNodeIndex;
 class btRigidBody;
 class tgModel;
 class tgWorld;
@@ -147,28 +148,30 @@ public:
     
     
     // Choose the appropriate rigids for the connector and give the connector pointers to them
-    virtual void chooseRigids(std::set<tgRigidInfo*> rigids);
+    virtual void chooseRigids(const tgRigidNodeIndex& index);
+
+    virtual void chooseRigids(const std::set<tgRigidInfo*>& rigids);
 
     // @todo: in the process of switching ti std::vector for these...
-    virtual void chooseRigids(std::vector<tgRigidInfo*> rigids) 
-    {
-        std::set<tgRigidInfo*> s;
-        s.insert(rigids.begin(), rigids.end());
-        chooseRigids(s);
-    }
+    virtual void chooseRigids(const std::vector<tgRigidInfo*>& rigids);
 
     
-    tgRigidInfo* chooseRigid(std::set<tgRigidInfo*> rigids, const btVector3& v);
+    tgRigidInfo* chooseRigid(const tgRigidNodeIndex& index, const btVector3& v);
+
+    tgRigidInfo* chooseRigid(const std::set<tgRigidInfo*>& rigids, const btVector3& v);
     
     
 protected:
-    tgRigidInfo* findClosestCenterOfMass(std::set<tgRigidInfo*> rigids, const btVector3& v);
+    // Pick one of the rigids containing v, NULL if there are none
+    tgRigidInfo* chooseCandidate(const std::set<tgRigidInfo*>& candidateRigids, const btVector3& v);
+
+    tgRigidInfo* findClosestCenterOfMass(const std::set<tgRigidInfo*>& rigids, const btVector3& v);
 
     // @todo: should this be protected/private?
-    std::set<tgRigidInfo*> findRigidsContaining(std::set<tgRigidInfo*> rigids, const btVector3& toFind);
+    std::set<tgRigidInfo*> findRigidsContaining(const std::set<tgRigidInfo*>& rigids, const btVector3& toFind);
     
     // @todo: Remove this? Is it used by anything?
-    bool rigidFoundIn(std::set<tgRigidInfo*> rigids, tgRigidInfo* rigid);
+    bool rigidFoundIn(const std::set<tgRigidInfo*>& rigids, tgRigidInfo* rigid);
     
     
     // Step 1: Define the points that we're connecting
@@ -30,7 +30,9 @@
 #include "BulletSoftBody/btSoftRigidDynamicsWorld.h"
 #include "tgCompoundRigidInfo.h"
 // The C++ standard library
+#include <algorithm>
 #include <map>
+#include <set>
 #include <cstdlib> // for random number generator
 #include <sstream> // for string streams, tags.
 // Boost
@@ -85,51 +87,134 @@ void tgRigidAutoCompound::setRigidInfoForGroup(tgRigidInfo* rigidInfo, std::dequ
     }
 }
 
-void tgRigidAutoCompound::groupRigids()
+namespace
 {
-    std::deque<tgRigidInfo*> ungrouped = std::deque<tgRigidInfo*>(m_rigids); // Copy of m_rigids
-
-    while(ungrouped.size() > 0) {
-        // go through each ungrouped element and find the groups for it
-        tgRigidInfo* elem = ungrouped[0]; // Note: the 0 element is removed by findGroup, so ungrouped[0] is different each iteration
+    /**
+     * The rigids that have a node, in the order of m_rigids, and the
+     * first of them that may not be grouped yet
+     */
+    struct NodeRigids
+    {
+        NodeRigids() : next(0) { }
+        std::vector<std::size_t> rigids;
+        std::size_t next;
+    };
 
-        // Find all elements linked to the first item in ungrouped
-        // This will also remove the elements in the group from ungrouped
-        std::deque<tgRigidInfo*> group = findGroup(elem, ungrouped);
+    /**
+     * Orders nodes so that two are equivalent exactly when
+     * btVector3::operator== is true, as sharesNodesWith compares them.
+     * btVector3 itself has no operator<.
+     */
+    struct NodeLess
+    {
+        bool operator()(const btVector3& a, const btVector3& b) const
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                if (a[i] < b[i])
+                {
+                    return true;
+                }
+                if (b[i] < a[i])
+                {
+                    return false;
+                }
+            }
+            return false;
+        }
+    };
 
-        // Add the group to the groups list
-        m_groups.push_back(group);            
+    /** NaN is equal to nothing, so such nodes are shared with no one */
+    bool isComparable(const btVector3& node)
+    {
+        return node[0] == node[0] && node[1] == node[1] &&
+            node[2] == node[2] && node[3] == node[3];
     }
 }
 
-// Find all rigids that should be in a group with the given rigid
-// @todo: This may contain an off-by-one error (the last rigid may not be grouped properly...)
-std::deque<tgRigidInfo*> tgRigidAutoCompound::findGroup(tgRigidInfo* rigid, std::deque<tgRigidInfo*>& ungrouped) {
+/**
+ * Groups are the connected components of the graph in which rigids that
+ * share a node are linked. The rigids of a group are listed depth first
+ * from its first rigid, visiting the linked rigids in the order of
+ * m_rigids, which is the order the previous pairwise search produced;
+ * compounds sum over their rigids in this order.
+ * Each node keeps a cursor past its grouped rigids, so the traversal is
+ * linear in the number of (rigid, node) pairs after the map is built.
+ */
+void tgRigidAutoCompound::groupRigids()
+{
+    const std::size_t n = m_rigids.size();
 
-    std::deque<tgRigidInfo*> group;
+    std::map<btVector3, NodeRigids, NodeLess> rigidsAt;
+    std::vector< std::vector<NodeRigids*> > nodesOf(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const std::set<btVector3> nodes = m_rigids[i]->getContainedNodes();
+        for (std::set<btVector3>::const_iterator it = nodes.begin();
+             it != nodes.end(); ++it)
+        {
+            if (!isComparable(*it))
+            {
+                continue;
+            }
+            NodeRigids& at = rigidsAt[*it];
+            // Sets of btVector3 may hold the same node twice
+            if (at.rigids.empty() || at.rigids.back() != i)
+            {
+                at.rigids.push_back(i);
+                nodesOf[i].push_back(&at);
+            }
+        }
+    }
 
-    // Add the rigid to the current group
-    group.push_back(rigid);     
-    
-    // Remove the rigid from the ungrouped since it's now in a group
-    ungrouped.erase(std::remove(ungrouped.begin(), ungrouped.end(), rigid), ungrouped.end());
-    
-    // Recursively find linked elements
-    int i = 0;
-    while(i < ungrouped.size()) {
-        tgRigidInfo* other = ungrouped[i];
-        if(rigid->sharesNodesWith(*other)) {
-            std::deque<tgRigidInfo*> links = findGroup(other, ungrouped);
-            group.insert(group.end(), links.begin(), links.end());
-            i = 0;
-        } else {
-            i++;
+    std::vector<bool> grouped(n, false);
+    for (std::size_t first = 0; first < n; first++)
+    {
+        if (grouped[first])
+        {
+            continue;
+        }
+
+        std::deque<tgRigidInfo*> group;
+        group.push_back(m_rigids[first]);
+        grouped[first] = true;
+
+        // The path from first to the rigid whose links are being followed
+        std::vector<std::size_t> path(1, first);
+        while (!path.empty())
+        {
+            // The first ungrouped rigid sharing a node with the current one
+            const std::vector<NodeRigids*>& nodes = nodesOf[path.back()];
+            std::size_t link = n;
+            for (std::size_t j = 0; j < nodes.size(); j++)
+            {
+                NodeRigids& at = *nodes[j];
+                while (at.next < at.rigids.size() && grouped[at.rigids[at.next]])
+                {
+                    at.next++;
+                }
+                if (at.next < at.rigids.size())
+                {
+                    link = std::min(link, at.rigids[at.next]);
+                }
+            }
+
+            if (link == n)
+            {
+                path.pop_back();
+            }
+            else
+            {
+                group.push_back(m_rigids[link]);
+                grouped[link] = true;
+                path.push_back(link);
+            }
         }
+
+        m_groups.push_back(group);
     }
+}
 
-    return group;
-};
-    
 void tgRigidAutoCompound::createCompounds() {
     for(int i=0; i < m_groups.size(); i++) {
         std::deque<tgRigidInfo*>& group = m_groups[i];
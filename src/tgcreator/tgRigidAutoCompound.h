@@ -66,12 +66,9 @@ protected:
    
     void setRigidInfoForGroup(tgRigidInfo* rigidInfo, std::deque<tgRigidInfo*>& group);
     
+    // Group the rigids that share nodes, directly or through other rigids
     void groupRigids();
 
-    // Find all rigids that should be in a group with the given rigid
-    // @todo: This may contain an off-by-one error (the last rigid may not be grouped properly...)
-    std::deque<tgRigidInfo*> findGroup(tgRigidInfo* rigid, std::deque<tgRigidInfo*>& ungrouped);
-
     /**
      * Creates tgCompoundRigidInfos for compounded bodies.
      * Also, adds tags to each of the consitutent tgRigidInfos 
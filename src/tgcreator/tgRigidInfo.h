@@ -311,6 +311,17 @@ public:
      */
     virtual std::set<btVector3> getContainedNodes() const = 0;
 
+    /**
+     * Is containsNode true only at the nodes of getContainedNodes? If so,
+     * tgRigidNodeIndex finds this rigid by its nodes, otherwise it tests
+     * this rigid for every node.
+     * @retval true by default
+     */
+    virtual bool containsOnlyNodes() const
+    {
+        return true;
+    }
+
     /**
      * Does this rigid have any nodes in common with the given tgRigidInfo object?
      * @param]in] other a reference to a tgRigidInfo object
@@ -0,0 +1,204 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgRigidNodeIndex.cpp
+ * @brief Implementation of class tgRigidNodeIndex
+ * $Id$
+ */
+
+// This module
+#include "tgRigidNodeIndex.h"
+// This library
+#include "tgRigidInfo.h"
+// The Bullet Physics library
+#include "LinearMath/btVector3.h"
+// The C++ standard library
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    /**
+     * Queries look at all cells within this fraction of a cell of the
+     * node, far more than the fuzzy comparisons of containsNode allow
+     */
+    const double kQueryMargin = 1.0 / 16.0;
+
+    /** Cells beyond this index are not hashed */
+    const double kMaxCellIndex = 1.0e15;
+}
+
+tgRigidNodeIndex::tgRigidNodeIndex(const std::vector<tgRigidInfo*>& rigids,
+                                   double cellSize) :
+    m_cellSize(cellSize),
+    m_rigids(rigids)
+{
+    if (!(cellSize > 0.0))
+    {
+        throw std::invalid_argument("Cell size must be positive");
+    }
+
+    // Two nodes per rigid is typical, size for about one entry per bucket
+    std::size_t buckets = 16;
+    while (buckets < 2 * rigids.size())
+    {
+        buckets *= 2;
+    }
+    m_buckets.resize(buckets);
+
+    for (std::size_t i = 0; i < rigids.size(); i++)
+    {
+        tgRigidInfo* const rigid = rigids[i];
+        assert(rigid != NULL);
+
+        bool indexed = rigid->containsOnlyNodes();
+        if (indexed)
+        {
+            const std::set<btVector3> nodes = rigid->getContainedNodes();
+            std::vector<Cell> cells;
+            for (std::set<btVector3>::const_iterator it = nodes.begin();
+                 indexed && it != nodes.end(); ++it)
+            {
+                Cell cell;
+                indexed = cellOf(it->x(), it->y(), it->z(), cell);
+                cells.push_back(cell);
+            }
+            if (indexed)
+            {
+                for (std::size_t j = 0; j < cells.size(); j++)
+                {
+                    insert(cells[j], rigid);
+                }
+            }
+        }
+        if (!indexed)
+        {
+            m_alwaysTested.push_back(rigid);
+        }
+    }
+}
+
+std::set<tgRigidInfo*>
+tgRigidNodeIndex::findRigidsContaining(const btVector3& node) const
+{
+    std::set<tgRigidInfo*> found;
+
+    const double margin = kQueryMargin * m_cellSize;
+    Cell low;
+    Cell high;
+    if (cellOf(node.x() - margin, node.y() - margin, node.z() - margin, low) &&
+        cellOf(node.x() + margin, node.y() + margin, node.z() + margin, high))
+    {
+        Cell cell;
+        for (cell.x = low.x; cell.x <= high.x; cell.x++)
+        {
+            for (cell.y = low.y; cell.y <= high.y; cell.y++)
+            {
+                for (cell.z = low.z; cell.z <= high.z; cell.z++)
+                {
+                    testCell(cell, node, found);
+                }
+            }
+        }
+    }
+    else
+    {
+        // Nodes out of the hash's range can only match the unindexed
+        // rigids, but test everything rather than rely on that
+        for (std::size_t i = 0; i < m_rigids.size(); i++)
+        {
+            if (m_rigids[i]->containsNode(node))
+            {
+                found.insert(m_rigids[i]);
+            }
+        }
+        return found;
+    }
+
+    for (std::size_t i = 0; i < m_alwaysTested.size(); i++)
+    {
+        if (m_alwaysTested[i]->containsNode(node))
+        {
+            found.insert(m_alwaysTested[i]);
+        }
+    }
+    return found;
+}
+
+bool tgRigidNodeIndex::cellOf(double x, double y, double z, Cell& cell) const
+{
+    const double cx = std::floor(x / m_cellSize);
+    const double cy = std::floor(y / m_cellSize);
+    const double cz = std::floor(z / m_cellSize);
+    // Also false for NaN
+    if (!(std::fabs(cx) < kMaxCellIndex &&
+          std::fabs(cy) < kMaxCellIndex &&
+          std::fabs(cz) < kMaxCellIndex))
+    {
+        return false;
+    }
+    cell.x = static_cast<long long>(cx);
+    cell.y = static_cast<long long>(cy);
+    cell.z = static_cast<long long>(cz);
+    return true;
+}
+
+std::size_t tgRigidNodeIndex::bucketOf(const Cell& cell) const
+{
+    // Large odd multipliers mix the coordinates across the bits
+    const unsigned long long h =
+        static_cast<unsigned long long>(cell.x) * 73856093ULL ^
+        static_cast<unsigned long long>(cell.y) * 19349663ULL ^
+        static_cast<unsigned long long>(cell.z) * 83492791ULL;
+    return static_cast<std::size_t>(h ^ (h >> 29)) & (m_buckets.size() - 1);
+}
+
+void tgRigidNodeIndex::insert(const Cell& cell, tgRigidInfo* rigid)
+{
+    std::vector<Entry>& bucket = m_buckets[bucketOf(cell)];
+    for (std::size_t i = 0; i < bucket.size(); i++)
+    {
+        const Entry& entry = bucket[i];
+        if (entry.rigid == rigid && entry.cell.x == cell.x &&
+            entry.cell.y == cell.y && entry.cell.z == cell.z)
+        {
+            return;
+        }
+    }
+    Entry entry;
+    entry.cell = cell;
+    entry.rigid = rigid;
+    bucket.push_back(entry);
+}
+
+void tgRigidNodeIndex::testCell(const Cell& cell, const btVector3& node,
+                                std::set<tgRigidInfo*>& found) const
+{
+    const std::vector<Entry>& bucket = m_buckets[bucketOf(cell)];
+    for (std::size_t i = 0; i < bucket.size(); i++)
+    {
+        const Entry& entry = bucket[i];
+        if (entry.cell.x == cell.x && entry.cell.y == cell.y &&
+            entry.cell.z == cell.z && entry.rigid->containsNode(node))
+        {
+            found.insert(entry.rigid);
+        }
+    }
+}
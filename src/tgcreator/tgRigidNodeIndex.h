@@ -0,0 +1,110 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgRigidNodeIndex.h
+ * @brief Definition of class tgRigidNodeIndex
+ * $Id$
+ */
+
+#ifndef TG_RIGID_NODE_INDEX_H
+#define TG_RIGID_NODE_INDEX_H
+
+// From the C++ standard library
+#include <cstddef>
+#include <set>
+#include <vector>
+
+// Forward declarations
+class tgRigidInfo;
+class btVector3;
+
+/**
+ * A spatial hash from node positions to the rigids that contain them,
+ * built once per structure so that connectors find their rigids without
+ * scanning every rigid. Positions are quantized to cubic cells and only
+ * the rigids with a node in the cells around a query are tested with
+ * containsNode, so the result is the same as testing all of them.
+ * Rigids that can contain positions other than their nodes, see
+ * tgRigidInfo::containsOnlyNodes, are always tested.
+ */
+class tgRigidNodeIndex
+{
+public:
+
+    /**
+     * Index rigids by their nodes. The rigids are not owned and must
+     * outlive the index.
+     * @param[in] rigids the rigids to search, usually the leaf rigids of
+     * a structure
+     * @param[in] cellSize the edge of a cell, in length units; any
+     * positive value gives the same results, one near the distance
+     * between nodes is fastest
+     * @throw std::invalid_argument if cellSize is not positive
+     */
+    tgRigidNodeIndex(const std::vector<tgRigidInfo*>& rigids,
+                     double cellSize = 1.0);
+
+    /**
+     * Return the rigids whose containsNode(node) is true.
+     */
+    std::set<tgRigidInfo*> findRigidsContaining(const btVector3& node) const;
+
+    const std::vector<tgRigidInfo*>& getRigids() const
+    {
+        return m_rigids;
+    }
+
+private:
+
+    struct Cell
+    {
+        long long x;
+        long long y;
+        long long z;
+    };
+
+    struct Entry
+    {
+        Cell cell;
+        tgRigidInfo* rigid;
+    };
+
+    /** The cell containing the coordinates, false if they are too large */
+    bool cellOf(double x, double y, double z, Cell& cell) const;
+
+    std::size_t bucketOf(const Cell& cell) const;
+
+    void insert(const Cell& cell, tgRigidInfo* rigid);
+
+    /** Add the rigids in cell that contain node to found */
+    void testCell(const Cell& cell, const btVector3& node,
+                  std::set<tgRigidInfo*>& found) const;
+
+    const double m_cellSize;
+
+    std::vector<tgRigidInfo*> m_rigids;
+
+    /** Buckets of the hash, a power of two of them */
+    std::vector< std::vector<Entry> > m_buckets;
+
+    /** Rigids tested for every node */
+    std::vector<tgRigidInfo*> m_alwaysTested;
+};
+
+#endif
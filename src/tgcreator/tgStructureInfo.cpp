@@ -29,6 +29,7 @@
 // This library
 #include "tgConnectorInfo.h"
 #include "tgRigidAutoCompound.h"
+#include "tgRigidNodeIndex.h"
 #include "tgStructure.h"
 #include "core/tgWorld.h"
 #include "core/tgModel.h"
@@ -122,24 +123,27 @@ void tgStructureInfo::addRigidsAndConnectors() {
     const std::vector<tgBuildSpec::RigidAgent*> rigidAgents = m_buildSpec.getRigidAgents();
     const std::vector<tgBuildSpec::ConnectorAgent*> connectorAgents = m_buildSpec.getConnectorAgents();
 
+    const std::vector<tgTagSearch> rigidSearches = localSearches(rigidAgents);
+    const std::vector<tgTagSearch> connectorSearches = localSearches(connectorAgents);
+
     const tgNodes& nodes = m_structure.getNodes();
     const tgPairs& pairs = m_structure.getPairs();
 
     // for each node, create a rigidInfo object using a matching rigidAgent
     for (int i = 0; i < nodes.size(); i++) {
-        tgRigidInfo* nodeRigid = initRigidInfo<tgNode>(nodes[i], rigidAgents);
+        tgRigidInfo* nodeRigid = initRigidInfo<tgNode>(nodes[i], rigidAgents, rigidSearches);
         if (nodeRigid) {
             m_rigids.push_back(nodeRigid);
         }
     }
     // for each pair, create a rigidInfo or connectorInfo object using a matching rigidAgent or connectorAgent
     for (int i = 0; i < pairs.size(); i++) {
-        tgRigidInfo* pairRigid = initRigidInfo<tgPair>(pairs[i], rigidAgents);
+        tgRigidInfo* pairRigid = initRigidInfo<tgPair>(pairs[i], rigidAgents, rigidSearches);
         if (pairRigid) {
 	  m_rigids.push_back(pairRigid);
         }
         else {
-            tgConnectorInfo* pairConnector = initConnectorInfo<tgPair>(pairs[i], connectorAgents);
+            tgConnectorInfo* pairConnector = initConnectorInfo<tgPair>(pairs[i], connectorAgents, connectorSearches);
             if (pairConnector) {
                 m_connectors.push_back(pairConnector);
             }
@@ -155,23 +159,34 @@ void tgStructureInfo::addRigidsAndConnectors() {
     }
 }
 
-template <class T>
-tgRigidInfo* tgStructureInfo::initRigidInfo(const T& rigidCandidate, const std::vector<tgBuildSpec::RigidAgent*>& rigidAgents) const {
-    for (int i = rigidAgents.size() - 1; i >= 0; i--) {
-        const tgBuildSpec::RigidAgent* pRigidAgent = rigidAgents[i];
-        assert(pRigidAgent != NULL);
-
-        tgTagSearch tagSearch = tgTagSearch(pRigidAgent->tagSearch);
+template <class A>
+std::vector<tgTagSearch> tgStructureInfo::localSearches(const std::vector<A*>& agents) const {
+    std::vector<tgTagSearch> result;
+    result.reserve(agents.size());
+    for (std::size_t i = 0; i < agents.size(); i++) {
+        assert(agents[i] != NULL);
+        result.push_back(agents[i]->tagSearch);
 
         // Remove our tags so that subcomponents 'inherit' them (because of the
         // way tags work, removing a tag from the search is the same as adding
         // the tag to children to be searched)
-        tagSearch.remove(getTags());
+        result.back().remove(getTags());
+    }
+    return result;
+}
+
+template <class T>
+tgRigidInfo* tgStructureInfo::initRigidInfo(const T& rigidCandidate, const std::vector<tgBuildSpec::RigidAgent*>& rigidAgents,
+                                            const std::vector<tgTagSearch>& searches) const {
+    assert(searches.size() == rigidAgents.size());
+    for (int i = rigidAgents.size() - 1; i >= 0; i--) {
+        const tgBuildSpec::RigidAgent* pRigidAgent = rigidAgents[i];
+        assert(pRigidAgent != NULL);
 
         tgRigidInfo* pRigidInfo = pRigidAgent->infoFactory;
         assert(pRigidInfo != NULL);
 
-        tgRigidInfo* rigid = pRigidInfo->createRigidInfo(rigidCandidate, tagSearch);
+        tgRigidInfo* rigid = pRigidInfo->createRigidInfo(rigidCandidate, searches[i]);
         if (rigid) {// check if a tgRigidInfo was found
 	  return rigid;
 	}
@@ -180,22 +195,17 @@ tgRigidInfo* tgStructureInfo::initRigidInfo(const T& rigidCandidate, const std::
 }
 
 template <class T>
-tgConnectorInfo* tgStructureInfo::initConnectorInfo(const T& connectorCandidate, const std::vector<tgBuildSpec::ConnectorAgent*>& connectorAgents) const {
+tgConnectorInfo* tgStructureInfo::initConnectorInfo(const T& connectorCandidate, const std::vector<tgBuildSpec::ConnectorAgent*>& connectorAgents,
+                                                    const std::vector<tgTagSearch>& searches) const {
+    assert(searches.size() == connectorAgents.size());
     for (int i = connectorAgents.size() - 1; i >= 0; i--) {
         const tgBuildSpec::ConnectorAgent*  pConnectorAgent = connectorAgents[i];
         assert(pConnectorAgent != NULL);
 
-        tgTagSearch tagSearch = tgTagSearch(pConnectorAgent->tagSearch);
-
-        // Remove our tags so that subcomponents 'inherit' them (because of the
-        // way tags work, removing a tag from the search is the same as adding
-        // the tag to children to be searched)
-        tagSearch.remove(getTags());
-
         tgConnectorInfo* pConnectorInfo = pConnectorAgent->infoFactory;
         assert(pConnectorInfo != NULL);
 
-        tgConnectorInfo* connector = pConnectorInfo->createConnectorInfo(connectorCandidate, tagSearch);
+        tgConnectorInfo* connector = pConnectorInfo->createConnectorInfo(connectorCandidate, searches[i]);
         if (connector) // check if a tgConnectorInfo was found
             return connector;
     }
@@ -213,13 +223,20 @@ void tgStructureInfo::chooseConnectorRigids()
     chooseConnectorRigids(getAllRigids());
 }
 
-void tgStructureInfo::chooseConnectorRigids(std::vector<tgRigidInfo*> allRigids)
+void tgStructureInfo::chooseConnectorRigids(const std::vector<tgRigidInfo*>& allRigids)
+{
+    // Index the rigids once for all connectors, rather than scanning
+    // every rigid for each end of each connector
+    chooseConnectorRigids(tgRigidNodeIndex(allRigids));
+}
+
+void tgStructureInfo::chooseConnectorRigids(const tgRigidNodeIndex& index)
 {
     for (std::size_t i = 0; i < m_connectors.size(); i++)
     {
         tgConnectorInfo * const pConnectorInfo = m_connectors[i];
     assert(pConnectorInfo != NULL);
-        pConnectorInfo->chooseRigids(allRigids);
+        pConnectorInfo->chooseRigids(index);
     }    
 
     // Children
@@ -227,7 +244,7 @@ void tgStructureInfo::chooseConnectorRigids(std::vector<tgRigidInfo*> allRigids)
     {
         tgStructureInfo * const pStructureInfo = m_children[i];
     assert(pStructureInfo != NULL);
-        pStructureInfo->chooseConnectorRigids(allRigids);
+        pStructureInfo->chooseConnectorRigids(index);
     }
 }
 
@@ -40,6 +40,7 @@ class tgBuildSpec;
 class tgConnectorInfo;
 class tgModel;
 class tgRigidInfo;
+class tgRigidNodeIndex;
 class tgStructure;
 class tgWorld;
 
@@ -79,22 +80,35 @@ private:
     void addRigidsAndConnectors();
 
     /*
-     * Create and return a rigidInfo object using a matching rigidAgent
+     * Return the agents' tag searches with this structure's tags removed,
+     * so subcomponents 'inherit' them
+     */
+    template <class A>
+    std::vector<tgTagSearch> localSearches(const std::vector<A*>& agents) const;
+
+    /*
+     * Create and return a rigidInfo object using a matching rigidAgent.
+     * searches holds each agent's search from localSearches.
      */
     template <class T>
-    tgRigidInfo* initRigidInfo(const T& rigidCandidate, const std::vector<tgBuildSpec::RigidAgent*>& rigidAgents) const;
+    tgRigidInfo* initRigidInfo(const T& rigidCandidate, const std::vector<tgBuildSpec::RigidAgent*>& rigidAgents,
+                               const std::vector<tgTagSearch>& searches) const;
 
     /*
      * Create and return a connectorInfo object using a matching connectorAgent
+     * searches holds each agent's search from localSearches.
      */
     template <class T>
-    tgConnectorInfo* initConnectorInfo(const T& connectorCandidate, const std::vector<tgBuildSpec::ConnectorAgent*>& connectorAgents) const;
+    tgConnectorInfo* initConnectorInfo(const T& connectorCandidate, const std::vector<tgBuildSpec::ConnectorAgent*>& connectorAgents,
+                                       const std::vector<tgTagSearch>& searches) const;
 
     void autoCompoundRigids();
     
     void chooseConnectorRigids();
 
-    void chooseConnectorRigids(std::vector<tgRigidInfo*> allRigids);
+    void chooseConnectorRigids(const std::vector<tgRigidInfo*>& allRigids);
+
+    void chooseConnectorRigids(const tgRigidNodeIndex& index);
     
     void initRigidBodies(tgWorld& world);
     
@@ -254,18 +254,24 @@ public:
     }
 
     /**
-     * Return a random btVector3 that is not parallel to v.
-     * @param[in] v a btVector3, passed by value
-     * @return a random btVector3 that is not parallel to v
+     * Return a unit btVector3 that is not parallel to v: the coordinate
+     * axis most nearly perpendicular to it. Deterministic, so it does not
+     * touch the C library's random number generator.
+     * @param[in] v a nonzero btVector3, passed by value
+     * @return a unit btVector3 that is not parallel to v
      */
     inline static btVector3 getArbitraryNonParallelVector(btVector3 v)
     {
-        btVector3 arb;
-        v.normalize();
-        do {
-            arb = btVector3(rand()%10, rand()%10, rand()%10).normalize();
-        } while (arb == v || arb == -v);
-        return arb;
+        const btVector3 a = v.absolute();
+        if (a.x() <= a.y() && a.x() <= a.z())
+        {
+            return btVector3(1.0, 0.0, 0.0);
+        }
+        else if (a.y() <= a.z())
+        {
+            return btVector3(0.0, 1.0, 0.0);
+        }
+        return btVector3(0.0, 0.0, 1.0);
     }
 
     /** 
@@ -358,6 +364,12 @@ public:
         return floor(d * m + 0.5)/m;
     }
     
+    /**
+     * Seed the C library's generator, which is shared by the whole
+     * process. Nothing in the NTRT libraries uses it, so that separate
+     * simulations can run on separate threads; prefer a per-instance
+     * std::tr1 engine in new code.
+     */
     static void seedRandom();
     
     /// @todo is this necessary? If everyone uses the above function we can just change the 
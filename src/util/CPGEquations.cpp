@@ -34,7 +34,9 @@
 
 
 // The C++ Standard Library
+#include <algorithm>
 #include <assert.h>
+#include <map>
 #include <stdexcept>
 
 using namespace boost::numeric::odeint;
@@ -44,13 +46,17 @@ typedef std::vector<double > cpgVars_type;
 CPGEquations::CPGEquations(int maxSteps) :
 stepSize(0.1),
 numSteps(0),
-m_maxSteps(maxSteps)
+m_maxSteps(maxSteps),
+m_fixedStep(0.0),
+m_pIntegrator(NULL)
  {}
 CPGEquations::CPGEquations(std::vector<CPGNode*>& newNodeList, int maxSteps) :
 nodeList(newNodeList),
 stepSize(0.1), //TODO: specify as a parameter somewhere
 numSteps(0),
-m_maxSteps(maxSteps)
+m_maxSteps(maxSteps),
+m_fixedStep(0.0),
+m_pIntegrator(NULL)
 {
 }
 
@@ -61,6 +67,7 @@ CPGEquations::~CPGEquations()
 		delete nodeList[i];
 	}
 	nodeList.clear();
+	delete m_pIntegrator;
 }
 
 // Params needs size 7 to fill all of the params.
@@ -70,6 +77,7 @@ int CPGEquations::addNode(std::vector<double>& newParams)
 	int index = nodeList.size();
 	CPGNode* newNode = new CPGNode(index, newParams);
 	nodeList.push_back(newNode);
+	invalidateIntegrator();
 	
 	return index;
 }
@@ -86,6 +94,7 @@ void CPGEquations::defineConnections (	int nodeIndex,
 	for(int i = 0; i != connections.size(); i++){
 		nodeList[nodeIndex]->addCoupling(nodeList[connections[i]], newWeights[i], newPhaseOffsets[i]); 
 	}
+	invalidateIntegrator();
 }
 
 const double CPGEquations::operator[](const std::size_t i) const
@@ -242,15 +251,42 @@ void CPGEquations::update(std::vector<double>& descCom, double dt)
 	
 	numSteps = 0;
 	
-	/**
-	 * Read information from nodes into variables that work for ODEInt
-	 */
-	std::vector<double>& xVars = getXVars(); 
-	
-	/**
-	 * Run ODEInt. This will change the data in xVars
-	 */
-	integrate(integrate_function(this, descCom), xVars, 0.0, dt, stepSize, output_function(this));
+	if (m_fixedStep > 0.0)
+	{
+		if (m_pIntegrator == NULL)
+		{
+			m_pIntegrator = compileIntegrator();
+		}
+		
+		// The nodes hold the state between updates
+		const std::vector<double>& nodeVars = getXVars();
+		const std::size_t n = nodeList.size();
+		for (std::size_t i = 0; i < n; i++)
+		{
+			m_pIntegrator->setNodeState(i, nodeVars[3*i], nodeVars[3*i+1], nodeVars[3*i+2]);
+		}
+		
+		numSteps = (int) m_pIntegrator->integrate(descCom, dt, std::min(m_fixedStep, dt), m_workspace);
+		
+		for (std::size_t i = 0; i < n; i++)
+		{
+			nodeList[i]->updateNodeValues(m_pIntegrator->getPhase(i),
+										  m_pIntegrator->getRadius(i),
+										  m_pIntegrator->getThird(i));
+		}
+	}
+	else
+	{
+		/**
+		 * Read information from nodes into variables that work for ODEInt
+		 */
+		std::vector<double>& xVars = getXVars(); 
+		
+		/**
+		 * Run ODEInt. This will change the data in xVars
+		 */
+		integrate(integrate_function(this, descCom), xVars, 0.0, dt, stepSize, output_function(this));
+	}
 	
     if (numSteps > m_maxSteps)
     {
@@ -266,6 +302,64 @@ void CPGEquations::update(std::vector<double>& descCom, double dt)
 	   
 }
 
+void CPGEquations::setFixedStep(double fixedStep)
+{
+	if (fixedStep < 0.0)
+	{
+		throw std::invalid_argument("Fixed step must not be negative");
+	}
+	m_fixedStep = fixedStep;
+}
+
+CPGFixedStepIntegrator* CPGEquations::compileIntegrator()
+{
+	CPGFixedStepIntegrator* integrator =
+		new CPGFixedStepIntegrator(CPGFixedStepIntegrator::eDescending);
+	
+	std::vector<double> params(7);
+	for (std::size_t i = 0; i < nodeList.size(); i++)
+	{
+		const CPGNode& node = *nodeList[i];
+		params[0] = node.frequencyOffset;
+		params[1] = node.frequencyScale;
+		params[2] = node.radiusOffset;
+		params[3] = node.radiusScale;
+		params[4] = node.rConst;
+		params[5] = node.dMin;
+		params[6] = node.dMax;
+		integrator->addNode(params);
+	}
+	compileCouplings(*integrator);
+	integrator->finalize();
+	
+	return integrator;
+}
+
+void CPGEquations::compileCouplings(CPGFixedStepIntegrator& integrator) const
+{
+	std::map<const CPGNode*, std::size_t> indices;
+	for (std::size_t i = 0; i < nodeList.size(); i++)
+	{
+		indices[nodeList[i]] = i;
+	}
+	
+	for (std::size_t i = 0; i < nodeList.size(); i++)
+	{
+		const CPGNode& node = *nodeList[i];
+		for (std::size_t j = 0; j < node.couplingList.size(); j++)
+		{
+			integrator.addCoupling(i, indices[node.couplingList[j]],
+								   node.weightList[j], node.phaseList[j]);
+		}
+	}
+}
+
+void CPGEquations::invalidateIntegrator()
+{
+	delete m_pIntegrator;
+	m_pIntegrator = NULL;
+}
+
 std::string CPGEquations::toString(const std::string& prefix) const
 {
 	std::string p = "  ";
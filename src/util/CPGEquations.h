@@ -31,6 +31,7 @@
 #include <sstream>
 
 #include "CPGNode.h"
+#include "CPGFixedStepIntegrator.h"
 
 /**
  * The top level class for interfacing with CPGs. Contains the definition
@@ -68,6 +69,14 @@ class CPGEquations
 	 */
 	void update(std::vector<double>& descCom, double dt);
 	
+	/**
+	 * Integrate with the RK4 of CPGFixedStepIntegrator in equal steps
+	 * of at most fixedStep seconds, instead of odeint's adaptive
+	 * stepper. The nodes hold the results after each update as before.
+	 * Set 0 to return to odeint.
+	 */
+	void setFixedStep(double fixedStep);
+	
 	std::string toString(const std::string& prefix = "") const;
 	
     void countStep()
@@ -77,6 +86,18 @@ class CPGEquations
     
 protected:
 	
+	/**
+	 * Copy the nodes and couplings into a new integrator. Called on
+	 * the first fixed step update after the network changes.
+	 */
+	virtual CPGFixedStepIntegrator* compileIntegrator();
+	
+	/** Add the couplings of every node to integrator */
+	void compileCouplings(CPGFixedStepIntegrator& integrator) const;
+	
+	/** Discard the compiled integrator, the network has changed */
+	void invalidateIntegrator();
+	
 	std::vector<CPGNode*> nodeList;
 	
     std::vector<double> XVars;
@@ -87,6 +108,11 @@ protected:
     int m_maxSteps;
     int numSteps;
     
+    /** Used instead of odeint if m_fixedStep is positive */
+    double m_fixedStep;
+    CPGFixedStepIntegrator* m_pIntegrator;
+    CPGFixedStepIntegrator::Workspace m_workspace;
+    
 };
 
 /**
@@ -61,6 +61,7 @@ int CPGEquationsFB::addNode(std::vector<double>& newParams)
 	int index = nodeList.size();
 	CPGNodeFB* newNode = new CPGNodeFB(index, newParams);
 	nodeList.push_back(newNode);
+	invalidateIntegrator();
 	
 	return index;
 }
@@ -128,3 +129,32 @@ void CPGEquationsFB::updateNodeData(std::vector<double> newXVals)
 		currentNode->updateNodeValues(newXVals[3*i], newXVals[3*i+1], newXVals[3*i+2]);
 	}
 }
+
+CPGFixedStepIntegrator* CPGEquationsFB::compileIntegrator()
+{
+	CPGFixedStepIntegrator* integrator =
+		new CPGFixedStepIntegrator(CPGFixedStepIntegrator::eFeedback);
+	
+	std::vector<double> params(11);
+	for (std::size_t i = 0; i < nodeList.size(); i++)
+	{
+		const CPGNodeFB* node = tgCast::cast<CPGNode, CPGNodeFB>(nodeList[i]);
+		assert(node);
+		params[0] = node->frequencyOffset;
+		params[1] = node->frequencyScale;
+		params[2] = node->radiusOffset;
+		params[3] = node->radiusScale;
+		params[4] = node->rConst;
+		params[5] = node->dMin;
+		params[6] = node->dMax;
+		params[7] = node->omega;
+		params[8] = node->kFreq;
+		params[9] = node->kAmp;
+		params[10] = node->kPhase;
+		integrator->addNode(params);
+	}
+	compileCouplings(*integrator);
+	integrator->finalize();
+	
+	return integrator;
+}
@@ -61,6 +61,11 @@ class CPGEquationsFB : public CPGEquations
 	
 	void updateNodeData(std::vector<double> newXVals);
 
+protected:
+
+	/** Compile the feedback node equations of CPGNodeFB */
+	CPGFixedStepIntegrator* compileIntegrator();
+
 };
 
 #endif // SIMULATOR_SRC_LIB_MODELS_SNAKE_CPGS_CPGEQUATIONS
@@ -0,0 +1,308 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file CPGFixedStepIntegrator.cpp
+ * @brief Implementation of class CPGFixedStepIntegrator
+ * $Id$
+ */
+
+// This module
+#include "CPGFixedStepIntegrator.h"
+
+// The Bullet Physics Library
+#include "LinearMath/btQuickprof.h"
+
+// The C++ Standard Library
+#include <math.h>
+#include <stdexcept>
+
+namespace
+{
+    /** CPGNode::nodeEquation */
+    inline double nodeEquation(double d, double c0, double c1,
+                               double dMin, double dMax)
+    {
+        return (d >= dMin && d <= dMax) ? c1 * d + c0 : 0;
+    }
+}
+
+CPGFixedStepIntegrator::CPGFixedStepIntegrator(NodeModel model) :
+m_model(model),
+m_numNodes(0),
+m_finalized(false)
+{
+}
+
+std::size_t CPGFixedStepIntegrator::addNode(const std::vector<double>& params)
+{
+    if (m_finalized)
+    {
+        throw std::logic_error("Nodes must be added before finalize");
+    }
+    const std::size_t needed = (m_model == eFeedback) ? 11 : 7;
+    if (params.size() < needed)
+    {
+        throw std::invalid_argument("Too few CPG node parameters");
+    }
+
+    m_frequencyOffset.push_back(params[0]);
+    m_frequencyScale.push_back(params[1]);
+    m_radiusOffset.push_back(params[2]);
+    m_radiusScale.push_back(params[3]);
+    m_rConst.push_back(params[4]);
+    m_dMin.push_back(params[5]);
+    m_dMax.push_back(params[6]);
+    m_kFreq.push_back(m_model == eFeedback ? params[8] : 0.0);
+    m_kAmp.push_back(m_model == eFeedback ? params[9] : 0.0);
+    m_kPhase.push_back(m_model == eFeedback ? params[10] : 0.0);
+
+    return m_numNodes++;
+}
+
+void CPGFixedStepIntegrator::addCoupling(std::size_t node, std::size_t target,
+                                         double weight, double phase)
+{
+    if (m_finalized)
+    {
+        throw std::logic_error("Couplings must be added before finalize");
+    }
+    if (node >= m_numNodes || target >= m_numNodes)
+    {
+        throw std::invalid_argument("Coupling node index out of bounds");
+    }
+    m_edgeNode.push_back(node);
+    m_edgeTarget.push_back(target);
+    m_edgeWeight.push_back(weight);
+    m_edgePhase.push_back(phase);
+}
+
+void CPGFixedStepIntegrator::finalize()
+{
+    if (m_finalized)
+    {
+        return;
+    }
+
+    // Counting sort of the edges by node, stable so each row keeps the
+    // order of addCoupling
+    const std::size_t numEdges = m_edgeNode.size();
+    m_rowStart.assign(m_numNodes + 1, 0);
+    for (std::size_t e = 0; e < numEdges; e++)
+    {
+        m_rowStart[m_edgeNode[e] + 1]++;
+    }
+    for (std::size_t i = 0; i < m_numNodes; i++)
+    {
+        m_rowStart[i + 1] += m_rowStart[i];
+    }
+
+    std::vector<std::size_t> next(m_rowStart.begin(), m_rowStart.end() - 1);
+    std::vector<std::size_t> target(numEdges);
+    std::vector<double> weight(numEdges);
+    std::vector<double> phase(numEdges);
+    for (std::size_t e = 0; e < numEdges; e++)
+    {
+        const std::size_t slot = next[m_edgeNode[e]]++;
+        target[slot] = m_edgeTarget[e];
+        weight[slot] = m_edgeWeight[e];
+        phase[slot] = m_edgePhase[e];
+    }
+    m_edgeTarget.swap(target);
+    m_edgeWeight.swap(weight);
+    m_edgePhase.swap(phase);
+    std::vector<std::size_t>().swap(m_edgeNode);
+
+    // Initial conditions of the node classes
+    m_state.assign(3 * m_numNodes, 0.0);
+    if (m_model == eFeedback)
+    {
+        for (std::size_t i = 0; i < m_numNodes; i++)
+        {
+            m_state[m_numNodes + i] = sqrt(m_radiusOffset[i]);
+        }
+    }
+
+    m_finalized = true;
+}
+
+void CPGFixedStepIntegrator::setNodeState(std::size_t i, double phi, double r, double third)
+{
+    if (!m_finalized || i >= m_numNodes)
+    {
+        throw std::invalid_argument("Node index out of bounds");
+    }
+    m_state[i] = phi;
+    m_state[m_numNodes + i] = r;
+    m_state[2 * m_numNodes + i] = third;
+}
+
+double CPGFixedStepIntegrator::getNodeValue(std::size_t i) const
+{
+    return getRadius(i) * cos(getPhase(i));
+}
+
+void CPGFixedStepIntegrator::computeDrive(const std::vector<double>& commands,
+                                          double* drive) const
+{
+    const std::size_t n = m_numNodes;
+    if (m_model == eDescending)
+    {
+        // Frequency and target radius, as in CPGNode::updateDTs
+        for (std::size_t i = 0; i < n; i++)
+        {
+            const double d = commands[i];
+            drive[i] = 2 * M_PI * nodeEquation(d, m_frequencyOffset[i], m_frequencyScale[i],
+                                               m_dMin[i], m_dMax[i]);
+            drive[n + i] = nodeEquation(d, m_radiusOffset[i], m_radiusScale[i],
+                                        m_dMin[i], m_dMax[i]);
+        }
+    }
+    else
+    {
+        // Phase, frequency and amplitude feedback, as in CPGNodeFB::updateDTs
+        for (std::size_t i = 0; i < n; i++)
+        {
+            drive[i] = m_kPhase[i] * commands[3 * i + 2];
+            drive[n + i] = m_kFreq[i] * commands[3 * i];
+            drive[2 * n + i] = m_radiusOffset[i] + m_kAmp[i] * commands[3 * i + 1];
+        }
+    }
+}
+
+void CPGFixedStepIntegrator::derivatives(const double* x, const double* drive,
+                                         double* dxdt) const
+{
+    const std::size_t n = m_numNodes;
+    const double* phi = x;
+    const double* r = x + n;
+    const double* third = x + 2 * n;
+
+    // Phase: base rate, then the couplings in the order they were added
+    for (std::size_t i = 0; i < n; i++)
+    {
+        double phiDot = (m_model == eDescending) ? drive[i] : third[i] + drive[i];
+        const double phiI = phi[i];
+        const std::size_t end = m_rowStart[i + 1];
+        for (std::size_t e = m_rowStart[i]; e != end; e++)
+        {
+            const std::size_t t = m_edgeTarget[e];
+            phiDot += m_edgeWeight[e] * r[t] * sin(phi[t] - phiI - m_edgePhase[e]);
+        }
+        dxdt[i] = phiDot;
+    }
+
+    if (m_model == eDescending)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            const double rc = m_rConst[i];
+            dxdt[n + i] = third[i];
+            dxdt[2 * n + i] = rc * (rc / 4 * (drive[n + i] - r[i]) - third[i]);
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            dxdt[n + i] = m_rConst[i] * (drive[2 * n + i] - r[i] * r[i]) * r[i];
+            dxdt[2 * n + i] = drive[n + i] * sin(phi[i]);
+        }
+    }
+}
+
+std::size_t CPGFixedStepIntegrator::integrate(const std::vector<double>& commands,
+                                              double dt, double maxStep,
+                                              Workspace& ws)
+{
+#ifndef BT_NO_PROFILE 
+    BT_PROFILE("CPGFixedStepIntegrator::integrate");
+#endif //BT_NO_PROFILE
+    if (!m_finalized)
+    {
+        throw std::logic_error("CPGFixedStepIntegrator must be finalized before integrating");
+    }
+    const std::size_t perNode = (m_model == eFeedback) ? 3 : 1;
+    if (commands.size() != perNode * m_numNodes)
+    {
+        throw std::invalid_argument("Wrong number of CPG commands");
+    }
+    if (!(dt > 0.0) || !(maxStep > 0.0))
+    {
+        throw std::invalid_argument("CPG integration times must be positive");
+    }
+
+    const std::size_t size = 3 * m_numNodes;
+    // Only resizes on the first call with this workspace
+    ws.k1.resize(size);
+    ws.k2.resize(size);
+    ws.k3.resize(size);
+    ws.k4.resize(size);
+    ws.stage.resize(size);
+    ws.drive.resize(size);
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    double* x = &m_state[0];
+    double* k1 = &ws.k1[0];
+    double* k2 = &ws.k2[0];
+    double* k3 = &ws.k3[0];
+    double* k4 = &ws.k4[0];
+    double* s = &ws.stage[0];
+    const double* drive = &ws.drive[0];
+    computeDrive(commands, &ws.drive[0]);
+
+    // Equal steps covering dt, ignoring round off in the quotient
+    std::size_t numSteps = static_cast<std::size_t>(ceil(dt / maxStep - 1e-9));
+    if (numSteps == 0)
+    {
+        numSteps = 1;
+    }
+    const double h = dt / numSteps;
+    const double h2 = h / 2;
+    const double h3 = h / 3;
+    const double h6 = h / 6;
+
+    for (std::size_t step = 0; step < numSteps; step++)
+    {
+        derivatives(x, drive, k1);
+        for (std::size_t j = 0; j < size; j++)
+        {
+            s[j] = x[j] + h2 * k1[j];
+        }
+        derivatives(s, drive, k2);
+        for (std::size_t j = 0; j < size; j++)
+        {
+            s[j] = x[j] + h2 * k2[j];
+        }
+        derivatives(s, drive, k3);
+        for (std::size_t j = 0; j < size; j++)
+        {
+            s[j] = x[j] + h * k3[j];
+        }
+        derivatives(s, drive, k4);
+        for (std::size_t j = 0; j < size; j++)
+        {
+            x[j] += h6 * k1[j] + h3 * k2[j] + h3 * k3[j] + h6 * k4[j];
+        }
+    }
+
+    return 4 * numSteps;
+}
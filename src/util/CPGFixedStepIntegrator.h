@@ -0,0 +1,176 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef SRC_UTIL_CPG_FIXED_STEP_INTEGRATOR_H
+#define SRC_UTIL_CPG_FIXED_STEP_INTEGRATOR_H
+
+/**
+ * @file CPGFixedStepIntegrator.h
+ * @brief Definition of class CPGFixedStepIntegrator
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+/**
+ * A fixed step RK4 integrator for the node equations of CPGNode and
+ * CPGNodeFB, with the network stored as flat arrays rather than as
+ * nodes holding pointers to each other.
+ *
+ * The state is kept as three blocks of numNodes values: phase, radius,
+ * and the third variable of the node model (rDot for CPGNode, omega for
+ * CPGNodeFB). Node parameters live in one array each and the couplings
+ * in compressed sparse row form, in the order they were added so the
+ * derivatives are summed exactly as CPGNode::updateDTs sums them.
+ *
+ * Build the network with addNode and addCoupling, then call finalize.
+ * integrate() allocates nothing once the Workspace it is given has been
+ * sized by a first call.
+ */
+class CPGFixedStepIntegrator
+{
+public:
+
+    /** Which node equations to integrate */
+    enum NodeModel
+    {
+        /** CPGNode: descending commands, one per node */
+        eDescending,
+        /** CPGNodeFB: feedback, three commands per node */
+        eFeedback
+    };
+
+    /**
+     * Scratch space for integrate(), owned by the caller so one can be
+     * reused across calls and integrators.
+     */
+    struct Workspace
+    {
+        std::vector<double> k1;
+        std::vector<double> k2;
+        std::vector<double> k3;
+        std::vector<double> k4;
+        std::vector<double> stage;
+        /** The command dependent terms, constant over a call */
+        std::vector<double> drive;
+    };
+
+    CPGFixedStepIntegrator(NodeModel model);
+
+    /**
+     * Add a node with the parameters CPGNode (7) or CPGNodeFB (11) takes.
+     * The state starts at zero, except omega (params[7]) and the radius
+     * (sqrt(params[2])) of feedback nodes, as in CPGNodeFB.
+     * @return the index of the new node
+     * @throw std::invalid_argument if params is too short
+     * @throw std::logic_error if called after finalize
+     */
+    std::size_t addNode(const std::vector<double>& params);
+
+    /**
+     * Couple node to target as CPGNode::addCoupling does
+     * @throw std::invalid_argument if either index is out of range
+     * @throw std::logic_error if called after finalize
+     */
+    void addCoupling(std::size_t node, std::size_t target,
+                     double weight, double phase);
+
+    /** Build the coupling rows. Must be called before integrate */
+    void finalize();
+
+    /**
+     * Advance the state by dt in equal RK4 steps no longer than maxStep
+     * @param[in] commands numNodes descending commands, or 3 * numNodes
+     * feedback values for eFeedback
+     * @return the number of derivative evaluations
+     * @throw std::invalid_argument if commands has the wrong size or a
+     * time is not positive
+     * @throw std::logic_error if not finalized
+     */
+    std::size_t integrate(const std::vector<double>& commands, double dt,
+                          double maxStep, Workspace& workspace);
+
+    /**
+     * The derivatives at state x, with the command terms computed by
+     * integrate in drive
+     */
+    void derivatives(const double* x, const double* drive, double* dxdt) const;
+
+    std::size_t getNumNodes() const
+    {
+        return m_numNodes;
+    }
+
+    void setNodeState(std::size_t i, double phi, double r, double third);
+
+    double getPhase(std::size_t i) const
+    {
+        return m_state[i];
+    }
+
+    double getRadius(std::size_t i) const
+    {
+        return m_state[m_numNodes + i];
+    }
+
+    /** rDot for eDescending, omega for eFeedback */
+    double getThird(std::size_t i) const
+    {
+        return m_state[2 * m_numNodes + i];
+    }
+
+    /** The output of node i, as CPGNode::nodeValue */
+    double getNodeValue(std::size_t i) const;
+
+private:
+
+    /** Compute the command dependent terms of each node into drive */
+    void computeDrive(const std::vector<double>& commands, double* drive) const;
+
+    const NodeModel m_model;
+    std::size_t m_numNodes;
+    bool m_finalized;
+
+    /** phase, radius and third variable blocks */
+    std::vector<double> m_state;
+
+    /** Node parameters, one entry per node */
+    std::vector<double> m_frequencyOffset;
+    std::vector<double> m_frequencyScale;
+    std::vector<double> m_radiusOffset;
+    std::vector<double> m_radiusScale;
+    std::vector<double> m_rConst;
+    std::vector<double> m_dMin;
+    std::vector<double> m_dMax;
+    std::vector<double> m_kFreq;
+    std::vector<double> m_kAmp;
+    std::vector<double> m_kPhase;
+
+    /** Couplings in insertion order, until finalize */
+    std::vector<std::size_t> m_edgeNode;
+
+    /** Coupling rows: the edges of node i are [m_rowStart[i], m_rowStart[i + 1]) */
+    std::vector<std::size_t> m_rowStart;
+    std::vector<std::size_t> m_edgeTarget;
+    std::vector<double> m_edgeWeight;
+    std::vector<double> m_edgePhase;
+};
+
+#endif // SRC_UTIL_CPG_FIXED_STEP_INTEGRATOR_H
@@ -0,0 +1,392 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file CompiledStructure.cpp
+ * @brief Contains the definition of the members of the class CompiledStructure.
+ * $Id$
+ */
+
+#include "CompiledStructure.h"
+// C++ Standard Library
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+// POSIX
+#include <sys/stat.h>
+#include <unistd.h>
+// NTRT Core and tgCreator Libraries
+#include "tgcreator/tgNode.h"
+#include "tgcreator/tgNodes.h"
+#include "tgcreator/tgPair.h"
+#include "tgcreator/tgPairs.h"
+#include "tgcreator/tgStructure.h"
+// Bullet Physics library
+#include "LinearMath/btVector3.h"
+
+/*
+ * Layout, in native byte order since the files are only meant for the
+ * machine that wrote them. Strings are a uint32 length and the bytes.
+ *
+ * file      := magic inputs builders string(structure)
+ * inputs    := uint32 count, count * (string path, uint64 hash)
+ * builders  := uint32 count, count * (string class, string tagMatch,
+ *              uint32 count, count * (string name, string value))
+ * structure := string tags,
+ *              uint32 count, count * (double x y z, string tags),
+ *              uint32 count, count * (double x y z x y z, string tags),
+ *              uint32 count, count * structure
+ */
+
+namespace
+{
+    const char magic[] = "NTRTCS01";
+    const std::size_t magicLength = sizeof(magic) - 1;
+
+    template <typename T>
+    void put(std::string& out, const T& value)
+    {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void putString(std::string& out, const std::string& value)
+    {
+        put(out, static_cast<unsigned int>(value.size()));
+        out.append(value);
+    }
+
+    void putVector(std::string& out, const btVector3& v)
+    {
+        put(out, static_cast<double>(v.x()));
+        put(out, static_cast<double>(v.y()));
+        put(out, static_cast<double>(v.z()));
+    }
+
+    /** Reads what put wrote, throwing at the end of the data */
+    class Reader
+    {
+    public:
+        Reader(const std::string& data) : m_data(data), m_pos(0) { }
+
+        template <typename T>
+        T get()
+        {
+            T value;
+            std::memcpy(&value, take(sizeof(value)), sizeof(value));
+            return value;
+        }
+
+        std::string getString()
+        {
+            const unsigned int length = get<unsigned int>();
+            return std::string(take(length), length);
+        }
+
+        btVector3 getVector()
+        {
+            const double x = get<double>();
+            const double y = get<double>();
+            const double z = get<double>();
+            return btVector3(x, y, z);
+        }
+
+        bool atEnd() const
+        {
+            return m_pos == m_data.size();
+        }
+
+    private:
+        const char* take(std::size_t bytes)
+        {
+            if (bytes > m_data.size() - m_pos)
+            {
+                throw std::runtime_error("Compiled structure is truncated");
+            }
+            const char* p = m_data.data() + m_pos;
+            m_pos += bytes;
+            return p;
+        }
+
+        const std::string& m_data;
+        std::size_t m_pos;
+    };
+
+    void putStructure(std::string& out, const tgStructure& structure)
+    {
+        putString(out, structure.getTagStr(" "));
+
+        const tgNodes& nodes = structure.getNodes();
+        put(out, static_cast<unsigned int>(nodes.size()));
+        for (int i = 0; i < nodes.size(); i++)
+        {
+            putVector(out, nodes[i]);
+            putString(out, nodes[i].getTagStr(" "));
+        }
+
+        const tgPairs& pairs = structure.getPairs();
+        put(out, static_cast<unsigned int>(pairs.size()));
+        for (int i = 0; i < pairs.size(); i++)
+        {
+            putVector(out, pairs[i].getFrom());
+            putVector(out, pairs[i].getTo());
+            putString(out, pairs[i].getTagStr(" "));
+        }
+
+        const std::vector<tgStructure*>& children = structure.getChildren();
+        put(out, static_cast<unsigned int>(children.size()));
+        for (std::size_t i = 0; i < children.size(); i++)
+        {
+            putStructure(out, *children[i]);
+        }
+    }
+
+    /** Fill structure, whose tags have been read already */
+    void getStructure(Reader& in, tgStructure& structure)
+    {
+        const unsigned int nodeCount = in.get<unsigned int>();
+        for (unsigned int i = 0; i < nodeCount; i++)
+        {
+            const btVector3 v = in.getVector();
+            structure.addNode(v.x(), v.y(), v.z(), in.getString());
+        }
+
+        const unsigned int pairCount = in.get<unsigned int>();
+        for (unsigned int i = 0; i < pairCount; i++)
+        {
+            const btVector3 from = in.getVector();
+            const btVector3 to = in.getVector();
+            structure.addPair(from, to, in.getString());
+        }
+
+        const unsigned int childCount = in.get<unsigned int>();
+        for (unsigned int i = 0; i < childCount; i++)
+        {
+            // structure owns its children
+            tgStructure* child = new tgStructure(tgTags(in.getString()));
+            structure.addChild(child);
+            getStructure(in, *child);
+        }
+    }
+}
+
+CompiledStructure::CompiledStructure()
+{
+}
+
+void CompiledStructure::clear()
+{
+    m_inputs.clear();
+    m_builders.clear();
+    m_structure.clear();
+}
+
+void CompiledStructure::addInput(const std::string& path)
+{
+    unsigned long long hash;
+    if (!hashFile(path, hash))
+    {
+        throw std::runtime_error("Cannot read " + path);
+    }
+    m_inputs.push_back(std::make_pair(path, hash));
+}
+
+void CompiledStructure::addBuilder(const Builder& builder)
+{
+    m_builders.push_back(builder);
+}
+
+void CompiledStructure::setStructure(const tgStructure& structure)
+{
+    m_structure.clear();
+    putStructure(m_structure, structure);
+}
+
+void CompiledStructure::restoreStructure(tgStructure& structure) const
+{
+    if (empty())
+    {
+        throw std::runtime_error("No structure has been compiled");
+    }
+    Reader in(m_structure);
+    structure.addTags(in.getString());
+    getStructure(in, structure);
+    if (!in.atEnd())
+    {
+        throw std::runtime_error("Compiled structure has trailing data");
+    }
+}
+
+bool CompiledStructure::isUpToDate(const std::string& root) const
+{
+    if (empty() || m_inputs.empty() || m_inputs[0].first != root)
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < m_inputs.size(); i++)
+    {
+        unsigned long long hash;
+        if (!hashFile(m_inputs[i].first, hash) || hash != m_inputs[i].second)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CompiledStructure::write(const std::string& filename) const
+{
+    std::string out(magic, magicLength);
+
+    put(out, static_cast<unsigned int>(m_inputs.size()));
+    for (std::size_t i = 0; i < m_inputs.size(); i++)
+    {
+        putString(out, m_inputs[i].first);
+        put(out, m_inputs[i].second);
+    }
+
+    put(out, static_cast<unsigned int>(m_builders.size()));
+    for (std::size_t i = 0; i < m_builders.size(); i++)
+    {
+        const Builder& builder = m_builders[i];
+        putString(out, builder.builderClass);
+        putString(out, builder.tagMatch);
+        put(out, static_cast<unsigned int>(builder.parameters.size()));
+        for (std::size_t j = 0; j < builder.parameters.size(); j++)
+        {
+            putString(out, builder.parameters[j].first);
+            putString(out, builder.parameters[j].second);
+        }
+    }
+
+    putString(out, m_structure);
+
+    // Other processes may be reading filename, so write a temporary file
+    // next to it and rename it into place: readers see the old file or
+    // the new one, never a partial write.
+    const std::string pattern = filename + ".XXXXXX";
+    std::vector<char> tempName(pattern.begin(), pattern.end());
+    tempName.push_back('\0');
+    const int fd = mkstemp(&tempName[0]);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Cannot write compiled structure " + filename);
+    }
+    fchmod(fd, 0644);
+
+    std::size_t written = 0;
+    while (written < out.size())
+    {
+        const ssize_t n = ::write(fd, out.data() + written, out.size() - written);
+        if (n <= 0)
+        {
+            break;
+        }
+        written += n;
+    }
+    const bool closed = (close(fd) == 0);
+
+    if (written != out.size() || !closed ||
+        std::rename(&tempName[0], filename.c_str()) != 0)
+    {
+        std::remove(&tempName[0]);
+        throw std::runtime_error("Cannot write compiled structure " + filename);
+    }
+}
+
+bool CompiledStructure::read(const std::string& filename)
+{
+    clear();
+
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    const std::string data((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+    if (data.compare(0, magicLength, magic) != 0)
+    {
+        return false;
+    }
+
+    const std::string body = data.substr(magicLength);
+    try
+    {
+        Reader in(body);
+
+        const unsigned int inputCount = in.get<unsigned int>();
+        for (unsigned int i = 0; i < inputCount; i++)
+        {
+            const std::string path = in.getString();
+            m_inputs.push_back(std::make_pair(path, in.get<unsigned long long>()));
+        }
+
+        const unsigned int builderCount = in.get<unsigned int>();
+        for (unsigned int i = 0; i < builderCount; i++)
+        {
+            Builder builder;
+            builder.builderClass = in.getString();
+            builder.tagMatch = in.getString();
+            const unsigned int parameterCount = in.get<unsigned int>();
+            for (unsigned int j = 0; j < parameterCount; j++)
+            {
+                const std::string name = in.getString();
+                builder.parameters.push_back(std::make_pair(name, in.getString()));
+            }
+            m_builders.push_back(builder);
+        }
+
+        m_structure = in.getString();
+        if (!in.atEnd() || m_structure.empty())
+        {
+            clear();
+            return false;
+        }
+    }
+    catch (const std::runtime_error&)
+    {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+bool CompiledStructure::hashFile(const std::string& path, unsigned long long& hash)
+{
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    hash = 14695981039346656037ULL;
+    char buffer[4096];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+    {
+        const std::streamsize n = file.gcount();
+        for (std::streamsize i = 0; i < n; i++)
+        {
+            hash ^= static_cast<unsigned char>(buffer[i]);
+            hash *= 1099511628211ULL;
+        }
+    }
+    return true;
+}
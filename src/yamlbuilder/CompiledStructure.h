@@ -0,0 +1,123 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef COMPILED_STRUCTURE_H
+#define COMPILED_STRUCTURE_H
+
+/**
+ * @file CompiledStructure.h
+ * @brief Contains the definition of the class CompiledStructure.
+ * $Id$
+ */
+
+// C++ Standard Library
+#include <string>
+#include <utility>
+#include <vector>
+
+// Forward declarations
+class tgStructure;
+
+/**
+ * A YAML-encoded structure after parsing: the resolved nodes, pairs and
+ * tags of the whole tgStructure tree in a flat binary buffer, and the
+ * builders in the order they were declared. Holds the paths and content
+ * hashes of all the YAML files that went into it, so that it can be
+ * reused until one of them changes. TensegrityModel keeps one to skip
+ * parsing on every setup after the first, and can store it in a file
+ * for other processes.
+ */
+class CompiledStructure
+{
+public:
+
+    /** A builder as declared in YAML, parameter values unparsed */
+    struct Builder
+    {
+        std::string builderClass;
+        std::string tagMatch;
+        std::vector< std::pair<std::string, std::string> > parameters;
+    };
+
+    CompiledStructure();
+
+    /** Nothing compiled yet */
+    bool empty() const
+    {
+        return m_structure.empty();
+    }
+
+    /** Forget everything, before compiling again */
+    void clear();
+
+    /**
+     * Record a YAML file that was read
+     * @throw std::runtime_error if the file cannot be read
+     */
+    void addInput(const std::string& path);
+
+    void addBuilder(const Builder& builder);
+
+    const std::vector<Builder>& getBuilders() const
+    {
+        return m_builders;
+    }
+
+    /** Store the resolved structure, after all inputs were read */
+    void setStructure(const tgStructure& structure);
+
+    /**
+     * Rebuild the stored structure into structure, which should be empty
+     * @throw std::runtime_error if nothing is stored or the data is corrupt
+     */
+    void restoreStructure(tgStructure& structure) const;
+
+    /**
+     * @param[in] root the path of the top level YAML file
+     * @return true if this was compiled from root, and every input still
+     * has the content it was compiled from
+     */
+    bool isUpToDate(const std::string& root) const;
+
+    /**
+     * Write to a file. The file is replaced in one step, so a concurrent
+     * read sees either the old content or the new.
+     * @throw std::runtime_error if the file cannot be written
+     */
+    void write(const std::string& filename) const;
+
+    /**
+     * Replace the contents with a file written by write
+     * @return false, leaving this empty, if the file is missing or not a
+     * compiled structure of this version
+     */
+    bool read(const std::string& filename);
+
+private:
+
+    /** 64 bit FNV-1a of a file's content, false if it cannot be read */
+    static bool hashFile(const std::string& path, unsigned long long& hash);
+
+    std::vector< std::pair<std::string, unsigned long long> > m_inputs;
+    std::vector<Builder> m_builders;
+
+    /** The structure tree, see CompiledStructure.cpp for the layout */
+    std::string m_structure;
+};
+
+#endif  // COMPILED_STRUCTURE_H
@@ -0,0 +1,149 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file SolverBenchmark.cpp
+ * @brief Times a YAML model under each constraint solver and broadphase
+ * configuration of tgWorld::Config.
+ * $Id$
+ */
+
+// This application
+#include "TensegrityModel.h"
+// This library
+#include "core/terrain/tgBoxGround.h"
+#include "core/tgSimulation.h"
+#include "core/tgSimViewHeadless.h"
+#include "core/tgWorld.h"
+// Bullet Physics
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    struct Solver
+    {
+        const char* name;
+        tgWorld::Config::SolverType type;
+    };
+
+    const Solver solvers[] =
+    {
+        { "Dantzig MLCP", tgWorld::Config::DANTZIG_MLCP },
+        { "PGS MLCP", tgWorld::Config::PGS_MLCP },
+        { "Sequential impulse", tgWorld::Config::SEQUENTIAL_IMPULSE }
+    };
+
+    struct Broadphase
+    {
+        const char* name;
+        tgWorld::Config::BroadphaseType type;
+    };
+
+    const Broadphase broadphases[] =
+    {
+        { "AxisSweep3", tgWorld::Config::AXIS_SWEEP_3 },
+        { "Dbvt", tgWorld::Config::DBVT }
+    };
+
+    /** Build the model in a fresh world and time the requested steps */
+    void runConfiguration(const std::string& name,
+                          const tgWorld::Config& config,
+                          const std::string& yamlPath,
+                          int steps)
+    {
+        const tgBoxGround::Config groundConfig(btVector3(0.0, 0.0, 0.0));
+        // the world will delete this
+        tgBoxGround* ground = new tgBoxGround(groundConfig);
+        tgWorld world(config, ground);
+        
+        const double timestep_physics = 0.001; // seconds
+        tgSimViewHeadless view(world, timestep_physics, false);
+        
+        tgSimulation simulation(view);
+        simulation.addModel(new TensegrityModel(yamlPath, false));
+        
+        simulation.run(steps);
+        
+        std::cout << name << ": "
+                  << view.getWallTime() / steps * 1.0e6 << " us/step, "
+                  << view.getStepsPerSecond() << " steps/s, "
+                  << "real time factor " << view.getRealTimeFactor()
+                  << std::endl;
+    }
+}
+
+/**
+ * The entry point.
+ * @param[in] argc the number of command-line arguments
+ * @param[in] argv argv[0] is the executable name
+ * @param[in] argv argv[1] is the path of the YAML encoded structure
+ * @param[in] argv argv[2], optional, is the number of steps per run
+ * @return 0, or 1 if the arguments are not valid
+ */
+int main(int argc, char** argv)
+{
+    const int defaultSteps = 10000;
+    if (argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " model.yaml [steps]" << std::endl;
+        return 1;
+    }
+    
+    const std::string yamlPath(argv[1]);
+    int steps = defaultSteps;
+    if (argc > 2)
+    {
+        char* end = NULL;
+        const long parsed = std::strtol(argv[2], &end, 10);
+        if (end == argv[2] || *end != '\0' || parsed <= 0 || parsed > INT_MAX)
+        {
+            std::cerr << "steps must be a positive integer, not "
+                      << argv[2] << std::endl;
+            return 1;
+        }
+        steps = static_cast<int>(parsed);
+    }
+    
+    const double gravity = 98.1; // dm/sec^2
+    const double worldSize = 1000.0;
+    const int iterations = 10;
+    const int capacity = 16384;
+    
+    const std::size_t solverCount = sizeof(solvers) / sizeof(solvers[0]);
+    const std::size_t broadphaseCount = sizeof(broadphases) / sizeof(broadphases[0]);
+    for (std::size_t i = 0; i < broadphaseCount; i++)
+    {
+        for (std::size_t j = 0; j < solverCount; j++)
+        {
+            const std::string name =
+                std::string(solvers[j].name) + ", " + broadphases[i].name;
+            runConfiguration(name,
+                tgWorld::Config(gravity, worldSize, solvers[j].type,
+                                iterations, broadphases[i].type, capacity),
+                yamlPath, steps);
+        }
+    }
+    
+    return 0;
+}
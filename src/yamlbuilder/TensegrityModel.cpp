@@ -43,7 +43,8 @@
 /**
  * Constructor that only takes the path to the YAML file.
  */
-TensegrityModel::TensegrityModel(const std::string& structurePath) : tgModel() {
+TensegrityModel::TensegrityModel(const std::string& structurePath) : tgModel(),
+    compiling(false) {
     topLvlStructurePath = structurePath;
 }
 
@@ -51,7 +52,8 @@ TensegrityModel::TensegrityModel(const std::string& structurePath) : tgModel() {
  * Constructor that includes the debugging flag.
  */
 TensegrityModel::TensegrityModel(const std::string& structurePath,
-				 bool debugging) : tgModel() {
+				 bool debugging) : tgModel(),
+    compiling(false) {
     topLvlStructurePath = structurePath;
     // All places in this file controlled by 'debugging_on' are labelled
     // with comments with the string DEBUGGING.
@@ -92,7 +94,35 @@ void TensegrityModel::setup(tgWorld& world) {
     addBoxBuilder("tgBoxInfo", "box", emptyYam, spec);
 
     tgStructure structure;
-    buildStructure(structure, topLvlStructurePath, spec);
+    if (loadCompiledStructure()) {
+        // skip the YAML: replay its builders and copy its resolved structure
+        const std::vector<CompiledStructure::Builder>& builders = compiledStructure.getBuilders();
+        for (std::size_t i = 0; i < builders.size(); i++) {
+            Yam parameters;
+            for (std::size_t j = 0; j < builders[i].parameters.size(); j++) {
+                parameters[builders[i].parameters[j].first] = builders[i].parameters[j].second;
+            }
+            addBuilder(spec, builders[i].builderClass, builders[i].tagMatch, parameters);
+        }
+        compiledStructure.restoreStructure(structure);
+    }
+    else {
+        compiledStructure.clear();
+        compiling = true;
+        try {
+            buildStructure(structure, topLvlStructurePath, spec);
+        }
+        catch (...) {
+            compiling = false;
+            compiledStructure.clear();
+            throw;
+        }
+        compiling = false;
+        compiledStructure.setStructure(structure);
+        if (!compiledCachePath.empty()) {
+            compiledStructure.write(compiledCachePath);
+        }
+    }
 
     tgStructureInfo structureInfo(structure, spec);
     structureInfo.buildInto(*this, world);
@@ -112,6 +142,17 @@ void TensegrityModel::setup(tgWorld& world) {
     tgModel::setup(world);
 }
 
+void TensegrityModel::setCompiledCachePath(const std::string& path) {
+    compiledCachePath = path;
+}
+
+bool TensegrityModel::loadCompiledStructure() {
+    if (!compiledStructure.isUpToDate(topLvlStructurePath) && !compiledCachePath.empty()) {
+        compiledStructure.read(compiledCachePath);
+    }
+    return compiledStructure.isUpToDate(topLvlStructurePath);
+}
+
 void TensegrityModel::addChildren(tgStructure& structure, const std::string& structurePath, tgBuildSpec& spec, const Yam& children) {
     if (!children) return;
     std::string structureAttributeKeys[] = {"path", "rotation", "translation", "scale", "offset"};
@@ -254,6 +295,9 @@ void TensegrityModel::buildStructure(tgStructure& structure, const std::string&
       // Then, throw the exception again, so that the program stops.
       throw badfileexception;
     }
+    if (compiling) {
+        compiledStructure.addInput(structurePath);
+    }
     // Validate YAML
     std::string rootKeys[] = {"nodes", "pair_groups", "builders", "substructures", "bond_groups"};
     std::vector<std::string> rootKeysVector(rootKeys, rootKeys + sizeof(rootKeys) / sizeof(std::string));
@@ -600,25 +644,43 @@ void TensegrityModel::addBuilders(tgBuildSpec& spec, const Yam& builders) {
         std::string builderClass = builder->second["class"].as<std::string>();
         Yam parameters = builder->second["parameters"];
 
-        if (builderClass == "tgRodInfo") {
-            addRodBuilder(builderClass, tagMatch, parameters, spec);
-        }
-        else if (builderClass == "tgBasicActuatorInfo" || builderClass == "tgBasicContactCableInfo") {
-            addBasicActuatorBuilder(builderClass, tagMatch, parameters, spec);
-        }
-        else if (builderClass == "tgKinematicContactCableInfo" || builderClass == "tgKinematicActuatorInfo") {
-            addKinematicActuatorBuilder(builderClass, tagMatch, parameters, spec);
-        }
-	else if (builderClass == "tgBoxInfo") {
-            addBoxBuilder(builderClass, tagMatch, parameters, spec);
-        }
-        // add more builders here if they use a different Config
-        else {
-            throw std::invalid_argument("Unsupported builder class: " + builderClass);
+        addBuilder(spec, builderClass, tagMatch, parameters);
+
+        if (compiling) {
+            CompiledStructure::Builder compiledBuilder;
+            compiledBuilder.builderClass = builderClass;
+            compiledBuilder.tagMatch = tagMatch;
+            if (parameters) {
+                for (YAML::const_iterator parameter = parameters.begin(); parameter != parameters.end(); ++parameter) {
+                    compiledBuilder.parameters.push_back(std::make_pair(parameter->first.as<std::string>(),
+                        parameter->second.as<std::string>()));
+                }
+            }
+            compiledStructure.addBuilder(compiledBuilder);
         }
     }
 }
 
+void TensegrityModel::addBuilder(tgBuildSpec& spec, const std::string& builderClass, const std::string& tagMatch,
+    const Yam& parameters) {
+    if (builderClass == "tgRodInfo") {
+        addRodBuilder(builderClass, tagMatch, parameters, spec);
+    }
+    else if (builderClass == "tgBasicActuatorInfo" || builderClass == "tgBasicContactCableInfo") {
+        addBasicActuatorBuilder(builderClass, tagMatch, parameters, spec);
+    }
+    else if (builderClass == "tgKinematicContactCableInfo" || builderClass == "tgKinematicActuatorInfo") {
+        addKinematicActuatorBuilder(builderClass, tagMatch, parameters, spec);
+    }
+    else if (builderClass == "tgBoxInfo") {
+        addBoxBuilder(builderClass, tagMatch, parameters, spec);
+    }
+    // add more builders here if they use a different Config
+    else {
+        throw std::invalid_argument("Unsupported builder class: " + builderClass);
+    }
+}
+
 void TensegrityModel::addRodBuilder(const std::string& builderClass, const std::string& tagMatch, const Yam& parameters, tgBuildSpec& spec) {
     // rodParameters
     std::map<std::string, double> rp;
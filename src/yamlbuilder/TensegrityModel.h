@@ -31,6 +31,8 @@
 #include <map>
 #include <string>
 #include <vector>
+// This library
+#include "CompiledStructure.h"
 // NTRT Core and tgCreator Libraries
 #include "core/tgModel.h"
 #include "core/tgSubject.h"
@@ -216,6 +218,15 @@ public:
      */
     virtual void setup(tgWorld& world);
 
+    /**
+     * Keep the compiled structure in a file, so that other processes
+     * building the same YAML skip parsing it. The file is replaced when
+     * any of the YAML inputs change. By default the compiled structure
+     * is only kept in memory, for the setups after the first.
+     * @param[in] path the cache file, empty to not use one
+     */
+    void setCompiledCachePath(const std::string& path);
+
     /**
      * Undoes setup. Deletes child models. Called automatically on
      * reset and end of simulation. Notifies controllers of teardown
@@ -249,6 +260,28 @@ private:
      */
     std::vector<tgSpringCableActuator*> allActuators;
 
+    /**
+     * The parsed YAML, reused by setup while the files are unchanged
+     */
+    CompiledStructure compiledStructure;
+
+    /**
+     * Where compiledStructure is stored, empty if it is not
+     */
+    std::string compiledCachePath;
+
+    /**
+     * True while buildStructure is recording into compiledStructure
+     */
+    bool compiling;
+
+    /**
+     * Make compiledStructure current for topLvlStructurePath, reading
+     * the cache file if needed.
+     * @return false if the YAML must be parsed again
+     */
+    bool loadCompiledStructure();
+
     /*
      * Responsible for adding all the children defined in a structure file, and apply their
      * rotation, scale, offset and translation attributes.
@@ -369,6 +402,12 @@ private:
      */
     void addBuilders(tgBuildSpec& spec, const Yam& builders);
 
+    /*
+     * Responsible for adding one builder of a known class to the build spec
+     */
+    void addBuilder(tgBuildSpec& spec, const std::string& builderClass, const std::string& tagMatch,
+        const Yam& parameters);
+
     /*
      * Responsible for adding a builder that uses the tgRod config
      */
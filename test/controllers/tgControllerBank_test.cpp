@@ -0,0 +1,319 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgControllerBank_test.cpp
+* @brief Contains tests that tgControllerBank matches per-actuator
+* tgImpedanceControllers and tgPIDControllers
+* $Id$
+*/
+
+// This application
+#include "controllers/tgControllerBank.h"
+#include "controllers/tgImpedanceController.h"
+#include "controllers/tgPIDController.h"
+#include "core/tgCast.h"
+#include "core/tgKinematicActuator.h"
+#include "core/tgModel.h"
+#include "core/tgRod.h"
+#include "core/tgSimulation.h"
+#include "core/tgSimView.h"
+#include "core/tgWorld.h"
+#include "tgcreator/tgBasicActuatorInfo.h"
+#include "tgcreator/tgBuildSpec.h"
+#include "tgcreator/tgKinematicActuatorInfo.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgStructureInfo.h"
+// The Bullet Physics library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	const double dt = 0.001;
+	const int steps = 1000;
+
+	// A three bar prism with kinematic or basic actuators
+	class BankPrism : public tgModel
+	{
+	public:
+		BankPrism(bool kinematic) :
+			m_kinematic(kinematic)
+		{
+		}
+
+		virtual void setup(tgWorld& world)
+		{
+			tgStructure s;
+			s.addNode(-5, 0, 0);
+			s.addNode( 5, 0, 0);
+			s.addNode( 0, 0, 10);
+			s.addNode(-5, 20, 0);
+			s.addNode( 5, 20, 0);
+			s.addNode( 0, 20, 10);
+
+			s.addPair(0, 4, "rod");
+			s.addPair(1, 5, "rod");
+			s.addPair(2, 3, "rod");
+
+			s.addPair(0, 1, "muscle");
+			s.addPair(1, 2, "muscle");
+			s.addPair(2, 0, "muscle");
+			s.addPair(3, 4, "muscle");
+			s.addPair(4, 5, "muscle");
+			s.addPair(5, 3, "muscle");
+			s.addPair(0, 3, "muscle");
+			s.addPair(1, 4, "muscle");
+			s.addPair(2, 5, "muscle");
+
+			s.move(btVector3(0, 10, 0));
+
+			const tgRod::Config rodConfig(0.31, 0.2);
+			tgBuildSpec spec;
+			spec.addBuilder("rod", new tgRodInfo(rodConfig));
+			if (m_kinematic)
+			{
+				// Backdrivable, so every control input moves the motor
+				const tgKinematicActuator::Config motorConfig(1000.0, 10.0, 500.0,
+															  1.0, 10.0, 1.0, true);
+				spec.addBuilder("muscle", new tgKinematicActuatorInfo(motorConfig));
+			}
+			else
+			{
+				const tgSpringCableActuator::Config muscleConfig(1000.0, 10.0, 500.0);
+				spec.addBuilder("muscle", new tgBasicActuatorInfo(muscleConfig));
+			}
+
+			tgStructureInfo structureInfo(s, spec);
+			structureInfo.buildInto(*this, world);
+
+			tgModel::setup(world);
+		}
+
+		std::vector<tgSpringCableActuator*> getMuscles() const
+		{
+			return tgCast::filter<tgModel, tgSpringCableActuator>(getDescendants());
+		}
+
+	private:
+		const bool m_kinematic;
+	};
+
+	// How often the impedance law runs; the PID loops run every step
+	enum Path
+	{
+		IMPEDANCE_ONLY,
+		PID_ONLY,
+		MIXED
+	};
+
+	bool impedanceStep(Path path, int step)
+	{
+		switch (path)
+		{
+		case IMPEDANCE_ONLY:
+			return true;
+		case PID_ONLY:
+			return false;
+		default:
+			return step % 5 == 0;
+		}
+	}
+
+	// Two identical worlds, one controlled by a bank and one by
+	// a tgImpedanceController and a tgPIDController per actuator
+	class tgControllerBankTest : public ::testing::Test
+	{
+	protected:
+		tgControllerBankTest() :
+			m_bankView(m_bankWorld, dt),
+			m_bankSimulation(m_bankView),
+			m_referenceView(m_referenceWorld, dt),
+			m_referenceSimulation(m_referenceView),
+			m_pBankPrism(new BankPrism(true)),
+			m_pReferencePrism(new BankPrism(true))
+		{
+			m_bankSimulation.addModel(m_pBankPrism);
+			m_referenceSimulation.addModel(m_pReferencePrism);
+		}
+
+		virtual ~tgControllerBankTest()
+		{
+			for (std::size_t i = 0; i < m_pids.size(); i++)
+			{
+				delete m_pids[i];
+				delete m_impedances[i];
+			}
+		}
+
+		void addControllers()
+		{
+			const std::vector<tgSpringCableActuator*> bankMuscles =
+				m_pBankPrism->getMuscles();
+			const std::vector<tgSpringCableActuator*> referenceMuscles =
+				m_pReferencePrism->getMuscles();
+			ASSERT_EQ(bankMuscles.size(), referenceMuscles.size());
+
+			for (std::size_t i = 0; i < bankMuscles.size(); i++)
+			{
+				// Different gains per actuator, so no lane can borrow
+				// another's
+				tgImpedanceController* const pImpedance =
+					new tgImpedanceController(400.0 + 10.0 * i, 300.0, 20.0 + i);
+				const tgPIDController::Config pidConfig(2.0 + 0.1 * i, 0.05,
+														0.001, true,
+														200.0 + 5.0 * i);
+				m_impedances.push_back(pImpedance);
+				m_pids.push_back(new tgPIDController(referenceMuscles[i],
+													 pidConfig));
+				m_setTensions.push_back(pidConfig.startingSetPoint);
+
+				EXPECT_EQ(i, m_bank.add(*bankMuscles[i], *pImpedance, pidConfig));
+			}
+			EXPECT_EQ(bankMuscles.size(), m_bank.size());
+		}
+
+		// Control and step both worlds, requiring identical states
+		void run(Path path)
+		{
+			const std::vector<tgSpringCableActuator*> bankMuscles =
+				m_pBankPrism->getMuscles();
+			const std::vector<tgSpringCableActuator*> referenceMuscles =
+				m_pReferencePrism->getMuscles();
+
+			double time = 0.0;
+			for (int step = 0; step < steps; step++)
+			{
+				if (impedanceStep(path, step))
+				{
+					for (std::size_t i = 0; i < referenceMuscles.size(); i++)
+					{
+						const double position =
+							referenceMuscles[i]->getStartLength() *
+							(0.9 + 0.05 * std::sin(3.0 * time + i));
+						const double offsetVel = 0.1 * std::cos(3.0 * time + i);
+						m_setTensions[i] =
+							m_impedances[i]->control(*m_pids[i], dt,
+													 position, offsetVel);
+						m_bank.setTarget(i, position, offsetVel);
+					}
+					m_bank.controlImpedance(dt);
+				}
+				else
+				{
+					for (std::size_t i = 0; i < referenceMuscles.size(); i++)
+					{
+						m_pids[i]->control(dt, m_setTensions[i],
+										   referenceMuscles[i]->getTension());
+					}
+					m_bank.controlTension(dt);
+				}
+
+				m_referenceSimulation.step(dt);
+				m_bankSimulation.step(dt);
+				time += dt;
+
+				for (std::size_t i = 0; i < referenceMuscles.size(); i++)
+				{
+					ASSERT_EQ(m_setTensions[i], m_bank.getSetTension(i))
+						<< "actuator " << i << " step " << step;
+					ASSERT_EQ(referenceMuscles[i]->getRestLength(),
+							  bankMuscles[i]->getRestLength())
+						<< "actuator " << i << " step " << step;
+					ASSERT_EQ(referenceMuscles[i]->getCurrentLength(),
+							  bankMuscles[i]->getCurrentLength())
+						<< "actuator " << i << " step " << step;
+					ASSERT_EQ(referenceMuscles[i]->getTension(),
+							  bankMuscles[i]->getTension())
+						<< "actuator " << i << " step " << step;
+				}
+			}
+
+			// The actuators really were driven
+			for (std::size_t i = 0; i < bankMuscles.size(); i++)
+			{
+				EXPECT_NE(bankMuscles[i]->getStartLength(),
+						  bankMuscles[i]->getRestLength());
+				EXPECT_NE(0.0, m_bank.getControlInput(i));
+			}
+		}
+
+		// Declared first, so they outlive the bank and the controllers
+		tgWorld m_bankWorld;
+		tgSimView m_bankView;
+		tgSimulation m_bankSimulation;
+		tgWorld m_referenceWorld;
+		tgSimView m_referenceView;
+		tgSimulation m_referenceSimulation;
+
+		BankPrism* const m_pBankPrism;
+		BankPrism* const m_pReferencePrism;
+
+		tgControllerBank m_bank;
+		std::vector<tgImpedanceController*> m_impedances;
+		std::vector<tgPIDController*> m_pids;
+		std::vector<double> m_setTensions;
+	};
+
+	TEST_F(tgControllerBankTest, ImpedanceMatchesPerActuatorControllers)
+	{
+		addControllers();
+		run(IMPEDANCE_ONLY);
+	}
+
+	TEST_F(tgControllerBankTest, PIDMatchesPerActuatorControllers)
+	{
+		addControllers();
+		run(PID_ONLY);
+	}
+
+	TEST_F(tgControllerBankTest, MixedMatchesPerActuatorControllers)
+	{
+		addControllers();
+		run(MIXED);
+	}
+
+	TEST(tgControllerBankAddTest, RejectsBasicActuators)
+	{
+		tgWorld world;
+		tgSimView view(world, dt);
+		tgSimulation simulation(view);
+		BankPrism* const pPrism = new BankPrism(false);
+		simulation.addModel(pPrism);
+
+		const std::vector<tgSpringCableActuator*> muscles = pPrism->getMuscles();
+		ASSERT_FALSE(muscles.empty());
+		const tgImpedanceController impedance(400.0, 300.0, 20.0);
+		tgControllerBank bank;
+		EXPECT_THROW(bank.add(*muscles[0], impedance, tgPIDController::Config()),
+					 std::invalid_argument);
+		EXPECT_EQ(0u, bank.size());
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,77 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgPIDController_test.cpp
+* @brief Contains tests of tgPIDController
+* $Id$
+*/
+
+// This application
+#include "controllers/tgPIDController.h"
+#include "core/tgControllable.h"
+// The C++ Standard Library
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	// Keeps every control input it is given
+	class Recorder : public tgControllable
+	{
+	public:
+		Recorder(std::vector<double>& inputs) :
+			m_inputs(inputs)
+		{
+		}
+
+		virtual void setControlInput(double input)
+		{
+			m_inputs.push_back(input);
+		}
+
+	private:
+		std::vector<double>& m_inputs;
+	};
+
+	TEST(tgPIDControllerTest, ResetMatchesANewController)
+	{
+		std::vector<double> inputs;
+		Recorder recorder(inputs);
+
+		const tgPIDController::Config config(1.0, 3.0, 0.5, false, 2.0);
+		tgPIDController used(&recorder, config);
+		used.control(0.1, 4.0, 1.0);
+		used.control(0.1, 5.0, 0.5);
+		used.reset();
+		used.control(0.1);
+
+		tgPIDController fresh(&recorder, config);
+		fresh.control(0.1);
+
+		ASSERT_EQ(4u, inputs.size());
+		EXPECT_EQ(inputs[3], inputs[2]);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,350 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgBulletContactSpringCable_test.cpp
+* @brief Contains tests that tgBulletContactSpringCable's collision shape,
+* updated in place, matches one rebuilt from new shapes every step
+* $Id$
+*/
+
+// This application
+#include "core/tgBulletContactSpringCable.h"
+#include "core/tgBulletSpringCableAnchor.h"
+#include "core/tgBulletUtil.h"
+#include "core/tgSpringCableAnchor.h"
+#include "core/tgWorld.h"
+#include "tgcreator/tgUtil.h"
+// The Bullet Physics library
+#include "BulletCollision/BroadphaseCollision/btBroadphaseInterface.h"
+#include "BulletCollision/BroadphaseCollision/btOverlappingPairCache.h"
+#include "BulletCollision/CollisionDispatch/btGhostObject.h"
+#include "BulletCollision/CollisionShapes/btBoxShape.h"
+#include "BulletCollision/CollisionShapes/btCompoundShape.h"
+#include "BulletCollision/CollisionShapes/btCylinderShape.h"
+#include "BulletDynamics/Dynamics/btDynamicsWorld.h"
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+#include "LinearMath/btDefaultMotionState.h"
+#include "LinearMath/btTransform.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	const double dt = 0.001;
+	const int steps = 3000;
+	const int cableCount = 4;
+
+	// Cables between pairs of boxes, each with a cylinder dropped on it
+	// so the cable wraps over it and gains and loses anchors
+	class ContactRig
+	{
+	public:
+		ContactRig() :
+			m_world(tgWorld::Config(9.81, 1000.0)),
+			m_dynamicsWorld(tgBulletUtil::worldToDynamicsWorld(m_world))
+		{
+			for (int c = 0; c < cableCount; c++)
+			{
+				const double z = 3.0 * c;
+				btRigidBody* const pA = addBody(new btBoxShape(btVector3(0.5, 0.5, 0.5)),
+												1.0, btVector3(-3.0, 5.0, z));
+				btRigidBody* const pB = addBody(new btBoxShape(btVector3(0.5, 0.5, 0.5)),
+												1.0, btVector3(3.0, 5.0, z));
+				addBody(new btCylinderShape(btVector3(0.5, 0.5, 0.5)),
+						2.0, btVector3(0.2 + 0.1 * c, 5.8, z + 0.1));
+
+				const btVector3 from(-2.5, 5.0, z);
+				const btVector3 to(2.5, 5.0, z);
+				std::vector<tgBulletSpringCableAnchor*> anchors;
+				anchors.push_back(new tgBulletSpringCableAnchor(pA, from));
+				anchors.push_back(new tgBulletSpringCableAnchor(pB, to));
+				// Both sizes of margin: the default and a thick cable's
+				const double thickness = (c % 2) ? 0.05 : 0.001;
+				m_thickness.push_back(thickness);
+				m_cables.push_back(new tgBulletContactSpringCable(
+					makeGhost(from, to), m_world, anchors,
+					500.0, 10.0, 100.0, thickness, 0.1));
+			}
+		}
+
+		~ContactRig()
+		{
+			for (std::size_t i = 0; i < m_cables.size(); i++)
+			{
+				delete m_cables[i];
+			}
+			for (std::size_t i = 0; i < m_bodies.size(); i++)
+			{
+				m_dynamicsWorld.removeRigidBody(m_bodies[i]);
+				delete m_bodies[i]->getMotionState();
+				delete m_bodies[i]->getCollisionShape();
+				delete m_bodies[i];
+			}
+		}
+
+		/**
+		 * Step the cables. If rebuild, afterwards replace every segment
+		 * shape with a new btCylinderShape, as the cable did before it
+		 * updated its shapes in place.
+		 */
+		void stepCables(bool rebuild)
+		{
+			for (std::size_t i = 0; i < m_cables.size(); i++)
+			{
+				m_cables[i]->step(dt);
+				if (rebuild)
+				{
+					rebuildShape(i);
+				}
+			}
+		}
+
+		void stepWorld()
+		{
+			m_world.step(dt);
+		}
+
+		const std::vector<btRigidBody*>& bodies() const
+		{
+			return m_bodies;
+		}
+
+		const tgBulletContactSpringCable& cable(std::size_t i) const
+		{
+			return *m_cables[i];
+		}
+
+		const btCompoundShape& compound(std::size_t i) const
+		{
+			return *static_cast<const btCompoundShape*>(
+				m_ghosts[i]->getCollisionShape());
+		}
+
+		/** The shape the cable would have allocated for a segment */
+		btCylinderShape newSegmentShape(std::size_t i, std::size_t segment) const
+		{
+			const std::vector<const tgSpringCableAnchor*> anchors =
+				m_cables[i]->getAnchors();
+			const double halfLength = (anchors[segment + 1]->getWorldPosition() -
+									   anchors[segment]->getWorldPosition()).length() / 2.0;
+			return btCylinderShape(btVector3(m_thickness[i], halfLength,
+											 m_thickness[i]));
+		}
+
+		/** Whether any pair of the ghost object still has a manifold */
+		bool hasManifolds(std::size_t i) const
+		{
+			btOverlappingPairCache* const pCache =
+				m_dynamicsWorld.getBroadphase()->getOverlappingPairCache();
+			const btBroadphaseProxy* const pProxy = m_ghosts[i]->getBroadphaseHandle();
+			btBroadphasePairArray& pairs = pCache->getOverlappingPairArray();
+			for (int j = 0; j < pairs.size(); j++)
+			{
+				if ((pairs[j].m_pProxy0 == pProxy || pairs[j].m_pProxy1 == pProxy) &&
+					pairs[j].m_algorithm != NULL)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+	private:
+		btRigidBody* addBody(btCollisionShape* pShape, double mass,
+							 const btVector3& position)
+		{
+			btVector3 inertia(0.0, 0.0, 0.0);
+			pShape->calculateLocalInertia(mass, inertia);
+			btTransform transform;
+			transform.setIdentity();
+			transform.setOrigin(position);
+			btRigidBody* const pBody =
+				new btRigidBody(mass, new btDefaultMotionState(transform),
+								pShape, inertia);
+			m_dynamicsWorld.addRigidBody(pBody);
+			m_bodies.push_back(pBody);
+			return pBody;
+		}
+
+		// As tgBasicContactCableInfo builds it
+		btPairCachingGhostObject* makeGhost(const btVector3& from,
+											const btVector3& to)
+		{
+			btTransform transform = tgUtil::getTransform(from, to);
+			btCompoundShape* const pCompound = new btCompoundShape();
+			btTransform childTransform = transform;
+			childTransform.setOrigin(btVector3(0.0, 0.0, 0.0));
+			pCompound->addChildShape(childTransform,
+				new btBoxShape(btVector3(0.001, (from - to).length() / 2.0, 0.001)));
+
+			btPairCachingGhostObject* const pGhost = new btPairCachingGhostObject();
+			transform.setRotation(btQuaternion::getIdentity());
+			pGhost->setCollisionShape(pCompound);
+			pGhost->setWorldTransform(transform);
+			pGhost->setCollisionFlags(btCollisionObject::CF_NO_CONTACT_RESPONSE);
+			m_dynamicsWorld.addCollisionObject(pGhost,
+				btBroadphaseProxy::CharacterFilter,
+				btBroadphaseProxy::StaticFilter | btBroadphaseProxy::DefaultFilter);
+			m_ghosts.push_back(pGhost);
+			return pGhost;
+		}
+
+		void rebuildShape(std::size_t i)
+		{
+			btCompoundShape* const pCompound =
+				static_cast<btCompoundShape*>(m_ghosts[i]->getCollisionShape());
+			std::vector<btTransform> transforms;
+			for (int j = pCompound->getNumChildShapes() - 1; j >= 0; j--)
+			{
+				transforms.insert(transforms.begin(), pCompound->getChildTransform(j));
+				delete pCompound->getChildShape(j);
+				pCompound->removeChildShapeByIndex(j);
+			}
+			for (std::size_t j = 0; j < transforms.size(); j++)
+			{
+				pCompound->addChildShape(transforms[j],
+					new btCylinderShape(newSegmentShape(i, j)));
+			}
+			m_ghosts[i]->setCollisionShape(pCompound);
+		}
+
+		tgWorld m_world;
+		btDynamicsWorld& m_dynamicsWorld;
+		std::vector<btRigidBody*> m_bodies;
+		std::vector<btPairCachingGhostObject*> m_ghosts;
+		std::vector<tgBulletContactSpringCable*> m_cables;
+		std::vector<double> m_thickness;
+	};
+
+	void expectSameShape(const btCylinderShape& expected,
+						 const btCollisionShape& actual,
+						 std::size_t cable, std::size_t segment, int step)
+	{
+		ASSERT_EQ(CYLINDER_SHAPE_PROXYTYPE, actual.getShapeType())
+			<< "cable " << cable << " segment " << segment << " step " << step;
+		const btCylinderShape& cylinder =
+			static_cast<const btCylinderShape&>(actual);
+		ASSERT_EQ(expected.getMargin(), cylinder.getMargin())
+			<< "cable " << cable << " segment " << segment << " step " << step;
+		ASSERT_TRUE(expected.getHalfExtentsWithoutMargin() ==
+					cylinder.getHalfExtentsWithoutMargin())
+			<< "cable " << cable << " segment " << segment << " step " << step;
+	}
+
+	TEST(tgBulletContactSpringCableTest, ShapesFollowTheAnchors)
+	{
+		ContactRig rig;
+		std::vector<std::size_t> minAnchors(cableCount, 1000);
+		std::vector<std::size_t> maxAnchors(cableCount, 0);
+		int removals = 0;
+
+		for (int s = 0; s < steps; s++)
+		{
+			std::vector<std::size_t> before(cableCount);
+			for (std::size_t i = 0; i < cableCount; i++)
+			{
+				before[i] = rig.cable(i).getAnchors().size();
+			}
+			rig.stepCables(false);
+
+			// Between the cable and world steps, where the shapes are set
+			for (std::size_t i = 0; i < cableCount; i++)
+			{
+				const std::size_t anchors = rig.cable(i).getAnchors().size();
+				const btCompoundShape& compound = rig.compound(i);
+				ASSERT_EQ(static_cast<int>(anchors) - 1,
+						  compound.getNumChildShapes()) << "step " << s;
+				for (int j = 0; j < compound.getNumChildShapes(); j++)
+				{
+					expectSameShape(rig.newSegmentShape(i, j),
+									*compound.getChildShape(j), i, j, s);
+				}
+				// No contact survives to the next step
+				ASSERT_FALSE(rig.hasManifolds(i)) << "cable " << i << " step " << s;
+
+				minAnchors[i] = std::min(minAnchors[i], anchors);
+				maxAnchors[i] = std::max(maxAnchors[i], anchors);
+				if (anchors < before[i])
+				{
+					removals++;
+				}
+			}
+			rig.stepWorld();
+		}
+
+		// Every cable wrapped, and some unwrapped again
+		for (std::size_t i = 0; i < cableCount; i++)
+		{
+			EXPECT_EQ(2u, minAnchors[i]) << "cable " << i;
+			EXPECT_LT(3u, maxAnchors[i]) << "cable " << i;
+		}
+		EXPECT_LT(0, removals);
+	}
+
+	TEST(tgBulletContactSpringCableTest, MatchesShapesAllocatedEveryStep)
+	{
+		ContactRig inPlace;
+		ContactRig rebuilt;
+
+		for (int s = 0; s < steps; s++)
+		{
+			inPlace.stepCables(false);
+			rebuilt.stepCables(true);
+			inPlace.stepWorld();
+			rebuilt.stepWorld();
+
+			const std::vector<btRigidBody*>& expectedBodies = rebuilt.bodies();
+			const std::vector<btRigidBody*>& actualBodies = inPlace.bodies();
+			for (std::size_t i = 0; i < expectedBodies.size(); i++)
+			{
+				ASSERT_TRUE(expectedBodies[i]->getCenterOfMassPosition() ==
+							actualBodies[i]->getCenterOfMassPosition())
+					<< "body " << i << " step " << s;
+				ASSERT_TRUE(expectedBodies[i]->getLinearVelocity() ==
+							actualBodies[i]->getLinearVelocity())
+					<< "body " << i << " step " << s;
+				ASSERT_TRUE(expectedBodies[i]->getAngularVelocity() ==
+							actualBodies[i]->getAngularVelocity())
+					<< "body " << i << " step " << s;
+			}
+			for (std::size_t i = 0; i < cableCount; i++)
+			{
+				ASSERT_EQ(rebuilt.cable(i).getAnchors().size(),
+						  inPlace.cable(i).getAnchors().size())
+					<< "cable " << i << " step " << s;
+				ASSERT_EQ(rebuilt.cable(i).getActualLength(),
+						  inPlace.cable(i).getActualLength())
+					<< "cable " << i << " step " << s;
+				ASSERT_EQ(rebuilt.cable(i).getTension(),
+						  inPlace.cable(i).getTension())
+					<< "cable " << i << " step " << s;
+			}
+		}
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,109 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+
+/**
+* @file tgBulletSpringCableAnchorPool_test.cpp
+* @brief Contains tests of the pooled allocation of cable anchors
+* $Id$
+*/
+
+// This application
+#include "core/tgBulletSpringCableAnchor.h"
+#include "core/tgBulletSpringCableAnchorPool.h"
+// The Bullet Physics library
+#include "BulletCollision/CollisionShapes/btSphereShape.h"
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+// The C++ Standard Library
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	class tgBulletSpringCableAnchorPoolTest : public ::testing::Test {
+	protected:
+		tgBulletSpringCableAnchorPoolTest() :
+			shape(1.0),
+			body(1.0, NULL, &shape)
+		{
+		}
+
+		btSphereShape shape;
+		btRigidBody body;
+	};
+
+	TEST_F(tgBulletSpringCableAnchorPoolTest, GrowsByChunksAndReusesSlots) {
+		tgBulletSpringCableAnchorPool pool(4);
+		std::vector<tgBulletSpringCableAnchor*> anchors;
+
+		for (int i = 0; i < 5; i++)
+		{
+			anchors.push_back(new (pool) tgBulletSpringCableAnchor(&body, btVector3(i, 0, 0)));
+		}
+		EXPECT_EQ(5u, pool.size());
+		EXPECT_EQ(8u, pool.capacity());
+
+		tgBulletSpringCableAnchor* const freed = anchors[2];
+		delete freed;
+		EXPECT_EQ(4u, pool.size());
+
+		// The most recently freed slot is used next
+		tgBulletSpringCableAnchor* const reused =
+			new (pool) tgBulletSpringCableAnchor(&body, btVector3(5, 0, 0));
+		EXPECT_EQ(freed, reused);
+		EXPECT_EQ(btVector3(5, 0, 0), reused->getWorldPosition());
+		anchors[2] = reused;
+
+		for (std::size_t i = 0; i < anchors.size(); i++)
+		{
+			delete anchors[i];
+		}
+		EXPECT_EQ(0u, pool.size());
+		EXPECT_EQ(8u, pool.capacity());
+	}
+
+	TEST_F(tgBulletSpringCableAnchorPoolTest, HeapAnchorsBypassThePool) {
+		tgBulletSpringCableAnchorPool pool;
+
+		tgSpringCableAnchor* const pooled =
+			new (pool) tgBulletSpringCableAnchor(&body, btVector3(1, 2, 3));
+		tgBulletSpringCableAnchor* const heap =
+			new tgBulletSpringCableAnchor(&body, btVector3(4, 5, 6));
+		EXPECT_EQ(1u, pool.size());
+		EXPECT_EQ(btVector3(4, 5, 6), heap->getWorldPosition());
+
+		delete heap;
+		EXPECT_EQ(1u, pool.size());
+
+		// Deleting through the base class still finds the pool
+		delete pooled;
+		EXPECT_EQ(0u, pool.size());
+	}
+
+	TEST(tgBulletSpringCableAnchorPoolConstructionTest, RejectsEmptyChunks) {
+		EXPECT_THROW(tgBulletSpringCableAnchorPool(0), std::invalid_argument);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,234 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgBulletSpringCableSystem_test.cpp
+* @brief Contains tests that tgBulletSpringCableSystem matches the per cable
+* force path of tgBulletSpringCable
+* $Id$
+*/
+
+// This application
+#include "core/tgBulletSpringCable.h"
+#include "core/tgBulletSpringCableAnchor.h"
+#include "core/tgBulletSpringCableSystem.h"
+// The Bullet Physics library
+#include "BulletCollision/BroadphaseCollision/btDbvtBroadphase.h"
+#include "BulletCollision/CollisionDispatch/btCollisionDispatcher.h"
+#include "BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h"
+#include "BulletCollision/CollisionShapes/btBoxShape.h"
+#include "BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h"
+#include "BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h"
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+#include "LinearMath/btTransform.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	const double dt = 0.001;
+	const int steps = 3000;
+
+	// Two boxes in their own world, joined by one cable between points
+	// off their centers of mass, so the impulses also spin the boxes
+	class CableRig
+	{
+	public:
+		CableRig() :
+			m_dispatcher(&m_collisionConfiguration),
+			m_world(&m_dispatcher, &m_broadphase, &m_solver,
+					&m_collisionConfiguration),
+			m_shape(btVector3(0.5, 0.5, 0.5)),
+			m_pBodyA(makeBody(btVector3(0, 0, 0), 1.0)),
+			m_pBodyB(makeBody(btVector3(10, 1, 0), 2.0))
+		{
+			m_world.setGravity(btVector3(0, 0, 0));
+			// Start stretched and moving, so the cable goes slack and
+			// taut again, and its damping is sometimes clamped
+			m_pBodyA->setLinearVelocity(btVector3(-3.0, 0.5, 0.0));
+			m_pBodyA->setAngularVelocity(btVector3(0.0, 0.0, 2.0));
+			m_pBodyB->setLinearVelocity(btVector3(4.0, 0.0, -1.0));
+
+			std::vector<tgBulletSpringCableAnchor*> anchors;
+			anchors.push_back(new tgBulletSpringCableAnchor(m_pBodyA,
+												btVector3(0.5, 0.3, 0.0)));
+			anchors.push_back(new tgBulletSpringCableAnchor(m_pBodyB,
+												btVector3(9.5, 1.2, 0.4)));
+			m_pCable = new tgBulletSpringCable(anchors, 200.0, 40.0, 50.0);
+		}
+
+		~CableRig()
+		{
+			delete m_pCable;
+			m_world.removeRigidBody(m_pBodyB);
+			m_world.removeRigidBody(m_pBodyA);
+			delete m_pBodyB;
+			delete m_pBodyA;
+		}
+
+		void useSystem()
+		{
+			m_system.addCable(m_pCable);
+		}
+
+		void leaveSystem()
+		{
+			m_system.removeCable(m_pCable);
+		}
+
+		// The order tgWorldBulletPhysicsImpl steps in
+		void step()
+		{
+			m_system.step(dt);
+			m_pCable->step(dt);
+			m_world.stepSimulation(dt, 0);
+		}
+
+		const tgBulletSpringCable& cable() const
+		{
+			return *m_pCable;
+		}
+
+		const btRigidBody& bodyA() const
+		{
+			return *m_pBodyA;
+		}
+
+		const btRigidBody& bodyB() const
+		{
+			return *m_pBodyB;
+		}
+
+		const tgBulletSpringCableSystem& system() const
+		{
+			return m_system;
+		}
+
+	private:
+		btRigidBody* makeBody(const btVector3& position, btScalar mass)
+		{
+			btVector3 inertia(0, 0, 0);
+			m_shape.calculateLocalInertia(mass, inertia);
+			btRigidBody::btRigidBodyConstructionInfo info(mass, NULL,
+														  &m_shape, inertia);
+			info.m_startWorldTransform.setIdentity();
+			info.m_startWorldTransform.setOrigin(position);
+			btRigidBody* const pBody = new btRigidBody(info);
+			pBody->setActivationState(DISABLE_DEACTIVATION);
+			m_world.addRigidBody(pBody);
+			return pBody;
+		}
+
+		btDefaultCollisionConfiguration m_collisionConfiguration;
+		btCollisionDispatcher m_dispatcher;
+		btDbvtBroadphase m_broadphase;
+		btSequentialImpulseConstraintSolver m_solver;
+		btDiscreteDynamicsWorld m_world;
+		btBoxShape m_shape;
+		btRigidBody* const m_pBodyA;
+		btRigidBody* const m_pBodyB;
+		tgBulletSpringCableSystem m_system;
+		tgBulletSpringCable* m_pCable;
+	};
+
+	void expectSameState(const CableRig& expected, const CableRig& actual,
+						 int step)
+	{
+		ASSERT_EQ(expected.cable().getTension(), actual.cable().getTension())
+			<< "step " << step;
+		ASSERT_EQ(expected.cable().getVelocity(), actual.cable().getVelocity())
+			<< "step " << step;
+		ASSERT_EQ(expected.cable().getDamping(), actual.cable().getDamping())
+			<< "step " << step;
+		ASSERT_EQ(expected.cable().getActualLength(),
+				  actual.cable().getActualLength()) << "step " << step;
+		ASSERT_TRUE(expected.bodyA().getLinearVelocity() ==
+					actual.bodyA().getLinearVelocity()) << "step " << step;
+		ASSERT_TRUE(expected.bodyA().getAngularVelocity() ==
+					actual.bodyA().getAngularVelocity()) << "step " << step;
+		ASSERT_TRUE(expected.bodyB().getLinearVelocity() ==
+					actual.bodyB().getLinearVelocity()) << "step " << step;
+		ASSERT_TRUE(expected.bodyB().getAngularVelocity() ==
+					actual.bodyB().getAngularVelocity()) << "step " << step;
+	}
+
+	TEST(tgBulletSpringCableSystemTest, MatchesPerCableForces)
+	{
+		CableRig perCable;
+		CableRig batched;
+		batched.useSystem();
+		ASSERT_EQ(1u, batched.system().size());
+
+		int slackSteps = 0;
+		int clampedSteps = 0;
+		for (int i = 0; i < steps; i++)
+		{
+			// The stretch the force law sees this step
+			const tgBulletSpringCable& cable = perCable.cable();
+			const double stretch = cable.getActualLength() - cable.getRestLength();
+			const double spring = 200.0 * stretch;
+
+			perCable.step();
+			batched.step();
+			expectSameState(perCable, batched, i);
+
+			if (stretch <= 0.0)
+			{
+				slackSteps++;
+			}
+			else if (cable.getDamping() == spring ||
+					 cable.getDamping() == -spring)
+			{
+				clampedSteps++;
+			}
+		}
+
+		// Every branch of the force law was taken
+		EXPECT_LT(0, slackSteps);
+		EXPECT_LT(0, clampedSteps);
+		EXPECT_LT(slackSteps + clampedSteps, steps);
+	}
+
+	TEST(tgBulletSpringCableSystemTest, LeavingTheSystemKeepsTheState)
+	{
+		CableRig perCable;
+		CableRig batched;
+		batched.useSystem();
+
+		for (int i = 0; i < steps; i++)
+		{
+			if (i == steps / 2)
+			{
+				batched.leaveSystem();
+				EXPECT_EQ(0u, batched.system().size());
+			}
+			perCable.step();
+			batched.step();
+			expectSameState(perCable, batched, i);
+		}
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
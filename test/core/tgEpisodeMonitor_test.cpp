@@ -0,0 +1,401 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgEpisodeMonitor_test.cpp
+* @brief Contains tests of when tgEpisodeMonitor checks its rules, and of
+* the rules it ships with on real rigid bodies
+* $Id$
+*/
+
+// This application
+#include "core/tgBaseRigid.h"
+#include "core/tgEpisodeMonitor.h"
+#include "core/tgModel.h"
+#include "core/tgTags.h"
+// The Bullet Physics library
+#include "BulletCollision/CollisionShapes/btBoxShape.h"
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+#include "LinearMath/btDefaultMotionState.h"
+#include "LinearMath/btQuaternion.h"
+#include "LinearMath/btTransform.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	// Fires once the episode has run for a given time
+	class TimeoutRule : public tgEpisodeMonitor::Rule
+	{
+	public:
+		TimeoutRule(double timeout, int& starts, int& checks) :
+			m_timeout(timeout),
+			m_starts(starts),
+			m_checks(checks)
+		{
+		}
+
+		virtual void onStart(const std::vector<tgBaseRigid*>& rigids)
+		{
+			m_starts++;
+		}
+
+		virtual tgEpisodeMonitor::Reason check(const std::vector<tgBaseRigid*>& rigids,
+											   double time)
+		{
+			m_checks++;
+			return time >= m_timeout ? tgEpisodeMonitor::eOther : tgEpisodeMonitor::eRunning;
+		}
+
+	private:
+		const double m_timeout;
+		int& m_starts;
+		int& m_checks;
+	};
+
+	TEST(tgEpisodeMonitorTest, ChecksAtItsIntervalUntilStopped) {
+		int starts = 0;
+		int checks = 0;
+		tgEpisodeMonitor monitor(0.1);
+		monitor.addRule(new TimeoutRule(0.5, starts, checks));
+		const std::vector<tgModel*> models;
+
+		// 1 ms steps, checked every 100 steps
+		int steps = 0;
+		while (!monitor.isStopped() && steps < 10000)
+		{
+			monitor.step(0.001, models);
+			steps++;
+		}
+
+		EXPECT_TRUE(monitor.isStopped());
+		EXPECT_EQ(tgEpisodeMonitor::eOther, monitor.getReason());
+		EXPECT_NEAR(0.5, monitor.getStopTime(), 0.1);
+		EXPECT_EQ(1, starts);
+		EXPECT_LE(checks, 6);
+		EXPECT_GE(checks, 5);
+
+		// Nothing more is checked once stopped
+		const int stoppedChecks = checks;
+		monitor.step(1.0, models);
+		EXPECT_EQ(stoppedChecks, checks);
+	}
+
+	TEST(tgEpisodeMonitorTest, ResetStartsANewEpisode) {
+		int starts = 0;
+		int checks = 0;
+		tgEpisodeMonitor monitor(0.1);
+		monitor.addRule(new TimeoutRule(0.25, starts, checks));
+		const std::vector<tgModel*> models;
+
+		for (int i = 0; i < 10; i++)
+		{
+			monitor.step(0.1, models);
+		}
+		EXPECT_TRUE(monitor.isStopped());
+
+		monitor.reset();
+		EXPECT_FALSE(monitor.isStopped());
+		EXPECT_EQ(tgEpisodeMonitor::eRunning, monitor.getReason());
+
+		monitor.step(0.1, models);
+		EXPECT_EQ(2, starts);
+		EXPECT_FALSE(monitor.isStopped());
+	}
+
+	TEST(tgEpisodeMonitorTest, RejectsBadArguments) {
+		EXPECT_THROW(tgEpisodeMonitor(0.0), std::invalid_argument);
+		tgEpisodeMonitor monitor;
+		EXPECT_THROW(monitor.addRule(NULL), std::invalid_argument);
+		EXPECT_THROW(tgEnergyRule(-1.0), std::invalid_argument);
+		EXPECT_THROW(tgHeightRule(2.0, 1.0), std::invalid_argument);
+		EXPECT_THROW(tgOrientationRule(0.0), std::invalid_argument);
+		EXPECT_THROW(tgProgressRule(1.0, 0.0), std::invalid_argument);
+		EXPECT_EQ("progress", tgEpisodeMonitor::reasonName(tgEpisodeMonitor::eProgress));
+	}
+
+	// A box, outside any world, whose state the tests set directly
+	class Body : public tgBaseRigid
+	{
+	public:
+		Body(double mass, const btVector3& position, const tgTags& tags = tgTags()) :
+			tgBaseRigid(makeBody(mass, position), tags),
+			m_pBody(m_pRigidBody)
+		{
+		}
+
+		virtual ~Body()
+		{
+			delete m_pBody->getMotionState();
+			delete m_pBody->getCollisionShape();
+			delete m_pBody;
+		}
+
+		btRigidBody& body()
+		{
+			return *m_pBody;
+		}
+
+		void moveTo(const btVector3& position)
+		{
+			btTransform transform = m_pBody->getWorldTransform();
+			transform.setOrigin(position);
+			setTransform(transform);
+		}
+
+		void rotateTo(const btQuaternion& rotation)
+		{
+			btTransform transform = m_pBody->getWorldTransform();
+			transform.setRotation(rotation);
+			setTransform(transform);
+		}
+
+	private:
+		static btRigidBody* makeBody(double mass, const btVector3& position)
+		{
+			btCollisionShape* const pShape = new btBoxShape(btVector3(1.0, 1.0, 1.0));
+			btVector3 inertia(0.0, 0.0, 0.0);
+			pShape->calculateLocalInertia(mass, inertia);
+			btTransform transform;
+			transform.setIdentity();
+			transform.setOrigin(position);
+			btDefaultMotionState* const pMotionState =
+				new btDefaultMotionState(transform);
+			const btRigidBody::btRigidBodyConstructionInfo info(mass, pMotionState,
+																pShape, inertia);
+			return new btRigidBody(info);
+		}
+
+		// centerOfMass reads the motion state
+		void setTransform(const btTransform& transform)
+		{
+			m_pBody->setWorldTransform(transform);
+			m_pBody->getMotionState()->setWorldTransform(transform);
+		}
+
+		/** Kept past teardown, which clears m_pRigidBody */
+		btRigidBody* const m_pBody;
+	};
+
+	// A monitor checking one rule at every 0.1 s step, over the bodies
+	// added to its model
+	class RuleTest : public ::testing::Test
+	{
+	protected:
+		RuleTest() :
+			m_monitor(0.1)
+		{
+			m_models.push_back(&m_model);
+		}
+
+		Body& addBody(double mass, const btVector3& position,
+					  const tgTags& tags = tgTags())
+		{
+			Body* const pBody = new Body(mass, position, tags);
+			m_model.addChild(pBody);
+			return *pBody;
+		}
+
+		/** @return true if still running after steps checks */
+		bool runFor(int steps)
+		{
+			for (int i = 0; i < steps; i++)
+			{
+				m_monitor.step(0.1, m_models);
+			}
+			return !m_monitor.isStopped();
+		}
+
+		tgModel m_model;
+		std::vector<tgModel*> m_models;
+		tgEpisodeMonitor m_monitor;
+	};
+
+	TEST_F(RuleTest, NotFiniteStopsOnANaNVelocity)
+	{
+		addBody(1.0, btVector3(0.0, 5.0, 0.0));
+		Body& body = addBody(1.0, btVector3(3.0, 5.0, 0.0));
+		m_monitor.addRule(new tgNotFiniteRule());
+
+		body.body().setLinearVelocity(btVector3(1.0, -2.0, 3.0));
+		body.body().setAngularVelocity(btVector3(0.0, 1e6, 0.0));
+		EXPECT_TRUE(runFor(3));
+
+		const double nan = std::numeric_limits<double>::quiet_NaN();
+		body.body().setLinearVelocity(btVector3(1.0, nan, 3.0));
+		EXPECT_FALSE(runFor(1));
+		EXPECT_EQ(tgEpisodeMonitor::eNotFinite, m_monitor.getReason());
+	}
+
+	TEST_F(RuleTest, NotFiniteStopsOnAnInfinitePosition)
+	{
+		Body& body = addBody(1.0, btVector3(0.0, 5.0, 0.0));
+		m_monitor.addRule(new tgNotFiniteRule());
+		EXPECT_TRUE(runFor(1));
+
+		body.moveTo(btVector3(std::numeric_limits<double>::infinity(), 5.0, 0.0));
+		EXPECT_FALSE(runFor(1));
+		EXPECT_EQ(tgEpisodeMonitor::eNotFinite, m_monitor.getReason());
+	}
+
+	TEST_F(RuleTest, EnergyStopsOnOverspeed)
+	{
+		// Half the mean squared speed: 0.5 * 8^2 = 32, under the limit,
+		// whatever the masses
+		Body& light = addBody(1.0, btVector3(0.0, 5.0, 0.0));
+		Body& heavy = addBody(3.0, btVector3(5.0, 5.0, 0.0));
+		m_monitor.addRule(new tgEnergyRule(50.0));
+		light.body().setLinearVelocity(btVector3(8.0, 0.0, 0.0));
+		heavy.body().setLinearVelocity(btVector3(0.0, 0.0, -8.0));
+		EXPECT_TRUE(runFor(3));
+
+		// 0.5 * (1 * 8^2 + 3 * 12^2) / 4 = 62
+		heavy.body().setLinearVelocity(btVector3(0.0, 0.0, -12.0));
+		EXPECT_FALSE(runFor(1));
+		EXPECT_EQ(tgEpisodeMonitor::eEnergy, m_monitor.getReason());
+	}
+
+	TEST_F(RuleTest, EnergyCountsSpin)
+	{
+		Body& body = addBody(2.0, btVector3(0.0, 5.0, 0.0));
+		m_monitor.addRule(new tgEnergyRule(50.0));
+		body.body().setLinearVelocity(btVector3(9.0, 0.0, 0.0));
+		EXPECT_TRUE(runFor(2));
+
+		// A 2 x 2 x 2 box has inertia 2/3 m per axis: 0.5 * 2/3 * 10^2
+		// is another 33 per unit of mass
+		body.body().setAngularVelocity(btVector3(0.0, 10.0, 0.0));
+		EXPECT_FALSE(runFor(1));
+		EXPECT_EQ(tgEpisodeMonitor::eEnergy, m_monitor.getReason());
+	}
+
+	TEST_F(RuleTest, HeightStopsBelowTheFloor)
+	{
+		Body& leg = addBody(1.0, btVector3(0.0, 10.0, 0.0), tgTags("leg"));
+		// Not selected, so its height does not count
+		addBody(5.0, btVector3(0.0, -50.0, 0.0));
+		m_monitor.addRule(new tgHeightRule(0.0, 100.0, tgTags("leg")));
+		EXPECT_TRUE(runFor(3));
+
+		leg.moveTo(btVector3(0.0, 0.5, 0.0));
+		EXPECT_TRUE(runFor(1));
+
+		leg.moveTo(btVector3(0.0, -0.5, 0.0));
+		EXPECT_FALSE(runFor(1));
+		EXPECT_EQ(tgEpisodeMonitor::eHeight, m_monitor.getReason());
+	}
+
+	TEST_F(RuleTest, HeightStopsAboveTheCeiling)
+	{
+		Body& body = addBody(1.0, btVector3(0.0, 10.0, 0.0));
+		addBody(1.0, btVector3(0.0, 20.0, 0.0));
+		m_monitor.addRule(new tgHeightRule(0.0, 100.0));
+		EXPECT_TRUE(runFor(2));
+
+		// Mean height 105
+		body.moveTo(btVector3(0.0, 190.0, 0.0));
+		EXPECT_FALSE(runFor(1));
+		EXPECT_EQ(tgEpisodeMonitor::eHeight, m_monitor.getReason());
+	}
+
+	TEST_F(RuleTest, OrientationStopsPastMaxTilt)
+	{
+		// Starts tilted, so only the tilt since the start counts
+		const btQuaternion start(btVector3(0.0, 0.0, 1.0), 1.0);
+		Body& body = addBody(1.0, btVector3(0.0, 5.0, 0.0));
+		body.rotateTo(start);
+		m_monitor.addRule(new tgOrientationRule(M_PI / 4.0));
+		EXPECT_TRUE(runFor(2));
+
+		// Turning about the vertical is not tipping
+		body.rotateTo(btQuaternion(btVector3(0.0, 1.0, 0.0), 2.0) * start);
+		EXPECT_TRUE(runFor(1));
+
+		body.rotateTo(btQuaternion(btVector3(1.0, 0.0, 0.0), M_PI / 6.0) * start);
+		EXPECT_TRUE(runFor(1));
+
+		body.rotateTo(btQuaternion(btVector3(1.0, 0.0, 0.0), M_PI / 3.0) * start);
+		EXPECT_FALSE(runFor(1));
+		EXPECT_EQ(tgEpisodeMonitor::eOrientation, m_monitor.getReason());
+	}
+
+	TEST_F(RuleTest, OrientationAveragesOverTheSelectedBodies)
+	{
+		Body& a = addBody(1.0, btVector3(0.0, 5.0, 0.0), tgTags("rod"));
+		Body& b = addBody(1.0, btVector3(2.0, 5.0, 0.0), tgTags("rod"));
+		Body& other = addBody(1.0, btVector3(4.0, 5.0, 0.0));
+		m_monitor.addRule(new tgOrientationRule(M_PI / 4.0, tgTags("rod")));
+
+		// Upside down, but not selected
+		other.rotateTo(btQuaternion(btVector3(1.0, 0.0, 0.0), M_PI));
+		// A mean of 3/8 pi
+		a.rotateTo(btQuaternion(btVector3(0.0, 0.0, 1.0), M_PI / 2.0));
+		b.rotateTo(btQuaternion(btVector3(0.0, 0.0, 1.0), M_PI / 4.0));
+		EXPECT_TRUE(runFor(1));
+	}
+
+	TEST_F(RuleTest, ProgressStopsBelowMinDistanceAtByTime)
+	{
+		Body& body = addBody(1.0, btVector3(0.0, 5.0, 0.0));
+		m_monitor.addRule(new tgProgressRule(10.0, 1.0));
+
+		// Not checked before byTime, however little has been covered
+		EXPECT_TRUE(runFor(9));
+
+		// Height does not count as progress
+		body.moveTo(btVector3(6.0, 500.0, -7.0));
+		EXPECT_FALSE(runFor(3));
+		EXPECT_EQ(tgEpisodeMonitor::eProgress, m_monitor.getReason());
+		EXPECT_NEAR(1.0, m_monitor.getStopTime(), 0.15);
+	}
+
+	TEST_F(RuleTest, ProgressChecksOncePerEpisode)
+	{
+		Body& body = addBody(1.0, btVector3(0.0, 5.0, 0.0));
+		m_monitor.addRule(new tgProgressRule(10.0, 1.0));
+
+		// The start is taken at the first step
+		EXPECT_TRUE(runFor(1));
+		body.moveTo(btVector3(6.0, 5.0, -9.0));
+		EXPECT_TRUE(runFor(11));
+
+		// Moving back after the checkpoint is allowed
+		body.moveTo(btVector3(0.0, 5.0, 0.0));
+		EXPECT_TRUE(runFor(10));
+
+		// A new episode starts where the body is now
+		m_monitor.reset();
+		body.moveTo(btVector3(0.0, 5.0, 0.0));
+		EXPECT_TRUE(runFor(1));
+		body.moveTo(btVector3(6.0, 5.0, 0.0));
+		EXPECT_FALSE(runFor(12));
+		EXPECT_EQ(tgEpisodeMonitor::eProgress, m_monitor.getReason());
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
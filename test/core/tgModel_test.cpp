@@ -0,0 +1,236 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgModel_test.cpp
+* @brief Contains tests of tgModel's cached find and its invalidation
+* $Id$
+*/
+
+// This application
+#include "core/tgModel.h"
+#include "core/tgTagSearch.h"
+#include "core/tgTags.h"
+// The C++ Standard Library
+#include <stdexcept>
+#include <string>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	// Two model types, so queries can differ by type alone
+	class Limb : public tgModel
+	{
+	public:
+		Limb(const std::string& tags) :
+			tgModel(tgTags(tags))
+		{
+		}
+	};
+
+	class Joint : public tgModel
+	{
+	public:
+		Joint(const std::string& tags) :
+			tgModel(tgTags(tags))
+		{
+		}
+	};
+
+	/*
+	 * root
+	 *   Limb "leg left"
+	 *     Joint "knee left"
+	 *       Limb "foot left"
+	 *   Limb "leg right"
+	 *     Joint "knee right"
+	 */
+	class tgModelTest : public ::testing::Test
+	{
+	protected:
+		tgModelTest() :
+			m_pLeftLeg(new Limb("leg left")),
+			m_pLeftKnee(new Joint("knee left")),
+			m_pLeftFoot(new Limb("foot left")),
+			m_pRightLeg(new Limb("leg right")),
+			m_pRightKnee(new Joint("knee right"))
+		{
+			m_pLeftKnee->addChild(m_pLeftFoot);
+			m_pLeftLeg->addChild(m_pLeftKnee);
+			m_pRightLeg->addChild(m_pRightKnee);
+			m_root.addChild(m_pLeftLeg);
+			m_root.addChild(m_pRightLeg);
+		}
+
+		/** Depth first, as getDescendants orders them */
+		std::vector<tgModel*> expectedDescendants() const
+		{
+			std::vector<tgModel*> result;
+			result.push_back(m_pLeftLeg);
+			result.push_back(m_pLeftKnee);
+			result.push_back(m_pLeftFoot);
+			result.push_back(m_pRightLeg);
+			result.push_back(m_pRightKnee);
+			return result;
+		}
+
+		tgModel m_root;
+		Limb* const m_pLeftLeg;
+		Joint* const m_pLeftKnee;
+		Limb* const m_pLeftFoot;
+		Limb* const m_pRightLeg;
+		Joint* const m_pRightKnee;
+	};
+
+	TEST_F(tgModelTest, FindMatchesTypeAndTags)
+	{
+		const std::vector<Limb*> left = m_root.find<Limb>("left");
+		ASSERT_EQ(2u, left.size());
+		EXPECT_EQ(m_pLeftLeg, left[0]);
+		EXPECT_EQ(m_pLeftFoot, left[1]);
+
+		const std::vector<Joint*> joints = m_root.find<Joint>("knee");
+		ASSERT_EQ(2u, joints.size());
+		EXPECT_EQ(m_pLeftKnee, joints[0]);
+		EXPECT_EQ(m_pRightKnee, joints[1]);
+
+		// Same search, other type
+		EXPECT_EQ(1u, m_root.find<Joint>("left").size());
+		EXPECT_EQ(5u, m_root.find<tgModel>("").size());
+		EXPECT_TRUE(m_root.find<Limb>("knee").empty());
+		EXPECT_TRUE(m_root.find<Limb>("arm").empty());
+
+		// Searches below the model only
+		const std::vector<Limb*> below = m_pLeftLeg->find<Limb>("left");
+		ASSERT_EQ(1u, below.size());
+		EXPECT_EQ(m_pLeftFoot, below[0]);
+	}
+
+	TEST_F(tgModelTest, RepeatedFindReturnsTheCachedResult)
+	{
+		const tgTagSearch search("left");
+		const std::vector<Limb*>& first = m_root.findCached<Limb>(search);
+		const std::vector<Limb*>& again = m_root.findCached<Limb>(search);
+		EXPECT_EQ(&first, &again);
+
+		// The same search compiled again has the same id
+		EXPECT_EQ(&first, &m_root.findCached<Limb>(tgTagSearch("left")));
+		// Another type is another entry
+		EXPECT_NE(static_cast<const void*>(&first),
+				  static_cast<const void*>(&m_root.findCached<Joint>(search)));
+
+		EXPECT_EQ(first, m_root.find<Limb>(search));
+		EXPECT_EQ(first, m_root.find<Limb>("left"));
+	}
+
+	TEST_F(tgModelTest, AddChildBelowInvalidatesEveryAncestor)
+	{
+		EXPECT_EQ(2u, m_root.find<Limb>("left").size());
+		EXPECT_EQ(1u, m_pLeftLeg->find<Limb>("left").size());
+		EXPECT_EQ(1u, m_pLeftKnee->find<Limb>("left").size());
+
+		// Two levels below the root, so only m_pParent links reach it
+		Limb* const pToe = new Limb("toe left");
+		m_pLeftFoot->addChild(pToe);
+
+		const std::vector<Limb*> left = m_root.find<Limb>("left");
+		ASSERT_EQ(3u, left.size());
+		EXPECT_EQ(pToe, left[2]);
+		EXPECT_EQ(2u, m_pLeftLeg->find<Limb>("left").size());
+		EXPECT_EQ(2u, m_pLeftKnee->find<Limb>("left").size());
+		// A sibling branch is unaffected
+		EXPECT_TRUE(m_pRightLeg->find<Limb>("left").empty());
+
+		std::vector<tgModel*> expected = expectedDescendants();
+		expected.insert(expected.begin() + 3, pToe);
+		EXPECT_EQ(expected, m_root.getDescendants());
+	}
+
+	TEST_F(tgModelTest, InvalidateIndexPicksUpChangedTags)
+	{
+		EXPECT_EQ(1u, m_root.find<Joint>("knee left").size());
+
+		m_pRightKnee->addTags("left");
+		// Documented: tags are not watched
+		EXPECT_EQ(1u, m_root.find<Joint>("knee left").size());
+
+		m_pRightKnee->invalidateIndex();
+		EXPECT_EQ(2u, m_root.find<Joint>("knee left").size());
+	}
+
+	TEST_F(tgModelTest, TeardownEmptiesTheIndex)
+	{
+		EXPECT_EQ(3u, m_root.find<Limb>("").size());
+		EXPECT_EQ(5u, m_root.getDescendants().size());
+
+		m_root.teardown();
+
+		EXPECT_TRUE(m_root.find<Limb>("").empty());
+		EXPECT_TRUE(m_root.find<Joint>("knee").empty());
+		EXPECT_TRUE(m_root.getDescendants().empty());
+	}
+
+	TEST_F(tgModelTest, TeardownBelowInvalidatesTheRoot)
+	{
+		EXPECT_EQ(2u, m_root.find<Limb>("left").size());
+
+		// Deletes the foot
+		m_pLeftKnee->teardown();
+
+		const std::vector<Limb*> left = m_root.find<Limb>("left");
+		ASSERT_EQ(1u, left.size());
+		EXPECT_EQ(m_pLeftLeg, left[0]);
+		EXPECT_EQ(4u, m_root.getDescendants().size());
+	}
+
+	TEST_F(tgModelTest, CachedDescendantsMatchTheWalk)
+	{
+		// No query yet, so this walks the tree
+		const std::vector<tgModel*> walked = m_root.getDescendants();
+		EXPECT_EQ(expectedDescendants(), walked);
+
+		// Now served from the index
+		m_root.find<tgModel>("");
+		EXPECT_EQ(walked, m_root.getDescendants());
+
+		const std::vector<tgModel*> legWalked = m_pLeftLeg->getDescendants();
+		m_pLeftLeg->find<tgModel>("");
+		EXPECT_EQ(legWalked, m_pLeftLeg->getDescendants());
+		ASSERT_EQ(2u, legWalked.size());
+		EXPECT_EQ(m_pLeftKnee, legWalked[0]);
+		EXPECT_EQ(m_pLeftFoot, legWalked[1]);
+	}
+
+	TEST_F(tgModelTest, RejectsBadChildren)
+	{
+		m_root.find<Limb>("");
+		EXPECT_THROW(m_root.addChild(NULL), std::invalid_argument);
+		EXPECT_THROW(m_root.addChild(&m_root), std::invalid_argument);
+		EXPECT_THROW(m_root.addChild(m_pLeftFoot), std::invalid_argument);
+		// Unchanged
+		EXPECT_EQ(expectedDescendants(), m_root.getDescendants());
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
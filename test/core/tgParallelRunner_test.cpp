@@ -0,0 +1,225 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgParallelRunner_test.cpp
+* @brief Contains tests that tgParallelRunner matches a serial run
+* $Id$
+*/
+
+// This application
+#include "core/tgBasicActuator.h"
+#include "core/tgCast.h"
+#include "core/tgModel.h"
+#include "core/tgParallelRunner.h"
+#include "core/tgRod.h"
+#include "core/tgSimulation.h"
+#include "tgcreator/tgBasicActuatorInfo.h"
+#include "tgcreator/tgBuildSpec.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgStructureInfo.h"
+// The Bullet Physics library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	// A three bar prism dropped onto the ground
+	class DropPrism : public tgModel
+	{
+	public:
+		DropPrism(double pretension) :
+			m_pretension(pretension)
+		{
+		}
+
+		virtual void setup(tgWorld& world)
+		{
+			tgStructure s;
+			s.addNode(-5, 0, 0);
+			s.addNode( 5, 0, 0);
+			s.addNode( 0, 0, 10);
+			s.addNode(-5, 20, 0);
+			s.addNode( 5, 20, 0);
+			s.addNode( 0, 20, 10);
+
+			s.addPair(0, 4, "rod");
+			s.addPair(1, 5, "rod");
+			s.addPair(2, 3, "rod");
+
+			s.addPair(0, 1, "muscle");
+			s.addPair(1, 2, "muscle");
+			s.addPair(2, 0, "muscle");
+			s.addPair(3, 4, "muscle");
+			s.addPair(4, 5, "muscle");
+			s.addPair(5, 3, "muscle");
+			s.addPair(0, 3, "muscle");
+			s.addPair(1, 4, "muscle");
+			s.addPair(2, 5, "muscle");
+
+			s.move(btVector3(0, 10, 0));
+
+			const tgRod::Config rodConfig(0.31, 0.2);
+			const tgSpringCableActuator::Config muscleConfig(1000.0, 10.0, m_pretension);
+			tgBuildSpec spec;
+			spec.addBuilder("rod", new tgRodInfo(rodConfig));
+			spec.addBuilder("muscle", new tgBasicActuatorInfo(muscleConfig));
+
+			tgStructureInfo structureInfo(s, spec);
+			structureInfo.buildInto(*this, world);
+
+			tgModel::setup(world);
+		}
+
+	private:
+		const double m_pretension;
+	};
+
+	// Scores the prism's rods by where they come to rest
+	class DropEpisode : public tgEpisode
+	{
+	public:
+		DropEpisode(double pretension) :
+			m_pretension(pretension),
+			m_pModel(NULL)
+		{
+		}
+
+		virtual void setup(tgSimulation& simulation)
+		{
+			m_pModel = new DropPrism(m_pretension);
+			simulation.addModel(m_pModel);
+		}
+
+		virtual double score(tgSimulation& simulation)
+		{
+			const std::vector<tgRod*> rods =
+				tgCast::filter<tgModel, tgRod>(m_pModel->getDescendants());
+			double result = 0.0;
+			for (std::size_t i = 0; i < rods.size(); i++)
+			{
+				const btVector3 com = rods[i]->centerOfMass();
+				result += com.x() + 10.0 * com.y() + 100.0 * com.z();
+			}
+			return result;
+		}
+
+	private:
+		const double m_pretension;
+		DropPrism* m_pModel;
+	};
+
+	// Fails during setup, after its model has been added
+	class ThrowingEpisode : public DropEpisode
+	{
+	public:
+		ThrowingEpisode() :
+			DropEpisode(500.0)
+		{
+		}
+
+		virtual void setup(tgSimulation& simulation)
+		{
+			DropEpisode::setup(simulation);
+			throw std::runtime_error("episode failed");
+		}
+	};
+
+	// The only solver the runner will use more than one thread with
+	const tgWorld::Config worldConfig(9.81, 1000,
+									  tgWorld::Config::SEQUENTIAL_IMPULSE);
+
+	std::vector<tgEpisode*> makeEpisodes()
+	{
+		std::vector<tgEpisode*> episodes;
+		for (int i = 0; i < 8; i++)
+		{
+			episodes.push_back(new DropEpisode(200.0 + 100.0 * i));
+		}
+		return episodes;
+	}
+
+	void deleteEpisodes(std::vector<tgEpisode*>& episodes)
+	{
+		for (std::size_t i = 0; i < episodes.size(); i++)
+		{
+			delete episodes[i];
+		}
+		episodes.clear();
+	}
+
+	TEST(tgParallelRunnerTest, ParallelMatchesSerial) {
+		std::vector<tgEpisode*> episodes = makeEpisodes();
+
+		tgParallelRunner serial(tgParallelRunner::Config(1500, 1, 0.001, worldConfig));
+		const std::vector<double> expected = serial.run(episodes);
+
+		tgParallelRunner parallel(tgParallelRunner::Config(1500, 4, 0.001, worldConfig));
+		const std::vector<double> actual = parallel.run(episodes);
+
+		ASSERT_EQ(episodes.size(), expected.size());
+		ASSERT_EQ(expected.size(), actual.size());
+		for (std::size_t i = 0; i < expected.size(); i++)
+		{
+			EXPECT_EQ(expected[i], actual[i]) << "episode " << i;
+		}
+		// Different pretensions, so the episodes really were distinct
+		EXPECT_NE(expected[0], expected[expected.size() - 1]);
+
+		// A runner can be reused, with the same results
+		EXPECT_EQ(actual, parallel.run(episodes));
+
+		deleteEpisodes(episodes);
+	}
+
+	TEST(tgParallelRunnerTest, OneThreadUnlessThreadSafe) {
+		tgParallelRunner runner(tgParallelRunner::Config(10, 4, 0.001, worldConfig));
+#ifdef BT_NO_PROFILE
+		EXPECT_EQ(4, runner.getThreadCount());
+#else
+		EXPECT_EQ(1, runner.getThreadCount());
+#endif
+
+		// The default world uses an MLCP solver
+		tgParallelRunner mlcpRunner(tgParallelRunner::Config(10, 4));
+		EXPECT_EQ(1, mlcpRunner.getThreadCount());
+	}
+
+	TEST(tgParallelRunnerTest, ThrowsWhenAnEpisodeThrows) {
+		std::vector<tgEpisode*> episodes = makeEpisodes();
+		std::vector<tgEpisode*> withFailure = episodes;
+		withFailure.insert(withFailure.begin() + 3, new ThrowingEpisode());
+
+		tgParallelRunner runner(tgParallelRunner::Config(100, 4, 0.001, worldConfig));
+		EXPECT_THROW(runner.run(withFailure), std::runtime_error);
+		delete withFailure[3];
+
+		deleteEpisodes(episodes);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
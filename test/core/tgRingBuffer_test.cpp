@@ -0,0 +1,94 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+
+/**
+* @file tgRingBuffer_test.cpp
+* @brief Contains tests of the fixed capacity and growable history buffers
+* $Id$
+*/
+
+// This application
+#include "core/tgRingBuffer.h"
+// The C++ Standard Library
+#include <algorithm>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	TEST(tgRingBufferTest, OverwritesOldestWhenFull) {
+		tgRingBufferBlock block(2, 3);
+		tgRingBuffer& a = block[0];
+
+		for (int i = 0; i < 5; i++)
+		{
+			a.push_back(i);
+		}
+
+		EXPECT_EQ(3u, a.size());
+		EXPECT_EQ(2.0, a.front());
+		EXPECT_EQ(4.0, a.back());
+		EXPECT_EQ(3.0, a[1]);
+		EXPECT_EQ(4.0, *std::max_element(a.begin(), a.end()));
+		EXPECT_TRUE(block[1].empty());
+	}
+
+	TEST(tgRingBufferTest, GrowableKeepsEverySample) {
+		tgRingBufferBlock block(2, 0);
+		const int n = 1000;
+
+		for (int i = 0; i < n; i++)
+		{
+			block[0].push_back(i);
+			block[1].push_back(-i);
+		}
+
+		ASSERT_EQ((std::size_t) n, block[0].size());
+		for (int i = 0; i < n; i++)
+		{
+			EXPECT_EQ((double) i, block[0][i]);
+			EXPECT_EQ((double) -i, block[1][i]);
+		}
+	}
+
+	TEST(tgRingBufferTest, CopyIsIndependent) {
+		tgRingBufferBlock block(1, 4);
+		block[0].push_back(1.0);
+
+		tgRingBufferBlock copy(block);
+		copy[0].push_back(2.0);
+
+		EXPECT_EQ(1u, block[0].size());
+		EXPECT_EQ(2u, copy[0].size());
+		EXPECT_EQ(2.0, copy[0].back());
+
+		block = copy;
+		EXPECT_EQ(2u, block[0].size());
+
+		block.clear();
+		EXPECT_TRUE(block[0].empty());
+		EXPECT_EQ(2u, copy[0].size());
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
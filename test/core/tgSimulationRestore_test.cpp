@@ -0,0 +1,287 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgSimulationRestore_test.cpp
+* @brief Contains tests that tgSimulation::restore matches a reset
+* $Id$
+*/
+
+// This application
+#include "core/tgBasicActuator.h"
+#include "core/tgCast.h"
+#include "core/tgControllable.h"
+#include "core/tgModel.h"
+#include "core/tgObserver.h"
+#include "core/tgRod.h"
+#include "core/tgSimulation.h"
+#include "core/tgSimView.h"
+#include "core/tgSubject.h"
+#include "core/tgWorld.h"
+#include "controllers/tgPIDController.h"
+#include "tgcreator/tgBasicActuatorInfo.h"
+#include "tgcreator/tgBuildSpec.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgStructureInfo.h"
+// The Bullet Physics library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <cmath>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	const double dt = 0.001;
+	const int steps = 2000;
+
+	// A three bar prism that reports to its controllers
+	class RestorePrism : public tgSubject<RestorePrism>, public tgModel
+	{
+	public:
+		virtual void setup(tgWorld& world)
+		{
+			tgStructure s;
+			s.addNode(-5, 0, 0);
+			s.addNode( 5, 0, 0);
+			s.addNode( 0, 0, 10);
+			s.addNode(-5, 20, 0);
+			s.addNode( 5, 20, 0);
+			s.addNode( 0, 20, 10);
+
+			s.addPair(0, 4, "rod");
+			s.addPair(1, 5, "rod");
+			s.addPair(2, 3, "rod");
+
+			s.addPair(0, 1, "muscle");
+			s.addPair(1, 2, "muscle");
+			s.addPair(2, 0, "muscle");
+			s.addPair(3, 4, "muscle");
+			s.addPair(4, 5, "muscle");
+			s.addPair(5, 3, "muscle");
+			s.addPair(0, 3, "muscle");
+			s.addPair(1, 4, "muscle");
+			s.addPair(2, 5, "muscle");
+
+			s.move(btVector3(0, 10, 0));
+
+			const tgRod::Config rodConfig(0.31, 0.2);
+			const tgSpringCableActuator::Config muscleConfig(1000.0, 10.0, 500.0);
+			tgBuildSpec spec;
+			spec.addBuilder("rod", new tgRodInfo(rodConfig));
+			spec.addBuilder("muscle", new tgBasicActuatorInfo(muscleConfig));
+
+			tgStructureInfo structureInfo(s, spec);
+			structureInfo.buildInto(*this, world);
+
+			notifySetup();
+			tgModel::setup(world);
+		}
+
+		virtual void step(double dt)
+		{
+			notifyStep(dt);
+			tgModel::step(dt);
+		}
+
+		virtual void teardown()
+		{
+			notifyTeardown();
+			tgModel::teardown();
+		}
+
+		std::vector<tgSpringCableActuator*> getMuscles() const
+		{
+			return tgCast::filter<tgModel, tgSpringCableActuator>(getDescendants());
+		}
+
+		std::vector<tgRod*> getRods() const
+		{
+			return tgCast::filter<tgModel, tgRod>(getDescendants());
+		}
+	};
+
+	// Holds a PID output until it is applied as a rest length offset
+	class OffsetInput : public tgControllable
+	{
+	public:
+		OffsetInput() :
+			m_input(0.0)
+		{
+		}
+
+		virtual void setControlInput(double input)
+		{
+			m_input = input;
+		}
+
+		double getInput() const
+		{
+			return m_input;
+		}
+
+	private:
+		double m_input;
+	};
+
+	// Tracks a moving target length with a PID loop per cable, so the
+	// trajectory depends on the error history and on the elapsed time
+	class PIDPrismController : public tgObserver<RestorePrism>
+	{
+	public:
+		PIDPrismController() :
+			m_time(0.0)
+		{
+		}
+
+		virtual ~PIDPrismController()
+		{
+			clear();
+		}
+
+		virtual void onSetup(RestorePrism& subject)
+		{
+			m_time = 0.0;
+			std::vector<tgSpringCableActuator*> muscles = subject.getMuscles();
+			for (std::size_t i = 0; i < muscles.size(); i++)
+			{
+				OffsetInput* const pOffset = new OffsetInput();
+				m_offsets.push_back(pOffset);
+				m_pids.push_back(new tgPIDController(pOffset,
+								tgPIDController::Config(0.5, 2.0, 0.01)));
+			}
+		}
+
+		virtual void onStep(RestorePrism& subject, double dt)
+		{
+			m_time += dt;
+			std::vector<tgSpringCableActuator*> muscles = subject.getMuscles();
+			for (std::size_t i = 0; i < muscles.size(); i++)
+			{
+				const double target = muscles[i]->getStartLength() *
+					(0.8 + 0.1 * std::sin(5.0 * m_time + i));
+				m_pids[i]->control(dt, target, muscles[i]->getCurrentLength());
+				const double restLength = muscles[i]->getStartLength() +
+					m_offsets[i]->getInput();
+				muscles[i]->setControlInput(std::max(0.1, restLength), dt);
+			}
+		}
+
+		virtual void onTeardown(RestorePrism& subject)
+		{
+			clear();
+		}
+
+		virtual void onRestore(RestorePrism& subject)
+		{
+			m_time = 0.0;
+			for (std::size_t i = 0; i < m_pids.size(); i++)
+			{
+				m_pids[i]->reset();
+			}
+		}
+
+	private:
+		void clear()
+		{
+			for (std::size_t i = 0; i < m_pids.size(); i++)
+			{
+				delete m_pids[i];
+				delete m_offsets[i];
+			}
+			m_pids.clear();
+			m_offsets.clear();
+		}
+
+		double m_time;
+		std::vector<OffsetInput*> m_offsets;
+		std::vector<tgPIDController*> m_pids;
+	};
+
+	// Rod positions and cable lengths after each step of an episode
+	std::vector<double> runEpisode(tgSimulation& simulation,
+								   const RestorePrism& prism)
+	{
+		std::vector<double> trace;
+		for (int i = 0; i < steps; i++)
+		{
+			simulation.step(dt);
+			const std::vector<tgRod*> rods = prism.getRods();
+			for (std::size_t j = 0; j < rods.size(); j++)
+			{
+				const btVector3 com = rods[j]->centerOfMass();
+				trace.push_back(com.x());
+				trace.push_back(com.y());
+				trace.push_back(com.z());
+			}
+			const std::vector<tgSpringCableActuator*> muscles = prism.getMuscles();
+			for (std::size_t j = 0; j < muscles.size(); j++)
+			{
+				trace.push_back(muscles[j]->getRestLength());
+				trace.push_back(muscles[j]->getTension());
+			}
+		}
+		return trace;
+	}
+
+	void expectSameTrace(const std::vector<double>& expected,
+						 const std::vector<double>& actual)
+	{
+		ASSERT_EQ(expected.size(), actual.size());
+		for (std::size_t i = 0; i < expected.size(); i++)
+		{
+			ASSERT_NEAR(expected[i], actual[i], 1e-9) << "at index " << i;
+		}
+	}
+
+	TEST(tgSimulationRestoreTest, RestoreThenStepsMatchesResetThenSteps) {
+		// Declared first, so it outlives the models it observes
+		PIDPrismController controller;
+
+		tgWorld world;
+		tgSimView view(world, dt);
+		tgSimulation simulation(view);
+
+		RestorePrism* const pPrism = new RestorePrism();
+		pPrism->attach(&controller);
+		simulation.addModel(pPrism);
+
+		const std::vector<double> first = runEpisode(simulation, *pPrism);
+
+		simulation.reset();
+		const std::vector<double> afterReset = runEpisode(simulation, *pPrism);
+		expectSameTrace(first, afterReset);
+
+		// Snapshot a rebuilt world, then dirty it before restoring
+		simulation.reset();
+		simulation.snapshot();
+		runEpisode(simulation, *pPrism);
+		simulation.restore();
+		const std::vector<double> afterRestore = runEpisode(simulation, *pPrism);
+		expectSameTrace(afterReset, afterRestore);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,186 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+
+/**
+* @file tgTagSearch_test.cpp
+* @brief Contains tests of interned tags and compiled tag searches
+* $Id$
+*/
+
+// This application
+#include "core/tgTags.h"
+#include "core/tgTagSearch.h"
+// The C++ Standard Library
+#include <sstream>
+#include <string>
+#include <vector>
+// POSIX
+#include <pthread.h>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	const int threadCount = 4;
+	const int threadTags = 5000;
+
+	// Interns the same new tags as every other thread, in its own order
+	struct Interner
+	{
+		pthread_barrier_t* pStart;
+		int offset;
+		std::vector<tgTagTable::Id> ids;
+	};
+
+	std::string threadTag(int i)
+	{
+		std::ostringstream tag;
+		tag << "threadTag" << i;
+		return tag.str();
+	}
+
+	void* internTags(void* pInterner)
+	{
+		Interner* const self = static_cast<Interner*>(pInterner);
+		self->ids.resize(threadTags);
+		pthread_barrier_wait(self->pStart);
+		for (int i = 0; i < threadTags; i++)
+		{
+			const int tag = (i + self->offset) % threadTags;
+			self->ids[tag] = tgTagTable::intern(threadTag(tag));
+		}
+		return NULL;
+	}
+	TEST(tgTagsTest, SetOperationsIgnoreOrder) {
+		tgTags tags("b a c");
+
+		EXPECT_TRUE(tags.contains("a c"));
+		EXPECT_TRUE(tags.contains(tgTags("c b")));
+		EXPECT_FALSE(tags.contains("a neverSeenTag"));
+		EXPECT_TRUE(tags.containsAny("x y b"));
+		EXPECT_FALSE(tags.containsAny("x y"));
+		EXPECT_TRUE(tags == tgTags("c a b"));
+
+		// The order tags were added is kept for printing
+		EXPECT_EQ("b", tags[0]);
+
+		tags.remove("a");
+		tags += tgTags("b d");
+		EXPECT_EQ(3, tags.size());
+		EXPECT_TRUE(tags == tgTags("b c d"));
+	}
+
+	TEST(tgTagSearchTest, PlainTermsAreRequired) {
+		tgTagSearch search("a b");
+
+		EXPECT_TRUE(search.matches(tgTags("a b c")));
+		EXPECT_FALSE(search.matches(tgTags("a c")));
+		EXPECT_TRUE(tgTagSearch("").matches(tgTags("a")));
+	}
+
+	TEST(tgTagSearchTest, OrAndNotTerms) {
+		tgTagSearch notB("a -b");
+		EXPECT_TRUE(notB.matches(tgTags("a c")));
+		EXPECT_FALSE(notB.matches(tgTags("a b")));
+
+		tgTagSearch bOrC("a b|c");
+		EXPECT_TRUE(bOrC.matches(tgTags("a b")));
+		EXPECT_TRUE(bOrC.matches(tgTags("a c")));
+		EXPECT_FALSE(bOrC.matches(tgTags("a d")));
+
+		tgTagSearch neither("-b|c");
+		EXPECT_TRUE(neither.matches(tgTags("a")));
+		EXPECT_FALSE(neither.matches(tgTags("a c")));
+	}
+
+	TEST(tgTagSearchTest, RemoveActsLikeAddingTags) {
+		tgTagSearch search("a b|c -d");
+		search.remove(tgTags("a c"));
+		EXPECT_TRUE(search.matches(tgTags("e")));
+		EXPECT_FALSE(search.matches(tgTags("d")));
+
+		search.remove(tgTags("d"));
+		EXPECT_FALSE(search.matches(tgTags("e")));
+	}
+
+	TEST(tgTagSearchTest, RejectsEmptyTerms) {
+		EXPECT_THROW(tgTagSearch("a -"), tgTagException);
+	}
+
+	TEST(tgTagSearchTest, EquivalentSearchesShareAnId) {
+		EXPECT_EQ(tgTagSearch("a b -c").getId(), tgTagSearch("b  a -c").getId());
+		EXPECT_NE(tgTagSearch("a b").getId(), tgTagSearch("a -b").getId());
+		EXPECT_NE(tgTagSearch("a b").getId(), tgTagSearch("a b|c").getId());
+
+		// A copy keeps the id, and remove() moves it
+		tgTagSearch search("a b");
+		const tgTagSearch copy(search);
+		EXPECT_EQ(search.getId(), copy.getId());
+		search.remove(tgTags("b"));
+		EXPECT_EQ(tgTagSearch("a").getId(), search.getId());
+		EXPECT_NE(copy.getId(), search.getId());
+
+		tgTagSearch unsatisfiable("a -b");
+		unsatisfiable.remove(tgTags("b"));
+		EXPECT_NE(tgTagSearch("a").getId(), unsatisfiable.getId());
+	}
+
+	TEST(tgTagTableTest, ThreadsAgreeOnNewIds) {
+		Interner interners[threadCount];
+		pthread_t threads[threadCount];
+		pthread_barrier_t start;
+		pthread_barrier_init(&start, NULL, threadCount);
+		for (int t = 0; t < threadCount; t++)
+		{
+			interners[t].pStart = &start;
+			interners[t].offset = t * threadTags / threadCount;
+			ASSERT_EQ(0, pthread_create(&threads[t], NULL, &internTags,
+										&interners[t]));
+		}
+		for (int t = 0; t < threadCount; t++)
+		{
+			pthread_join(threads[t], NULL);
+		}
+		pthread_barrier_destroy(&start);
+
+		// Every tag got exactly one id, whichever thread added it
+		std::vector<bool> seen;
+		for (int i = 0; i < threadTags; i++)
+		{
+			tgTagTable::Id id;
+			ASSERT_TRUE(tgTagTable::lookup(threadTag(i), id));
+			for (int t = 0; t < threadCount; t++)
+			{
+				ASSERT_EQ(id, interners[t].ids[i]) << "tag " << i;
+			}
+			if (seen.size() <= id)
+			{
+				seen.resize(id + 1, false);
+			}
+			EXPECT_FALSE(seen[id]) << "tag " << i;
+			seen[id] = true;
+		}
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,189 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file AnnealEvolution_test.cpp
+* @brief Contains tests that AnnealEvolution::nextGeneration matches the
+* serial nextSetOfControllers/updateScores loop
+* $Id$
+*/
+
+// This application
+#include "learning/AnnealEvolution/AnnealEvolution.h"
+// The C++ Standard Library
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+// POSIX
+#include <sys/stat.h>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	const char* const configFile = "AnnealEvolution_test.ini";
+	const char* const suffix = "AnnealEvolution_test";
+	const int numberOfControllers = 2;
+	const int generations = 3;
+
+	class AnnealEvolutionTest : public ::testing::Test
+	{
+	protected:
+		AnnealEvolutionTest()
+		{
+			// Scores and best parameters are always written to logs/
+			mkdir("logs", 0755);
+		}
+
+		virtual ~AnnealEvolutionTest()
+		{
+			std::remove(configFile);
+			std::remove("logs/scores.csv");
+			for (int i = 0; i < numberOfControllers; i++)
+			{
+				std::stringstream ss;
+				ss << "logs/bestParameters-" << suffix << "-" << i << ".nnw";
+				std::remove(ss.str().c_str());
+			}
+			// Only succeeds if the test created it
+			rmdir("logs");
+		}
+
+		void writeConfig(bool coevolution)
+		{
+			std::ofstream config(configFile);
+			config << "populationSize=6\n"
+				   << "numberOfElementsToMutate=3\n"
+				   << "numberOfTestsBetweenGenerations=5\n"
+				   << "numberOfSubtests=2\n"
+				   << "numberOfControllers=" << numberOfControllers << "\n"
+				   << "leniencyCoef=0.3\n"
+				   << "coevolution=" << coevolution << "\n"
+				   << "startSeed=0\n"
+				   << "learning=0\n"
+				   << "randomSeed=42\n"
+				   << "numberOfActions=4\n"
+				   << "deviation=0.2\n"
+				   << "MonteCarlo=0\n"
+				   << "compareAverageScores=0\n"
+				   << "clearScoresBetweenGenerations=0\n";
+		}
+	};
+
+	// A score that depends on every parameter of every member in the set,
+	// and on the episode, as subtests on different terrain would
+	std::vector<double> score(const std::vector<AnnealEvoMember*>& set,
+							  std::size_t episode)
+	{
+		std::vector<double> scores(2, 0.1 * episode);
+		for (std::size_t i = 0; i < set.size(); i++)
+		{
+			const std::vector<double>& params = set[i]->getParameters();
+			for (std::size_t j = 0; j < params.size(); j++)
+			{
+				scores[0] += (i + 1.0) * (j + 1.0) * params[j];
+				scores[1] += params[j] * params[j];
+			}
+		}
+		return scores;
+	}
+
+	void expectSameMembers(const std::vector<AnnealEvoMember*>& expected,
+						   const std::vector<AnnealEvoMember*>& actual)
+	{
+		ASSERT_EQ(expected.size(), actual.size());
+		for (std::size_t i = 0; i < expected.size(); i++)
+		{
+			EXPECT_EQ(expected[i]->getParameters(), actual[i]->getParameters());
+			EXPECT_EQ(expected[i]->pastScores, actual[i]->pastScores);
+			EXPECT_EQ(expected[i]->maxScore, actual[i]->maxScore);
+			EXPECT_EQ(expected[i]->maxScore1, actual[i]->maxScore1);
+			EXPECT_EQ(expected[i]->maxScore2, actual[i]->maxScore2);
+		}
+	}
+
+	// Runs both evolutions side by side, scoring the parallel one's sets
+	// in reverse order
+	void expectParallelMatchesSerial()
+	{
+		AnnealEvolution serial(suffix, configFile);
+		AnnealEvolution parallel(suffix, configFile);
+
+		for (int g = 0; g < generations; g++)
+		{
+			const std::vector< std::vector<AnnealEvoMember*> > sets =
+				parallel.nextGeneration();
+			ASSERT_FALSE(sets.empty());
+
+			std::vector< std::vector<AnnealEvoMember*> > serialSets;
+			for (std::size_t i = 0; i < sets.size(); i++)
+			{
+				serialSets.push_back(serial.nextSetOfControllers());
+				serial.updateScores(score(serialSets.back(), i));
+			}
+
+			for (std::size_t i = sets.size(); i > 0; i--)
+			{
+				parallel.updateScores(i - 1, score(sets[i - 1], i - 1));
+			}
+
+			for (std::size_t i = 0; i < sets.size(); i++)
+			{
+				expectSameMembers(serialSets[i], sets[i]);
+			}
+		}
+	}
+
+	TEST_F(AnnealEvolutionTest, ParallelMatchesSerial)
+	{
+		writeConfig(false);
+		expectParallelMatchesSerial();
+	}
+
+	TEST_F(AnnealEvolutionTest, ParallelMatchesSerialWithCoevolution)
+	{
+		writeConfig(true);
+		expectParallelMatchesSerial();
+	}
+
+	TEST_F(AnnealEvolutionTest, RejectsUnexpectedScores)
+	{
+		writeConfig(false);
+		AnnealEvolution evolution(suffix, configFile);
+		const std::vector< std::vector<AnnealEvoMember*> > sets =
+			evolution.nextGeneration();
+		ASSERT_LT(1u, sets.size());
+
+		EXPECT_THROW(evolution.updateScores(sets.size(), score(sets[0], 0)),
+					 std::invalid_argument);
+		evolution.updateScores(1, score(sets[1], 1));
+		EXPECT_THROW(evolution.updateScores(1, score(sets[1], 1)),
+					 std::invalid_argument);
+		// Set 0 is still unscored
+		EXPECT_THROW(evolution.nextGeneration(), std::runtime_error);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,117 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+* 
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+* 
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+
+/**
+* @file CMAES_test.cpp
+* @brief Contains tests of the CMA-ES optimizer
+* $Id$
+*/
+
+// This application
+#include "learning/CMAES/CMAES.h"
+// The C++ Standard Library
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	// Fitness is maximized, so these are negated costs
+	double sphere(const std::vector<double>& x)
+	{
+		double sum = 0.0;
+		for (std::size_t i = 0; i < x.size(); i++)
+		{
+			sum += (x[i] - 0.3) * (x[i] - 0.3);
+		}
+		return -sum;
+	}
+	
+	// Condition number 1e6, which needs the covariance to be learned
+	double ellipsoid(const std::vector<double>& x)
+	{
+		double sum = 0.0;
+		const double n = x.size();
+		for (std::size_t i = 0; i < x.size(); i++)
+		{
+			sum += std::pow(1e6, i / (n - 1.0)) * x[i] * x[i];
+		}
+		return -sum;
+	}
+	
+	// Runs until the best fitness of a generation exceeds target
+	std::size_t generationsToReach(CMAES& es, double (*f)(const std::vector<double>&),
+								   double target, std::size_t limit)
+	{
+		for (std::size_t g = 0; g < limit; g++)
+		{
+			const std::vector< std::vector<double> > candidates = es.ask();
+			std::vector<double> fitness;
+			double best = -HUGE_VAL;
+			for (std::size_t k = 0; k < candidates.size(); k++)
+			{
+				fitness.push_back(f(candidates[k]));
+				best = std::max(best, fitness.back());
+			}
+			es.tell(candidates, fitness);
+			if (best > target)
+			{
+				return g + 1;
+			}
+		}
+		return limit;
+	}
+
+	TEST(CMAESTest, SolvesSphere) {
+		CMAES es(std::vector<double>(20, 0.0), 0.5, 0, 1);
+		EXPECT_EQ(12, es.getLambda());
+		EXPECT_LT(generationsToReach(es, sphere, -1e-10, 1000), 1000);
+		for (std::size_t i = 0; i < es.getDimension(); i++)
+		{
+			EXPECT_NEAR(0.3, es.getMean()[i], 1e-4);
+		}
+	}
+	
+	TEST(CMAESTest, LearnsIllConditionedCovariance) {
+		CMAES es(std::vector<double>(10, 1.0), 1.0, 0, 2);
+		EXPECT_LT(generationsToReach(es, ellipsoid, -1e-8, 3000), 3000);
+		// The axes scale with the square root of the condition number
+		EXPECT_GT(es.getAxisRatio(), 100.0);
+	}
+	
+	TEST(CMAESTest, EnforcesAskTellOrder) {
+		CMAES es(std::vector<double>(3, 0.0), 1.0, 6, 3);
+		std::vector<double> fitness(6, 0.0);
+		EXPECT_THROW(es.tell(std::vector< std::vector<double> >(6, std::vector<double>(3)), fitness),
+					 std::logic_error);
+		const std::vector< std::vector<double> > candidates = es.ask();
+		EXPECT_THROW(es.ask(), std::logic_error);
+		EXPECT_THROW(es.tell(candidates, std::vector<double>(5)), std::invalid_argument);
+		es.tell(candidates, fitness);
+		EXPECT_EQ(1, es.getGeneration());
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,179 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+* 
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+* 
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+
+
+/**
+* @file FitnessCache_test.cpp
+* @brief Contains tests of the persistent fitness cache
+* $Id$
+*/
+
+// This application
+#include "learning/FitnessCache/FitnessCache.h"
+// The C++ Standard Library
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	const char* const cacheFile = "FitnessCache_test.cache";
+
+	class FitnessCacheTest : public ::testing::Test
+	{
+	protected:
+		FitnessCacheTest()
+		{
+			std::remove(cacheFile);
+			params.push_back(0.25);
+			params.push_back(-1.5);
+			params.push_back(3.0);
+			scores.push_back(12.5);
+			scores.push_back(0.1);
+		}
+
+		virtual ~FitnessCacheTest()
+		{
+			std::remove(cacheFile);
+		}
+
+		std::vector<double> params;
+		std::vector<double> scores;
+	};
+
+	TEST_F(FitnessCacheTest, StoresAndReloads)
+	{
+		{
+			FitnessCache cache(cacheFile, 7);
+			std::vector<double> found;
+			EXPECT_FALSE(cache.lookup(cache.key(params), found));
+			cache.store(cache.key(params), scores);
+			ASSERT_TRUE(cache.lookup(cache.key(params), found));
+			EXPECT_EQ(scores, found);
+			EXPECT_EQ(1u, cache.getHits());
+			EXPECT_EQ(1u, cache.getMisses());
+		}
+
+		FitnessCache reloaded(cacheFile, 7);
+		EXPECT_EQ(1u, reloaded.size());
+		std::vector<double> found;
+		ASSERT_TRUE(reloaded.lookup(reloaded.key(params), found));
+		// Scores are written exactly
+		EXPECT_EQ(scores, found);
+	}
+
+	TEST_F(FitnessCacheTest, IgnoresTruncatedLastLine)
+	{
+		{
+			FitnessCache cache(cacheFile, 0);
+			cache.store(cache.key(params), scores);
+		}
+		{
+			// As if the process died while writing an entry
+			std::ofstream file(cacheFile, std::ios::app);
+			file << "1234abcd 2 1.5";
+		}
+
+		FitnessCache reloaded(cacheFile, 0);
+		EXPECT_EQ(1u, reloaded.size());
+	}
+
+	TEST_F(FitnessCacheTest, ReloadsNonFiniteScores)
+	{
+		std::vector<double> diverged;
+		diverged.push_back(std::numeric_limits<double>::quiet_NaN());
+		diverged.push_back(std::numeric_limits<double>::infinity());
+		diverged.push_back(-std::numeric_limits<double>::infinity());
+		diverged.push_back(-0.0);
+		{
+			FitnessCache cache(cacheFile, 3);
+			cache.store(cache.key(params), diverged);
+			cache.store(cache.key(diverged), scores);
+		}
+
+		FitnessCache reloaded(cacheFile, 3);
+		EXPECT_EQ(2u, reloaded.size());
+		std::vector<double> found;
+		ASSERT_TRUE(reloaded.lookup(reloaded.key(params), found));
+		ASSERT_EQ(4u, found.size());
+		EXPECT_TRUE(found[0] != found[0]);
+		EXPECT_EQ(std::numeric_limits<double>::infinity(), found[1]);
+		EXPECT_EQ(-std::numeric_limits<double>::infinity(), found[2]);
+		EXPECT_EQ(0.0, found[3]);
+		EXPECT_GT(0.0, 1.0 / found[3]);
+
+		ASSERT_TRUE(reloaded.lookup(reloaded.key(diverged), found));
+		EXPECT_EQ(scores, found);
+	}
+
+	TEST_F(FitnessCacheTest, SkipsMalformedLines)
+	{
+		{
+			std::ofstream file(cacheFile);
+			file << "1 2 1.5 abc\n"
+				 << "2 2 1.5 2.5x\n"
+				 << "3 1 infinite\n"
+				 << "4 2 1.5 -inf\n";
+		}
+
+		FitnessCache cache(cacheFile, 0);
+		EXPECT_EQ(1u, cache.size());
+		std::vector<double> found;
+		ASSERT_TRUE(cache.lookup(4, found));
+		ASSERT_EQ(2u, found.size());
+		EXPECT_EQ(-std::numeric_limits<double>::infinity(), found[1]);
+	}
+
+	TEST_F(FitnessCacheTest, KeysDependOnContextAndParameters)
+	{
+		FitnessCache a("", 1);
+		FitnessCache b("", 2);
+		EXPECT_NE(a.key(params), b.key(params));
+		EXPECT_EQ(a.key(params), a.key(params));
+
+		std::vector<double> changed(params);
+		changed[2] += 1e-12;
+		EXPECT_NE(a.key(params), a.key(changed));
+
+		a.store(a.key(params), scores);
+		std::vector<double> found;
+		EXPECT_FALSE(a.lookup(a.key(changed), found));
+	}
+
+	TEST_F(FitnessCacheTest, HashesAreStable)
+	{
+		// FNV-1a of the empty input is its offset basis
+		EXPECT_EQ(FitnessCache::initialHash, FitnessCache::hashString(""));
+		EXPECT_EQ(0xaf63dc4c8601ec8cULL, FitnessCache::hashString("a"));
+		EXPECT_EQ(FitnessCache::hashParameters(params),
+				  FitnessCache::hashParameters(params));
+		EXPECT_EQ(FitnessCache::seedFor(FitnessCache::hashParameters(params)),
+				  FitnessCache::seedFor(FitnessCache::hashParameters(params)));
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
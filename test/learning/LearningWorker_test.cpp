@@ -0,0 +1,231 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file LearningWorker_test.cpp
+* @brief Contains tests of LearningWorker's side of the scheduler protocol
+* $Id$
+*/
+
+// This application
+#include "learning/Adapters/LearningWorker.h"
+// The C++ Standard Library
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+// POSIX
+#include <sys/socket.h>
+#include <unistd.h>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	// Plays the scheduler on one end of a socketpair. Replies are sent
+	// before the worker asks, so the socket buffer holds them and the
+	// test needs no second thread.
+	class LearningWorkerTest : public ::testing::Test
+	{
+	protected:
+		LearningWorkerTest() :
+			m_pWorker(NULL),
+			m_scheduler(-1)
+		{
+			int sockets[2];
+			if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0)
+			{
+				m_pWorker = new LearningWorker(sockets[0]);
+				m_scheduler = sockets[1];
+			}
+		}
+
+		virtual ~LearningWorkerTest()
+		{
+			delete m_pWorker;
+			closeScheduler();
+		}
+
+		virtual void SetUp()
+		{
+			ASSERT_TRUE(m_pWorker != NULL);
+		}
+
+		void reply(const std::string& data)
+		{
+			ASSERT_EQ(static_cast<ssize_t>(data.size()),
+					  write(m_scheduler, data.data(), data.size()));
+		}
+
+		/** The next line the worker sent, without the newline */
+		std::string received()
+		{
+			std::string line;
+			char c;
+			while (read(m_scheduler, &c, 1) == 1 && c != '\n')
+			{
+				line += c;
+			}
+			return line;
+		}
+
+		std::string request(const std::string& verb) const
+		{
+			std::ostringstream expected;
+			expected << verb << " " << getpid();
+			return expected.str();
+		}
+
+		void closeScheduler()
+		{
+			if (m_scheduler >= 0)
+			{
+				close(m_scheduler);
+				m_scheduler = -1;
+			}
+		}
+
+		LearningWorker* m_pWorker;
+		int m_scheduler;
+	};
+
+	TEST_F(LearningWorkerTest, NextJobParsesTheJob)
+	{
+		reply("job 17 60000 trials/Quad Params_3.json\n");
+		LearningWorker::Job job;
+		ASSERT_TRUE(m_pWorker->nextJob(job));
+		EXPECT_EQ(request("ready"), received());
+
+		EXPECT_EQ("17", job.id);
+		EXPECT_EQ(60000, job.steps);
+		// Everything after the steps, spaces included
+		EXPECT_EQ("trials/Quad Params_3.json", job.args);
+	}
+
+	TEST_F(LearningWorkerTest, FollowingJobReportsEachReply)
+	{
+		reply("job 1 10 a.json\nnone\nquit\n");
+		LearningWorker::Job job;
+		EXPECT_EQ(LearningWorker::JOB, m_pWorker->followingJob(job));
+		EXPECT_EQ("a.json", job.args);
+		EXPECT_EQ(LearningWorker::NO_JOB, m_pWorker->followingJob(job));
+		EXPECT_EQ(LearningWorker::QUIT, m_pWorker->followingJob(job));
+		for (int i = 0; i < 3; i++)
+		{
+			EXPECT_EQ(request("next"), received());
+		}
+	}
+
+	TEST_F(LearningWorkerTest, NextJobStopsOnQuitOrClose)
+	{
+		reply("quit\n");
+		LearningWorker::Job job;
+		EXPECT_FALSE(m_pWorker->nextJob(job));
+
+		// Shut down only the scheduler's sending side, so the request
+		// can still be written
+		shutdown(m_scheduler, SHUT_WR);
+		EXPECT_FALSE(m_pWorker->nextJob(job));
+		LearningWorker::Job following;
+		EXPECT_EQ(LearningWorker::QUIT, m_pWorker->followingJob(following));
+	}
+
+	TEST_F(LearningWorkerTest, NextJobRejectsNone)
+	{
+		// Only a following job may be refused
+		reply("none\n");
+		LearningWorker::Job job;
+		EXPECT_THROW(m_pWorker->nextJob(job), std::runtime_error);
+	}
+
+	TEST_F(LearningWorkerTest, RejectsMalformedLines)
+	{
+		const char* const malformed[] =
+		{
+			"",
+			"hello",
+			"job",
+			"job 3",
+			"job 3 100",
+			"job 3 100   ",
+			"job 3 ten a.json",
+			"job 3 0 a.json",
+			"job 3 -100 a.json",
+			"jobs 3 100 a.json",
+			"JOB 3 100 a.json",
+			"quit now"
+		};
+		const std::size_t n = sizeof(malformed) / sizeof(malformed[0]);
+		for (std::size_t i = 0; i < n; i++)
+		{
+			reply(std::string(malformed[i]) + "\n");
+			LearningWorker::Job job;
+			EXPECT_THROW(m_pWorker->followingJob(job), std::runtime_error)
+				<< "\"" << malformed[i] << "\"";
+		}
+
+		// The bad lines were consumed; the connection still works
+		reply("job 4 100 b.json\n");
+		LearningWorker::Job job;
+		ASSERT_TRUE(m_pWorker->nextJob(job));
+		EXPECT_EQ("4", job.id);
+		EXPECT_EQ("b.json", job.args);
+	}
+
+	TEST_F(LearningWorkerTest, ReportsScoresAndErrors)
+	{
+		LearningWorker::Job job;
+		job.id = "9";
+		std::vector<double> scores;
+		scores.push_back(0.1);
+		scores.push_back(-2.0);
+		m_pWorker->reportScores(job, scores);
+		// Every digit, so the scheduler gets the exact score
+		EXPECT_EQ("done 9 0.10000000000000001 -2", received());
+
+		m_pWorker->reportScores(job, std::vector<double>());
+		EXPECT_EQ("done 9", received());
+
+		m_pWorker->reportError(job, "Bad filename\nfor JSON");
+		EXPECT_EQ("error 9 Bad filename for JSON", received());
+	}
+
+	TEST_F(LearningWorkerTest, LostSchedulerThrows)
+	{
+		closeScheduler();
+		LearningWorker::Job job;
+		job.id = "1";
+		// An exception, not SIGPIPE
+		EXPECT_THROW(m_pWorker->reportScores(job, std::vector<double>(1, 1.0)),
+					 std::runtime_error);
+	}
+
+	TEST(LearningWorkerConnectTest, RejectsBadEndpoints)
+	{
+		EXPECT_THROW(LearningWorker(-1), std::invalid_argument);
+		EXPECT_THROW(LearningWorker(std::string(200, 'x')), std::invalid_argument);
+		EXPECT_THROW(LearningWorker("/nonexistent/LearningWorker_test.sock"),
+					 std::runtime_error);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
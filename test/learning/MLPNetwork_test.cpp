@@ -0,0 +1,145 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+* 
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+* 
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file MLPNetwork_test.cpp
+* @brief Contains tests of batched inference in MLPNetwork
+* $Id$
+*/
+
+// This application
+#include "learning/MLP/MLPNetwork.h"
+// The C++ Standard Library
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	double sigmoid(double x)
+	{
+		return 1.0 / (1.0 + std::exp(-x));
+	}
+	
+	// One pattern at a time, as neuralNetwork::feedForwardPattern does
+	std::vector<double> reference(const std::vector<double>& w,
+								  int nIn, int nHid, int nOut,
+								  const double* pattern)
+	{
+		std::vector<double> in(pattern, pattern + nIn);
+		in.push_back(-1.0);
+		std::vector<double> hid(nHid + 1, -1.0);
+		for (int j = 0; j < nHid; j++)
+		{
+			hid[j] = 0.0;
+			for (int i = 0; i <= nIn; i++)
+			{
+				hid[j] += in[i] * w[i * nHid + j];
+			}
+			hid[j] = sigmoid(hid[j]);
+		}
+		const double* w2 = &w[(nIn + 1) * nHid];
+		std::vector<double> out(nOut, 0.0);
+		for (int k = 0; k < nOut; k++)
+		{
+			for (int j = 0; j <= nHid; j++)
+			{
+				out[k] += hid[j] * w2[j * nOut + k];
+			}
+			out[k] = sigmoid(out[k]);
+		}
+		return out;
+	}
+	
+	std::vector<double> someValues(std::size_t n, double scale)
+	{
+		std::vector<double> values(n);
+		for (std::size_t i = 0; i < n; i++)
+		{
+			values[i] = scale * std::sin(1.7 * i + 0.3);
+		}
+		return values;
+	}
+
+	TEST(MLPNetworkTest, BatchMatchesSinglePatterns) {
+		// Odd sizes exercise the remainders of the blocked kernel
+		const int sizes[][3] = { {2, 4, 3}, {3, 6, 5}, {5, 9, 1}, {1, 1, 8} };
+		for (std::size_t s = 0; s < 4; s++)
+		{
+			const int nIn = sizes[s][0];
+			const int nHid = sizes[s][1];
+			const int nOut = sizes[s][2];
+			MLPNetwork nn(nIn, nHid, nOut);
+			const std::vector<double> weights = someValues(nn.getNumWeights(), 2.0);
+			nn.setWeights(weights);
+			
+			const std::size_t batch = 7;
+			const std::vector<double> inputs = someValues(batch * nIn, 1.0);
+			std::vector<double> outputs;
+			nn.feedForward(inputs, outputs);
+			ASSERT_EQ(batch * nOut, outputs.size());
+			
+			for (std::size_t b = 0; b < batch; b++)
+			{
+				const std::vector<double> expected =
+					reference(weights, nIn, nHid, nOut, &inputs[b * nIn]);
+				for (int k = 0; k < nOut; k++)
+				{
+					EXPECT_EQ(expected[k], outputs[b * nOut + k]);
+				}
+			}
+		}
+	}
+	
+	TEST(MLPNetworkTest, LoadsNnwFiles) {
+		MLPNetwork nn(2, 2, 1);
+		const char* filename = "MLPNetwork_test.nnw";
+		{
+			std::ofstream file(filename);
+			file << "0.5,-1,2,0.25,0,1.5,\n-2,3,0.125";
+		}
+		nn.loadWeights(filename);
+		const std::vector<double> weights = nn.getWeights();
+		ASSERT_EQ(9, weights.size());
+		EXPECT_EQ(0.25, weights[3]);
+		EXPECT_EQ(0.125, weights[8]);
+		
+		MLPNetwork tooBig(3, 2, 1);
+		EXPECT_THROW(tooBig.loadWeights(filename), std::runtime_error);
+		EXPECT_THROW(nn.loadWeights("no_such_file.nnw"), std::runtime_error);
+		std::remove(filename);
+	}
+	
+	TEST(MLPNetworkTest, RejectsPartialPatterns) {
+		MLPNetwork nn(2, 3, 1);
+		std::vector<double> outputs;
+		EXPECT_THROW(nn.feedForward(std::vector<double>(3), outputs), std::invalid_argument);
+		nn.feedForward(std::vector<double>(), outputs);
+		EXPECT_TRUE(outputs.empty());
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,205 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgDataManagerAsync_test.cpp
+* @brief Contains tests of tgDataManager's asynchronous writer mode
+* $Id$
+*/
+
+// This application
+#include "sensors/tgDataManager.h"
+// The C++ Standard Library
+#include <vector>
+// POSIX
+#include <pthread.h>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	// Records the first value of every row. The writer can be held inside
+	// writeRow, so the queue fills up on demand.
+	class RecordingManager : public tgDataManager
+	{
+	public:
+		RecordingManager() :
+			m_held(false),
+			m_writerThread(pthread_self())
+		{
+			pthread_mutex_init(&m_mutex, NULL);
+			pthread_cond_init(&m_released, NULL);
+		}
+
+		virtual ~RecordingManager()
+		{
+			release();
+			stopWriter();
+			pthread_cond_destroy(&m_released);
+			pthread_mutex_destroy(&m_mutex);
+		}
+
+		void start(std::size_t rowWidth)
+		{
+			startWriter(rowWidth);
+		}
+
+		void submit(double value)
+		{
+			const double row[2] = { value, -value };
+			submitRow(row);
+		}
+
+		void hold()
+		{
+			pthread_mutex_lock(&m_mutex);
+			m_held = true;
+			pthread_mutex_unlock(&m_mutex);
+		}
+
+		void release()
+		{
+			pthread_mutex_lock(&m_mutex);
+			m_held = false;
+			pthread_cond_broadcast(&m_released);
+			pthread_mutex_unlock(&m_mutex);
+		}
+
+		/** Only read once the writer has stopped */
+		const std::vector<double>& written() const
+		{
+			return m_written;
+		}
+
+		bool wroteOnThisThread() const
+		{
+			return pthread_equal(m_writerThread, pthread_self()) != 0;
+		}
+
+	protected:
+		virtual void writeRow(const double* pRow)
+		{
+			pthread_mutex_lock(&m_mutex);
+			while (m_held)
+			{
+				pthread_cond_wait(&m_released, &m_mutex);
+			}
+			pthread_mutex_unlock(&m_mutex);
+
+			m_written.push_back(pRow[0]);
+			m_writerThread = pthread_self();
+		}
+
+	private:
+		pthread_mutex_t m_mutex;
+		pthread_cond_t m_released;
+		bool m_held;
+		std::vector<double> m_written;
+		pthread_t m_writerThread;
+	};
+
+	TEST(tgDataManagerAsyncTest, WritesOnTheCallerWhenNotEnabled)
+	{
+		RecordingManager manager;
+		manager.start(2);
+		EXPECT_FALSE(manager.isAsyncRunning());
+
+		manager.submit(1.0);
+		manager.submit(2.0);
+		ASSERT_EQ(2u, manager.written().size());
+		EXPECT_EQ(2.0, manager.written()[1]);
+		EXPECT_TRUE(manager.wroteOnThisThread());
+	}
+
+	TEST(tgDataManagerAsyncTest, DropCountsDiscardedRowsAndHighWater)
+	{
+		RecordingManager manager;
+		manager.enableAsync(4, tgDataManager::DROP);
+		manager.hold();
+		manager.start(2);
+		ASSERT_TRUE(manager.isAsyncRunning());
+
+		// The held writer pops nothing, so exactly 4 rows fit
+		for (int i = 0; i < 10; i++)
+		{
+			manager.submit(i);
+		}
+		EXPECT_EQ(6u, manager.getDroppedSamples());
+		EXPECT_EQ(4u, manager.getQueueHighWater());
+
+		manager.release();
+		manager.teardown();
+		EXPECT_FALSE(manager.isAsyncRunning());
+
+		const double expected[] = { 0.0, 1.0, 2.0, 3.0 };
+		EXPECT_EQ(std::vector<double>(expected, expected + 4), manager.written());
+		EXPECT_FALSE(manager.wroteOnThisThread());
+
+		// Counters start again with the next writer
+		manager.start(2);
+		EXPECT_EQ(0u, manager.getDroppedSamples());
+		EXPECT_EQ(0u, manager.getQueueHighWater());
+	}
+
+	TEST(tgDataManagerAsyncTest, TeardownWritesEveryQueuedRow)
+	{
+		RecordingManager manager;
+		manager.enableAsync(3, tgDataManager::BLOCK);
+		manager.start(2);
+
+		// Blocks whenever the writer falls 3 rows behind
+		const int n = 2000;
+		for (int i = 0; i < n; i++)
+		{
+			manager.submit(i);
+		}
+		manager.teardown();
+
+		EXPECT_EQ(0u, manager.getDroppedSamples());
+		EXPECT_GE(3u, manager.getQueueHighWater());
+		EXPECT_LT(0u, manager.getQueueHighWater());
+		ASSERT_EQ(static_cast<std::size_t>(n), manager.written().size());
+		for (int i = 0; i < n; i++)
+		{
+			ASSERT_EQ(i, manager.written()[i]);
+		}
+	}
+
+	TEST(tgDataManagerAsyncTest, TeardownWritesRowsQueuedBehindAHeldWriter)
+	{
+		RecordingManager manager;
+		manager.enableAsync(8, tgDataManager::BLOCK);
+		manager.hold();
+		manager.start(2);
+		for (int i = 0; i < 5; i++)
+		{
+			manager.submit(i);
+		}
+
+		// Everything was queued while the writer was held
+		manager.release();
+		manager.teardown();
+		EXPECT_EQ(5u, manager.written().size());
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,194 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgRowQueue_test.cpp
+* @brief Contains tests of the single producer, single consumer row queue
+* $Id$
+*/
+
+// This application
+#include "sensors/tgRowQueue.h"
+// The C++ Standard Library
+#include <stdexcept>
+#include <vector>
+// POSIX
+#include <pthread.h>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	const std::size_t width = 3;
+
+	void makeRow(double value, double* pRow)
+	{
+		for (std::size_t i = 0; i < width; i++)
+		{
+			pRow[i] = value + 0.25 * i;
+		}
+	}
+
+	// Reads rows as tgDataManager's writer thread does
+	struct Consumer
+	{
+		tgRowQueue* pQueue;
+		std::vector<double> rows;
+	};
+
+	void* consume(void* pConsumer)
+	{
+		Consumer* const self = static_cast<Consumer*>(pConsumer);
+		while (true)
+		{
+			self->pQueue->waitForRow();
+			const double* pRow = self->pQueue->front();
+			if (pRow == NULL)
+			{
+				break;
+			}
+			self->rows.insert(self->rows.end(), pRow, pRow + width);
+			self->pQueue->pop();
+		}
+		return NULL;
+	}
+
+	TEST(tgRowQueueTest, KeepsOrderAcrossWraparound)
+	{
+		tgRowQueue queue(3, width);
+		EXPECT_EQ(3u, queue.capacity());
+		EXPECT_EQ(width, queue.width());
+		EXPECT_TRUE(queue.front() == NULL);
+
+		double row[width];
+		double next = 0.0;
+		double expected = 0.0;
+		// Uneven batches, so the head and tail pass the end of the
+		// storage at different points
+		for (int round = 0; round < 20; round++)
+		{
+			const std::size_t pushes = 1 + round % 3;
+			for (std::size_t i = 0; i < pushes; i++)
+			{
+				makeRow(next, row);
+				if (queue.tryPush(row))
+				{
+					next += 1.0;
+				}
+				else
+				{
+					EXPECT_EQ(3u, queue.size());
+				}
+			}
+
+			const std::size_t pops = 1 + (round + 1) % 2;
+			for (std::size_t i = 0; i < pops && queue.front() != NULL; i++)
+			{
+				const double* pRow = queue.front();
+				for (std::size_t j = 0; j < width; j++)
+				{
+					ASSERT_EQ(expected + 0.25 * j, pRow[j]) << "round " << round;
+				}
+				queue.pop();
+				expected += 1.0;
+			}
+			EXPECT_EQ(next - expected, queue.size());
+		}
+		EXPECT_LT(10.0, next);
+	}
+
+	TEST(tgRowQueueTest, RefusesRowsWhenFull)
+	{
+		tgRowQueue queue(2, width);
+		double row[width];
+		makeRow(1.0, row);
+		EXPECT_TRUE(queue.tryPush(row));
+		EXPECT_TRUE(queue.tryPush(row));
+		EXPECT_FALSE(queue.tryPush(row));
+		EXPECT_EQ(2u, queue.size());
+
+		queue.pop();
+		EXPECT_TRUE(queue.tryPush(row));
+	}
+
+	TEST(tgRowQueueTest, ConsumerDrainsEveryRowAfterClose)
+	{
+		// Far more rows than slots, so both threads sleep on each other
+		tgRowQueue queue(2, width);
+		Consumer consumer;
+		consumer.pQueue = &queue;
+		pthread_t thread;
+		ASSERT_EQ(0, pthread_create(&thread, NULL, &consume, &consumer));
+
+		const int n = 5000;
+		double row[width];
+		for (int i = 0; i < n; i++)
+		{
+			makeRow(i, row);
+			while (!queue.tryPush(row))
+			{
+				queue.waitForSpace();
+			}
+		}
+		queue.close();
+		EXPECT_TRUE(queue.isClosed());
+		pthread_join(thread, NULL);
+
+		ASSERT_EQ(n * width, consumer.rows.size());
+		for (int i = 0; i < n; i++)
+		{
+			makeRow(i, row);
+			for (std::size_t j = 0; j < width; j++)
+			{
+				ASSERT_EQ(row[j], consumer.rows[i * width + j]) << "row " << i;
+			}
+		}
+		EXPECT_EQ(0u, queue.size());
+	}
+
+	TEST(tgRowQueueTest, ClosedQueueStillHandsOutQueuedRows)
+	{
+		tgRowQueue queue(4, width);
+		double row[width];
+		makeRow(7.0, row);
+		queue.tryPush(row);
+		queue.close();
+
+		// Returns at once: there is a row
+		queue.waitForRow();
+		ASSERT_TRUE(queue.front() != NULL);
+		EXPECT_EQ(7.0, queue.front()[0]);
+		queue.pop();
+
+		// Returns at once: closed and empty
+		queue.waitForRow();
+		EXPECT_TRUE(queue.front() == NULL);
+	}
+
+	TEST(tgRowQueueTest, RejectsEmptyShapes)
+	{
+		EXPECT_THROW(tgRowQueue(0, width), std::invalid_argument);
+		EXPECT_THROW(tgRowQueue(4, 0), std::invalid_argument);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,135 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+* 
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+* 
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgRigidNodeIndex_test.cpp
+* @brief Contains a test of the node index used to bind connectors to rigids
+* $Id$
+*/
+
+// This application
+#include "tgcreator/tgRigidNodeIndex.h"
+#include "tgcreator/tgBoxMoreAnchorsInfo.h"
+#include "tgcreator/tgNode.h"
+#include "tgcreator/tgPair.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgSphereInfo.h"
+// The Bullet Physics Library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <set>
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	std::set<tgRigidInfo*> scan(const std::vector<tgRigidInfo*>& rigids,
+								const btVector3& node)
+	{
+		std::set<tgRigidInfo*> found;
+		for (std::size_t i = 0; i < rigids.size(); i++)
+		{
+			if (rigids[i]->containsNode(node))
+			{
+				found.insert(rigids[i]);
+			}
+		}
+		return found;
+	}
+
+	class tgRigidNodeIndexTest : public ::testing::Test
+	{
+	protected:
+		tgRigidNodeIndexTest()
+		{
+			const tgRod::Config rodConfig;
+			// A grid of rods meeting at their ends, some ends on cell
+			// boundaries and some not
+			for (int i = 0; i < 6; i++)
+			{
+				for (int j = 0; j < 6; j++)
+				{
+					const btVector3 a(i * 0.5, j * 0.7, 0.0);
+					const btVector3 b((i + 1) * 0.5, j * 0.7, 0.0);
+					const btVector3 c(i * 0.5, (j + 1) * 0.7, 0.0);
+					rigids.push_back(new tgRodInfo(rodConfig, tgPair(a, b)));
+					rigids.push_back(new tgRodInfo(rodConfig, tgPair(a, c)));
+					nodes.push_back(a);
+				}
+			}
+			const tgSphere::Config sphereConfig;
+			rigids.push_back(new tgSphereInfo(sphereConfig,
+											  tgNode(btVector3(-3.0, 1.0, 2.0))));
+			nodes.push_back(btVector3(-3.0, 1.0, 2.0));
+			// Contains the points on its surface, not just its ends
+			const tgBox::Config boxConfig;
+			rigids.push_back(new tgBoxMoreAnchorsInfo(boxConfig,
+				tgPair(btVector3(10.0, 0.0, 0.0), btVector3(10.0, 0.0, 5.0))));
+			nodes.push_back(btVector3(10.0, 0.0, 2.5));
+			// Matches nothing
+			nodes.push_back(btVector3(0.25, 0.35, 0.0));
+		}
+
+		virtual ~tgRigidNodeIndexTest()
+		{
+			for (std::size_t i = 0; i < rigids.size(); i++)
+			{
+				delete rigids[i];
+			}
+		}
+
+		std::vector<tgRigidInfo*> rigids;
+		std::vector<btVector3> nodes;
+	};
+
+	TEST_F(tgRigidNodeIndexTest, MatchesScan)
+	{
+		const double cellSizes[] = {0.1, 0.5, 1.0, 100.0};
+		for (int k = 0; k < 4; k++)
+		{
+			const tgRigidNodeIndex index(rigids, cellSizes[k]);
+			for (std::size_t i = 0; i < nodes.size(); i++)
+			{
+				EXPECT_EQ(scan(rigids, nodes[i]),
+						  index.findRigidsContaining(nodes[i]));
+			}
+		}
+	}
+
+	TEST_F(tgRigidNodeIndexTest, FindsSharedNodes)
+	{
+		const tgRigidNodeIndex index(rigids);
+		// An interior grid node is the end of four rods
+		EXPECT_EQ(4u, index.findRigidsContaining(btVector3(1.0, 1.4, 0.0)).size());
+		EXPECT_EQ(1u, index.findRigidsContaining(btVector3(10.0, 0.0, 2.5)).size());
+		EXPECT_TRUE(index.findRigidsContaining(btVector3(0.25, 0.35, 0.0)).empty());
+	}
+
+	TEST_F(tgRigidNodeIndexTest, RejectsBadCellSize)
+	{
+		EXPECT_THROW(tgRigidNodeIndex(rigids, 0.0), std::invalid_argument);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
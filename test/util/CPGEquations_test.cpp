@@ -25,6 +25,8 @@
 
 // This application
 #include "util/CPGEquations.h"
+#include "util/CPGEquationsFB.h"
+#include "util/CPGFixedStepIntegrator.h"
 #include "util/CPGNode.h"
 // The Bullet Physics Library
 #include "LinearMath/btVector3.h"
@@ -137,6 +139,50 @@ namespace {
                 
                 return m_pCPGSystem;
             }
+            
+            CPGEquationsFB* getCPGFBSystem(int numNodes)
+            {
+                CPGEquationsFB* m_pCPGSystem = new CPGEquationsFB(100000);
+                
+                std::vector<double> params (11);
+                params[0] = 0.0; // Frequency Offset
+                params[1] = 0.0; // Frequency Scale
+                params[2] = 1.0; // Radius Offset
+                params[3] = 0.0; // Radius Scale
+                params[4] = 5.0; // rConst (a constant)
+                params[5] = 0.0; // dMin for descending commands
+                params[6] = 5.0; // dMax for descending commands
+                params[7] = 2.0; // omega
+                params[8] = 0.5; // kFreq
+                params[9] = 0.2; // kAmp
+                params[10] = 0.3; // kPhase
+                
+                for (int i = 0; i < numNodes; i++)
+                {
+                    params[7] = 2.0 + 0.5 * i;
+                    m_pCPGSystem->addNode(params);
+                }
+                
+                // Each node pulls on its neighbours in a ring
+                for (int i = 0; i < numNodes; i++)
+                {
+                    std::vector<int> connectivityList;
+                    std::vector<double> weights;
+                    std::vector<double> phases;
+                    
+                    connectivityList.push_back((i + 1) % numNodes);
+                    weights.push_back(1.0);
+                    phases.push_back(M_PI / 3.0);
+                    
+                    connectivityList.push_back((i + numNodes - 1) % numNodes);
+                    weights.push_back(0.5);
+                    phases.push_back(-M_PI / 3.0);
+                    
+                    m_pCPGSystem->defineConnections(i, connectivityList, weights, phases);
+                }
+                
+                return m_pCPGSystem;
+            }
 	};
 
 	TEST_F(CPGEquationsTest, testIntegration) {
@@ -172,6 +218,109 @@ namespace {
             delete m_pCPGSystem2;
 	}
 
+	TEST_F(CPGEquationsTest, testFixedStepIntegration) {
+            
+            int numNodes = 3;
+            
+            CPGEquations* m_pCPGSystem = getCPGSystem(numNodes);
+            CPGEquations* m_pCPGSystem2 = getCPGSystem(numNodes);
+            m_pCPGSystem2->setFixedStep(0.001);
+            
+            std::vector<double> desComs (numNodes, 0.0);
+            
+            double m_updateTime = 20.0;
+            int numSteps = 100;
+            for (int i = 0; i < numSteps; i++)
+            {
+                m_pCPGSystem->update(desComs, (m_updateTime / (double) numSteps));
+                m_pCPGSystem2->update(desComs, (m_updateTime / (double) numSteps));
+            }
+            
+            EXPECT_NEAR((*m_pCPGSystem)[0], (*m_pCPGSystem2)[0], 1.0 * pow(10, -6));
+            EXPECT_NEAR((*m_pCPGSystem)[1], (*m_pCPGSystem2)[1], 1.0 * pow(10, -6));
+            EXPECT_NEAR((*m_pCPGSystem)[2], (*m_pCPGSystem2)[2], 1.0 * pow(10, -6));
+            
+            delete m_pCPGSystem;
+            delete m_pCPGSystem2;
+	}
+	
+	TEST_F(CPGEquationsTest, testFixedStepFeedback) {
+            
+            int numNodes = 6;
+            
+            CPGEquationsFB* m_pCPGSystem = getCPGFBSystem(numNodes);
+            CPGEquationsFB* m_pCPGSystem2 = getCPGFBSystem(numNodes);
+            m_pCPGSystem2->setFixedStep(0.001);
+            
+            std::vector<double> feedback (3 * numNodes);
+            
+            int numSteps = 200;
+            for (int i = 0; i < numSteps; i++)
+            {
+                for (std::size_t j = 0; j < feedback.size(); j++)
+                {
+                    feedback[j] = sin(0.1 * i + j);
+                }
+                m_pCPGSystem->update(feedback, 0.01);
+                m_pCPGSystem2->update(feedback, 0.01);
+            }
+            
+            for (int i = 0; i < numNodes; i++)
+            {
+                EXPECT_NEAR((*m_pCPGSystem)[i], (*m_pCPGSystem2)[i], 1.0 * pow(10, -5));
+            }
+            
+            delete m_pCPGSystem;
+            delete m_pCPGSystem2;
+	}
+	
+	TEST_F(CPGEquationsTest, testFixedStepIntegratorMatchesNodes) {
+            
+            // The integrator on its own gives the node values CPGEquations reports
+            CPGEquations* m_pCPGSystem = getCPGSystem(3);
+            m_pCPGSystem->setFixedStep(0.01);
+            
+            CPGFixedStepIntegrator integrator(CPGFixedStepIntegrator::eDescending);
+            std::vector<double> params (7);
+            params[0] = 1.0;
+            params[1] = 0.0;
+            params[2] = 1.0;
+            params[3] = 0.0;
+            params[4] = 20.0;
+            params[5] = 0.0;
+            params[6] = 5.0;
+            for (int i = 0; i < 3; i++)
+            {
+                integrator.addNode(params);
+            }
+            integrator.addCoupling(0, 1, 1.0, M_PI / 2.0);
+            integrator.addCoupling(1, 0, 1.0, M_PI / 2.0);
+            integrator.addCoupling(2, 0, 1.0, 0.0);
+            integrator.addCoupling(0, 2, 1.0, 0.0);
+            integrator.addCoupling(1, 2, 1.0, M_PI / 2.0);
+            integrator.addCoupling(2, 1, 1.0, M_PI / 2.0);
+            integrator.finalize();
+            
+            CPGFixedStepIntegrator::Workspace workspace;
+            std::vector<double> desComs (3, 1.0);
+            for (int i = 0; i < 50; i++)
+            {
+                m_pCPGSystem->update(desComs, 0.05);
+                EXPECT_EQ(20u, integrator.integrate(desComs, 0.05, 0.01, workspace));
+            }
+            
+            for (int i = 0; i < 3; i++)
+            {
+                EXPECT_EQ((*m_pCPGSystem)[i], integrator.getNodeValue(i));
+            }
+            
+            std::vector<double> wrongSize (2, 1.0);
+            EXPECT_THROW(integrator.integrate(wrongSize, 0.05, 0.01, workspace), std::invalid_argument);
+            EXPECT_THROW(integrator.addNode(params), std::logic_error);
+            
+            delete m_pCPGSystem;
+	}
+
 } // namespace
 
 int main(int argc, char **argv) {
@@ -0,0 +1,297 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file CompiledStructure_test.cpp
+* @brief Contains tests of CompiledStructure's file format
+* $Id$
+*/
+
+// This application
+#include "yamlbuilder/CompiledStructure.h"
+#include "tgcreator/tgNode.h"
+#include "tgcreator/tgNodes.h"
+#include "tgcreator/tgPair.h"
+#include "tgcreator/tgPairs.h"
+#include "tgcreator/tgStructure.h"
+// The Bullet Physics library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+// POSIX
+#include <dirent.h>
+// Google Test
+#include "gtest/gtest.h"
+
+namespace {
+
+	const char* const cacheFile = "CompiledStructure_test.bin";
+	const char* const rootFile = "CompiledStructure_test_root.yaml";
+	const char* const childFile = "CompiledStructure_test_child.yaml";
+
+	void writeFile(const char* path, const std::string& content)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file << content;
+	}
+
+	std::string readFile(const char* path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		return std::string((std::istreambuf_iterator<char>(file)),
+						   std::istreambuf_iterator<char>());
+	}
+
+	// A rod pair in a tagged child, which holds a tagged grandchild
+	tgStructure* makeChild(double offset)
+	{
+		tgStructure* const pChild = new tgStructure("leg left");
+		pChild->addNode(offset, 0.5, -1.25, "foot");
+		pChild->addNode(offset, 3.0, 0.0);
+		pChild->addPair(0, 1, "rod heavy");
+
+		tgStructure* const pGrandchild = new tgStructure("toe");
+		pGrandchild->addNode(offset + 0.1, 0.0, 0.0, "tip");
+		pGrandchild->addNode(offset + 0.2, 0.0, 1e-9);
+		pGrandchild->addPair(0, 1);
+		pChild->addChild(pGrandchild);
+		return pChild;
+	}
+
+	void makeStructure(tgStructure& structure)
+	{
+		structure.addTags("robot");
+		structure.addNode(0, 0, 0, "base");
+		structure.addNode(1.0 / 3.0, -2, 7);
+		structure.addNode(-4, 5, 1e6, "top spine");
+		structure.addPair(0, 1, "muscle");
+		structure.addPair(1, 2, "muscle saddle");
+		structure.addChild(makeChild(1.0));
+		structure.addChild(makeChild(-1.0));
+	}
+
+	void expectSameStructure(const tgStructure& expected,
+							 const tgStructure& actual)
+	{
+		EXPECT_EQ(expected.getTags(), actual.getTags());
+
+		const tgNodes& expectedNodes = expected.getNodes();
+		const tgNodes& actualNodes = actual.getNodes();
+		ASSERT_EQ(expectedNodes.size(), actualNodes.size());
+		for (std::size_t i = 0; i < expectedNodes.size(); i++)
+		{
+			EXPECT_TRUE(expectedNodes[i] == actualNodes[i]) << "node " << i;
+			EXPECT_EQ(expectedNodes[i].getTags(), actualNodes[i].getTags())
+				<< "node " << i;
+		}
+
+		const tgPairs& expectedPairs = expected.getPairs();
+		const tgPairs& actualPairs = actual.getPairs();
+		ASSERT_EQ(expectedPairs.size(), actualPairs.size());
+		for (std::size_t i = 0; i < expectedPairs.size(); i++)
+		{
+			EXPECT_TRUE(expectedPairs[i].getFrom() == actualPairs[i].getFrom())
+				<< "pair " << i;
+			EXPECT_TRUE(expectedPairs[i].getTo() == actualPairs[i].getTo())
+				<< "pair " << i;
+			EXPECT_EQ(expectedPairs[i].getTags(), actualPairs[i].getTags())
+				<< "pair " << i;
+		}
+
+		const std::vector<tgStructure*>& expectedChildren =
+			expected.getChildren();
+		const std::vector<tgStructure*>& actualChildren = actual.getChildren();
+		ASSERT_EQ(expectedChildren.size(), actualChildren.size());
+		for (std::size_t i = 0; i < expectedChildren.size(); i++)
+		{
+			expectSameStructure(*expectedChildren[i], *actualChildren[i]);
+		}
+	}
+
+	bool sameBuilder(const CompiledStructure::Builder& a,
+					 const CompiledStructure::Builder& b)
+	{
+		return a.builderClass == b.builderClass &&
+			a.tagMatch == b.tagMatch &&
+			a.parameters == b.parameters;
+	}
+
+	class CompiledStructureTest : public ::testing::Test
+	{
+	protected:
+		CompiledStructureTest()
+		{
+			writeFile(rootFile, "substructures:\n  leg: child.yaml\n");
+			writeFile(childFile, "nodes:\n  foot: [0, 0.5, 0]\n");
+
+			makeStructure(m_structure);
+			m_compiled.addInput(rootFile);
+			m_compiled.addInput(childFile);
+
+			CompiledStructure::Builder rods;
+			rods.builderClass = "tgRodInfo";
+			rods.tagMatch = "rod";
+			rods.parameters.push_back(std::make_pair("density", "0.688"));
+			rods.parameters.push_back(std::make_pair("radius", "0.31"));
+			m_compiled.addBuilder(rods);
+
+			CompiledStructure::Builder muscles;
+			muscles.builderClass = "tgBasicActuatorInfo";
+			muscles.tagMatch = "muscle";
+			m_compiled.addBuilder(muscles);
+
+			m_compiled.setStructure(m_structure);
+		}
+
+		virtual ~CompiledStructureTest()
+		{
+			std::remove(cacheFile);
+			std::remove(rootFile);
+			std::remove(childFile);
+		}
+
+		tgStructure m_structure;
+		CompiledStructure m_compiled;
+	};
+
+	TEST_F(CompiledStructureTest, RoundTripsANestedStructure)
+	{
+		m_compiled.write(cacheFile);
+
+		CompiledStructure loaded;
+		ASSERT_TRUE(loaded.read(cacheFile));
+		EXPECT_TRUE(loaded.isUpToDate(rootFile));
+
+		const std::vector<CompiledStructure::Builder>& builders =
+			loaded.getBuilders();
+		ASSERT_EQ(2u, builders.size());
+		EXPECT_TRUE(sameBuilder(m_compiled.getBuilders()[0], builders[0]));
+		EXPECT_TRUE(sameBuilder(m_compiled.getBuilders()[1], builders[1]));
+
+		tgStructure restored;
+		loaded.restoreStructure(restored);
+		ASSERT_EQ(2u, restored.getChildren().size());
+		ASSERT_EQ(1u, restored.getChildren()[0]->getChildren().size());
+		expectSameStructure(m_structure, restored);
+	}
+
+	TEST_F(CompiledStructureTest, WriteLeavesNoTemporaryFile)
+	{
+		// Over an existing file, as another worker would have left it
+		writeFile(cacheFile, "stale");
+		m_compiled.write(cacheFile);
+
+		const std::string prefix = std::string(cacheFile) + ".";
+		DIR* const pDir = opendir(".");
+		ASSERT_TRUE(pDir != NULL);
+		for (dirent* pEntry = readdir(pDir); pEntry != NULL;
+			 pEntry = readdir(pDir))
+		{
+			EXPECT_NE(0, std::string(pEntry->d_name).compare(0, prefix.size(),
+															 prefix))
+				<< pEntry->d_name;
+		}
+		closedir(pDir);
+
+		CompiledStructure loaded;
+		EXPECT_TRUE(loaded.read(cacheFile));
+	}
+
+	TEST_F(CompiledStructureTest, RejectsTruncatedFiles)
+	{
+		m_compiled.write(cacheFile);
+		const std::string data = readFile(cacheFile);
+		ASSERT_LT(100u, data.size());
+
+		// Every cut, from inside the magic to one byte short
+		for (std::size_t length = 0; length < data.size(); length++)
+		{
+			writeFile(cacheFile, data.substr(0, length));
+			CompiledStructure loaded;
+			EXPECT_FALSE(loaded.read(cacheFile)) << "length " << length;
+			EXPECT_TRUE(loaded.empty()) << "length " << length;
+			EXPECT_TRUE(loaded.getBuilders().empty()) << "length " << length;
+		}
+	}
+
+	TEST_F(CompiledStructureTest, RejectsCorruptFiles)
+	{
+		m_compiled.write(cacheFile);
+		const std::string data = readFile(cacheFile);
+
+		std::string badMagic = data;
+		badMagic[7] = 'X';
+		writeFile(cacheFile, badMagic);
+		CompiledStructure loaded;
+		EXPECT_FALSE(loaded.read(cacheFile));
+
+		writeFile(cacheFile, data + "x");
+		EXPECT_FALSE(loaded.read(cacheFile));
+		EXPECT_TRUE(loaded.empty());
+
+		// The first input path's length, so large it runs off the end
+		std::string badLength = data;
+		badLength[12 + sizeof(unsigned int) - 1] = '\x7f';
+		writeFile(cacheFile, badLength);
+		EXPECT_FALSE(loaded.read(cacheFile));
+
+		std::remove(cacheFile);
+		EXPECT_FALSE(loaded.read(cacheFile));
+
+		// Nothing was broken by the failures
+		writeFile(cacheFile, data);
+		EXPECT_TRUE(loaded.read(cacheFile));
+	}
+
+	TEST_F(CompiledStructureTest, ChangedInputsAreOutOfDate)
+	{
+		EXPECT_TRUE(m_compiled.isUpToDate(rootFile));
+		EXPECT_FALSE(m_compiled.isUpToDate(childFile));
+
+		writeFile(childFile, "nodes:\n  foot: [0, 0.75, 0]\n");
+		EXPECT_FALSE(m_compiled.isUpToDate(rootFile));
+
+		// Back to what it was compiled from
+		writeFile(childFile, "nodes:\n  foot: [0, 0.5, 0]\n");
+		EXPECT_TRUE(m_compiled.isUpToDate(rootFile));
+
+		std::remove(childFile);
+		EXPECT_FALSE(m_compiled.isUpToDate(rootFile));
+	}
+
+	TEST(CompiledStructureEmptyTest, NothingCompiledIsNeverUpToDate)
+	{
+		CompiledStructure compiled;
+		EXPECT_TRUE(compiled.empty());
+		EXPECT_FALSE(compiled.isUpToDate(rootFile));
+		tgStructure structure;
+		EXPECT_THROW(compiled.restoreStructure(structure), std::runtime_error);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}